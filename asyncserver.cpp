@@ -0,0 +1,439 @@
+/*---------------------------------------------------------------------------
+* @file: asyncserver.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: implementation of the AsyncLibraryServer class
+---------------------------------------------------------------------------*/
+#include "asyncserver.h"
+
+#if defined(__cpp_impl_coroutine)
+
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "command.h"
+#include "constants.h"
+
+using namespace std;
+
+// line that ends the answer to every command
+static const char* const ANSWER_END = ".\n";
+
+// transaction type of the command displayed in parts
+static const char DISPLAY_TYPE = 'D';
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* Creates the epoll instance, nothing is listened on and no worker runs yet
+* @pre: Library object exists and is built
+* @post: AsyncLibraryServer object exists
+* @param: Library& - the library commands are executed against
+* @param: int - number of worker threads running sessions
+*/
+AsyncLibraryServer::AsyncLibraryServer(Library& library, int workerCount)
+    : library(library), workerCount(workerCount), stopping(false) {
+    epollFd = epoll_create1(0);
+    listenFd = -1;
+    socketPath = "";
+    poolStopping = false;
+    if (this->workerCount < 1) {
+        this->workerCount = 1;
+    }
+}
+
+/*-------------------------------------------------------------------------
+* Destructor
+*
+* Closes the listening socket, and removes the Unix socket file if one
+* was created
+* @pre: run() has returned, or was never called
+* @post: all sockets are closed
+* @param: None
+*/
+AsyncLibraryServer::~AsyncLibraryServer() {
+    if (listenFd >= 0) {
+        close(listenFd);
+    }
+    if (socketPath != "") {
+        unlink(socketPath.c_str());
+    }
+    close(epollFd);
+}
+
+/*-------------------------------------------------------------------------
+* listenUnix(const string&)
+*
+* Listens on a Unix domain socket at the given path (replacing a stale
+* socket file left behind by an earlier run)
+* @pre: server is not listening yet
+* @post: clients can connect to the path
+* @param: const string& - file system path of the socket
+* @return: bool - true if the socket is listening
+*/
+bool AsyncLibraryServer::listenUnix(const string& path) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        cerr << "ERROR: socket path is too long: " << path << endl;
+        return false;
+    }
+    strcpy(address.sun_path, path.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str());
+    if (fd < 0 || bind(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+        cerr << "ERROR: cannot bind " << path << ": " << strerror(errno) << endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+    socketPath = path;
+    return startListening(fd);
+}
+
+/*-------------------------------------------------------------------------
+* listenTcp(int)
+*
+* Listens on the given TCP port of 127.0.0.1 only
+* @pre: server is not listening yet
+* @post: clients can connect to localhost:port
+* @param: int - the port number
+* @return: bool - true if the socket is listening
+*/
+bool AsyncLibraryServer::listenTcp(int port) {
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    if (fd >= 0) {
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    }
+    if (fd < 0 || bind(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+        cerr << "ERROR: cannot bind port " << port << ": " << strerror(errno) << endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+    return startListening(fd);
+}
+
+/*-------------------------------------------------------------------------
+* startListening(int)
+*
+* Makes a bound socket non-blocking, listens and registers it with epoll
+* @pre: socket is bound
+* @post: socket is listening, or closed on failure
+* @param: int - the bound socket
+* @return: bool - true if listening
+*/
+bool AsyncLibraryServer::startListening(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr; // the only registration without a Waiter
+    if (listen(fd, SERVER_BACKLOG) < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        cerr << "ERROR: cannot listen: " << strerror(errno) << endl;
+        close(fd);
+        return false;
+    }
+    listenFd = fd;
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* run()
+*
+* Starts the workers and runs the reactor until stop() is called, then
+* ends every session and joins the workers
+* @pre: listenUnix() or listenTcp() succeeded
+* @post: every session has ended and its socket is closed
+* @param: None
+*/
+void AsyncLibraryServer::run() {
+    for (int i = 0; i < workerCount; i++) {
+        workers.push_back(thread(&AsyncLibraryServer::work, this));
+    }
+
+    epoll_event events[MAX_EVENTS];
+    while (!stopping) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, EVENT_TIMEOUT);
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.ptr == nullptr) {
+                acceptConnections();
+            } else {
+                schedule(static_cast<Waiter*>(events[i].data.ptr)->handle);
+            }
+        }
+    }
+
+    // no new clients. Shutting the sockets down makes every pending read
+    // and write fail, so each session wakes up and ends on its own
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, listenFd, nullptr);
+    bool sessionsLeft = true;
+    while (sessionsLeft) {
+        {
+            lock_guard<mutex> guard(sessionLock);
+            for (set<int>::iterator fd = sessionFds.begin(); fd != sessionFds.end(); fd++) {
+                shutdown(*fd, SHUT_RDWR);
+            }
+            sessionsLeft = !sessionFds.empty();
+        }
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, EVENT_TIMEOUT / 10);
+        for (int i = 0; i < count; i++) {
+            schedule(static_cast<Waiter*>(events[i].data.ptr)->handle);
+        }
+    }
+
+    {
+        lock_guard<mutex> guard(queueLock);
+        poolStopping = true;
+    }
+    queueChanged.notify_all();
+    for (int i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+    workers.clear();
+}
+
+/*-------------------------------------------------------------------------
+* stop()
+*
+* Asks the reactor to return. Safe to call from a signal handler.
+* @pre: None
+* @post: run() returns once the sessions have ended
+* @param: None
+*/
+void AsyncLibraryServer::stop() {
+    stopping = true;
+}
+
+// accepts every pending client and starts a session for each
+void AsyncLibraryServer::acceptConnections() {
+    int fd = accept(listenFd, nullptr, nullptr);
+    while (fd >= 0) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        {
+            lock_guard<mutex> guard(sessionLock);
+            sessionFds.insert(fd);
+        }
+        schedule(session(fd).handle);
+        fd = accept(listenFd, nullptr, nullptr);
+    }
+}
+
+// queues a session to be resumed by a worker
+void AsyncLibraryServer::schedule(coroutine_handle<> handle) {
+    {
+        lock_guard<mutex> guard(queueLock);
+        runQueue.push_back(handle);
+    }
+    queueChanged.notify_one();
+}
+
+// worker thread body: resumes queued sessions until the pool stops
+void AsyncLibraryServer::work() {
+    unique_lock<mutex> guard(queueLock);
+    while (true) {
+        while (runQueue.empty() && !poolStopping) {
+            queueChanged.wait(guard);
+        }
+        if (runQueue.empty()) {
+            return;
+        }
+        coroutine_handle<> handle = runQueue.front();
+        runQueue.pop_front();
+        guard.unlock();
+        handle.resume();
+        guard.lock();
+    }
+}
+
+// awaitable: suspends until the waiter's socket is ready
+AsyncLibraryServer::ReadyAwaiter AsyncLibraryServer::ready(Waiter& waiter, unsigned int events) {
+    ReadyAwaiter awaiter;
+    awaiter.server = this;
+    awaiter.waiter = &waiter;
+    awaiter.events = events;
+    return awaiter;
+}
+
+// awaitable: lets the other queued sessions run first
+AsyncLibraryServer::YieldAwaiter AsyncLibraryServer::yield() {
+    YieldAwaiter awaiter;
+    awaiter.server = this;
+    return awaiter;
+}
+
+// arms the socket once, the reactor schedules the session when it fires.
+// The session may be resumed by another worker before this returns, so
+// nothing of the frame is touched after epoll_ctl
+void AsyncLibraryServer::ReadyAwaiter::await_suspend(coroutine_handle<> handle) {
+    waiter->handle = handle;
+    epoll_event event;
+    event.events = events | EPOLLONESHOT;
+    event.data.ptr = waiter;
+    int fd = waiter->fd;
+    if (epoll_ctl(server->epollFd, EPOLL_CTL_MOD, fd, &event) < 0 &&
+        (errno != ENOENT || epoll_ctl(server->epollFd, EPOLL_CTL_ADD, fd, &event) < 0)) {
+        // can't wait on this socket, let the session find out by itself
+        server->schedule(handle);
+    }
+}
+
+// queues the session behind everything already waiting to run
+void AsyncLibraryServer::YieldAwaiter::await_suspend(coroutine_handle<> handle) {
+    server->schedule(handle);
+}
+
+/*-------------------------------------------------------------------------
+* session(int)
+*
+* The coroutine serving one client: reads, executes the complete lines
+* (displays in parts), writes the answers, until the client is gone or
+* the server stops
+* @pre: socket is non-blocking and not yet registered with epoll
+* @post: socket is closed, the frame is freed
+* @param: int - the client socket
+* @return: Session - the suspended session, to be scheduled
+*/
+AsyncLibraryServer::Session AsyncLibraryServer::session(int fd) {
+    Waiter waiter;
+    waiter.fd = fd;
+    string input;
+    string output;
+    vector<string> lines;
+    Command command;
+    char buffer[ASYNC_READ_SIZE];
+    bool peerClosed = false;
+
+    while (!peerClosed) {
+        ssize_t count = recv(fd, buffer, sizeof(buffer), 0);
+        if (count > 0) {
+            input.append(buffer, count);
+        } else if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            co_await ready(waiter, EPOLLIN);
+            continue;
+        } else {
+            peerClosed = true;
+            // the last command of a client that is done sending may lack its newline
+            if (!input.empty() && input[input.size() - 1] != '\n') {
+                input += '\n';
+            }
+        }
+
+        // execute every complete line, in batches between displays
+        size_t start = 0;
+        size_t end = input.find('\n');
+        while (end != string::npos) {
+            string line = input.substr(start, end - start);
+            start = end + 1;
+            end = input.find('\n', start);
+            if (!CommandParser::parse(line, command) || command.type != DISPLAY_TYPE) {
+                lines.push_back(line);
+                if (lines.size() >= COMMAND_BATCH_SIZE) {
+                    executeBatch(lines, output);
+                    lines.clear();
+                }
+                continue;
+            }
+            if (!lines.empty()) {
+                executeBatch(lines, output);
+                lines.clear();
+            }
+
+            // a display, printed a part at a time with other sessions in between
+            // (counted with the time spent printing, not the time yielded)
+            Library::DisplayProgress progress;
+            ostringstream answer;
+            CommandStats& statistics = library.getStatistics();
+            long long spent = 0;
+            bool done;
+            {
+                lock_guard<mutex> guard(libraryLock);
+                long long started = statistics.now();
+                streambuf* console = cout.rdbuf(answer.rdbuf());
+                library.startDisplay(progress);
+                done = library.displayPart(progress, DISPLAY_PART_ITEMS);
+                cout.rdbuf(console);
+                spent += statistics.now() - started;
+            }
+            while (!done) {
+                co_await yield();
+                lock_guard<mutex> guard(libraryLock);
+                long long started = statistics.now();
+                streambuf* console = cout.rdbuf(answer.rdbuf());
+                done = library.displayPart(progress, DISPLAY_PART_ITEMS);
+                cout.rdbuf(console);
+                spent += statistics.now() - started;
+            }
+            {
+                lock_guard<mutex> guard(libraryLock);
+                statistics.finish(DISPLAY_TYPE, spent);
+            }
+            output += answer.str();
+            output += ANSWER_END;
+        }
+        if (!lines.empty()) {
+            executeBatch(lines, output);
+            lines.clear();
+        }
+        input.erase(0, start);
+        if (input.size() > MAX_COMMAND_LENGTH) {
+            // not a command line, stop listening to this client
+            input.clear();
+            peerClosed = true;
+        }
+
+        // answers go out before more commands are read (backpressure)
+        size_t written = 0;
+        while (written < output.size()) {
+            ssize_t sent = send(fd, output.data() + written, output.size() - written, MSG_NOSIGNAL);
+            if (sent > 0) {
+                written += sent;
+            } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                co_await ready(waiter, EPOLLOUT);
+            } else {
+                // client is gone, nothing more can be delivered
+                peerClosed = true;
+                break;
+            }
+        }
+        output.clear();
+    }
+
+    {
+        lock_guard<mutex> guard(sessionLock);
+        sessionFds.erase(fd);
+    }
+    close(fd);
+}
+
+// executes a batch of non-display lines, appending their answers
+void AsyncLibraryServer::executeBatch(const vector<string>& lines, string& output) {
+    vector<string> answers;
+    {
+        lock_guard<mutex> guard(libraryLock);
+        library.acceptBatch(lines, answers);
+    }
+    for (int i = 0; i < answers.size(); i++) {
+        output += answers[i];
+        output += ANSWER_END;
+    }
+}
+
+#endif // __cpp_impl_coroutine
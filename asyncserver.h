@@ -0,0 +1,220 @@
+/*---------------------------------------------------------------------------
+* @file: asyncserver.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the AsyncLibraryServer class
+---------------------------------------------------------------------------*/
+// AsyncLibraryServer Class: Serves the same line protocol as LibraryServer
+// (see server.h), but every client session is a C++20 coroutine that runs
+// on a small, fixed pool of worker threads.
+//---------------------------------------------------------------------------
+// Features:
+// -- A session awaits socket reads, parses and executes the complete lines
+//    it got, and awaits the writes of their answers. A session waiting on
+//    its socket holds no thread, so thousands of idle clients cost only
+//    their coroutine frames.
+// -- One reactor thread (the one calling run()) accepts clients and turns
+//    epoll readiness into resumed sessions. The workers only run sessions.
+// -- A Display is printed in parts of DISPLAY_PART_ITEMS items. Between the
+//    parts the session yields, so checkouts and returns from other clients
+//    are not stuck behind a display of a huge catalog.
+//
+// Assumptions/implementation:
+// -- Needs C++20 coroutines ("g++ -std=c++20 *.cpp"). Built as C++17, the
+//    class is left out and main.cpp falls back to LibraryServer.
+// -- The Library is not thread safe. Every use of it (and of std::cout,
+//    which is redirected into the session's answer) happens under one lock
+//    that is never held across a suspension. Lookups still run in batches
+//    (Library::acceptBatch).
+// -- Sockets are registered with EPOLLONESHOT: the session arms its socket
+//    right before it suspends and the reactor resumes it exactly once.
+// -- The Library is owned by the caller and must outlive the server.
+//---------------------------------------------------------------------------
+#ifndef ASYNCSERVER_H
+#define ASYNCSERVER_H
+
+#if defined(__cpp_impl_coroutine)
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <set>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <coroutine>
+#include "library.h"
+
+using namespace std;
+
+class AsyncLibraryServer {
+  public:
+    /*-------------------------------------------------------------------------
+    * Constructor
+    *
+    * Creates the epoll instance, nothing is listened on and no worker runs yet
+    * @pre: Library object exists and is built
+    * @post: AsyncLibraryServer object exists
+    * @param: Library& - the library commands are executed against
+    * @param: int - number of worker threads running sessions
+    */
+    AsyncLibraryServer(Library&, int);
+
+    /*-------------------------------------------------------------------------
+    * Destructor
+    *
+    * Closes the listening socket, and removes the Unix socket file if one
+    * was created
+    * @pre: run() has returned, or was never called
+    * @post: all sockets are closed
+    * @param: None
+    */
+    ~AsyncLibraryServer();
+
+    /*-------------------------------------------------------------------------
+    * listenUnix(const string&)
+    *
+    * Listens on a Unix domain socket at the given path (replacing a stale
+    * socket file left behind by an earlier run)
+    * @pre: server is not listening yet
+    * @post: clients can connect to the path
+    * @param: const string& - file system path of the socket
+    * @return: bool - true if the socket is listening
+    */
+    bool listenUnix(const string&);
+
+    /*-------------------------------------------------------------------------
+    * listenTcp(int)
+    *
+    * Listens on the given TCP port of 127.0.0.1 only
+    * @pre: server is not listening yet
+    * @post: clients can connect to localhost:port
+    * @param: int - the port number
+    * @return: bool - true if the socket is listening
+    */
+    bool listenTcp(int);
+
+    /*-------------------------------------------------------------------------
+    * run()
+    *
+    * Starts the workers and runs the reactor until stop() is called, then
+    * ends every session and joins the workers
+    * @pre: listenUnix() or listenTcp() succeeded
+    * @post: every session has ended and its socket is closed
+    * @param: None
+    */
+    void run();
+
+    /*-------------------------------------------------------------------------
+    * stop()
+    *
+    * Asks the reactor to return. Safe to call from a signal handler.
+    * @pre: None
+    * @post: run() returns once the sessions have ended
+    * @param: None
+    */
+    void stop();
+
+  private:
+    // coroutine type of a session. It starts suspended (run() schedules it)
+    // and frees its own frame when it ends, nobody waits for it
+    struct Session {
+        struct promise_type {
+            Session get_return_object() {
+                return Session{coroutine_handle<promise_type>::from_promise(*this)};
+            }
+            suspend_always initial_suspend() noexcept { return suspend_always(); }
+            suspend_never final_suspend() noexcept { return suspend_never(); }
+            void return_void() {}
+            void unhandled_exception() { terminate(); }
+        };
+        coroutine_handle<promise_type> handle;
+    };
+
+    // a session's socket and the session waiting on it, the epoll data of
+    // the socket points here
+    struct Waiter {
+        int fd;                        // client socket
+        coroutine_handle<> handle;     // session to resume when ready
+    };
+
+    // suspends a session until its socket is ready for the given events
+    struct ReadyAwaiter {
+        AsyncLibraryServer* server;
+        Waiter* waiter;
+        unsigned int events;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(coroutine_handle<>);
+        void await_resume() const noexcept {}
+    };
+
+    // puts a session at the back of the run queue
+    struct YieldAwaiter {
+        AsyncLibraryServer* server;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(coroutine_handle<>);
+        void await_resume() const noexcept {}
+    };
+
+    Library& library;                     // library commands run against
+    mutex libraryLock;                    // serializes every use of library
+    int workerCount;                      // threads running sessions
+    int epollFd;                          // epoll instance
+    int listenFd;                         // listening socket, -1 if none
+    string socketPath;                    // Unix socket file, "" for TCP
+    atomic<bool> stopping;                // set by stop()
+
+    vector<thread> workers;               // the pool
+    deque<coroutine_handle<> > runQueue;  // sessions ready to run
+    bool poolStopping;                    // workers return once queue is empty
+    mutex queueLock;                      // guards runQueue and poolStopping
+    condition_variable queueChanged;      // signaled on schedule and shutdown
+
+    set<int> sessionFds;                  // sockets of live sessions
+    mutex sessionLock;                    // guards sessionFds
+
+    /*-------------------------------------------------------------------------
+    * startListening(int)
+    *
+    * Makes a bound socket non-blocking, listens and registers it with epoll
+    * @pre: socket is bound
+    * @post: socket is listening, or closed on failure
+    * @param: int - the bound socket
+    * @return: bool - true if listening
+    */
+    bool startListening(int);
+
+    // accepts every pending client and starts a session for each
+    void acceptConnections();
+
+    // queues a session to be resumed by a worker
+    void schedule(coroutine_handle<>);
+
+    // worker thread body: resumes queued sessions until the pool stops
+    void work();
+
+    // awaitable: suspends until the waiter's socket is ready
+    ReadyAwaiter ready(Waiter&, unsigned int);
+
+    // awaitable: lets the other queued sessions run first
+    YieldAwaiter yield();
+
+    /*-------------------------------------------------------------------------
+    * session(int)
+    *
+    * The coroutine serving one client: reads, executes the complete lines
+    * (displays in parts), writes the answers, until the client is gone or
+    * the server stops
+    * @pre: socket is non-blocking and registered with epoll (disarmed)
+    * @post: socket is closed, the frame is freed
+    * @param: int - the client socket
+    * @return: Session - the suspended session, to be scheduled
+    */
+    Session session(int);
+
+    // executes a batch of non-display lines, appending their answers
+    void executeBatch(const vector<string>&, string&);
+};
+
+#endif // __cpp_impl_coroutine
+#endif //ASYNCSERVER_H
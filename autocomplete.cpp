@@ -0,0 +1,183 @@
+/*---------------------------------------------------------------------------
+* @file: autocomplete.cpp
+* @authors: Braxton Goss & Elijah Shaw
+* @brief: implementation of the transaction type - autocomplete
+--------------------------------------------------------------------------*/
+
+#include "transaction.h"
+#include "autocomplete.h"
+#include "library.h"
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* Initializes patronID to be 0 and the prefix to be empty
+* @pre: Nothing
+* @post: new Autocomplete object exists
+* @param: None
+*/
+Autocomplete::Autocomplete() : Transaction() {
+    patronID = 0;
+    itemType = ' ';
+    prefix = "";
+    patron = nullptr;
+}
+
+/*-------------------------------------------------------------------------
+* Destructor
+*
+* Nothing to delete
+* @pre: Autocomplete object exists
+* @post: Memory associated with that Autocomplete object is released
+* @param: None
+*/
+Autocomplete::~Autocomplete() {}
+
+/*-------------------------------------------------------------------------
+* create()
+*
+* Returns a pointer to a newly created & empty Autocomplete object
+* This method is used inside of TransactionFactory to create new objects
+* without using Switch-Case or If-else statements.
+* @pre: Nothing
+* @post: empty Autocomplete object is returned to the caller
+* @param: None
+* @return: returns the new Autocomplete object
+*/
+Autocomplete* Autocomplete::create() const {
+    return new Autocomplete();
+}
+
+/*-------------------------------------------------------------------------
+* load(const Command&)
+*
+* Stores the patronID, the "*" and the prefix typed.
+* @pre: command.type is A
+* @post: patronID, itemType and prefix are stored
+* @param: const Command& - the parsed command
+*/
+void Autocomplete::load(const Command& command) {
+    patronID = command.patronID;
+    itemType = command.itemType;
+    // the parser takes the first character after the item type as a
+    // format: here it is the first letter typed
+    prefix.clear();
+    if (command.format != ' ') {
+        prefix += command.format;
+    }
+    prefix += command.itemData;
+}
+
+/*-------------------------------------------------------------------------
+* getPatronID()
+*
+* Returns the patron ID loaded by load(), used for prefetching
+* @pre: load() has been called
+* @post: Autocomplete is unchanged
+* @return: int - the patron ID of this command
+*/
+int Autocomplete::getPatronID() const {
+    return patronID;
+}
+
+/*-------------------------------------------------------------------------
+* findPatron(Library&)
+*
+* Looks up the patron typing.
+* @pre: load() has been called
+* @post: patron is set, or nullptr if the ID is invalid
+* @param: Library& - the library the patron is looked up in
+*/
+void Autocomplete::findPatron(Library& currLibrary) {
+    patron = nullptr;
+    currLibrary.retrievePatron(patronID, patron);
+}
+
+/*-------------------------------------------------------------------------
+* findItem(Library&)
+*
+* An autocomplete names no item, the titles are found by apply().
+* @pre: None
+* @post: Nothing is changed
+* @param: Library& - unused
+*/
+void Autocomplete::findItem(Library&) {
+    // nothing to look up
+}
+
+/*-------------------------------------------------------------------------
+* apply(Library&)
+*
+* Prints the titles starting with the prefix, or an error if the
+* patronID is invalid or the item type isn't "*".
+* @pre: earlier commands have been applied
+* @post: the completions are printed, the library is unchanged
+* @param: Library& - the library whose titles are completed
+* @return: always false, there is no information to save for an
+* Autocomplete
+*/
+bool Autocomplete::apply(Library& currLibrary) {
+    if (patron == nullptr) {
+        cout << endl;
+        cout << "ERROR: Cannot autocomplete for invalid Patron ID: " << patronID << endl;
+        currLibrary.getStatistics().error(CommandStats::INVALID_PATRON);
+    } else if (itemType != '*') {
+        cout << endl;
+        cout << "ERROR: Cannot autocomplete for item type: " << itemType
+             << " (titles of every section are completed, use *)" << endl;
+        currLibrary.getStatistics().error(CommandStats::INVALID_TYPE);
+    } else {
+        // one list per thread, a query allocates nothing once it has grown
+        static thread_local vector<const TitleTrie::Title*> titles;
+        currLibrary.completeTitle(prefix, titles);
+        cout << endl << "Titles starting with \"" << prefix << "\": "
+             << titles.size() << endl;
+        for (size_t i = 0; i < titles.size(); i++) {
+            cout << "   " << titles[i]->title << " (" << titles[i]->checkouts
+                 << " checkouts)" << endl;
+        }
+    }
+    return false;
+}
+
+/*-------------------------------------------------------------------------
+* display()
+*
+* Prints to the std::cout the Autocomplete action, which is always
+* nothing: apply() printed the completions.
+* @pre: execute() has already been called by this object.
+* @post: Nothing is printed
+* @param: None
+*/
+void Autocomplete::display() const {
+
+}
+
+/*-------------------------------------------------------------------------
+* replay(Patron*, char, Item*, int&)
+*
+* An Autocomplete never changes the library, so it is never logged and
+* there is nothing to redo.
+* @pre: Nothing
+* @post: Nothing is changed
+* @param: Patron*, char, Item* - unused
+* @param: int& - set to 0, an Autocomplete never changes stock
+* @return: always false, an Autocomplete is never saved to patron
+* history
+*/
+bool Autocomplete::replay(Patron*, char, Item*, int& stockChange) {
+    stockChange = 0;
+    return false;
+}
+
+/*-------------------------------------------------------------------------
+* save(ostream&)
+*
+* Never called, an Autocomplete is not saved to any patron history.
+* @pre: Nothing
+* @post: Nothing is written
+* @param: ostream& - the stream the record is written to
+*/
+void Autocomplete::save(ostream&) const {
+    // nothing to save, not part of a patron's transaction list
+}
@@ -0,0 +1,160 @@
+/*---------------------------------------------------------------------------
+* @file: autocomplete.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the autocomplete (type of transaction) class
+//------------------------------------------------------------------------*/
+// Autocomplete Class: What a kiosk asks for while a patron types a title:
+// the titles starting with the letters typed so far, most checked out
+// first. Command line: "A 1000 * Harry Po", the patron, then "*" where
+// other commands name the item type (titles come from every section),
+// then the prefix.
+// Features:
+// -- Prints up to AUTOCOMPLETE_RESULTS titles from the library's title
+//    trie (see TitleTrie), each with its checkouts.
+//
+// Assumptions/implementation:
+// -- The prefix is the rest of the line; case and extra blanks don't
+//    matter, a blank at its end does ("the " isn't "theory").
+// -- Like a History, it changes nothing, so it is never saved or logged.
+// -- A query walks the prefix down the trie and copies one node's list,
+//    the size of the catalog doesn't matter.
+//---------------------------------------------------------------------------
+
+#ifndef AUTOCOMPLETE_H
+#define AUTOCOMPLETE_H
+
+class Autocomplete : public Transaction {
+    public:
+
+        /*-------------------------------------------------------------------------
+        * Constructor
+        *
+        * Initializes patronID to be 0 and the prefix to be empty
+        * @pre: Nothing
+        * @post: new Autocomplete object exists
+        * @param: None
+        */
+        Autocomplete();
+
+        /*-------------------------------------------------------------------------
+        * Destructor
+        *
+        * Nothing to delete
+        * @pre: Autocomplete object exists
+        * @post: Memory associated with that Autocomplete object is released
+        * @param: None
+        */
+        ~Autocomplete();
+
+        /*-------------------------------------------------------------------------
+        * create()
+        *
+        * Returns a pointer to a newly created & empty Autocomplete object
+        * This method is used inside of TransactionFactory to create new objects
+        * without using Switch-Case or If-else statements.
+        * @pre: Nothing
+        * @post: empty Autocomplete object is returned to the caller
+        * @param: None
+        * @return: returns the new Autocomplete object
+        */
+        virtual Autocomplete* create() const;
+
+        // letter of the command, for its registration in TransactionTypes
+        static const char TYPE = 'A';
+
+        /*-------------------------------------------------------------------------
+        * load(const Command&)
+        *
+        * Stores the patronID, the "*" and the prefix typed.
+        * @pre: command.type is A
+        * @post: patronID, itemType and prefix are stored
+        * @param: const Command& - the parsed command
+        */
+        virtual void load(const Command&);
+
+        /*-------------------------------------------------------------------------
+        * getPatronID()
+        *
+        * Returns the patron ID loaded by load(), used for prefetching
+        * @pre: load() has been called
+        * @post: Autocomplete is unchanged
+        * @return: int - the patron ID of this command
+        */
+        virtual int getPatronID() const;
+
+        /*-------------------------------------------------------------------------
+        * findPatron(Library&)
+        *
+        * Looks up the patron typing.
+        * @pre: load() has been called
+        * @post: patron is set, or nullptr if the ID is invalid
+        * @param: Library& - the library the patron is looked up in
+        */
+        virtual void findPatron(Library&);
+
+        /*-------------------------------------------------------------------------
+        * findItem(Library&)
+        *
+        * An autocomplete names no item, the titles are found by apply().
+        * @pre: None
+        * @post: Nothing is changed
+        * @param: Library& - unused
+        */
+        virtual void findItem(Library&);
+
+        /*-------------------------------------------------------------------------
+        * apply(Library&)
+        *
+        * Prints the titles starting with the prefix, or an error if the
+        * patronID is invalid or the item type isn't "*".
+        * @pre: earlier commands have been applied
+        * @post: the completions are printed, the library is unchanged
+        * @param: Library& - the library whose titles are completed
+        * @return: always false, there is no information to save for an
+        * Autocomplete
+        */
+        virtual bool apply(Library&);
+
+        /*-------------------------------------------------------------------------
+        * display()
+        *
+        * Prints to the std::cout the Autocomplete action, which is always
+        * nothing: apply() printed the completions.
+        * @pre: execute() has already been called by this object.
+        * @post: Nothing is printed
+        * @param: None
+        */
+        virtual void display() const;
+
+        /*-------------------------------------------------------------------------
+        * replay(Patron*, char, Item*, int&)
+        *
+        * An Autocomplete never changes the library, so it is never logged and
+        * there is nothing to redo.
+        * @pre: Nothing
+        * @post: Nothing is changed
+        * @param: Patron*, char, Item* - unused
+        * @param: int& - set to 0, an Autocomplete never changes stock
+        * @return: always false, an Autocomplete is never saved to patron
+        * history
+        */
+        virtual bool replay(Patron*, char, Item*, int&);
+
+        /*-------------------------------------------------------------------------
+        * save(ostream&)
+        *
+        * Never called, an Autocomplete is not saved to any patron history.
+        * @pre: Nothing
+        * @post: Nothing is written
+        * @param: ostream& - the stream the record is written to
+        */
+        virtual void save(ostream&) const;
+
+    private:
+        int patronID;      // ID of the patron typing
+        char itemType;     // "*" for every section, anything else is an error
+        string prefix;     // what was typed so far
+        Patron* patron;    // patron found by findPatron(), nullptr if invalid
+};
+
+#endif
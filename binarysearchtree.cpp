@@ -20,10 +20,8 @@ using namespace std;
 * @param: string name - name of tree 
 * @param: string header - combination of headers used for display
 */
-BinarySearchTree::BinarySearchTree(string name, string header) {
+BinarySearchTree::BinarySearchTree(string name, string header) : Section(name, header) {
     root = nullptr;
-    this->name = name;
-    this->header = header;
 }
 
 /*-------------------------------------------------------------------------
@@ -48,18 +46,7 @@ BinarySearchTree::~BinarySearchTree() {
 * Note: uses private member method makeEmptyHelper for recursion
 */
 void BinarySearchTree::display() const {
-    cout << '\n' << this->name << endl;
-    // Header AVAIL, AUTHOR, TITLE, YEAR ETC
-    stringstream headers(header);
-    string currentHeader;
-    getline(headers, currentHeader, ',');
-    cout << setw(AVAIL_WIDTH) << left << currentHeader;
-    getline(headers, currentHeader, ',');
-    cout << setw(TITLE_WIDTH)<< left << currentHeader;
-    getline(headers, currentHeader, ',');
-    cout << setw(MONTH_AUTHOR_WIDTH) << left << currentHeader;
-    getline(headers, currentHeader, ',');
-    cout << setw(YEAR_WIDTH) << left << currentHeader << endl;
+    displayHeader();
     displayHelper(root);
 }
 
@@ -74,6 +61,29 @@ void BinarySearchTree::displayHelper(Node *root) const {
     displayHelper(root->right);
 }
 
+/*-------------------------------------------------------------------------
+* collect()
+*
+* @pre: tree is declared (empty or not)
+* @post: every Item in the tree is appended to the vector in sorted 
+* (inorder) order. The tree still owns the Items.
+* @param: vector<Item*>& items - the list the Items are appended to
+* Note: uses private member method collectHelper for recursion
+*/
+void BinarySearchTree::collect(vector<Item*> &items) const {
+    collectHelper(root, items);
+}
+
+// recursive inorder collection helper
+void BinarySearchTree::collectHelper(Node *root, vector<Item*> &items) const {
+    if (root == nullptr) {
+        return;
+    }
+    collectHelper(root->left, items);
+    items.push_back(root->data);
+    collectHelper(root->right, items);
+}
+
 /*-------------------------------------------------------------------------
 * retrieve()
 *
@@ -86,9 +96,25 @@ void BinarySearchTree::displayHelper(Node *root) const {
 * @return: bool - true if found, false if not
 */
 bool BinarySearchTree::retrieve(const Item &target, Item *&found) const {
+    int depth;
+    return retrieve(target, found, depth);
+}
+
+/*-------------------------------------------------------------------------
+* retrieve() with depth
+*
+* same as retrieve() above, and also reports how deep the search went
+* @pre: tree must be declared and target must be passed of type: Item
+* @post: as retrieve(), depth is the number of nodes compared to target
+* @param: int& depth - set to the number of nodes visited
+* @return: bool - true if found, false if not
+*/
+bool BinarySearchTree::retrieve(const Item &target, Item *&found, int &depth) const {
     Node *temp = root;
     bool result = false;
+    depth = 0;
     while (temp != nullptr && !result) {
+        depth++;
         if (*temp->data == target) {
             found = temp->data;
             result = true;
@@ -101,6 +127,100 @@ bool BinarySearchTree::retrieve(const Item &target, Item *&found) const {
     return result;
 }
 
+/*-------------------------------------------------------------------------
+* remove()
+*
+* Unlinks the node of the Item retrieve() would find for target. A node
+* with two children is replaced by its in-order successor node, so no
+* Item moves between nodes.
+* @pre: target is of the tree's type
+* @post: if a match is found, its node is freed and the Item is kept
+* (with the removed ones) until makeEmpty()
+* @param: const Item& target - the Item to remove
+* @param: Item*& removed - set to the Item removed, unchanged if not found
+* @return: bool - true if removed, false if not found
+*/
+bool BinarySearchTree::remove(const Item &target, Item *&removed) {
+    thaw();
+    // same descent as retrieve(), keeping the link to the node
+    Node **link = &root;
+    while (*link != nullptr && !(*(*link)->data == target)) {
+        link = (*(*link)->data > target) ? &(*link)->left : &(*link)->right;
+    }
+    if (*link == nullptr) {
+        return false;
+    }
+    Node *node = *link;
+    if (node->left == nullptr) {
+        *link = node->right;
+    } else if (node->right == nullptr) {
+        *link = node->left;
+    } else {
+        // the leftmost node of the right subtree takes the node's place
+        Node **next = &node->right;
+        while ((*next)->left != nullptr) {
+            next = &(*next)->left;
+        }
+        Node *successor = *next;
+        *next = successor->right;
+        successor->left = node->left;
+        successor->right = node->right;
+        *link = successor;
+    }
+    index.remove(node->data->keyHash(), node->data);
+    removed = node->data;
+    removedItems.push_back(node->data);
+    delete node;
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* measure()
+*
+* @pre: tree is declared (empty or not)
+* @post: tree is unchanged
+* @param: Shape& shape - set to the height, depths and memory of the tree
+* Note: walks the tree with a stack of its own instead of recursion, so
+* degenerate (list shaped) trees can be measured too
+*/
+void BinarySearchTree::measure(Shape &shape) const {
+    resetShape(shape);
+
+    long depthSum = 0;
+    vector<pair<Node*, int> > pending;
+    if (root != nullptr) {
+        pending.push_back(make_pair(root, 1));
+    }
+    while (!pending.empty()) {
+        Node *node = pending.back().first;
+        int depth = pending.back().second;
+        pending.pop_back();
+
+        shape.nodes++;
+        depthSum += depth;
+        if (depth > shape.height) {
+            shape.height = depth;
+            shape.depths.resize(depth + 1, 0);
+        }
+        shape.depths[depth]++;
+        shape.nodeBytes += sizeof(Node);
+        shape.itemBytes += node->data->getObjectSize();
+        shape.stringBytes += node->data->getStringSize();
+
+        if (node->left != nullptr) {
+            pending.push_back(make_pair(node->left, depth + 1));
+        }
+        if (node->right != nullptr) {
+            pending.push_back(make_pair(node->right, depth + 1));
+        }
+    }
+    shape.indexBytes = ((frozen != nullptr) ? frozen->getBytes() : index.getBytes())
+                       + filter.getBytes();
+    if (shape.nodes > 0) {
+        shape.averageDepth = static_cast<double>(depthSum) / shape.nodes;
+    }
+}
+
 /*-------------------------------------------------------------------------
 * insert()
 *
@@ -113,6 +233,7 @@ bool BinarySearchTree::retrieve(const Item &target, Item *&found) const {
 * Relies on Item comparison operators < and > to find space in tree
 */
 bool BinarySearchTree::insert(Item *obj) {
+    thaw();
     Node *ptr = new Node; // exception is thrown if memory is not allocated
     ptr->left = ptr->right = nullptr;
     ptr->data = obj;
@@ -149,6 +270,9 @@ bool BinarySearchTree::insert(Item *obj) {
             }
         }
     }
+    size_t hash = ptr->data->keyHash();
+    index.insert(hash, ptr->data);
+    filterKey(hash);
     return true;
 }
 
@@ -175,6 +299,11 @@ bool BinarySearchTree::isEmpty() const {
 */
 void BinarySearchTree::makeEmpty() { 
     makeEmptyHelper(root); 
+    clearIndexes();
+    for (int i = 0; i < removedItems.size(); i++) {
+        delete removedItems[i];
+    }
+    removedItems.clear();
 }
 
 // Helper to makeEmpty(). postOrder deletion: left, right, node
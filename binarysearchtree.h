@@ -12,6 +12,7 @@
 //  -- Allows for insertion (in sorted order) and retrieval of Nodes 
 //  -- Displays tree using an in-order traversal 
 //  -- Dump the entire tree using makeEmpty() or by calling delete 
+//  -- Implements the Section interface (pointer storage of a section)
 //
 // Assumptions/implementation:
 // -- implemented using classic Node, left, right implementation. Each node
@@ -25,7 +26,9 @@
 #ifndef BINARYSEARCHTREE_H
 #define BINARYSEARCHTREE_H
 
+#include <vector>
 #include "item.h"
+#include "section.h"
 
 class Node {
 
@@ -43,7 +46,7 @@ class Node {
     friend class BinarySearchTree; 
 };
 
-class BinarySearchTree {
+class BinarySearchTree : public Section {
 
 public:
     /*-------------------------------------------------------------------------
@@ -79,6 +82,17 @@ public:
     */
     bool retrieve(const Item &target, Item *&found) const;
 
+    /*-------------------------------------------------------------------------
+    * retrieve() with depth
+    *
+    * same as retrieve() above, and also reports how deep the search went
+    * @pre: tree must be declared and target must be passed of type: Item
+    * @post: as retrieve(), depth is the number of nodes compared to target
+    * @param: int& depth - set to the number of nodes visited
+    * @return: bool - true if found, false if not
+    */
+    bool retrieve(const Item &target, Item *&found, int &depth) const;
+
     /*-------------------------------------------------------------------------
     * insert()
     *
@@ -92,6 +106,85 @@ public:
     */
     bool insert(Item *data);
 
+    /*-------------------------------------------------------------------------
+    * remove()
+    *
+    * Unlinks the node of the Item retrieve() would find for target. A node
+    * with two children is replaced by its in-order successor node, so no
+    * Item moves between nodes.
+    * @pre: target is of the tree's type
+    * @post: if a match is found, its node is freed and the Item is kept
+    * (with the removed ones) until makeEmpty()
+    * @param: const Item& target - the Item to remove
+    * @param: Item*& removed - set to the Item removed, unchanged if not found
+    * @return: bool - true if removed, false if not found
+    */
+    bool remove(const Item &target, Item *&removed);
+
+    /*-------------------------------------------------------------------------
+    * retrieveAs<Type>()
+    *
+    * same as retrieve() with depth, for a tree holding only Items of Type.
+    * Type::compare() is called directly and inlined, instead of the virtual
+    * (and copying) operators
+    * @pre: every Item in the tree and target are of Type
+    * @post: as retrieve(), depth is the number of nodes compared to target
+    * @param: const Type& target - the Item to find
+    * @param: Item*& found - set to the Item found, unchanged if not found
+    * @param: int& depth - set to the number of nodes visited
+    * @return: bool - true if found, false if not
+    */
+    template <class Type>
+    bool retrieveAs(const Type &target, Item *&found, int &depth) const {
+        Node *temp = root;
+        depth = 0;
+        while (temp != nullptr) {
+            depth++;
+            const Type &data = static_cast<const Type &>(*temp->data);
+            int order = data.compare(target);
+            if (order == 0 && data.sameFormat(target)) {
+                found = temp->data;
+                return true;
+            }
+            // same place in the order but another format goes right, as in
+            // retrieve()
+            temp = (order > 0) ? temp->left : temp->right;
+        }
+        return false;
+    }
+
+    /*-------------------------------------------------------------------------
+    * insertAs<Type>()
+    *
+    * same as insert(), for a tree holding only Items of Type, comparing
+    * with Type::compare()
+    * @pre: every Item in the tree and data are of Type
+    * @post: data is inserted (if not a duplicate)
+    * @param: Item* data - the Item object to be inserted into tree
+    * @return: true if inserted correctly, false if a duplicate
+    */
+    template <class Type>
+    bool insertAs(Item *data) {
+        thaw();
+        const Type &item = static_cast<const Type &>(*data);
+        Node **link = &root;
+        while (*link != nullptr) {
+            int order = item.compare(static_cast<const Type &>(*(*link)->data));
+            if (order == 0) {
+                return false; // no dupes allowed
+            }
+            link = (order < 0) ? &(*link)->left : &(*link)->right;
+        }
+        Node *ptr = new Node; // exception is thrown if memory is not allocated
+        ptr->data = data;
+        ptr->left = ptr->right = nullptr;
+        *link = ptr;
+        size_t hash = item.Type::keyHash();
+        index.insert(hash, data);
+        filterKey(hash);
+        return true;
+    }
+
     /*-------------------------------------------------------------------------
     * isEmpty()
     *
@@ -123,12 +216,35 @@ public:
     */
     void display() const;
 
+    /*-------------------------------------------------------------------------
+    * collect()
+    *
+    * @pre: tree is declared (empty or not)
+    * @post: every Item in the tree is appended to the vector in sorted 
+    * (inorder) order. The tree still owns the Items.
+    * @param: vector<Item*>& items - the list the Items are appended to
+    * Note: uses private member method collectHelper for recursion
+    */
+    void collect(vector<Item*> &items) const;
+
+    /*-------------------------------------------------------------------------
+    * measure()
+    *
+    * @pre: tree is declared (empty or not)
+    * @post: tree is unchanged
+    * @param: Shape& shape - set to the height, depths and memory of the tree
+    * Note: walks the tree with a stack of its own instead of recursion, so
+    * degenerate (list shaped) trees can be measured too
+    */
+    void measure(Shape &shape) const;
+
 
 private:
 
     Node *root; // root of the tree
-    string name; // name of the tree
-    string header;
+
+    // Items removed from the tree, freed by makeEmpty()
+    vector<Item*> removedItems;
     
     // ************************************** //
     // **** utility functions start here **** //
@@ -137,6 +253,9 @@ private:
     // recursive function to help display the entire tree
     void displayHelper(Node *root) const;
 
+    // recursive function to help collect the entire tree in order
+    void collectHelper(Node *root, vector<Item*> &items) const;
+
     // recursive function to help delete the entire tree and free memory
     void makeEmptyHelper(Node *&node);
 
@@ -0,0 +1,103 @@
+/*---------------------------------------------------------------------------
+* @file: bloomfilter.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: implementation of the BloomFilter class
+---------------------------------------------------------------------------*/
+#include "bloomfilter.h"
+#include "constants.h"
+
+using namespace std;
+
+// keys a block is sized for
+static const size_t BLOCK_KEYS = 512 / BLOOM_BITS_PER_KEY;
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* @pre: None
+* @post: empty filter exists, sized for no key
+* @param: None
+*/
+BloomFilter::BloomFilter() {
+    blocks = nullptr;
+    blockCount = 0;
+    count = 0;
+    capacity = 0;
+}
+
+/*-------------------------------------------------------------------------
+* Destructor
+*
+* @pre: filter exists
+* @post: the blocks are freed
+* @param: None
+*/
+BloomFilter::~BloomFilter() {
+    clear();
+}
+
+/*-------------------------------------------------------------------------
+* reset(size_t)
+*
+* Empties the filter and sizes it for a number of keys
+* @pre: None
+* @post: filter holds no key, add() accepts at least keys keys
+* @param: size_t - the number of keys
+*/
+void BloomFilter::reset(size_t keys) {
+    clear();
+    blockCount = (keys + BLOCK_KEYS - 1) / BLOCK_KEYS;
+    if (blockCount == 0) {
+        blockCount = 1;
+    }
+    blocks = new Block[blockCount]();
+    capacity = blockCount * BLOCK_KEYS;
+}
+
+/*-------------------------------------------------------------------------
+* add(size_t)
+*
+* @pre: None
+* @post: if there was room, mayContain() is true for the hash
+* @param: size_t - the key's keyHash()
+* @return: bool - false if the filter is full (the key is not added)
+*/
+bool BloomFilter::add(size_t hash) {
+    if (count == capacity) {
+        return false;
+    }
+    uint64_t mixed = mix(hash);
+    uint64_t* words = blocks[blockOf(mixed)].words;
+    uint32_t bits = static_cast<uint32_t>(mixed);
+    for (int w = 0; w < BLOCK_WORDS; w++) {
+        words[w] |= bitOf(bits, w);
+    }
+    count++;
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* clear()
+*
+* @pre: None
+* @post: filter holds no key and its blocks are freed
+* @param: None
+*/
+void BloomFilter::clear() {
+    delete[] blocks;
+    blocks = nullptr;
+    blockCount = 0;
+    count = 0;
+    capacity = 0;
+}
+
+/*-------------------------------------------------------------------------
+* getBytes()
+*
+* @pre: None
+* @post: filter is unchanged
+* @return: long - memory of the blocks
+*/
+long BloomFilter::getBytes() const {
+    return static_cast<long>(blockCount * sizeof(Block));
+}
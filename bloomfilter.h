@@ -0,0 +1,157 @@
+/*---------------------------------------------------------------------------
+* @file: bloomfilter.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the BloomFilter class
+---------------------------------------------------------------------------*/
+// BloomFilter Class: Set of key hashes that answers "certainly not in the
+// section" or "maybe in it". Misspelled and stale titles are a large share
+// of the commands, and a section checks its filter before its index, so
+// most of them are turned away without a probe.
+//---------------------------------------------------------------------------
+// Features:
+// -- Blocked (split block, as in Impala and Parquet): a key only sets and
+//    tests bits of one 64 byte block, one cache line, so a lookup is one
+//    memory access. The block is 8 words and the key has one bit in each.
+// -- The 8 words are tested without a branch between them (the loop
+//    folds them into one mask), which the compiler turns into vector
+//    instructions where the target has them.
+// -- BLOOM_BITS_PER_KEY bits per key: about 1 miss in 1000 gets through
+//    to the index when the filter is full, fewer after a rebuild (it is
+//    then half full).
+//
+// Assumptions/implementation:
+// -- Keys are only added. add() refuses a key once the filter holds as
+//    many as it was sized for; its section then rebuilds it, twice as big,
+//    from the Items it holds. Removed keys stay in until that rebuild
+//    (they only get through to the index, which doesn't find them).
+// -- An empty filter (nothing sized yet) contains nothing.
+//---------------------------------------------------------------------------
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+#include <cstdint>
+#include <cstddef>
+
+class BloomFilter {
+  public:
+    /*-------------------------------------------------------------------------
+    * Constructor
+    *
+    * @pre: None
+    * @post: empty filter exists, sized for no key
+    * @param: None
+    */
+    BloomFilter();
+
+    /*-------------------------------------------------------------------------
+    * Destructor
+    *
+    * @pre: filter exists
+    * @post: the blocks are freed
+    * @param: None
+    */
+    ~BloomFilter();
+
+    /*-------------------------------------------------------------------------
+    * reset(size_t)
+    *
+    * Empties the filter and sizes it for a number of keys
+    * @pre: None
+    * @post: filter holds no key, add() accepts at least keys keys
+    * @param: size_t - the number of keys
+    */
+    void reset(size_t);
+
+    /*-------------------------------------------------------------------------
+    * add(size_t)
+    *
+    * @pre: None
+    * @post: if there was room, mayContain() is true for the hash
+    * @param: size_t - the key's keyHash()
+    * @return: bool - false if the filter is full (the key is not added)
+    */
+    bool add(size_t);
+
+    /*-------------------------------------------------------------------------
+    * mayContain(size_t)
+    *
+    * @pre: None
+    * @post: filter is unchanged
+    * @param: size_t - a keyHash()
+    * @return: bool - false if the key was certainly never added
+    */
+    bool mayContain(size_t hash) const {
+        if (blockCount == 0) {
+            return false;
+        }
+        uint64_t mixed = mix(hash);
+        const uint64_t* words = blocks[blockOf(mixed)].words;
+        uint32_t bits = static_cast<uint32_t>(mixed);
+        uint64_t missing = 0;
+        for (int w = 0; w < BLOCK_WORDS; w++) {
+            missing |= ~words[w] & bitOf(bits, w);
+        }
+        return missing == 0;
+    }
+
+    /*-------------------------------------------------------------------------
+    * clear()
+    *
+    * @pre: None
+    * @post: filter holds no key and its blocks are freed
+    * @param: None
+    */
+    void clear();
+
+    /*-------------------------------------------------------------------------
+    * getBytes()
+    *
+    * @pre: None
+    * @post: filter is unchanged
+    * @return: long - memory of the blocks
+    */
+    long getBytes() const;
+
+  private:
+    static const int BLOCK_WORDS = 8;
+
+    // the bits of the keys that hash to it, one cache line
+    struct alignas(64) Block {
+        uint64_t words[BLOCK_WORDS];
+    };
+
+    Block* blocks;       // the filter
+    size_t blockCount;   // blocks allocated
+    size_t count;        // keys added
+    size_t capacity;     // keys it was sized for
+
+    // finalizer of MurmurHash3: spreads every bit of x over the result
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    // block of a key, from the high bits of its mixed hash
+    size_t blockOf(uint64_t mixed) const {
+        return static_cast<size_t>(((mixed >> 32) * blockCount) >> 32);
+    }
+
+    // the key's bit in word w: an odd multiplier per word, top 6 bits
+    static uint64_t bitOf(uint32_t bits, int w) {
+        static const uint32_t SALT[BLOCK_WORDS] = {
+            0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+            0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+        };
+        return 1ULL << ((bits * SALT[w]) >> 26);
+    }
+
+    // copying would share (and free twice) the blocks
+    BloomFilter(const BloomFilter&);
+    BloomFilter& operator=(const BloomFilter&);
+};
+
+#endif //BLOOMFILTER_H
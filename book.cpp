@@ -40,4 +40,17 @@ Book::~Book() {}
 */
 void Book::setFormat(char format) {
     this->format = format;
+}
+
+/*-------------------------------------------------------------------------
+* getFormat
+* 
+* virtual Item function - returns the format of the current book
+* @pre: Book object exists
+* @post: Book is unchanged
+* @param: None
+* @return: char - the Book's format
+*/
+char Book::getFormat() const {
+    return format;
 }
\ No newline at end of file
@@ -61,6 +61,31 @@ class Book: public Item {
     */
     virtual void setFormat(char);
 
+    /*-------------------------------------------------------------------------
+    * getFormat
+    * 
+    * virtual Item function - returns the format of the current book
+    * @pre: Book object exists
+    * @post: Book is unchanged
+    * @param: None
+    * @return: char - the Book's format
+    */
+    virtual char getFormat() const;
+
+    /*-------------------------------------------------------------------------
+    * sameFormat(const Book&)
+    * 
+    * Non-virtual format check, the part of operator== that compare() in
+    * the derived classes leaves out
+    * @pre: None
+    * @post: Book is unchanged
+    * @param: const Book& - the book compared to
+    * @return: bool - true if both books have the same format
+    */
+    bool sameFormat(const Book& other) const {
+        return format == other.format;
+    }
+
   protected:
     int year;     // year book was published
     char format;  // format of the book (hard copy, etc.)
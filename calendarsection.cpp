@@ -0,0 +1,383 @@
+/*---------------------------------------------------------------------------
+* @file: calendarsection.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: implementation of the CalendarSection class
+---------------------------------------------------------------------------*/
+#include "calendarsection.h"
+#include "constants.h"
+#include <typeinfo>
+#include <climits>
+
+using namespace std;
+
+/*-------------------------------------------------------------------------
+* CalendarSection Constructor (with name and header)
+*
+* @pre: nothing
+* @post: empty section exists, no month has a bucket yet
+* @param: string name - name of the section
+* @param: string header - combination of headers used for display
+*/
+CalendarSection::CalendarSection(string name, string header) : Section(name, header) {
+    baseYear = 0;
+    live = 0;
+}
+
+/*-------------------------------------------------------------------------
+* CalendarSection Destructor
+*
+* @pre: section exists
+* @post: every Item is destroyed
+* @param: None
+*/
+CalendarSection::~CalendarSection() {
+    makeEmpty();
+}
+
+/*-------------------------------------------------------------------------
+* retrieve()
+*
+* Section lookup for any Item: targets other than PeriodicalBooks are
+* never found
+* @pre: None
+* @post: if a match is found, found points to the Item in the section
+* @return: bool - true if found, false if not
+*/
+bool CalendarSection::retrieve(const Item &target, Item *&found) const {
+    int depth = 0;
+    return retrieve(target, found, depth);
+}
+
+bool CalendarSection::retrieve(const Item &target, Item *&found, int &depth) const {
+    depth = 0;
+    if (typeid(target) != typeid(PeriodicalBook)) {
+        return false;
+    }
+    return retrieveAs(static_cast<const PeriodicalBook &>(target), found, depth);
+}
+
+/*-------------------------------------------------------------------------
+* retrieveAs()
+*
+* same as retrieve() with depth, with a target already a PeriodicalBook:
+* the bucket of its month, then a scan of the titles
+* @pre: None
+* @post: as retrieve(), depth is the number of Items compared to target
+* @param: const PeriodicalBook& target - the Item to find
+* @param: Item*& found - set to the Item found, unchanged if not found
+* @param: int& depth - set to the number of Items compared
+* @return: bool - true if found, false if not
+*/
+bool CalendarSection::retrieveAs(const PeriodicalBook &target, Item *&found, int &depth) const {
+    depth = 0;
+    const Issues *issues = bucketOf(target.getYear(), target.getMonth());
+    if (issues == nullptr) {
+        issues = &undated;
+    }
+    size_t at = position(*issues, target, depth);
+    if (at == issues->size() || (*issues)[at]->compare(target) != 0) {
+        return false;
+    }
+    // one Item per key, another format is not found
+    if (!(*issues)[at]->sameFormat(target)) {
+        return false;
+    }
+    found = (*issues)[at];
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* insert()
+*
+* @pre: data is a PeriodicalBook allocated with new
+* @post: data is in the bucket of its month (if not a duplicate,
+* otherwise it is deleted)
+* @param: Item* data - the Item object to be inserted
+* @return: true if inserted correctly, false if a duplicate
+*/
+bool CalendarSection::insert(Item *data) {
+    PeriodicalBook *item = static_cast<PeriodicalBook *>(data);
+    Issues *issues = makeBucket(item->getYear(), item->getMonth());
+    if (issues == nullptr) {
+        issues = &undated;
+    }
+    int depth = 0;
+    size_t at = position(*issues, *item, depth);
+    if (at < issues->size() && (*issues)[at]->compare(*item) == 0) {
+        delete data;
+        return false; // no dupes allowed
+    }
+    issues->insert(issues->begin() + at, item);
+    live++;
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* remove()
+*
+* Takes the Item retrieve() would find for target out of its bucket
+* @pre: None (targets of another type are never found)
+* @post: if a match is found, it is no longer found, displayed or
+* collected, but is kept until makeEmpty()
+* @param: const Item& target - the Item to remove
+* @param: Item*& removed - set to the Item removed, unchanged if not found
+* @return: bool - true if removed, false if not found
+*/
+bool CalendarSection::remove(const Item &target, Item *&removed) {
+    Item *found = nullptr;
+    int depth = 0;
+    if (!retrieve(target, found, depth)) {
+        return false;
+    }
+    PeriodicalBook *item = static_cast<PeriodicalBook *>(found);
+    Issues *issues = const_cast<Issues *>(bucketOf(item->getYear(), item->getMonth()));
+    if (issues == nullptr) {
+        issues = &undated;
+    }
+    issues->erase(issues->begin() + position(*issues, *item, depth));
+    removedItems.push_back(item);
+    live--;
+    removed = item;
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* isEmpty()
+*
+* @pre: section exists
+* @post: section is unchanged
+* @return boolean - true if the section holds no Items
+*/
+bool CalendarSection::isEmpty() const {
+    return live == 0;
+}
+
+/*-------------------------------------------------------------------------
+* makeEmpty()
+*
+* @pre: section exists (empty or not)
+* @post: every Item (removed ones too) is destroyed, the buckets freed
+* @param: None
+*/
+void CalendarSection::makeEmpty() {
+    for (size_t m = 0; m < months.size(); m++) {
+        for (size_t i = 0; i < months[m].size(); i++) {
+            delete months[m][i];
+        }
+    }
+    vector<Issues>().swap(months);
+    for (size_t i = 0; i < undated.size(); i++) {
+        delete undated[i];
+    }
+    Issues().swap(undated);
+    for (size_t i = 0; i < removedItems.size(); i++) {
+        delete removedItems[i];
+    }
+    removedItems.clear();
+    baseYear = 0;
+    live = 0;
+}
+
+/*-------------------------------------------------------------------------
+* display()
+*
+* @pre: section exists (empty or not)
+* @post: the header, then every Item in sorted order is printed
+* @param: None
+*/
+void CalendarSection::display() const {
+    displayHeader();
+    vector<Item*> items;
+    collect(items);
+    for (size_t i = 0; i < items.size(); i++) {
+        items[i]->displayItem();
+    }
+}
+
+/*-------------------------------------------------------------------------
+* freeze()
+*
+* Nothing to freeze: lookups go to the month buckets, which have no hash
+* index to replace
+* @pre: section exists (empty or not)
+* @post: section is unchanged, isFrozen() stays false
+* @return: bool - always true, there is nothing that could fail to build
+*/
+bool CalendarSection::freeze() {
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* collect()
+*
+* @pre: section exists (empty or not)
+* @post: every Item is appended to the vector in sorted order
+* @param: vector<Item*>& items - the list the Items are appended to
+*/
+void CalendarSection::collect(vector<Item*> &items) const {
+    walk(0, months.size(), dateOf(INT_MIN, INT_MIN), dateOf(INT_MAX, INT_MAX), items);
+}
+
+/*-------------------------------------------------------------------------
+* collectMonths()
+*
+* Issues of a span of months, e.g. all of 2009 with (2009, 1, 2009, 12)
+* @pre: None
+* @post: every Item dated from the first month to the last (both
+* included) is appended to the vector in sorted order
+* @param: int firstYear, int firstMonth - first month of the span
+* @param: int lastYear, int lastMonth - last month of the span
+* @param: vector<Item*>& items - the list the Items are appended to
+*/
+void CalendarSection::collectMonths(int firstYear, int firstMonth, int lastYear, int lastMonth,
+                                    vector<Item*> &items) const {
+    long long from = dateOf(firstYear, firstMonth);
+    long long to = dateOf(lastYear, lastMonth);
+    if (from > to) {
+        return;
+    }
+    // buckets of the valid months in the span: from the first one on or
+    // after from, to the last one on or before to
+    long long first = (static_cast<long long>(firstYear) - baseYear) * 12
+                      + ((firstMonth < 1) ? 0 : (firstMonth > 12) ? 12 : firstMonth - 1);
+    long long last = (static_cast<long long>(lastYear) - baseYear) * 12
+                     + ((lastMonth < 1) ? 0 : (lastMonth > 12) ? 12 : lastMonth);
+    long long count = static_cast<long long>(months.size());
+    first = (first < 0) ? 0 : (first > count) ? count : first;
+    last = (last < first) ? first : (last > count) ? count : last;
+    walk(static_cast<size_t>(first), static_cast<size_t>(last), from, to, items);
+}
+
+/*-------------------------------------------------------------------------
+* measure()
+*
+* @pre: section exists (empty or not)
+* @post: section is unchanged
+* @param: Shape& shape - set to the depths and memory. The depth of an
+* Item is 1 (its bucket) plus its place in the bucket (or the halvings
+* of the undated list). Node bytes are the buckets and the pointers in
+* them. There are no index bytes.
+*/
+void CalendarSection::measure(Shape &shape) const {
+    resetShape(shape);
+    long depthSum = 0;
+    shape.nodeBytes = static_cast<long>((months.capacity() + 1) * sizeof(Issues));
+    for (size_t m = 0; m <= months.size(); m++) {
+        const Issues &issues = (m < months.size()) ? months[m] : undated;
+        shape.nodeBytes += static_cast<long>(issues.capacity() * sizeof(PeriodicalBook*));
+        for (size_t i = 0; i < issues.size(); i++) {
+            int depth = static_cast<int>(i) + 2;
+            if (m == months.size()) {
+                // the undated list is halved
+                depth = 2;
+                for (size_t n = issues.size(); n > 1; n >>= 1) {
+                    depth++;
+                }
+            }
+            shape.nodes++;
+            depthSum += depth;
+            if (depth > shape.height) {
+                shape.height = depth;
+                shape.depths.resize(depth + 1, 0);
+            }
+            shape.depths[depth]++;
+            shape.itemBytes += issues[i]->getObjectSize();
+            shape.stringBytes += issues[i]->getStringSize();
+        }
+    }
+    shape.itemBytes += static_cast<long>(sizeof(PeriodicalBook) * removedItems.size());
+    if (shape.nodes > 0) {
+        shape.averageDepth = static_cast<double>(depthSum) / shape.nodes;
+    }
+}
+
+// bucket of a date, nullptr if it has none (undated)
+const CalendarSection::Issues *CalendarSection::bucketOf(int year, int month) const {
+    if (month < 1 || month > 12 || year < baseYear) {
+        return nullptr;
+    }
+    size_t at = static_cast<size_t>(year - baseYear) * 12 + (month - 1);
+    return (at < months.size()) ? &months[at] : nullptr;
+}
+
+// bucket of a date, the buckets grown to cover it if they may; nullptr
+// if it stays undated
+CalendarSection::Issues *CalendarSection::makeBucket(int year, int month) {
+    if (month < 1 || month > 12) {
+        return nullptr;
+    }
+    if (months.empty()) {
+        baseYear = year;
+    }
+    long long years = static_cast<long long>(months.size() / 12);
+    long long first = (year < baseYear) ? year : baseYear;
+    long long end = (year >= baseYear + years) ? static_cast<long long>(year) + 1 : baseYear + years;
+    if (end - first > CALENDAR_MAX_YEARS) {
+        return nullptr;
+    }
+    if (first < baseYear) {
+        // the buckets before the old base year (a vector of empty lists
+        // moves without copying the lists' Items)
+        months.insert(months.begin(), static_cast<size_t>(baseYear - first) * 12, Issues());
+        baseYear = static_cast<int>(first);
+    }
+    if (static_cast<size_t>(end - baseYear) * 12 > months.size()) {
+        months.resize(static_cast<size_t>(end - baseYear) * 12);
+    }
+    return &months[static_cast<size_t>(year - baseYear) * 12 + (month - 1)];
+}
+
+// place of target in a list: the first Item not before it; depth
+// counts the Items compared. A bucket is scanned, the undated list
+// (which bad data could make long) is halved.
+size_t CalendarSection::position(const Issues &issues, const PeriodicalBook &target, int &depth) const {
+    depth++; // the bucket
+    size_t low = 0;
+    size_t high = issues.size();
+    if (&issues == &undated) {
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            depth++;
+            if (issues[middle]->compare(target) < 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+    while (low < high) {
+        depth++;
+        if (issues[low]->compare(target) >= 0) {
+            break;
+        }
+        low++;
+    }
+    return low;
+}
+
+// a year and month as one number, in date order (any month)
+long long CalendarSection::dateOf(int year, int month) {
+    return static_cast<long long>(year) * (1LL << 32) + (static_cast<long long>(month) - INT_MIN);
+}
+
+// appends the Items of buckets [first, last) merged with the undated
+// Items dated from from to to (both included), in sorted order
+void CalendarSection::walk(size_t first, size_t last, long long from, long long to,
+                           vector<Item*> &items) const {
+    size_t u = 0;
+    while (u < undated.size() && dateOf(undated[u]->getYear(), undated[u]->getMonth()) < from) {
+        u++;
+    }
+    for (size_t m = first; m < last; m++) {
+        for (size_t i = 0; i < months[m].size(); i++) {
+            while (u < undated.size() && undated[u]->compare(*months[m][i]) < 0) {
+                items.push_back(undated[u++]);
+            }
+            items.push_back(months[m][i]);
+        }
+    }
+    while (u < undated.size() && dateOf(undated[u]->getYear(), undated[u]->getMonth()) <= to) {
+        items.push_back(undated[u++]);
+    }
+}
@@ -0,0 +1,222 @@
+/*---------------------------------------------------------------------------
+* @file: calendarsection.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the CalendarSection class
+*/
+//---------------------------------------------------------------------------
+// CalendarSection Class: Section of the periodicals, filed by date. Every
+// month has a bucket, found directly at (year - baseYear) * 12 + month - 1,
+// that lists the issues of that month sorted by title. Commands name a
+// periodical by year and month first, so a lookup is one array index and
+// a scan of a few titles instead of a tree descent.
+// --------------------------------------------------------------------------
+// Features:
+//  -- The buckets are in date order, so display() and collect() walk them
+//     in order, and the issues of a year (or of any span of months) are
+//     one contiguous run of buckets: collectMonths().
+//  -- The buckets cover the years from the oldest periodical to the
+//     newest, and grow (at either end) when an issue is dated outside.
+//  -- Same insert/retrieve/remove/display contract as BinarySearchTree;
+//     the Library uses it for the periodicals with POINTER_SECTIONS (the
+//     default storage) and looks them up with retrieveAs().
+//  -- No key index, Bloom filter or perfect hash: the month bucket is the
+//     index. retrieveByKey() never finds anything, freeze() does nothing.
+//
+// Assumptions/implementation:
+// -- Holds PeriodicalBooks only, as heap objects that never move (the
+//    buckets hold pointers to them). Removed Items are kept until
+//    makeEmpty(), as in BinarySearchTree.
+// -- Issues with a month outside 1 to 12, or a year that would make the
+//    buckets span more than CALENDAR_MAX_YEARS, are kept in one sorted
+//    list of their own, merged in date order wherever the issues are
+//    walked in order.
+//---------------------------------------------------------------------------
+#ifndef CALENDARSECTION_H
+#define CALENDARSECTION_H
+
+#include <vector>
+#include "item.h"
+#include "section.h"
+#include "book.h"
+#include "periodicalbook.h"
+
+class CalendarSection : public Section {
+
+public:
+    /*-------------------------------------------------------------------------
+    * CalendarSection Constructor (with name and header)
+    *
+    * @pre: nothing
+    * @post: empty section exists, no month has a bucket yet
+    * @param: string name - name of the section
+    * @param: string header - combination of headers used for display
+    */
+    CalendarSection(string name, string header);
+
+    /*-------------------------------------------------------------------------
+    * CalendarSection Destructor
+    *
+    * @pre: section exists
+    * @post: every Item is destroyed
+    * @param: None
+    */
+    ~CalendarSection();
+
+    /*-------------------------------------------------------------------------
+    * retrieve()
+    *
+    * Section lookup for any Item: targets other than PeriodicalBooks are
+    * never found
+    * @pre: None
+    * @post: if a match is found, found points to the Item in the section
+    * @return: bool - true if found, false if not
+    */
+    bool retrieve(const Item &target, Item *&found) const;
+
+    bool retrieve(const Item &target, Item *&found, int &depth) const;
+
+    /*-------------------------------------------------------------------------
+    * retrieveAs()
+    *
+    * same as retrieve() with depth, with a target already a PeriodicalBook:
+    * the bucket of its month, then a scan of the titles
+    * @pre: None
+    * @post: as retrieve(), depth is the number of Items compared to target
+    * @param: const PeriodicalBook& target - the Item to find
+    * @param: Item*& found - set to the Item found, unchanged if not found
+    * @param: int& depth - set to the number of Items compared
+    * @return: bool - true if found, false if not
+    */
+    bool retrieveAs(const PeriodicalBook &target, Item *&found, int &depth) const;
+
+    /*-------------------------------------------------------------------------
+    * insert()
+    *
+    * @pre: data is a PeriodicalBook allocated with new
+    * @post: data is in the bucket of its month (if not a duplicate,
+    * otherwise it is deleted)
+    * @param: Item* data - the Item object to be inserted
+    * @return: true if inserted correctly, false if a duplicate
+    */
+    bool insert(Item *data);
+
+    /*-------------------------------------------------------------------------
+    * remove()
+    *
+    * Takes the Item retrieve() would find for target out of its bucket
+    * @pre: None (targets of another type are never found)
+    * @post: if a match is found, it is no longer found, displayed or
+    * collected, but is kept until makeEmpty()
+    * @param: const Item& target - the Item to remove
+    * @param: Item*& removed - set to the Item removed, unchanged if not found
+    * @return: bool - true if removed, false if not found
+    */
+    bool remove(const Item &target, Item *&removed);
+
+    /*-------------------------------------------------------------------------
+    * isEmpty()
+    *
+    * @pre: section exists
+    * @post: section is unchanged
+    * @return boolean - true if the section holds no Items
+    */
+    bool isEmpty() const;
+
+    /*-------------------------------------------------------------------------
+    * makeEmpty()
+    *
+    * @pre: section exists (empty or not)
+    * @post: every Item (removed ones too) is destroyed, the buckets freed
+    * @param: None
+    */
+    void makeEmpty();
+
+    /*-------------------------------------------------------------------------
+    * display()
+    *
+    * @pre: section exists (empty or not)
+    * @post: the header, then every Item in sorted order is printed
+    * @param: None
+    */
+    void display() const;
+
+    /*-------------------------------------------------------------------------
+    * freeze()
+    *
+    * Nothing to freeze: lookups go to the month buckets, which have no hash
+    * index to replace
+    * @pre: section exists (empty or not)
+    * @post: section is unchanged, isFrozen() stays false
+    * @return: bool - always true, there is nothing that could fail to build
+    */
+    bool freeze();
+
+    /*-------------------------------------------------------------------------
+    * collect()
+    *
+    * @pre: section exists (empty or not)
+    * @post: every Item is appended to the vector in sorted order
+    * @param: vector<Item*>& items - the list the Items are appended to
+    */
+    void collect(vector<Item*> &items) const;
+
+    /*-------------------------------------------------------------------------
+    * collectMonths()
+    *
+    * Issues of a span of months, e.g. all of 2009 with (2009, 1, 2009, 12)
+    * @pre: None
+    * @post: every Item dated from the first month to the last (both
+    * included) is appended to the vector in sorted order
+    * @param: int firstYear, int firstMonth - first month of the span
+    * @param: int lastYear, int lastMonth - last month of the span
+    * @param: vector<Item*>& items - the list the Items are appended to
+    */
+    void collectMonths(int firstYear, int firstMonth, int lastYear, int lastMonth,
+                       vector<Item*> &items) const;
+
+    /*-------------------------------------------------------------------------
+    * measure()
+    *
+    * @pre: section exists (empty or not)
+    * @post: section is unchanged
+    * @param: Shape& shape - set to the depths and memory. The depth of an
+    * Item is 1 (its bucket) plus its place in the bucket (or the halvings
+    * of the undated list). Node bytes are the buckets and the pointers in
+    * them. There are no index bytes.
+    */
+    void measure(Shape &shape) const;
+
+private:
+    typedef vector<PeriodicalBook*> Issues; // sorted by compare()
+
+    vector<Issues> months;   // bucket of every month from baseYear on
+    int baseYear;            // year of months[0] to [11]
+    Issues undated;          // issues without a bucket (see the header)
+    vector<Item*> removedItems; // removed Items, kept until makeEmpty()
+    long live;               // Items found
+
+    // bucket of a date, nullptr if it has none (undated)
+    const Issues *bucketOf(int year, int month) const;
+
+    // bucket of a date, the buckets grown to cover it if they may; nullptr
+    // if it stays undated
+    Issues *makeBucket(int year, int month);
+
+    // place of target in a list: the first Item not before it; depth
+    // counts the Items compared
+    size_t position(const Issues &issues, const PeriodicalBook &target, int &depth) const;
+
+    // a year and month as one number, in date order (any month)
+    static long long dateOf(int year, int month);
+
+    // appends the Items of buckets [first, last) merged with the undated
+    // Items dated from from to to (both included), in sorted order
+    void walk(size_t first, size_t last, long long from, long long to,
+              vector<Item*> &items) const;
+
+    // copying would leave two sections owning the same Items
+    CalendarSection(const CalendarSection &);
+    CalendarSection &operator=(const CalendarSection &);
+};
+
+#endif //CALENDARSECTION_H
@@ -7,6 +7,7 @@
 #include "transaction.h"
 #include "checkout.h"
 #include "library.h"
+#include <sstream>
 
 /*-------------------------------------------------------------------------
 * Constructor 
@@ -18,19 +19,28 @@
 */
 Checkout::Checkout() : Transaction() {
     patronID = 0;
+    itemType = ' ';
+    itemFormat = ' ';
+    item = nullptr;
+    patron = nullptr;
+    itemData = "";
+    requested = nullptr;
 }
 
 /*-------------------------------------------------------------------------
 * Destructor
 *
 * Nulls out the member item. Transactions aren't responsible for deleting
-* Item objects they are associated with.
+* Item objects they are associated with, only the requested copy built by
+* findItem() if apply() never ran.
 * @pre: Checkout object exists
 * @post: Memory associated with that Checkout object is released (except
 * for item)
 * @param: None
 */
-Checkout::~Checkout() {}
+Checkout::~Checkout() {
+    delete requested;
+}
 
 /*-------------------------------------------------------------------------
 * create()
@@ -48,92 +58,130 @@ Checkout* Checkout::create() const {
 }
 
 /*-------------------------------------------------------------------------
-* execute(Library&, ifstream&)
+* load(const Command&)
+*
+* Stores the patronID and the item part of the command (item type, format
+* and item data). The item data is parsed once the patron is known to exist.
+* @pre: command.type is C
+* @post: patronID and the item part of the command are stored
+* @param: const Command& - the parsed command
+*/
+void Checkout::load(const Command& command) {
+    patronID = command.patronID;
+    itemType = command.itemType;
+    itemFormat = command.format;
+    itemData = command.itemData;
+}
+
+/*-------------------------------------------------------------------------
+* getPatronID()
+*
+* Returns the patron ID loaded by load(), used for prefetching
+* @pre: load() has been called
+* @post: Checkout is unchanged
+* @return: int - the patron ID of this command
+*/
+int Checkout::getPatronID() const {
+    return patronID;
+}
+
+/*-------------------------------------------------------------------------
+* findPatron(Library&)
 *
-* Executes the checkout command: validates the patronID, validates the item 
-* that is requested to be checked out, assigns the checkout to the patron's 
-* history, and removes 1 quantity of that item from the library quantity. 
-* @pre: Library and a command file exist
+* Looks up the patron checking something out.
+* @pre: load() has been called
+* @post: patron is set, or nullptr if the ID is invalid
+* @param: Library& - the library the patron is looked up in
+*/
+void Checkout::findPatron(Library& currLibrary) {
+    patron = nullptr;
+    currLibrary.retrievePatron(patronID, patron);
+}
+
+/*-------------------------------------------------------------------------
+* findItem(Library&)
+*
+* If the patron exists, creates the requested item from the command data
+* (printing an error for an invalid item type) and finds it in its section.
+* @pre: findPatron() has been called
+* @post: requested and item are set, or nullptr if invalid / not found
+* @param: Library& - the library the item is looked up in
+*/
+void Checkout::findItem(Library& currLibrary) {
+    // the item part of the command is only looked at for a valid patron
+    if (patron == nullptr) {
+        return;
+    }
+    // one reader per thread, building a stream per command is costly
+    static thread_local istringstream data;
+    data.clear();
+    data.str(itemData);
+    requested = currLibrary.createItem(itemType);
+
+    // if item is valid type
+    if (requested) {
+        // create item from the data given
+        requested->setTransactionData(data);
+        requested->setFormat(itemFormat);
+
+        // find item in the tree of its type in libraryStorage
+        // itemType has already been validated above, no need to check tree type
+        currLibrary.retrieveItem(itemType, *requested, item);
+    }
+}
+
+/*-------------------------------------------------------------------------
+* apply(Library&)
+*
+* Validates the patronID, validates the item that is requested to be
+* checked out, assigns the checkout to the patron's history, and removes
+* 1 quantity of that item from the library quantity. Prints an error for
+* anything invalid.
+* @pre: findItem() has been called, earlier commands have been applied
 * @post: An item in zero or one library trees is modified, associated with
 * this Checkout, and associated with the Patron given by command data.
 * @param: Library& - the library the command should change
-* @param: ifstream& - the ifstream providing data for commands (1 per line),
-* in this case marked by a C as the first char of the line. The rest of the
-* line should provide patronID, item type and item data
 * @return: returns a bool marking whether or not to save this Checkout
 * to patron history. Returns true if the Checkout should be saved, and
 * false otherwise (determined by validity of data for Checkout objects).
 */
-bool Checkout::execute(Library& currLibrary, ifstream& infile) {
-    // find the patron if it exists
-    infile >> patronID;
-    Patron* potentialPatron = nullptr;
-    currLibrary.retrievePatron(patronID, potentialPatron);
-
-    // if patron exists in library database
-    if (potentialPatron) {
-        char itemType;
-        infile >> itemType;
-        char itemFormat;
-        infile >> itemFormat;
-
-        Item* potentialItem = currLibrary.createItem(itemType);
-
-        // if item is valid type
-        if (potentialItem) {
-            // create item from the data given
-            potentialItem->setTransactionData(infile);
-            potentialItem->setFormat(itemFormat);
-            
-            // hash to the correct tree in libraryStorage
-            // itemType has already been validated above, no need to check tree type
-            BinarySearchTree* section = currLibrary.findTree(itemType);
-            
-            // find item in library section 
-            Item* realItem = nullptr;
-            section->retrieve(*potentialItem, realItem);
-            
-            // if item exists in library
-            if (realItem) {
-                if (realItem->getStock() > 0) {
-                    item = realItem;
-                    realItem->modifyStock(-1);
-                    // add to patrons list of books
-                    potentialPatron->addItem(realItem);
-                    potentialPatron->addToHistory(this);
-                    delete potentialItem;
-                    return true;
-                } else {
-                    cout << endl;
-                    cout << "ERROR: ";
-                    potentialPatron->display();
-                    cout << " tried to check out " << potentialItem->getTitle();
-                    cout << " -- item is out of stock." << endl;
-                }
-            } else {
-                cout << endl;
-                cout << "ERROR: ";
-                potentialPatron->display();
-                cout << " tried to check out " << potentialItem->getTitle();
-                cout << " -- can't find in library." << endl;
-            }
-        } else {
-            // if book type given is invalid, 
-            cout << endl;
-            cout << "ERROR: Cannot checkout for invalid item type: " << itemType << endl;
-            string oldLine = "";
-            getline(infile, oldLine);
-        }
-        delete potentialItem;
-    }else{
+bool Checkout::apply(Library& currLibrary) {
+    bool saved = false;
+    if (patron == nullptr) {
         // if patron doesn't exist, output error message
         cout << endl;
         cout << "ERROR: Cannot checkout for invalid Patron ID: " << patronID << endl;
-        string oldLine = "";
-        getline(infile, oldLine);
+        currLibrary.getStatistics().error(CommandStats::INVALID_PATRON);
+    } else if (requested == nullptr) {
+        // if book type given is invalid
+        cout << endl;
+        cout << "ERROR: Cannot checkout for invalid item type: " << itemType << endl;
+        currLibrary.getStatistics().error(CommandStats::INVALID_TYPE);
+    } else if (item == nullptr) {
+        cout << endl;
+        cout << "ERROR: ";
+        patron->display();
+        cout << " tried to check out " << requested->getTitle();
+        cout << " -- can't find in library." << endl;
+        currLibrary.getStatistics().error(CommandStats::NOT_FOUND);
+    } else if (item->getStock() > 0) {
+        item->modifyStock(-1);
+        currLibrary.countCheckout(*item);
+        // add to patrons list of books
+        patron->addItem(item);
+        patron->addToHistory(this);
+        saved = true;
+    } else {
+        cout << endl;
+        cout << "ERROR: ";
+        patron->display();
+        cout << " tried to check out " << requested->getTitle();
+        cout << " -- item is out of stock." << endl;
+        currLibrary.getStatistics().error(CommandStats::OUT_OF_STOCK);
     }
-    
-    return false;
+    delete requested;
+    requested = nullptr;
+    return saved;
 }
 
 /*-------------------------------------------------------------------------
@@ -147,4 +195,43 @@ bool Checkout::execute(Library& currLibrary, ifstream& infile) {
 */
 void Checkout::display() const {
     cout << "Checked out " << item->getTitle() << endl;
+}
+
+/*-------------------------------------------------------------------------
+* replay(Patron*, char, Item*, int&)
+*
+* Redoes an already validated checkout from a log or snapshot without
+* checking stock or printing anything: the item is given to the patron and 
+* this Checkout is added to the patron's history.
+* @pre: the patron and item exist and the checkout was valid when logged
+* @post: this Checkout is associated with the patron and item
+* @param: Patron* - the patron named by the logged Checkout
+* @param: char - the item type (section) of the logged Checkout
+* @param: Item* - the item in the library named by the logged Checkout
+* @param: int& - set to the change in stock this Checkout caused
+* @return: returns a bool marking whether or not this Checkout was saved
+* to the patron history, as execute() does
+*/
+bool Checkout::replay(Patron* patron, char type, Item* realItem, int& stockChange) {
+    patronID = patron->getID();
+    itemType = type;
+    item = realItem;
+    patron->addItem(realItem);
+    patron->addToHistory(this);
+    stockChange = -1;
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* save(ostream&)
+*
+* Writes this Checkout as one command-format record (C, patronID, item
+* type, format and item data) that replay() can be driven from.
+* @pre: execute() or replay() has already been called by this object.
+* @post: Checkout is unchanged
+* @param: ostream& - the stream the record is written to
+*/
+void Checkout::save(ostream& out) const {
+    out << "C " << patronID << ' ' << itemType << ' ' << item->getFormat();
+    item->writeTransactionData(out);
 }
\ No newline at end of file
@@ -16,8 +16,8 @@
 //  -- Can display entire Checkout and all associated data fields 
 //
 // Assumptions/implementation:
-// -- Calling execute(Library&, ifstream&) won't be done with uninitialized 
-//    objects.
+// -- Calling execute(Library&, const Command&) (or its stages) won't be
+//    done with uninitialized objects.
 // -- Deleting a Checkout doesn't delete the Item associated with it.
 //---------------------------------------------------------------------------
 #ifndef CHECKOUT_H
@@ -39,7 +39,8 @@ class Checkout : public Transaction {
         * Destructor
         *
         * Nulls out the member item. Transactions aren't responsible for deleting
-        * Item objects they are associated with.
+        * Item objects they are associated with, only the requested copy built by
+        * findItem() if apply() never ran.
         * @pre: Checkout object exists
         * @post: Memory associated with that Checkout object is released (except
         * for item)
@@ -60,24 +61,67 @@ class Checkout : public Transaction {
         */
         virtual Checkout* create() const;
 
+        // letter of the command, for its registration in TransactionTypes
+        static const char TYPE = 'C';
+
+        /*-------------------------------------------------------------------------
+        * load(const Command&)
+        *
+        * Stores the patronID and the item part of the command (item type, format
+        * and item data). The item data is parsed once the patron is known to exist.
+        * @pre: command.type is C
+        * @post: patronID and the item part of the command are stored
+        * @param: const Command& - the parsed command
+        */
+        virtual void load(const Command&);
+
+        /*-------------------------------------------------------------------------
+        * getPatronID()
+        *
+        * Returns the patron ID loaded by load(), used for prefetching
+        * @pre: load() has been called
+        * @post: Checkout is unchanged
+        * @return: int - the patron ID of this command
+        */
+        virtual int getPatronID() const;
+
+        /*-------------------------------------------------------------------------
+        * findPatron(Library&)
+        *
+        * Looks up the patron checking something out.
+        * @pre: load() has been called
+        * @post: patron is set, or nullptr if the ID is invalid
+        * @param: Library& - the library the patron is looked up in
+        */
+        virtual void findPatron(Library&);
+
         /*-------------------------------------------------------------------------
-        * execute(Library&, ifstream&)
+        * findItem(Library&)
         *
-        * Executes the checkout command: validates the patronID, validates the item 
-        * that is requested to be checked out, assigns the checkout to the patron's 
-        * history, and removes 1 quantity of that item from the library quantity. 
-        * @pre: Library and a command file exist
-        * @post: A item in zero or one library trees is modified, associated with
+        * If the patron exists, creates the requested item from the command data
+        * (printing an error for an invalid item type) and finds it in its section.
+        * @pre: findPatron() has been called
+        * @post: requested and item are set, or nullptr if invalid / not found
+        * @param: Library& - the library the item is looked up in
+        */
+        virtual void findItem(Library&);
+
+        /*-------------------------------------------------------------------------
+        * apply(Library&)
+        *
+        * Validates the patronID, validates the item that is requested to be
+        * checked out, assigns the checkout to the patron's history, and removes
+        * 1 quantity of that item from the library quantity. Prints an error for
+        * anything invalid.
+        * @pre: findItem() has been called, earlier commands have been applied
+        * @post: An item in zero or one library trees is modified, associated with
         * this Checkout, and associated with the Patron given by command data.
         * @param: Library& - the library the command should change
-        * @param: ifstream& - the ifstream providing data for commands (1 per line),
-        * in this case marked by a C as the first char of the line. The rest of the
-        * line should provide patronID, item type and item data
         * @return: returns a bool marking whether or not to save this Checkout
         * to patron history. Returns true if the Checkout should be saved, and
         * false otherwise (determined by validity of data for Checkout objects).
         */
-        virtual bool execute(Library&, ifstream&);
+        virtual bool apply(Library&);
 
 
         /*-------------------------------------------------------------------------
@@ -91,8 +135,41 @@ class Checkout : public Transaction {
         */
         virtual void display() const;
 
+        /*-------------------------------------------------------------------------
+        * replay(Patron*, char, Item*, int&)
+        *
+        * Redoes an already validated checkout from a log or snapshot without
+        * checking stock or printing anything: the item is given to the patron and
+        * this Checkout is added to the patron's history.
+        * @pre: the patron and item exist and the checkout was valid when logged
+        * @post: this Checkout is associated with the patron and item
+        * @param: Patron* - the patron named by the logged Checkout
+        * @param: char - the item type (section) of the logged Checkout
+        * @param: Item* - the item in the library named by the logged Checkout
+        * @param: int& - set to the change in stock this Checkout caused
+        * @return: returns a bool marking whether or not this Checkout was saved
+        * to the patron history, as execute() does
+        */
+        virtual bool replay(Patron*, char, Item*, int&);
+
+        /*-------------------------------------------------------------------------
+        * save(ostream&)
+        *
+        * Writes this Checkout as one command-format record (C, patronID, item
+        * type, format and item data) that replay() can be driven from.
+        * @pre: execute() or replay() has already been called by this object.
+        * @post: Checkout is unchanged
+        * @param: ostream& - the stream the record is written to
+        */
+        virtual void save(ostream&) const;
+
     private:
         int patronID; // ID of the patron checking something out of the library
+        char itemType; // type (section) of the item, needed to save this record
+        char itemFormat; // format of the item named by the command
         Item* item; // item being checked out
+        Patron* patron; // patron found by findPatron(), nullptr if invalid
+        string itemData; // key fields of the item, parsed by findItem()
+        Item* requested; // item built from the command, owned until apply()
 };
 #endif 
\ No newline at end of file
@@ -52,6 +52,46 @@ ChildrenBook* ChildrenBook::create() const {
     return new ChildrenBook();
 }
 
+/*-------------------------------------------------------------------------
+* getObjectSize()
+* 
+* Inherited from Item - size of a ChildrenBook object
+* @pre: ChildrenBook object exists
+* @post: ChildrenBook is unchanged
+* @param: None 
+* @return: int - bytes of the object
+*/
+int ChildrenBook::getObjectSize() const {
+    return sizeof(ChildrenBook);
+}
+
+/*-------------------------------------------------------------------------
+* getStringSize()
+* 
+* Inherited from Item - heap memory held by the title and author
+* @pre: ChildrenBook object exists
+* @post: ChildrenBook is unchanged
+* @param: None 
+* @return: int - bytes allocated for strings
+*/
+int ChildrenBook::getStringSize() const {
+    return Item::getStringSize() + heapSize(author);
+}
+
+/*-------------------------------------------------------------------------
+* poolStrings()
+* 
+* Inherited from Item - pools the title and author, if too long to be
+* kept in place
+* @pre: ChildrenBook object exists
+* @post: the long fields are shared with the other Items holding them
+* @param: None 
+*/
+void ChildrenBook::poolStrings() {
+    Item::poolStrings();
+    author.pool();
+}
+
 /*-------------------------------------------------------------------------
 * setData(ifstream&)
 * 
@@ -75,7 +115,7 @@ void ChildrenBook::setData(ifstream& infile) {
 }
 
 /*-------------------------------------------------------------------------
-* setTransactionData(ifstream&)
+* setTransactionData(istream&)
 * 
 * Inherited from Item - Sets the data of the current ChildrenBook to the data
 * that is fed in from the command data file. Only differs from setData due to 
@@ -83,9 +123,9 @@ void ChildrenBook::setData(ifstream& infile) {
 * @pre: ChildrenBook object exists 
 * @post: the current ChildrenBook object's members are set to the current
 * line of the command ifstream data.
-* @param: ifstream& infile - a file stream allowing processing of file data
+* @param: istream& infile - a stream (command file or log) allowing processing of data
 */
-void ChildrenBook::setTransactionData(ifstream &infile) {
+void ChildrenBook::setTransactionData(istream &infile) {
     infile.get();                // get (and ignore) blank before title
                                  // don't use if you want to keep the blank
     getline(infile, title, ','); // input author, looks for comma terminator
@@ -96,6 +136,20 @@ void ChildrenBook::setTransactionData(ifstream &infile) {
 
 }
 
+/*-------------------------------------------------------------------------
+* writeTransactionData(ostream&)
+* 
+* Inherited from Item - writes the ChildrenBook's identifying data in the 
+* command file layout (title, author), so setTransactionData() can 
+* read it back
+* @pre: ChildrenBook object exists
+* @post: ChildrenBook is unchanged
+* @param: ostream& out - stream the data is written to
+*/
+void ChildrenBook::writeTransactionData(ostream& out) const {
+    out << ' ' << title << ", " << author << ',';
+}
+
 /*-------------------------------------------------------------------------
 * displayItem() 
 * 
@@ -15,6 +15,8 @@
 //
 // Assumptions/implementation: 
 // -- Contains an author 
+//    (an InlineString, like the title: in place up to ITEM_AUTHOR_BYTES - 1
+//    characters, on the heap beyond, pooled once a section holds the book)
 // -- Data that is passed to setData and setTransactionData is correctly
 //    formatted for a children's book.
 // -- stock is automatically set to 5 whenever a new ChildrenBook is 
@@ -63,6 +65,39 @@ class ChildrenBook : public Book {
     * @return: returns the newly created ChildrenBook object
     */
     ChildrenBook* create() const; 
+
+    /*-------------------------------------------------------------------------
+    * getObjectSize()
+    * 
+    * Inherited from Item - size of a ChildrenBook object
+    * @pre: ChildrenBook object exists
+    * @post: ChildrenBook is unchanged
+    * @param: None 
+    * @return: int - bytes of the object
+    */
+    int getObjectSize() const;
+
+    /*-------------------------------------------------------------------------
+    * getStringSize()
+    * 
+    * Inherited from Item - heap memory held by the title and author
+    * @pre: ChildrenBook object exists
+    * @post: ChildrenBook is unchanged
+    * @param: None 
+    * @return: int - bytes allocated for strings
+    */
+    int getStringSize() const;
+
+    /*-------------------------------------------------------------------------
+    * poolStrings()
+    * 
+    * Inherited from Item - pools the title and author, if too long to be
+    * kept in place
+    * @pre: ChildrenBook object exists
+    * @post: the long fields are shared with the other Items holding them
+    * @param: None 
+    */
+    void poolStrings();
     
     /*-------------------------------------------------------------------------
     * setData(ifstream&)
@@ -77,7 +112,7 @@ class ChildrenBook : public Book {
     void setData(ifstream&);   
 
     /*-------------------------------------------------------------------------
-    * setTransactionData(ifstream&)
+    * setTransactionData(istream&)
     * 
     * Inherited from Item - Sets the data of the current ChildrenBook to the data
     * that is fed in from the command data file. Only differs from setData due to 
@@ -85,9 +120,21 @@ class ChildrenBook : public Book {
     * @pre: ChildrenBook object exists 
     * @post: the current ChildrenBook object's members are set to the current
     * line of the command ifstream data.
-    * @param: ifstream& infile - a file stream allowing processing of file data
+    * @param: istream& infile - a stream (command file or log) allowing processing of data
+    */
+    void setTransactionData(istream&); 
+
+    /*-------------------------------------------------------------------------
+    * writeTransactionData(ostream&)
+    * 
+    * Inherited from Item - writes the ChildrenBook's identifying data in the 
+    * command file layout (title, author), so setTransactionData() can 
+    * read it back
+    * @pre: ChildrenBook object exists
+    * @post: ChildrenBook is unchanged
+    * @param: ostream& out - stream the data is written to
     */
-    void setTransactionData(ifstream&); 
+    void writeTransactionData(ostream&) const;
 
 
 
@@ -153,7 +200,61 @@ class ChildrenBook : public Book {
     */
     virtual bool operator>(const Item&) const;
 
+    /*-------------------------------------------------------------------------
+    * compare(const ChildrenBook&)
+    * 
+    * Non-virtual three way comparison, by title then author, for code that
+    * knows the type at compile time (BinarySearchTree::retrieveAs and
+    * insertAs). Orders like operator< and operator>, without copying.
+    * @pre: None
+    * @post: ChildrenBook is unchanged
+    * @param: const ChildrenBook& - the book compared to
+    * @return: int - negative, 0 or positive as this book sorts before, with
+    * or after the other one
+    */
+    int compare(const ChildrenBook& other) const {
+        int order = title.compare(other.title);
+        return (order != 0) ? order : author.compare(other.author);
+    }
+
+    /*-------------------------------------------------------------------------
+    * keyHash()
+    * 
+    * Inherited from Item - hashes the key compare() orders by (title then author).
+    * Also called non-virtually by KeyIndex::findAs.
+    * @pre: None
+    * @post: ChildrenBook is unchanged
+    * @param: None
+    * @return: size_t - hash of the key
+    */
+    size_t keyHash() const {
+        size_t hash = title.hash();
+        return combineHash(hash, author.hash());
+    }
+
+    /*-------------------------------------------------------------------------
+    * appendSortKey(string&)
+    * 
+    * Non-virtual, appends the key compare() orders by as bytes (title, a 0
+    * byte, then author), so that comparing the bytes of two keys orders their
+    * books like compare(). Used for the front coded keys of LsmSection runs.
+    * @pre: None
+    * @post: ChildrenBook is unchanged
+    * @param: string& - the key is appended to it
+    */
+    void appendSortKey(string& key) const {
+        key.append(title.data(), title.size());
+        key.push_back('\0');
+        key.append(author.data(), author.size());
+    }
+
+    // registration in the MediaTypes list: letter of the type in data and
+    // command files, and name and column headings of its section
+    static const char TYPE = 'C';
+    static const char* sectionName() { return "CHILDREN BOOKS"; }
+    static const char* sectionColumns() { return "AVAIL,TITLE,AUTHOR,YEAR"; }
+
   private:
-    string author;          // Store author's name
+    InlineString<ITEM_AUTHOR_BYTES> author; // Store author's name
   };
 #endif //CHILDRENBOOK_H
\ No newline at end of file
@@ -0,0 +1,376 @@
+/*---------------------------------------------------------------------------
+* @file: command.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: implementation of the CommandParser and CommandQueue classes
+---------------------------------------------------------------------------*/
+#include "command.h"
+#include "linereader.h"
+#include <climits>
+#include <cstring>
+#include "constants.h"
+
+using namespace std;
+
+// blanks between the fields of a command
+static const char* skipBlanks(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    return p;
+}
+
+/*-------------------------------------------------------------------------
+* parse(const char*, const char*, Command&)
+*
+* Parses the command held in [begin, end), one line without its newline
+* @pre: begin <= end
+* @post: command holds the parsed fields if a command was found
+* @param: const char* - first character of the line
+* @param: const char* - one past the last character of the line
+* @param: Command& - the parsed command
+* @return: bool - false if the line is blank (no command)
+*/
+bool CommandParser::parse(const char* begin, const char* end, Command& command) {
+    command.patronID = 0;
+    command.itemType = ' ';
+    command.format = ' ';
+    command.itemData.clear();
+
+    const char* p = skipBlanks(begin, end);
+    if (p == end) {
+        return false;
+    }
+    command.type = *p++;
+
+    // patron ID, clamped to the range of an int
+    p = skipBlanks(p, end);
+    bool negative = (p < end && (*p == '-' || *p == '+'));
+    if (negative) {
+        negative = (*p == '-');
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+        return true;
+    }
+    long long id = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (id <= INT_MAX) {
+            id = id * 10 + (*p - '0');
+        }
+        p++;
+    }
+    if (id > INT_MAX) {
+        id = INT_MAX;
+    }
+    command.patronID = static_cast<int>(negative ? -id : id);
+
+    // item type and format, then the key fields as they are
+    p = skipBlanks(p, end);
+    if (p < end) {
+        command.itemType = *p++;
+    }
+    p = skipBlanks(p, end);
+    if (p < end) {
+        command.format = *p++;
+    }
+    command.itemData.assign(p, end);
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* parse(const string&, Command&)
+*
+* Parses the command held in a line without its newline
+* @pre: None
+* @post: command holds the parsed fields if a command was found
+* @param: const string& - the line
+* @param: Command& - the parsed command
+* @return: bool - false if the line is blank (no command)
+*/
+bool CommandParser::parse(const string& line, Command& command) {
+    return parse(line.data(), line.data() + line.size(), command);
+}
+
+/*-------------------------------------------------------------------------
+* parseStream(istream&, CommandQueue&)
+*
+* Parses every line of the stream and pushes the commands onto the queue
+* in chunks of COMMAND_CHUNK_SIZE. Meant to run on its own thread while 
+* another thread executes what was already parsed.
+* @pre: stream is open
+* @post: every command is queued and the queue is closed
+* @param: istream& - the stream holding the commands (1 per line)
+* @param: CommandQueue& - the queue the chunks are pushed onto
+*/
+void CommandParser::parseStream(istream& infile, CommandQueue& queue) {
+    vector<Command> chunk;
+    Command command;
+    string line;
+    while (getline(infile, line)) {
+        if (parse(line, command)) {
+            chunk.push_back(command);
+        }
+        if (chunk.size() >= COMMAND_CHUNK_SIZE) {
+            queue.push(chunk);
+        }
+    }
+    if (!chunk.empty()) {
+        queue.push(chunk);
+    }
+    queue.close();
+}
+
+/*-------------------------------------------------------------------------
+* parseLines(LineReader&, CommandQueue&)
+*
+* Same as parseStream(), for the lines of a LineReader, parsed where
+* they are in its buffer
+* @pre: None
+* @post: every command is queued and the queue is closed
+* @param: LineReader& - the source of the commands (1 per line)
+* @param: CommandQueue& - the queue the chunks are pushed onto
+*/
+void CommandParser::parseLines(LineReader& reader, CommandQueue& queue) {
+    vector<Command> chunk;
+    Command command;
+    const char* begin;
+    const char* end;
+    while (reader.next(begin, end)) {
+        if (parse(begin, end, command)) {
+            chunk.push_back(command);
+        }
+        if (chunk.size() >= COMMAND_CHUNK_SIZE) {
+            queue.push(chunk);
+        }
+    }
+    if (!chunk.empty()) {
+        queue.push(chunk);
+    }
+    queue.close();
+}
+
+/*-------------------------------------------------------------------------
+* parseBlock(const char*, const char*, vector<Command>&)
+*
+* Parses every line of [begin, end), a part of a command file that
+* starts at the start of a line
+* @pre: begin <= end
+* @post: the vector holds the commands of the block, in order. Lines
+* longer than MAX_COMMAND_LENGTH are skipped, as LineReader skips them.
+* @param: const char* - first character of the block
+* @param: const char* - one past its last character
+* @param: vector<Command>& - the commands parsed. Commands it already
+* holds are overwritten, so their strings' memory is used again
+* @return: long - lines skipped for being too long
+*/
+long CommandParser::parseBlock(const char* begin, const char* end, vector<Command>& commands) {
+    long skipped = 0;
+    int used = 0;
+    while (begin < end) {
+        const char* newline = static_cast<const char*>(memchr(begin, '\n', end - begin));
+        const char* lineEnd = (newline != nullptr) ? newline : end;
+        if (lineEnd - begin > MAX_COMMAND_LENGTH) {
+            skipped++;
+        } else {
+            // parsed in place, into the memory of a Command already there
+            if (used == commands.size()) {
+                commands.emplace_back();
+            }
+            if (parse(begin, lineEnd, commands[used])) {
+                used++;
+            }
+        }
+        begin = lineEnd + 1;
+    }
+    commands.resize(used);
+    return skipped;
+}
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* Creates an empty, open queue
+* @pre: None
+* @post: CommandQueue object exists
+* @param: int - most chunks held before push() blocks
+*/
+CommandQueue::CommandQueue(int capacity) : capacity(capacity) {
+    closed = false;
+}
+
+/*-------------------------------------------------------------------------
+* push(vector<Command>&)
+*
+* Adds a chunk of commands, waiting for room if the queue is full
+* @pre: queue is not closed
+* @post: the chunk is queued and the given vector is left empty
+* @param: vector<Command>& - the chunk to queue
+*/
+void CommandQueue::push(vector<Command>& chunk) {
+    unique_lock<mutex> guard(lock);
+    while (chunks.size() >= capacity) {
+        changed.wait(guard);
+    }
+    chunks.push_back(vector<Command>());
+    chunks.back().swap(chunk);
+    changed.notify_all();
+}
+
+/*-------------------------------------------------------------------------
+* pop(vector<Command>&)
+*
+* Takes the oldest chunk, waiting for one if the queue is empty
+* @pre: None
+* @post: the chunk is removed from the queue
+* @param: vector<Command>& - set to the chunk
+* @return: bool - false once the queue is closed and empty
+*/
+bool CommandQueue::pop(vector<Command>& chunk) {
+    unique_lock<mutex> guard(lock);
+    while (chunks.empty() && !closed) {
+        changed.wait(guard);
+    }
+    if (chunks.empty()) {
+        return false;
+    }
+    chunk.swap(chunks.front());
+    chunks.pop_front();
+    changed.notify_all();
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* close()
+*
+* Marks the end of the commands, pop() returns false once drained
+* @pre: None
+* @post: no more chunks will be pushed
+* @param: None
+*/
+void CommandQueue::close() {
+    lock_guard<mutex> guard(lock);
+    closed = true;
+    changed.notify_all();
+}
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* Cuts the file into blocks and starts the parsing threads
+* @pre: data holds size bytes
+* @post: ParallelParser object exists, threads are parsing
+* @param: const char* - the file's bytes
+* @param: size_t - number of bytes
+* @param: int - parsing threads (at least 1)
+*/
+ParallelParser::ParallelParser(const char* data, size_t size, int threads) {
+    const char* end = data + size;
+    const char* begin = data;
+    bounds.push_back(begin);
+    while (begin < end) {
+        // a block ends after the first newline at or past its nominal size
+        const char* cut = begin + min(static_cast<size_t>(PARSE_BLOCK_SIZE), static_cast<size_t>(end - begin));
+        const char* newline = static_cast<const char*>(memchr(cut - 1, '\n', end - (cut - 1)));
+        begin = (newline != nullptr) ? newline + 1 : end;
+        bounds.push_back(begin);
+    }
+    count = bounds.size() - 1;
+    blocks.resize(count);
+    parsed.assign(count, 0);
+    skips.assign(count, 0);
+    skipped = 0;
+    nextBlock = 0;
+    taken = 0;
+    threads = max(1, threads);
+    ahead = threads * PARSE_BLOCKS_AHEAD;
+    for (int i = 0; i < threads; i++) {
+        workers.push_back(thread(&ParallelParser::work, this));
+    }
+}
+
+/*-------------------------------------------------------------------------
+* Destructor
+*
+* Stops handing out blocks and waits for the threads
+* @pre: ParallelParser object exists
+* @post: every thread has ended
+* @param: None
+*/
+ParallelParser::~ParallelParser() {
+    {
+        lock_guard<mutex> guard(lock);
+        nextBlock = count;
+        changed.notify_all();
+    }
+    for (int i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+}
+
+/*-------------------------------------------------------------------------
+* next(vector<Command>&)
+*
+* Takes the commands of the next block in file order, waiting until it
+* is parsed
+* @pre: None
+* @post: the block is handed over, a thread may parse one more
+* @param: vector<Command>& - set to the block's commands
+* @return: bool - false once every block was handed out
+*/
+bool ParallelParser::next(vector<Command>& chunk) {
+    unique_lock<mutex> guard(lock);
+    if (taken >= count) {
+        return false;
+    }
+    while (!parsed[taken]) {
+        changed.wait(guard);
+    }
+    // the block executed last is kept for a thread to parse into
+    spare.push_back(vector<Command>());
+    spare.back().swap(chunk);
+    chunk.swap(blocks[taken]);
+    skipped += skips[taken];
+    taken++;
+    changed.notify_all();
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* getSkipped()
+*
+* Number of lines skipped for being longer than MAX_COMMAND_LENGTH, in
+* the blocks handed out so far
+* @pre: None
+* @post: ParallelParser is unchanged
+* @return: long - lines skipped
+*/
+long ParallelParser::getSkipped() const {
+    lock_guard<mutex> guard(lock);
+    return skipped;
+}
+
+// what a parsing thread does: parse blocks until none are left
+void ParallelParser::work() {
+    unique_lock<mutex> guard(lock);
+    while (true) {
+        while (nextBlock < count && nextBlock >= taken + ahead) {
+            changed.wait(guard);
+        }
+        if (nextBlock >= count) {
+            return;
+        }
+        int index = nextBlock++;
+        vector<Command> commands;
+        if (!spare.empty()) {
+            commands.swap(spare.back());
+            spare.pop_back();
+        }
+        guard.unlock();
+        long tooLong = CommandParser::parseBlock(bounds[index], bounds[index + 1], commands);
+        guard.lock();
+        blocks[index].swap(commands);
+        skips[index] = tooLong;
+        parsed[index] = 1;
+        changed.notify_all();
+    }
+}
@@ -0,0 +1,281 @@
+/*---------------------------------------------------------------------------
+* @file: command.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the Command struct, the CommandParser class and
+* the CommandQueue class
+---------------------------------------------------------------------------*/
+// Command Struct: One command line (C, R, D, H, ...) split into its fields,
+// independent of the stream it was read from. Transactions are loaded from
+// a Command, so commands can be parsed ahead of time, batched, queued for
+// another thread or received over a socket.
+//---------------------------------------------------------------------------
+// Features:
+// -- Holds the transaction type, the patron ID, the item type (section), the
+//    item format and the item's key fields.
+//
+// Assumptions/implementation:
+// -- Fields a command doesn't have are left at their defaults (0 or ' ').
+// -- The key fields differ per media type (author and title, title and
+//    author, year month and title), so they are kept as the text of the
+//    command line after the format, and each Item reads its own fields from
+//    it with setTransactionData().
+//---------------------------------------------------------------------------
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include <string>
+#include <istream>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+using namespace std;
+
+class CommandQueue;
+class LineReader;
+
+struct Command {
+    char type;         // transaction type
+    int patronID;      // patron the command is for, 0 if none
+    char itemType;     // item type (section), ' ' if none
+    char format;       // item format, ' ' if none
+    string itemData;   // key fields, e.g. " Kerouac Jack, On the Road,"
+};
+
+//---------------------------------------------------------------------------
+// CommandParser Class: Splits command lines into Commands without using
+// string streams, so parsing is cheap enough to run ahead of execution.
+//---------------------------------------------------------------------------
+// Features:
+// -- Accepts the command file layout: type, then optionally patron ID, item
+//    type, format and key fields, separated by blanks.
+// -- Knows nothing about the library: an unknown transaction or item type
+//    still parses, and is reported when the command is executed.
+//
+// Assumptions/implementation:
+// -- One command per line. A patron ID that isn't a number ends the command
+//    with patron ID 0, like a failed stream read would.
+//---------------------------------------------------------------------------
+class CommandParser {
+  public:
+    /*-------------------------------------------------------------------------
+    * parse(const char*, const char*, Command&)
+    *
+    * Parses the command held in [begin, end), one line without its newline
+    * @pre: begin <= end
+    * @post: command holds the parsed fields if a command was found
+    * @param: const char* - first character of the line
+    * @param: const char* - one past the last character of the line
+    * @param: Command& - the parsed command
+    * @return: bool - false if the line is blank (no command)
+    */
+    static bool parse(const char*, const char*, Command&);
+
+    /*-------------------------------------------------------------------------
+    * parse(const string&, Command&)
+    *
+    * Parses the command held in a line without its newline
+    * @pre: None
+    * @post: command holds the parsed fields if a command was found
+    * @param: const string& - the line
+    * @param: Command& - the parsed command
+    * @return: bool - false if the line is blank (no command)
+    */
+    static bool parse(const string&, Command&);
+
+    /*-------------------------------------------------------------------------
+    * parseStream(istream&, CommandQueue&)
+    *
+    * Parses every line of the stream and pushes the commands onto the queue
+    * in chunks of COMMAND_CHUNK_SIZE. Meant to run on its own thread while 
+    * another thread executes what was already parsed.
+    * @pre: stream is open
+    * @post: every command is queued and the queue is closed
+    * @param: istream& - the stream holding the commands (1 per line)
+    * @param: CommandQueue& - the queue the chunks are pushed onto
+    */
+    static void parseStream(istream&, CommandQueue&);
+
+    /*-------------------------------------------------------------------------
+    * parseLines(LineReader&, CommandQueue&)
+    *
+    * Same as parseStream(), for the lines of a LineReader, parsed where
+    * they are in its buffer
+    * @pre: None
+    * @post: every command is queued and the queue is closed
+    * @param: LineReader& - the source of the commands (1 per line)
+    * @param: CommandQueue& - the queue the chunks are pushed onto
+    */
+    static void parseLines(LineReader&, CommandQueue&);
+
+    /*-------------------------------------------------------------------------
+    * parseBlock(const char*, const char*, vector<Command>&)
+    *
+    * Parses every line of [begin, end), a part of a command file that
+    * starts at the start of a line
+    * @pre: begin <= end
+    * @post: the vector holds the commands of the block, in order. Lines
+    * longer than MAX_COMMAND_LENGTH are skipped, as LineReader skips them.
+    * @param: const char* - first character of the block
+    * @param: const char* - one past its last character
+    * @param: vector<Command>& - the commands parsed. Commands it already
+    * holds are overwritten, so their strings' memory is used again
+    * @return: long - lines skipped for being too long
+    */
+    static long parseBlock(const char*, const char*, vector<Command>&);
+};
+
+//---------------------------------------------------------------------------
+// CommandQueue Class: Bounded, blocking queue of parsed command chunks
+// handed from a parsing thread to the executing thread.
+//---------------------------------------------------------------------------
+// Features:
+// -- Commands travel in chunks so the threads synchronize once per chunk,
+//    not once per command.
+// -- push() blocks while the queue is full, so a fast parser can't run
+//    arbitrarily far ahead of execution.
+//
+// Assumptions/implementation:
+// -- One producer and one consumer. Chunks are moved, never copied.
+//---------------------------------------------------------------------------
+class CommandQueue {
+  public:
+    /*-------------------------------------------------------------------------
+    * Constructor
+    *
+    * Creates an empty, open queue
+    * @pre: None
+    * @post: CommandQueue object exists
+    * @param: int - most chunks held before push() blocks
+    */
+    CommandQueue(int);
+
+    /*-------------------------------------------------------------------------
+    * push(vector<Command>&)
+    *
+    * Adds a chunk of commands, waiting for room if the queue is full
+    * @pre: queue is not closed
+    * @post: the chunk is queued and the given vector is left empty
+    * @param: vector<Command>& - the chunk to queue
+    */
+    void push(vector<Command>&);
+
+    /*-------------------------------------------------------------------------
+    * pop(vector<Command>&)
+    *
+    * Takes the oldest chunk, waiting for one if the queue is empty
+    * @pre: None
+    * @post: the chunk is removed from the queue
+    * @param: vector<Command>& - set to the chunk
+    * @return: bool - false once the queue is closed and empty
+    */
+    bool pop(vector<Command>&);
+
+    /*-------------------------------------------------------------------------
+    * close()
+    *
+    * Marks the end of the commands, pop() returns false once drained
+    * @pre: None
+    * @post: no more chunks will be pushed
+    * @param: None
+    */
+    void close();
+
+  private:
+    deque<vector<Command> > chunks;   // queued chunks, oldest first
+    int capacity;                     // most chunks held
+    bool closed;                      // no more chunks will be pushed
+    mutex lock;                       // guards the members above
+    condition_variable changed;       // signaled on push, pop and close
+};
+
+//---------------------------------------------------------------------------
+// ParallelParser Class: Parses a command file held in memory (mapped) on
+// several threads, and hands the commands out in file order.
+//---------------------------------------------------------------------------
+// Features:
+// -- The file is cut into blocks of about PARSE_BLOCK_SIZE bytes, each
+//    ending at a newline, so every block parses on its own.
+// -- Threads take the next unparsed block; next() waits for the block the
+//    executor needs next, so execution order is the file's order.
+// -- Parsing stays at most PARSE_BLOCKS_AHEAD blocks per thread ahead of
+//    next(), so memory is bounded for files of any size.
+//
+// Assumptions/implementation:
+// -- The file's bytes stay valid and unchanged while the parser exists.
+// -- One consumer calls next(). Blocks are moved, never copied, and the
+//    block given back by the next call is parsed into again, so commands
+//    reuse the memory of their strings instead of allocating it.
+//---------------------------------------------------------------------------
+class ParallelParser {
+  public:
+    /*-------------------------------------------------------------------------
+    * Constructor
+    *
+    * Cuts the file into blocks and starts the parsing threads
+    * @pre: data holds size bytes
+    * @post: ParallelParser object exists, threads are parsing
+    * @param: const char* - the file's bytes
+    * @param: size_t - number of bytes
+    * @param: int - parsing threads (at least 1)
+    */
+    ParallelParser(const char*, size_t, int);
+
+    /*-------------------------------------------------------------------------
+    * Destructor
+    *
+    * Stops handing out blocks and waits for the threads
+    * @pre: ParallelParser object exists
+    * @post: every thread has ended
+    * @param: None
+    */
+    ~ParallelParser();
+
+    /*-------------------------------------------------------------------------
+    * next(vector<Command>&)
+    *
+    * Takes the commands of the next block in file order, waiting until it
+    * is parsed
+    * @pre: None
+    * @post: the block is handed over, a thread may parse one more
+    * @param: vector<Command>& - set to the block's commands
+    * @return: bool - false once every block was handed out
+    */
+    bool next(vector<Command>&);
+
+    /*-------------------------------------------------------------------------
+    * getSkipped()
+    *
+    * Number of lines skipped for being longer than MAX_COMMAND_LENGTH, in
+    * the blocks handed out so far
+    * @pre: None
+    * @post: ParallelParser is unchanged
+    * @return: long - lines skipped
+    */
+    long getSkipped() const;
+
+  private:
+    vector<const char*> bounds;       // block i is [bounds[i], bounds[i + 1])
+    vector<vector<Command> > blocks;  // parsed blocks not handed out yet
+    vector<vector<Command> > spare;   // executed blocks, parsed into again
+    vector<char> parsed;              // block i is parsed
+    vector<long> skips;               // lines of block i that were too long
+    long skipped;                     // lines too long in the blocks taken
+    int count;                        // number of blocks
+    int nextBlock;                    // next block a thread parses
+    int taken;                        // blocks handed out by next()
+    int ahead;                        // blocks parsed beyond taken, at most
+    mutable mutex lock;                       // guards the members above
+    condition_variable changed;       // signaled when a block is parsed or taken
+    vector<thread> workers;           // parsing threads
+
+    // what a parsing thread does: parse blocks until none are left
+    void work();
+
+    // copying would share the threads
+    ParallelParser(const ParallelParser&);
+    ParallelParser& operator=(const ParallelParser&);
+};
+#endif //COMMAND_H
@@ -0,0 +1,185 @@
+/*---------------------------------------------------------------------------
+* @file: commandstats.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: implementation of the Histogram and CommandStats classes
+---------------------------------------------------------------------------*/
+#include "commandstats.h"
+#include <iomanip>
+
+using namespace std;
+
+// names of the error reasons, in ErrorReason order
+static const char* ERROR_NAMES[CommandStats::ERROR_REASONS] = {
+    "INVALID PATRON", "INVALID TYPE", "NOT FOUND", "OUT OF STOCK", "NOT CHECKED OUT"
+};
+
+// percentiles printed for every histogram
+static const double PERCENTILES[] = {0.5, 0.9, 0.99, 0.999};
+static const int PERCENTILE_COUNT = 4;
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* Creates an empty histogram, no buckets are allocated yet
+* @pre: None
+* @post: Histogram object exists
+* @param: None
+*/
+Histogram::Histogram() {
+    count = 0;
+    total = 0;
+    maximum = 0;
+}
+
+/*-------------------------------------------------------------------------
+* percentile(double)
+*
+* Finds the value below which the given fraction of the values are
+* @pre: 0 <= fraction <= 1
+* @post: Histogram is unchanged
+* @param: double - the fraction, e.g. 0.99
+* @return: long long - highest value of the bucket the percentile falls
+* in (never more than the maximum), 0 if nothing was recorded
+*/
+long long Histogram::percentile(double fraction) const {
+    if (count == 0) {
+        return 0;
+    }
+    long long rank = static_cast<long long>(fraction * count + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    long long seen = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            long long highest = highestOf(i);
+            return (highest < maximum) ? highest : maximum;
+        }
+    }
+    return maximum;
+}
+
+/*-------------------------------------------------------------------------
+* getCount(), getMean(), getMax()
+*
+* Number of values, their mean and the largest value recorded
+* @pre: None
+* @post: Histogram is unchanged
+*/
+long long Histogram::getCount() const {
+    return count;
+}
+
+double Histogram::getMean() const {
+    return (count == 0) ? 0 : static_cast<double>(total) / count;
+}
+
+long long Histogram::getMax() const {
+    return maximum;
+}
+
+// highest value counted in the given bucket
+long long Histogram::highestOf(int bucket) {
+    if (bucket < HISTOGRAM_SUB_BUCKETS) {
+        return bucket;
+    }
+    int shift = bucket / HISTOGRAM_SUB_BUCKETS - 1;
+    long long lowest = static_cast<long long>(HISTOGRAM_SUB_BUCKETS + bucket % HISTOGRAM_SUB_BUCKETS) << shift;
+    return lowest + (1LL << shift) - 1;
+}
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* Creates statistics with nothing counted
+* @pre: None
+* @post: CommandStats object exists
+* @param: None
+*/
+CommandStats::CommandStats() {
+    for (int i = 0; i < TRANSACTION_TYPES; i++) {
+        commands[i] = 0;
+        for (int j = 0; j < ERROR_REASONS; j++) {
+            errors[i][j] = 0;
+        }
+    }
+    unknownCommands = 0;
+    pendingError = ERROR_REASONS;
+}
+
+/*-------------------------------------------------------------------------
+* display(ostream&)
+*
+* Prints counts, errors by reason and latency percentiles per command
+* type, then the lookup depth and chain length histograms' percentiles
+* @pre: None
+* @post: CommandStats is unchanged
+* @param: ostream& - where the statistics are printed
+*/
+void CommandStats::display(ostream& out) const {
+    out << "----------------------------------------";
+    out << "----------------------------------------" << endl;
+#if LIBRARY_STATS
+    out << "COMMAND STATISTICS" << endl << endl;
+    out << left << setw(6) << "TYPE" << right << setw(10) << "COUNT"
+        << setw(10) << "ERRORS" << setw(10) << "MEAN us" << setw(10) << "P50 us"
+        << setw(10) << "P90 us" << setw(10) << "P99 us" << setw(10) << "P99.9 us"
+        << setw(12) << "MAX us" << endl;
+    out << fixed << setprecision(1);
+    for (int i = 0; i < TRANSACTION_TYPES; i++) {
+        if (commands[i] == 0) {
+            continue;
+        }
+        long long failed = 0;
+        for (int j = 0; j < ERROR_REASONS; j++) {
+            failed += errors[i][j];
+        }
+        out << left << setw(6) << static_cast<char>('A' + i) << right
+            << setw(10) << commands[i] << setw(10) << failed
+            << setw(10) << latency[i].getMean() / 1000;
+        for (int p = 0; p < PERCENTILE_COUNT; p++) {
+            out << setw(10) << latency[i].percentile(PERCENTILES[p]) / 1000.0;
+        }
+        out << setw(12) << latency[i].getMax() / 1000.0 << endl;
+    }
+    out << "unknown command types: " << unknownCommands << endl << endl;
+
+    out << left << setw(6) << "TYPE" << right;
+    for (int j = 0; j < ERROR_REASONS; j++) {
+        out << setw(17) << ERROR_NAMES[j];
+    }
+    out << endl;
+    for (int i = 0; i < TRANSACTION_TYPES; i++) {
+        if (commands[i] == 0) {
+            continue;
+        }
+        out << left << setw(6) << static_cast<char>('A' + i) << right;
+        for (int j = 0; j < ERROR_REASONS; j++) {
+            out << setw(17) << errors[i][j];
+        }
+        out << endl;
+    }
+    out << endl;
+
+    out << left << setw(14) << "LOOKUPS" << right << setw(10) << "COUNT"
+        << setw(10) << "MEAN" << setw(10) << "P50" << setw(10) << "P90"
+        << setw(10) << "P99" << setw(10) << "P99.9" << setw(10) << "MAX" << endl;
+    const Histogram* lookups[] = {&treeDepth, &chainLength};
+    const char* names[] = {"item probes", "patron chain"};
+    for (int i = 0; i < 2; i++) {
+        out << left << setw(14) << names[i] << right << setw(10) << lookups[i]->getCount()
+            << setw(10) << lookups[i]->getMean();
+        for (int p = 0; p < PERCENTILE_COUNT; p++) {
+            out << setw(10) << lookups[i]->percentile(PERCENTILES[p]);
+        }
+        out << setw(10) << lookups[i]->getMax() << endl;
+    }
+    out.unsetf(ios::floatfield);
+    out << setprecision(6);
+#else
+    out << "Command statistics were compiled out (LIBRARY_STATS=0)." << endl;
+#endif
+    out << "----------------------------------------";
+    out << "----------------------------------------" << endl;
+}
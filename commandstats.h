@@ -0,0 +1,270 @@
+/*---------------------------------------------------------------------------
+* @file: commandstats.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the Histogram and CommandStats classes
+---------------------------------------------------------------------------*/
+// Histogram Class: Counts values (latencies in ns, lookup depths) in
+// log-linear buckets, the way an HDR histogram does: every power of two is
+// split into HISTOGRAM_SUB_BUCKETS equal buckets, so a percentile read back
+// is within 1/HISTOGRAM_SUB_BUCKETS of the real value, at any magnitude.
+//---------------------------------------------------------------------------
+// Features:
+// -- record() is a couple of shifts and an increment.
+// -- Percentiles, mean and maximum can be read back at any time.
+//
+// Assumptions/implementation:
+// -- Values must be >= 0. Values of 2^HISTOGRAM_MAGNITUDES and more are
+//    counted in the last bucket (the maximum is still exact).
+// -- The buckets are only allocated by the first record(), so histograms of
+//    command types that never run cost next to nothing.
+//---------------------------------------------------------------------------
+#ifndef COMMANDSTATS_H
+#define COMMANDSTATS_H
+
+// Compile with -DLIBRARY_STATS=0 to leave all instrumentation out
+#ifndef LIBRARY_STATS
+#define LIBRARY_STATS 1
+#endif
+
+#include <vector>
+#include <chrono>
+#include <ostream>
+#include "constants.h"
+#include "typecodes.h"
+
+using namespace std;
+
+class Histogram {
+  public:
+    /*-------------------------------------------------------------------------
+    * Constructor
+    *
+    * Creates an empty histogram, no buckets are allocated yet
+    * @pre: None
+    * @post: Histogram object exists
+    * @param: None
+    */
+    Histogram();
+
+    /*-------------------------------------------------------------------------
+    * record(long long)
+    *
+    * Counts one value
+    * @pre: value >= 0
+    * @post: the value's bucket, the total and the maximum are updated
+    * @param: long long - the value
+    */
+    void record(long long value) {
+        if (buckets.empty()) {
+            buckets.resize(HISTOGRAM_BUCKETS, 0);
+        }
+        buckets[bucketOf(value)]++;
+        count++;
+        total += value;
+        if (value > maximum) {
+            maximum = value;
+        }
+    }
+
+    /*-------------------------------------------------------------------------
+    * percentile(double)
+    *
+    * Finds the value below which the given fraction of the values are
+    * @pre: 0 <= fraction <= 1
+    * @post: Histogram is unchanged
+    * @param: double - the fraction, e.g. 0.99
+    * @return: long long - highest value of the bucket the percentile falls
+    * in (never more than the maximum), 0 if nothing was recorded
+    */
+    long long percentile(double) const;
+
+    /*-------------------------------------------------------------------------
+    * getCount(), getMean(), getMax()
+    *
+    * Number of values, their mean and the largest value recorded
+    * @pre: None
+    * @post: Histogram is unchanged
+    */
+    long long getCount() const;
+    double getMean() const;
+    long long getMax() const;
+
+  private:
+    // every power of two is split into 2^HISTOGRAM_SUB_BITS buckets
+    static const int HISTOGRAM_SUB_BUCKETS = 1 << HISTOGRAM_SUB_BITS;
+    static const int HISTOGRAM_BUCKETS = (HISTOGRAM_MAGNITUDES - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_BUCKETS;
+
+    vector<long long> buckets;   // values counted per bucket
+    long long count;             // values recorded
+    long long total;             // sum of the values recorded
+    long long maximum;           // largest value recorded
+
+    // bucket a value is counted in: values below HISTOGRAM_SUB_BUCKETS have a
+    // bucket each, larger ones keep their top HISTOGRAM_SUB_BITS + 1 bits
+    static int bucketOf(long long value) {
+        if (value < HISTOGRAM_SUB_BUCKETS) {
+            return (value < 0) ? 0 : static_cast<int>(value);
+        }
+        int magnitude = 63 - __builtin_clzll(static_cast<unsigned long long>(value));
+        if (magnitude >= HISTOGRAM_MAGNITUDES) {
+            return HISTOGRAM_BUCKETS - 1;
+        }
+        int shift = magnitude - HISTOGRAM_SUB_BITS;
+        return (shift + 1) * HISTOGRAM_SUB_BUCKETS + static_cast<int>((value >> shift) & (HISTOGRAM_SUB_BUCKETS - 1));
+    }
+
+    // highest value counted in the given bucket
+    static long long highestOf(int);
+};
+
+//---------------------------------------------------------------------------
+// CommandStats Class: Instrumentation of the commands a Library executes.
+// Per transaction type it keeps the number of commands, their errors by
+// reason and a latency histogram. It also keeps histograms of the index
+// probes of item lookups and the chain length of patron lookups.
+//---------------------------------------------------------------------------
+// Features:
+// -- Shown by the S command, and written at exit by "./a.out -t file".
+// -- Commands are timed from the creation of their Transaction to the end
+//    of apply(), including what they print.
+//
+// Assumptions/implementation:
+// -- Not thread safe. It is only changed by the thread executing commands,
+//    which the servers already serialize. Lookups made by crash recovery
+//    (on several threads) are not counted.
+// -- A transaction reports its error with error() during apply(), the
+//    error is charged to the command type by the following finish().
+// -- With LIBRARY_STATS set to 0 every recording method is empty and the
+//    clock is never read, so instrumentation costs nothing.
+//---------------------------------------------------------------------------
+class CommandStats {
+  public:
+    // why a command failed
+    enum ErrorReason {
+        INVALID_PATRON,    // no patron with the command's ID
+        INVALID_TYPE,      // no item type (section) of that letter
+        NOT_FOUND,         // item is not in its section
+        OUT_OF_STOCK,      // every copy is checked out
+        NOT_CHECKED_OUT,   // patron doesn't hold the item returned
+        ERROR_REASONS
+    };
+
+    /*-------------------------------------------------------------------------
+    * Constructor
+    *
+    * Creates statistics with nothing counted
+    * @pre: None
+    * @post: CommandStats object exists
+    * @param: None
+    */
+    CommandStats();
+
+    /*-------------------------------------------------------------------------
+    * now()
+    *
+    * Start time of a command, handed back to finish()
+    * @pre: None
+    * @post: CommandStats is unchanged
+    * @return: long long - steady clock time in ns (0 when compiled out)
+    */
+    long long now() const {
+#if LIBRARY_STATS
+        return chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+#else
+        return 0;
+#endif
+    }
+
+    /*-------------------------------------------------------------------------
+    * error(ErrorReason)
+    *
+    * Notes why the command being executed failed
+    * @pre: the command has not been finished yet
+    * @post: the error is charged to the command by finish()
+    * @param: ErrorReason - why the command failed
+    */
+    void error(ErrorReason reason) {
+#if LIBRARY_STATS
+        pendingError = reason;
+#endif
+    }
+
+    /*-------------------------------------------------------------------------
+    * finish(char, long long)
+    *
+    * Counts a command of the given type that has been executed, and the
+    * error it reported, if any
+    * @pre: type is a valid transaction type
+    * @post: count, errors and latency of the type are updated
+    * @param: char - the transaction type
+    * @param: long long - how long it took, in ns
+    */
+    void finish(char type, long long elapsed) {
+#if LIBRARY_STATS
+        int index = typeIndex(type);
+        commands[index]++;
+        latency[index].record(elapsed);
+        if (pendingError != ERROR_REASONS) {
+            errors[index][pendingError]++;
+            pendingError = ERROR_REASONS;
+        }
+#endif
+    }
+
+    /*-------------------------------------------------------------------------
+    * unknownCommand()
+    *
+    * Counts a command whose transaction type doesn't exist
+    * @pre: None
+    * @post: unknown command count is updated
+    * @param: None
+    */
+    void unknownCommand() {
+#if LIBRARY_STATS
+        unknownCommands++;
+#endif
+    }
+
+    /*-------------------------------------------------------------------------
+    * treeLookup(int), patronLookup(int)
+    *
+    * Counts the slots an item lookup probed in its section's key index, or
+    * the entries a patron lookup visited in its HashTable chain
+    * @pre: None
+    * @post: the depth or chain length histogram is updated
+    * @param: int - nodes or entries visited
+    */
+    void treeLookup(int depth) {
+#if LIBRARY_STATS
+        treeDepth.record(depth);
+#endif
+    }
+    void patronLookup(int length) {
+#if LIBRARY_STATS
+        chainLength.record(length);
+#endif
+    }
+
+    /*-------------------------------------------------------------------------
+    * display(ostream&)
+    *
+    * Prints counts, errors by reason and latency percentiles per command
+    * type, then the lookup depth and chain length histograms' percentiles
+    * @pre: None
+    * @post: CommandStats is unchanged
+    * @param: ostream& - where the statistics are printed
+    */
+    void display(ostream&) const;
+
+  private:
+    long long commands[TRANSACTION_TYPES];                // commands per type
+    long long errors[TRANSACTION_TYPES][ERROR_REASONS];   // errors per type, reason
+    Histogram latency[TRANSACTION_TYPES];                 // ns per command, by type
+    long long unknownCommands;      // commands of an invalid transaction type
+    Histogram treeDepth;            // index slots probed per item lookup
+    Histogram chainLength;          // entries visited per patron lookup
+    ErrorReason pendingError;       // error of the running command
+};
+
+#endif //COMMANDSTATS_H
@@ -12,13 +12,23 @@ const static int TITLE_WIDTH = 35;
 const static int MONTH_AUTHOR_WIDTH = 25;
 const static int YEAR_WIDTH = 4;
 
+// bytes of the title and author fields of Items (InlineString), one of them
+// the length: longer values go to the heap (the StringPool, for the Items
+// in a section)
+const static int ITEM_TITLE_BYTES = 40;
+const static int ITEM_AUTHOR_BYTES = 24;
+
 // constants for hashing
+const static int A_HASH_VALUE = 'A' - 'A';
 const static int C_HASH_VALUE = 'C' - 'A';
 const static int D_HASH_VALUE = 'D' - 'A';
 const static int F_HASH_VALUE = 'F' - 'A';
 const static int H_HASH_VALUE = 'H' - 'A';
+const static int K_HASH_VALUE = 'K' - 'A';
+const static int M_HASH_VALUE = 'M' - 'A';
 const static int P_HASH_VALUE = 'P' - 'A';
 const static int R_HASH_VALUE = 'R' - 'A';
+const static int S_HASH_VALUE = 'S' - 'A';
 
 // hashtable to contain patrons' size 
 const int TABLE_SIZE = 100;
@@ -35,6 +45,101 @@ const static int TRANSACTION_TYPES = 50;
 // used in item factory 
 const int ITEM_TYPES = 26; 
 
+// used by the library server
+// bytes read from a client socket per call 
+const static int READ_CHUNK_SIZE = 64 * 1024;
+// answers queued for one client before its commands stop being read
+const static int MAX_PENDING_OUTPUT = 4 * 1024 * 1024;
+// longest command line accepted from a client
+const static int MAX_COMMAND_LENGTH = 64 * 1024;
+// connections waiting to be accepted
+const static int SERVER_BACKLOG = 128;
+// events handled per epoll_wait call and its timeout in ms
+const static int MAX_EVENTS = 256;
+const static int EVENT_TIMEOUT = 500;
+
+// complete command lines a server connection runs as one staged batch
+const static int COMMAND_BATCH_SIZE = 64;
+// commands ahead of the current one whose patron is prefetched
+const static int PREFETCH_DISTANCE = 8;
+
+// used by the coroutine server
+// bytes read from a client socket per call, kept small since every
+// (idle) session holds one buffer
+const static int ASYNC_READ_SIZE = 4 * 1024;
+// items a display prints before letting other sessions run
+const static int DISPLAY_PART_ITEMS = 256;
+
+// used when commands are streamed from a file, pipe or socket
+// bytes buffered by a LineReader, the most a command stream ever holds
+const static int STREAM_BUFFER_SIZE = 256 * 1024;
+
+// used when a command file is parsed on its own thread
+// parsed commands handed to the executing thread at a time
+const static int COMMAND_CHUNK_SIZE = 256;
+// chunks parsed ahead of execution before the parser waits
+const static int COMMAND_QUEUE_CHUNKS = 16;
+
+// used when a command file is parsed by several threads
+// bytes of the file parsed as one block (ends are moved to a newline)
+const static int PARSE_BLOCK_SIZE = 1024 * 1024;
+// blocks each parsing thread may get ahead of execution
+const static int PARSE_BLOCKS_AHEAD = 4;
+
+// used by catalog delta files
+// delta lines read (and their Items created) before a batch is applied
+const static int DELTA_BATCH_RECORDS = 4096;
+
+// used by the sections' key indexes
+// slots of an index when its first Item is added (a power of two)
+const static int KEY_INDEX_SLOTS = 16;
+
+// used by the perfect hash indexes of frozen sections
+// keys per bucket, on average (each bucket has a 4 byte pilot)
+const static int PERFECT_HASH_BUCKET_KEYS = 4;
+// how full pilots fill the range they place keys in (percent, < 100)
+const static int PERFECT_HASH_LOAD_PERCENT = 97;
+// seeds tried before a section is left unfrozen
+const static int PERFECT_HASH_ATTEMPTS = 4;
+
+// used by the Bloom filters of sections
+// bits of filter per key (a power of two, at most 512: one 64 byte block)
+const static int BLOOM_BITS_PER_KEY = 16;
+
+// used by LSM sections
+// Items in the write buffer before it becomes a sorted run
+const static int LSM_BUFFER_ITEMS = 4096;
+// memory of a buffer node (a std::set node: 3 pointers, color, the Item*)
+const static int LSM_BUFFER_NODE_BYTES = 40;
+
+// used by front coded keys (the sorted runs of LSM sections)
+// keys per block, the first stored whole (lookups halve over them)
+const static int FRONT_CODING_BLOCK_KEYS = 32;
+
+// used by the calendar section of periodicals
+// years the month buckets span at most (issues dated outside go to a list)
+const static int CALENDAR_MAX_YEARS = 1000;
+
+// used by the title trie (autocomplete)
+// completions a prefix query returns at most (each trie node keeps as many)
+const static int AUTOCOMPLETE_RESULTS = 10;
+
+// used by the word index (keyword search over titles)
+// item IDs per block of a posting list, the first stored whole
+const static int WORD_BLOCK_IDS = 128;
+// results a keyword search returns at most
+const static int WORD_SEARCH_RESULTS = 10;
+
+// used by value sections
+// nodes (each holding an Item) allocated together in one block
+const static int VALUE_BLOCK_NODES = 256;
+
+// used by the command statistics histograms
+// every power of two is split into 2^HISTOGRAM_SUB_BITS buckets (~6% error)
+const static int HISTOGRAM_SUB_BITS = 4;
+// values from 2^HISTOGRAM_MAGNITUDES up share the last bucket (ns: ~3 days)
+const static int HISTOGRAM_MAGNITUDES = 48;
+
 
 
 #endif
\ No newline at end of file
@@ -44,19 +44,63 @@ Display* Display::create() const {
 }
 
 /*-------------------------------------------------------------------------
-    * execute(Library&, ifstream&)
-    *
-    * Executes the Display command: displays the entire library collection of
-    * items.
-    * @post: Item data in the library is printed in a formatted and sectioned 
-    * manner.
-    * @param: ifstream& - the ifstream providing data for commands (1 per line),
-    * in this case marked by a D. 
-    * @return: returns a bool marking whether or not to save this Display
-    * to patron history. Always returns false, as there is no information to 
-    * save or print in the future related to this Display object.
-    */
-bool Display::execute(Library& currLibrary, ifstream& infile) {
+* load(const Command&)
+*
+* A display has no fields, nothing is stored.
+* @pre: command.type is D
+* @post: Nothing is changed
+* @param: const Command& - unused
+*/
+void Display::load(const Command&) {
+    // nothing to store
+}
+
+/*-------------------------------------------------------------------------
+* getPatronID()
+*
+* A display has no patron, there is nothing to prefetch.
+* @pre: None
+* @post: Display is unchanged
+* @return: int - always 0
+*/
+int Display::getPatronID() const {
+    return 0;
+}
+
+/*-------------------------------------------------------------------------
+* findPatron(Library&)
+*
+* A display has no patron, nothing is looked up.
+* @pre: None
+* @post: Nothing is changed
+* @param: Library& - unused
+*/
+void Display::findPatron(Library&) {
+    // nothing to look up
+}
+
+/*-------------------------------------------------------------------------
+* findItem(Library&)
+*
+* A display has no item, nothing is looked up.
+* @pre: None
+* @post: Nothing is changed
+* @param: Library& - unused
+*/
+void Display::findItem(Library&) {
+    // nothing to look up
+}
+
+/*-------------------------------------------------------------------------
+* apply(Library&)
+*
+* Displays the entire library (all media types).
+* @pre: earlier commands have been applied
+* @post: Library contents are printed, the library is unchanged
+* @param: Library& - the library to display
+* @return: always false, there is no information to save for a Display
+*/
+bool Display::apply(Library& currLibrary) {
     currLibrary.display();
     return false;
 }
@@ -71,4 +115,32 @@ bool Display::execute(Library& currLibrary, ifstream& infile) {
 */
 void Display::display() const {
     
+}
+
+/*-------------------------------------------------------------------------
+* replay(Patron*, char, Item*, int&)
+*
+* A Display never changes the library, so it is never logged and there
+* is nothing to redo.
+* @pre: Nothing
+* @post: Nothing is changed
+* @param: Patron*, char, Item* - unused
+* @param: int& - set to 0, a Display never changes stock
+* @return: always false, a Display is never saved to patron history
+*/
+bool Display::replay(Patron*, char, Item*, int& stockChange) {
+    stockChange = 0;
+    return false;
+}
+
+/*-------------------------------------------------------------------------
+* save(ostream&)
+*
+* Never called, a Display is not saved to any patron history.
+* @pre: Nothing
+* @post: Nothing is written
+* @param: ostream& - the stream the record is written to
+*/
+void Display::save(ostream&) const {
+    // nothing to save, not part of a patron's transaction list
 }
\ No newline at end of file
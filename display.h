@@ -10,10 +10,11 @@
 // -- Displays a Library's contents
 //
 // Assumptions/implementation:
-// -- Calling execute(Library&, ifstream&) won't be done with uninitialized 
-//    objects. Executing a display requires the use of the binarysearchtree's
-//    display method. This method uses a recursive helper function and with
-//    a large enough library, may cause a stack overflow. 
+// -- Calling execute(Library&, const Command&) (or its stages) won't be
+//    done with uninitialized objects. Executing a display requires the use
+//    of the binarysearchtree's display method. This method uses a recursive
+//    helper function and with a large enough library, may cause a stack 
+//    overflow. 
 // -- The library can either be empty or full of objects. 
 // -- The library is unchanged after being displayed.
 //---------------------------------------------------------------------------
@@ -57,20 +58,59 @@ class Display : public Transaction {
         */
         virtual Display* create() const;  // creates new Display object
 
+        // letter of the command, for its registration in TransactionTypes
+        static const char TYPE = 'D';
+
+        /*-------------------------------------------------------------------------
+        * load(const Command&)
+        *
+        * A display has no fields, nothing is stored.
+        * @pre: command.type is D
+        * @post: Nothing is changed
+        * @param: const Command& - unused
+        */
+        virtual void load(const Command&);
+
+        /*-------------------------------------------------------------------------
+        * getPatronID()
+        *
+        * A display has no patron, there is nothing to prefetch.
+        * @pre: None
+        * @post: Display is unchanged
+        * @return: int - always 0
+        */
+        virtual int getPatronID() const;
+
         /*-------------------------------------------------------------------------
-        * execute(Library&, ifstream&)
+        * findPatron(Library&)
         *
-        * Executes the Display command: displays the entire library collection of
-        * items.
-        * @post: Item data in the library is printed in a formatted and sectioned 
-        * manner.
-        * @param: ifstream& - the ifstream providing data for commands (1 per line),
-        * in this case marked by a D. 
-        * @return: returns a bool marking whether or not to save this Display
-        * to patron history. Always returns false, as there is no information to 
-        * save or print in the future related to this Display object.
+        * A display has no patron, nothing is looked up.
+        * @pre: None
+        * @post: Nothing is changed
+        * @param: Library& - unused
         */
-        virtual bool execute(Library&, ifstream&); // Perform borrowed operation in Transaction class 
+        virtual void findPatron(Library&);
+
+        /*-------------------------------------------------------------------------
+        * findItem(Library&)
+        *
+        * A display has no item, nothing is looked up.
+        * @pre: None
+        * @post: Nothing is changed
+        * @param: Library& - unused
+        */
+        virtual void findItem(Library&);
+
+        /*-------------------------------------------------------------------------
+        * apply(Library&)
+        *
+        * Displays the entire library (all media types).
+        * @pre: earlier commands have been applied
+        * @post: Library contents are printed, the library is unchanged
+        * @param: Library& - the library to display
+        * @return: always false, there is no information to save for a Display
+        */
+        virtual bool apply(Library&);
 
         
 
@@ -83,6 +123,29 @@ class Display : public Transaction {
         * @param: None
         */
         virtual void display() const;
+
+        /*-------------------------------------------------------------------------
+        * replay(Patron*, char, Item*, int&)
+        *
+        * A Display never changes the library, so it is never logged and there
+        * is nothing to redo.
+        * @pre: Nothing
+        * @post: Nothing is changed
+        * @param: Patron*, char, Item* - unused
+        * @param: int& - set to 0, a Display never changes stock
+        * @return: always false, a Display is never saved to patron history
+        */
+        virtual bool replay(Patron*, char, Item*, int&);
+
+        /*-------------------------------------------------------------------------
+        * save(ostream&)
+        *
+        * Never called, a Display is not saved to any patron history.
+        * @pre: Nothing
+        * @post: Nothing is written
+        * @param: ostream& - the stream the record is written to
+        */
+        virtual void save(ostream&) const;
     
 }; //DISPLAY_H
 
@@ -0,0 +1,397 @@
+/*---------------------------------------------------------------------------
+* @file: eytzingersection.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file (and template implementation) of the EytzingerSection
+* class
+*/
+//---------------------------------------------------------------------------
+// EytzingerSection Class: Section for a catalog that is loaded once and then
+// mostly read. After layout(), its Items sit by value in one array in
+// Eytzinger order (the breadth first order of a complete binary search
+// tree), so a descent walks an array instead of chasing node pointers.
+// --------------------------------------------------------------------------
+// Features:
+//  -- Node k has its children at 2k and 2k + 1, and its four grandchildren
+//     next to each other at 4k to 4k + 3. Every step of a descent
+//     prefetches the grandchildren, so the next two levels are on their
+//     way while the current one is compared.
+//  -- The tree is complete: log2(n) + 1 levels for n Items, whatever order
+//     they were inserted in.
+//  -- Same insert/retrieve/remove/display contract as ValueSection. Items
+//     inserted after layout() go to the ValueSection tree this class is
+//     built on, and are found there after the array.
+//  -- The Library's exact lookups (checkouts, returns, recovery) do not
+//     descend the array: like every storage, EYTZINGER_SECTIONS answers
+//     them from the section's key index (retrieveByKey()), which is about
+//     4x faster (tools/layoutbench.cpp). The array serves display(),
+//     collect(), the ordered walks and the duplicate check of insert();
+//     retrieveAs() is there for code (and benches) that descends it.
+//
+// Assumptions/implementation:
+// -- layout() copies every Item into a new array, so it must be called
+//    before any pointer to an Item leaves the section: the Library calls
+//    it at the end of buildBooksFromFile().
+// -- Removing a laid-out Item only flags it (in a parallel array, so the
+//    Item stays where patrons and the log point to); it is skipped until
+//    the next layout() or makeEmpty().
+// -- Stock stays in the Items: checkouts and returns change it through
+//    the Item pointers they hold.
+// -- A template, so everything is defined in this header.
+//---------------------------------------------------------------------------
+#ifndef EYTZINGERSECTION_H
+#define EYTZINGERSECTION_H
+
+#include <vector>
+#include <new>
+#include <typeinfo>
+#include "valuesection.h"
+
+template <class Type>
+class EytzingerSection : public ValueSection<Type> {
+
+public:
+    /*-------------------------------------------------------------------------
+    * EytzingerSection Constructor (with name and header)
+    *
+    * @pre: nothing
+    * @post: empty section exists, nothing is laid out yet
+    * @param: string name - name of the section
+    * @param: string header - combination of headers used for display
+    */
+    EytzingerSection(string name, string header) : ValueSection<Type>(name, header) {
+        slots = nullptr;
+        slotCount = 0;
+        live = 0;
+    }
+
+    /*-------------------------------------------------------------------------
+    * EytzingerSection Destructor
+    *
+    * @pre: section exists
+    * @post: the laid-out Items are destroyed, then the tree's
+    * @param: None
+    */
+    ~EytzingerSection() {
+        releaseLayout();
+    }
+
+    /*-------------------------------------------------------------------------
+    * retrieve()
+    *
+    * Section lookup for any Item: targets of another type are never found
+    * @pre: None
+    * @post: if a match is found, found points to the Item in the section
+    * @return: bool - true if found, false if not
+    */
+    bool retrieve(const Item &target, Item *&found) const {
+        int depth = 0;
+        return retrieve(target, found, depth);
+    }
+
+    bool retrieve(const Item &target, Item *&found, int &depth) const {
+        depth = 0;
+        if (typeid(target) != typeid(Type)) {
+            return false;
+        }
+        return retrieveAs(static_cast<const Type &>(target), found, depth);
+    }
+
+    /*-------------------------------------------------------------------------
+    * retrieveAs()
+    *
+    * same as retrieve() with depth, with a target already of Type. Looks
+    * in the array, then in the tree of Items inserted since layout().
+    * @pre: None
+    * @post: as retrieve(), depth is the number of Items compared to target
+    * @param: const Type& target - the Item to find
+    * @param: Item*& found - set to the Item found, unchanged if not found
+    * @param: int& depth - set to the number of Items compared
+    * @return: bool - true if found, false if not
+    */
+    bool retrieveAs(const Type &target, Item *&found, int &depth) const {
+        depth = 0;
+        size_t k = find(target, depth);
+        if (k != 0 && !removed[k]) {
+            // one Item per key, another format is not found
+            if (!slots[k].sameFormat(target)) {
+                return false;
+            }
+            found = &slots[k];
+            return true;
+        }
+        int treeDepth = 0;
+        bool result = ValueSection<Type>::retrieveAs(target, found, treeDepth);
+        depth += treeDepth;
+        return result;
+    }
+
+    /*-------------------------------------------------------------------------
+    * insert()
+    *
+    * @pre: data is a Type allocated with new
+    * @post: a copy of data is in the section (if not a duplicate), data is
+    * deleted either way
+    * @param: Item* data - the Item object to be inserted
+    * @return: true if inserted correctly, false if a duplicate
+    */
+    bool insert(Item *data) {
+        int depth = 0;
+        size_t k = find(static_cast<const Type &>(*data), depth);
+        if (k != 0 && !removed[k]) {
+            delete data;
+            return false; // no dupes allowed
+        }
+        return ValueSection<Type>::insert(data);
+    }
+
+    /*-------------------------------------------------------------------------
+    * remove()
+    *
+    * Flags the laid-out Item retrieve() would find for target as removed,
+    * or unlinks it from the tree if it was inserted since layout()
+    * @pre: None (targets of another type are never found)
+    * @post: if a match is found, it is no longer found, displayed or
+    * collected, but stays where it is until layout() or makeEmpty()
+    * @param: const Item& target - the Item to remove
+    * @param: Item*& removedItem - set to the Item removed, unchanged if not
+    * found
+    * @return: bool - true if removed, false if not found
+    */
+    bool remove(const Item &target, Item *&removedItem) {
+        if (typeid(target) != typeid(Type)) {
+            return false;
+        }
+        const Type &key = static_cast<const Type &>(target);
+        int depth = 0;
+        size_t k = find(key, depth);
+        if (k == 0 || removed[k]) {
+            return ValueSection<Type>::remove(target, removedItem);
+        }
+        if (!slots[k].sameFormat(key)) {
+            return false;
+        }
+        this->thaw();
+        removed[k] = true;
+        live--;
+        this->index.remove(slots[k].Type::keyHash(), &slots[k]);
+        removedItem = &slots[k];
+        return true;
+    }
+
+    /*-------------------------------------------------------------------------
+    * isEmpty()
+    *
+    * @pre: section exists
+    * @post: section is unchanged
+    * @return boolean - true if the section holds no Items
+    */
+    bool isEmpty() const {
+        return live == 0 && ValueSection<Type>::isEmpty();
+    }
+
+    /*-------------------------------------------------------------------------
+    * makeEmpty()
+    *
+    * @pre: section exists (empty or not)
+    * @post: every Item is destroyed, the array and every block freed
+    * @param: None
+    */
+    void makeEmpty() {
+        releaseLayout();
+        ValueSection<Type>::makeEmpty();
+    }
+
+    /*-------------------------------------------------------------------------
+    * display()
+    *
+    * @pre: section exists (empty or not)
+    * @post: the header, then every Item in sorted order is printed
+    * @param: None
+    */
+    void display() const {
+        this->displayHeader();
+        vector<Item*> items;
+        collect(items);
+        for (size_t i = 0; i < items.size(); i++) {
+            items[i]->displayItem();
+        }
+    }
+
+    /*-------------------------------------------------------------------------
+    * collect()
+    *
+    * @pre: section exists (empty or not)
+    * @post: every Item is appended to the vector in sorted order, the
+    * laid-out ones merged with the ones inserted since
+    * @param: vector<Item*>& items - the list the Items are appended to
+    */
+    void collect(vector<Item*> &items) const {
+        vector<Item*> added;
+        ValueSection<Type>::collect(added);
+        size_t a = 0;
+        for (size_t k = first(slotCount); k != 0; k = next(k, slotCount)) {
+            if (removed[k]) {
+                continue;
+            }
+            while (a < added.size() && static_cast<const Type &>(*added[a]).compare(slots[k]) < 0) {
+                items.push_back(added[a++]);
+            }
+            items.push_back(&slots[k]);
+        }
+        items.insert(items.end(), added.begin() + a, added.end());
+    }
+
+    /*-------------------------------------------------------------------------
+    * layout()
+    *
+    * Lays every Item out again in one array in Eytzinger order, the ones
+    * inserted since the last layout() included, and drops removed ones
+    * @pre: no pointer to an Item of the section is held outside it (the
+    * Items are copied and the old ones destroyed)
+    * @post: the tree is empty, the array holds every Item, the key index
+    * and filter are rebuilt (a frozen section is thawed)
+    * @param: None
+    */
+    void layout() {
+        vector<Item*> items;
+        collect(items);
+        size_t count = items.size();
+        Type *built = static_cast<Type *>(::operator new(sizeof(Type) * (count + 1)));
+        size_t i = 0;
+        for (size_t k = first(count); k != 0; k = next(k, count)) {
+            new (built + k) Type(static_cast<const Type &>(*items[i++]));
+        }
+        releaseLayout();
+        ValueSection<Type>::makeEmpty();
+        slots = built;
+        slotCount = count;
+        live = count;
+        removed.assign(count + 1, false);
+        for (size_t k = 1; k <= slotCount; k++) {
+            size_t hash = slots[k].Type::keyHash();
+            this->index.insert(hash, &slots[k]);
+            this->filterKey(hash);
+        }
+    }
+
+    /*-------------------------------------------------------------------------
+    * measure()
+    *
+    * @pre: section exists (empty or not)
+    * @post: section is unchanged
+    * @param: Shape& shape - set to the height, depths and memory. Item
+    * bytes include the removed Items still in the array, node bytes the
+    * removed flags; Items inserted since layout() are counted at their
+    * depth in the tree.
+    */
+    void measure(Section::Shape &shape) const {
+        ValueSection<Type>::measure(shape);
+        double depthSum = shape.averageDepth * shape.nodes;
+        for (size_t k = 1; k <= slotCount; k++) {
+            if (removed[k]) {
+                continue;
+            }
+            int depth = levelOf(k);
+            shape.nodes++;
+            depthSum += depth;
+            if (depth > shape.height) {
+                shape.height = depth;
+                shape.depths.resize(depth + 1, 0);
+            }
+            shape.depths[depth]++;
+            shape.stringBytes += slots[k].getStringSize();
+        }
+        shape.itemBytes += static_cast<long>(sizeof(Type) * slotCount);
+        shape.nodeBytes += static_cast<long>(removed.size());
+        if (shape.nodes > 0) {
+            shape.averageDepth = depthSum / shape.nodes;
+        }
+    }
+
+private:
+    Type *slots;            // the Items, in slots 1 to slotCount (0 is unused)
+    size_t slotCount;       // Items laid out, removed ones included
+    size_t live;            // Items laid out and not removed
+    vector<char> removed;   // removed flag of every slot
+
+    // slot holding target's key, 0 if none; depth counts the Items compared
+    size_t find(const Type &target, int &depth) const {
+        size_t k = 1;
+        while (k <= slotCount) {
+            depth++;
+            prefetchGrandchildren(k);
+            int order = slots[k].compare(target);
+            if (order == 0) {
+                return k;
+            }
+            k = 2 * k + (order < 0);
+        }
+        return 0;
+    }
+
+    // asks for the cache lines of slots 4k to 4k + 3, the level after next
+    void prefetchGrandchildren(size_t k) const {
+        size_t grandchild = 4 * k;
+        if (grandchild > slotCount) {
+            return;
+        }
+        size_t last = (grandchild + 3 <= slotCount) ? grandchild + 3 : slotCount;
+        const char *start = reinterpret_cast<const char *>(slots + grandchild);
+        const char *end = reinterpret_cast<const char *>(slots + last + 1);
+        for (const char *line = start; line < end; line += 64) {
+            __builtin_prefetch(line);
+        }
+    }
+
+    // level of slot k, the root (slot 1) is at level 1
+    static int levelOf(size_t k) {
+        return 64 - __builtin_clzll(k);
+    }
+
+    // first slot in sorted order (the leftmost), 0 if there is none
+    static size_t first(size_t count) {
+        if (count == 0) {
+            return 0;
+        }
+        size_t k = 1;
+        while (2 * k <= count) {
+            k = 2 * k;
+        }
+        return k;
+    }
+
+    // slot after k in sorted order, 0 after the last
+    static size_t next(size_t k, size_t count) {
+        if (2 * k + 1 <= count) {
+            // leftmost slot of the right subtree
+            k = 2 * k + 1;
+            while (2 * k <= count) {
+                k = 2 * k;
+            }
+            return k;
+        }
+        // up while k is a right child, then up once more
+        while (k & 1) {
+            k >>= 1;
+        }
+        return k >> 1;
+    }
+
+    // destroys the laid-out Items and frees the array
+    void releaseLayout() {
+        for (size_t k = 1; k <= slotCount; k++) {
+            slots[k].~Type();
+        }
+        ::operator delete(slots);
+        slots = nullptr;
+        slotCount = 0;
+        live = 0;
+        removed.clear();
+    }
+
+    // copying would leave two sections owning the same array
+    EytzingerSection(const EytzingerSection &);
+    EytzingerSection &operator=(const EytzingerSection &);
+};
+
+#endif //EYTZINGERSECTION_H
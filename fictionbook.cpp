@@ -53,6 +53,46 @@ FictionBook* FictionBook::create() const {
     return new FictionBook();
 }
 
+/*-------------------------------------------------------------------------
+* getObjectSize()
+* 
+* Inherited from Item - size of a FictionBook object
+* @pre: FictionBook object exists
+* @post: FictionBook is unchanged
+* @param: None 
+* @return: int - bytes of the object
+*/
+int FictionBook::getObjectSize() const {
+    return sizeof(FictionBook);
+}
+
+/*-------------------------------------------------------------------------
+* getStringSize()
+* 
+* Inherited from Item - heap memory held by the title and author
+* @pre: FictionBook object exists
+* @post: FictionBook is unchanged
+* @param: None 
+* @return: int - bytes allocated for strings
+*/
+int FictionBook::getStringSize() const {
+    return Item::getStringSize() + heapSize(author);
+}
+
+/*-------------------------------------------------------------------------
+* poolStrings()
+* 
+* Inherited from Item - pools the title and author, if too long to be
+* kept in place
+* @pre: FictionBook object exists
+* @post: the long fields are shared with the other Items holding them
+* @param: None 
+*/
+void FictionBook::poolStrings() {
+    Item::poolStrings();
+    author.pool();
+}
+
 /*-------------------------------------------------------------------------
 * setData(ifstream&)
 * 
@@ -76,7 +116,7 @@ void FictionBook::setData(ifstream& infile) {
 }
 
 /*-------------------------------------------------------------------------
-* setTransactionData(ifstream&)
+* setTransactionData(istream&)
 * 
 * Inherited from Item - Sets the data of the current FictionBook to the data
 * that is fed in from the command data file. Only differs from setData due to 
@@ -84,9 +124,9 @@ void FictionBook::setData(ifstream& infile) {
 * @pre: FictionBook object exists 
 * @post: the current FictionBook object's members are set to the current
 * line of the command ifstream data.
-* @param: ifstream& infile - a file stream allowing processing of file data
+* @param: istream& infile - a stream (command file or log) allowing processing of data
 */
-void FictionBook::setTransactionData(ifstream &infile) {
+void FictionBook::setTransactionData(istream &infile) {
     infile.get();                
 
     getline(infile, author, ','); 
@@ -96,6 +136,20 @@ void FictionBook::setTransactionData(ifstream &infile) {
     getline(infile, title, ',');
 }
 
+/*-------------------------------------------------------------------------
+* writeTransactionData(ostream&)
+* 
+* Inherited from Item - writes the FictionBook's identifying data in the 
+* command file layout (author, title), so setTransactionData() can 
+* read it back
+* @pre: FictionBook object exists
+* @post: FictionBook is unchanged
+* @param: ostream& out - stream the data is written to
+*/
+void FictionBook::writeTransactionData(ostream& out) const {
+    out << ' ' << author << ", " << title << ',';
+}
+
 /*-------------------------------------------------------------------------
 * displayItem() 
 * 
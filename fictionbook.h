@@ -16,6 +16,8 @@
 //
 // Assumptions/implementation: 
 // -- Contains an author 
+//    (an InlineString, like the title: in place up to ITEM_AUTHOR_BYTES - 1
+//    characters, on the heap beyond, pooled once a section holds the book)
 // -- Data that is passed to setData and setTransactionData is correctly
 //    formatted for a fiction book.
 // -- stock is automatically set to 5 whenever a new FictionBook is 
@@ -64,6 +66,39 @@ class FictionBook : public Book  {
     */
     FictionBook* create() const; 
 
+    /*-------------------------------------------------------------------------
+    * getObjectSize()
+    * 
+    * Inherited from Item - size of a FictionBook object
+    * @pre: FictionBook object exists
+    * @post: FictionBook is unchanged
+    * @param: None 
+    * @return: int - bytes of the object
+    */
+    int getObjectSize() const;
+
+    /*-------------------------------------------------------------------------
+    * getStringSize()
+    * 
+    * Inherited from Item - heap memory held by the title and author
+    * @pre: FictionBook object exists
+    * @post: FictionBook is unchanged
+    * @param: None 
+    * @return: int - bytes allocated for strings
+    */
+    int getStringSize() const;
+
+    /*-------------------------------------------------------------------------
+    * poolStrings()
+    * 
+    * Inherited from Item - pools the title and author, if too long to be
+    * kept in place
+    * @pre: FictionBook object exists
+    * @post: the long fields are shared with the other Items holding them
+    * @param: None 
+    */
+    void poolStrings();
+
     /*-------------------------------------------------------------------------
     * setData(ifstream&)
     * 
@@ -77,7 +112,7 @@ class FictionBook : public Book  {
     void setData(ifstream&);
 
     /*-------------------------------------------------------------------------
-    * setTransactionData(ifstream&)
+    * setTransactionData(istream&)
     * 
     * Inherited from Item - Sets the data of the current FictionBook to the data
     * that is fed in from the command data file. Only differs from setData due to 
@@ -85,9 +120,21 @@ class FictionBook : public Book  {
     * @pre: FictionBook object exists 
     * @post: the current FictionBook object's members are set to the current
     * line of the command ifstream data.
-    * @param: ifstream& infile - a file stream allowing processing of file data
+    * @param: istream& infile - a stream (command file or log) allowing processing of data
+    */
+    void setTransactionData(istream&);
+
+    /*-------------------------------------------------------------------------
+    * writeTransactionData(ostream&)
+    * 
+    * Inherited from Item - writes the FictionBook's identifying data in the 
+    * command file layout (author, title), so setTransactionData() can 
+    * read it back
+    * @pre: FictionBook object exists
+    * @post: FictionBook is unchanged
+    * @param: ostream& out - stream the data is written to
     */
-    void setTransactionData(ifstream&);
+    void writeTransactionData(ostream&) const;
 
     /*-------------------------------------------------------------------------
     * displayItem() 
@@ -151,8 +198,62 @@ class FictionBook : public Book  {
     * Compares by author then title
     */
     virtual bool operator>(const Item&) const;
+
+    /*-------------------------------------------------------------------------
+    * compare(const FictionBook&)
+    * 
+    * Non-virtual three way comparison, by author then title, for code that
+    * knows the type at compile time (BinarySearchTree::retrieveAs and
+    * insertAs). Orders like operator< and operator>, without copying.
+    * @pre: None
+    * @post: FictionBook is unchanged
+    * @param: const FictionBook& - the book compared to
+    * @return: int - negative, 0 or positive as this book sorts before, with
+    * or after the other one
+    */
+    int compare(const FictionBook& other) const {
+        int order = author.compare(other.author);
+        return (order != 0) ? order : title.compare(other.title);
+    }
+
+    /*-------------------------------------------------------------------------
+    * keyHash()
+    * 
+    * Inherited from Item - hashes the key compare() orders by (author then title).
+    * Also called non-virtually by KeyIndex::findAs.
+    * @pre: None
+    * @post: FictionBook is unchanged
+    * @param: None
+    * @return: size_t - hash of the key
+    */
+    size_t keyHash() const {
+        size_t hash = author.hash();
+        return combineHash(hash, title.hash());
+    }
+
+    /*-------------------------------------------------------------------------
+    * appendSortKey(string&)
+    * 
+    * Non-virtual, appends the key compare() orders by as bytes (author, a 0
+    * byte, then title), so that comparing the bytes of two keys orders their
+    * books like compare(). Used for the front coded keys of LsmSection runs.
+    * @pre: None
+    * @post: FictionBook is unchanged
+    * @param: string& - the key is appended to it
+    */
+    void appendSortKey(string& key) const {
+        key.append(author.data(), author.size());
+        key.push_back('\0');
+        key.append(title.data(), title.size());
+    }
+
+    // registration in the MediaTypes list: letter of the type in data and
+    // command files, and name and column headings of its section
+    static const char TYPE = 'F';
+    static const char* sectionName() { return "FICTION BOOKS"; }
+    static const char* sectionColumns() { return "AVAIL,TITLE,AUTHOR,YEAR"; }
     
   private:
-    string author; // name of book's author
+    InlineString<ITEM_AUTHOR_BYTES> author; // name of book's author
   };
 #endif //FICTIONBOOK_H
\ No newline at end of file
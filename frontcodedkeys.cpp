@@ -0,0 +1,202 @@
+/*---------------------------------------------------------------------------
+* @file: frontcodedkeys.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: implementation of the FrontCodedKeys class
+---------------------------------------------------------------------------*/
+#include "frontcodedkeys.h"
+#include "constants.h"
+#include <cstring>
+
+using namespace std;
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* @pre: None
+* @post: empty list exists
+* @param: None
+*/
+FrontCodedKeys::FrontCodedKeys() {
+    count = 0;
+    keyBytes = 0;
+}
+
+/*-------------------------------------------------------------------------
+* add(const string&)
+*
+* @pre: key sorts after every key added before it
+* @post: key is the last key of the list, its rank is size() - 1
+* @param: const string& - the key
+*/
+void FrontCodedKeys::add(const string& key) {
+    if (count % FRONT_CODING_BLOCK_KEYS == 0) {
+        heads.push_back(bytes.size());
+        putLength(key.size());
+        bytes.insert(bytes.end(), key.begin(), key.end());
+    } else {
+        size_t shared = 0;
+        while (shared < key.size() && shared < last.size() && key[shared] == last[shared]) {
+            shared++;
+        }
+        putLength(shared);
+        putLength(key.size() - shared);
+        bytes.insert(bytes.end(), key.begin() + shared, key.end());
+    }
+    last = key;
+    count++;
+    keyBytes += key.size();
+}
+
+/*-------------------------------------------------------------------------
+* find(const string&, int&)
+*
+* @pre: None
+* @post: list is unchanged
+* @param: const string& - the key to find
+* @param: int& - incremented by the keys compared (block heads, then
+* keys scanned in the block)
+* @return: long - rank of the key, -1 if it is not in the list
+*/
+long FrontCodedKeys::find(const string& key, int& compared) const {
+    // the last block whose head is not after key
+    size_t low = 0;
+    size_t high = heads.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        compared++;
+        if (compareHead(middle, key) <= 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low == 0) {
+        return -1;
+    }
+    size_t block = low - 1;
+    const unsigned char* at = &bytes[heads[block]];
+    const unsigned char* end = (block + 1 < heads.size()) ? &bytes[heads[block + 1]]
+                                                          : bytes.data() + bytes.size();
+    size_t length = getLength(at);
+    // matched: bytes the current key has in common with key, which sorts
+    // after it (the head is not after key)
+    size_t matched = 0;
+    while (matched < length && matched < key.size() && at[matched] == (unsigned char)key[matched]) {
+        matched++;
+    }
+    long rank = block * FRONT_CODING_BLOCK_KEYS;
+    if (matched == length && matched == key.size()) {
+        return rank;
+    }
+    at += length;
+    while (at < end) {
+        rank++;
+        compared++;
+        size_t shared = getLength(at);
+        size_t suffix = getLength(at);
+        const unsigned char* rest = at;
+        at += suffix;
+        if (shared < matched) {
+            // differs from the key before where that one still matched, and
+            // is bigger there: after key, so key isn't in the list
+            return -1;
+        }
+        if (shared > matched) {
+            continue; // same as the key before where it was smaller than key
+        }
+        size_t m = 0;
+        while (m < suffix && matched + m < key.size() && rest[m] == (unsigned char)key[matched + m]) {
+            m++;
+        }
+        if (matched + m == key.size()) {
+            // key ends here: the same key, or a prefix of (so before) this one
+            return (m == suffix) ? rank : -1;
+        }
+        if (m < suffix && rest[m] > (unsigned char)key[matched + m]) {
+            return -1;
+        }
+        matched += m;
+    }
+    return -1;
+}
+
+/*-------------------------------------------------------------------------
+* keyAt(size_t, string&)
+*
+* @pre: rank < size()
+* @post: list is unchanged
+* @param: size_t - rank of a key
+* @param: string& - set to the key
+*/
+void FrontCodedKeys::keyAt(size_t rank, string& key) const {
+    const unsigned char* at = &bytes[heads[rank / FRONT_CODING_BLOCK_KEYS]];
+    size_t length = getLength(at);
+    key.assign(reinterpret_cast<const char*>(at), length);
+    at += length;
+    for (size_t i = rank % FRONT_CODING_BLOCK_KEYS; i > 0; i--) {
+        size_t shared = getLength(at);
+        size_t suffix = getLength(at);
+        key.resize(shared);
+        key.append(reinterpret_cast<const char*>(at), suffix);
+        at += suffix;
+    }
+}
+
+/*-------------------------------------------------------------------------
+* clear()
+*
+* @pre: None
+* @post: list is empty and its memory freed
+* @param: None
+*/
+void FrontCodedKeys::clear() {
+    vector<unsigned char>().swap(bytes);
+    vector<size_t>().swap(heads);
+    string().swap(last);
+    count = 0;
+    keyBytes = 0;
+}
+
+/*-------------------------------------------------------------------------
+* getBytes()
+*
+* @pre: None
+* @post: list is unchanged
+* @return: long - memory of the coded keys and the block offsets
+*/
+long FrontCodedKeys::getBytes() const {
+    return static_cast<long>(bytes.capacity() + heads.capacity() * sizeof(size_t));
+}
+
+// appends a varint
+void FrontCodedKeys::putLength(size_t length) {
+    while (length >= 0x80) {
+        bytes.push_back(static_cast<unsigned char>(length | 0x80));
+        length >>= 7;
+    }
+    bytes.push_back(static_cast<unsigned char>(length));
+}
+
+// reads the varint at at, and moves at past it
+size_t FrontCodedKeys::getLength(const unsigned char*& at) {
+    size_t length = 0;
+    int shift = 0;
+    while (*at & 0x80) {
+        length |= static_cast<size_t>(*at++ & 0x7f) << shift;
+        shift += 7;
+    }
+    length |= static_cast<size_t>(*at++) << shift;
+    return length;
+}
+
+// compares block b's head with key: negative, 0 or positive
+int FrontCodedKeys::compareHead(size_t block, const string& key) const {
+    const unsigned char* at = &bytes[heads[block]];
+    size_t length = getLength(at);
+    size_t common = (length < key.size()) ? length : key.size();
+    int order = memcmp(at, key.data(), common);
+    if (order != 0) {
+        return order;
+    }
+    return (length < key.size()) ? -1 : (length > key.size()) ? 1 : 0;
+}
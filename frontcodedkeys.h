@@ -0,0 +1,135 @@
+/*---------------------------------------------------------------------------
+* @file: frontcodedkeys.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the FrontCodedKeys class
+---------------------------------------------------------------------------*/
+// FrontCodedKeys Class: Sorted list of keys stored with front coding, in
+// which every key only keeps what differs from the key before it. Sorted
+// sections have long shared prefixes (FICTION is sorted by author, so an
+// author's name starts every one of their books), which front coding
+// mostly stores once.
+//---------------------------------------------------------------------------
+// Features:
+// -- Keys are in blocks of FRONT_CODING_BLOCK_KEYS. The first key of a
+//    block (its head) is stored whole, so a lookup can halve over the
+//    heads without decoding anything; every other key is stored as the
+//    length it shares with the key before it, then the rest of it.
+// -- Inside its block, a lookup scans the keys in order and compares
+//    only the bytes past the prefix it already knows matches, so no key
+//    is rebuilt on the way.
+// -- Keys are found by rank (their position in the list), and a rank is
+//    turned back into its key with keyAt().
+//
+// Assumptions/implementation:
+// -- Keys are added in increasing order (as unsigned bytes, the order of
+//    string::compare) and are all different; the list is not changed
+//    afterwards, only cleared.
+// -- Lengths are stored as varints (7 bits a byte), so short keys and
+//    suffixes cost one byte of length.
+//---------------------------------------------------------------------------
+#ifndef FRONTCODEDKEYS_H
+#define FRONTCODEDKEYS_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+class FrontCodedKeys {
+  public:
+    /*-------------------------------------------------------------------------
+    * Constructor
+    *
+    * @pre: None
+    * @post: empty list exists
+    * @param: None
+    */
+    FrontCodedKeys();
+
+    /*-------------------------------------------------------------------------
+    * add(const string&)
+    *
+    * @pre: key sorts after every key added before it
+    * @post: key is the last key of the list, its rank is size() - 1
+    * @param: const string& - the key
+    */
+    void add(const string&);
+
+    /*-------------------------------------------------------------------------
+    * find(const string&, int&)
+    *
+    * @pre: None
+    * @post: list is unchanged
+    * @param: const string& - the key to find
+    * @param: int& - incremented by the keys compared (block heads, then
+    * keys scanned in the block)
+    * @return: long - rank of the key, -1 if it is not in the list
+    */
+    long find(const string&, int&) const;
+
+    /*-------------------------------------------------------------------------
+    * keyAt(size_t, string&)
+    *
+    * @pre: rank < size()
+    * @post: list is unchanged
+    * @param: size_t - rank of a key
+    * @param: string& - set to the key
+    */
+    void keyAt(size_t, string&) const;
+
+    /*-------------------------------------------------------------------------
+    * size()
+    *
+    * @pre: None
+    * @post: list is unchanged
+    * @return: size_t - number of keys
+    */
+    size_t size() const { return count; }
+
+    /*-------------------------------------------------------------------------
+    * clear()
+    *
+    * @pre: None
+    * @post: list is empty and its memory freed
+    * @param: None
+    */
+    void clear();
+
+    /*-------------------------------------------------------------------------
+    * getBytes()
+    *
+    * @pre: None
+    * @post: list is unchanged
+    * @return: long - memory of the coded keys and the block offsets
+    */
+    long getBytes() const;
+
+    /*-------------------------------------------------------------------------
+    * getKeyBytes()
+    *
+    * @pre: None
+    * @post: list is unchanged
+    * @return: long - total length of the keys added, as they would be
+    * stored without front coding
+    */
+    long getKeyBytes() const { return keyBytes; }
+
+  private:
+    vector<unsigned char> bytes; // every block, one after the other
+    vector<size_t> heads;        // offset of every block in bytes
+    string last;                 // last key added (its prefix is shared)
+    size_t count;                // keys added
+    long keyBytes;               // total length of the keys added
+
+    // appends a varint
+    void putLength(size_t length);
+
+    // reads the varint at at, and moves at past it
+    static size_t getLength(const unsigned char*& at);
+
+    // compares block b's head with key: negative, 0 or positive
+    int compareHead(size_t block, const string& key) const;
+};
+
+#endif //FRONTCODEDKEYS_H
@@ -50,14 +50,16 @@ HashTable::~HashTable() {
 /*-------------------------------------------------------------------------
 * hashFunc(int)
 *
-* Returns the hash value based on the integer passed. 
+* Returns the hash value based on the integer passed. Negative IDs (not
+* valid, but they can be typed into a command) still map into the table.
 * @pre: integer passed to function represents possible IDs of patrons 
 * @post: index of passed patronID in the hashtable 
 * @param: int - patronID we're using to identify a Patron object
 * @return: int - index given by hashing the passed patronID
 */
-int HashTable::hashFunc(int ID) {
-    return ID % TABLE_SIZE;
+int HashTable::hashFunc(int ID) const {
+    int index = ID % TABLE_SIZE;
+    return (index < 0) ? index + TABLE_SIZE : index;
 }
 
 /*-------------------------------------------------------------------------
@@ -114,18 +116,84 @@ void HashTable::insert(int ID, Patron* patron) {
 * @param: int - patronID of the Patron object to be retrieved
 * @param: Patron*& - Reference to the location of the patron in 
 * the hashTable[], if not found: reference will be nullptr 
+* @return: int - entries of the chain that were visited
 */
-void HashTable::retrieve(int ID, Patron*& retrieved) {
+int HashTable::retrieve(int ID, Patron*& retrieved) {
     int index = hashFunc(ID);
     HashTableEntry* curr = hashTable[index];
+    int visited = 0;
     // loop through list at index until we reach end or find matching ID
     while (curr != nullptr) {
+        visited++;
         if (curr->ID == ID) {
             retrieved = curr->patron;
-            return;
+            return visited;
         }
         curr = curr->next;
     }
-    return;
+    return visited;
 }
 
+
+
+/*-------------------------------------------------------------------------
+* prefetch(int)
+*
+* Hints the CPU to start loading the first entry of the chain for
+* the given ID, so a retrieve() issued a little later doesn't stall on
+* memory. Purely a performance hint.
+* @pre: hashTable[] is initialized
+* @post: HashTable is unchanged
+* @param: int - patronID that will be retrieved soon
+*/
+void HashTable::prefetch(int ID) const {
+    __builtin_prefetch(hashTable[hashFunc(ID)]);
+}
+
+/*-------------------------------------------------------------------------
+* collect(vector<Patron*>&)
+*
+* Appends every Patron in the table to the given list, index by index and
+* in chain order within an index. The table still owns the Patrons.
+* @pre: hashTable[] is initialized
+* @post: HashTable is unchanged, list holds every Patron in the table
+* @param: vector<Patron*>& - the list the Patrons are appended to
+*/
+void HashTable::collect(vector<Patron*>& list) const {
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        HashTableEntry* curr = hashTable[i];
+        while (curr != nullptr) {
+            list.push_back(curr->patron);
+            curr = curr->next;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------
+* measure(Shape&)
+*
+* Walks every chain of the table to find its load and chain lengths
+* @pre: hashTable[] is initialized
+* @post: HashTable is unchanged
+* @param: Shape& - set to the load, chain lengths and memory of the table
+*/
+void HashTable::measure(Shape& shape) const {
+    shape.buckets = TABLE_SIZE;
+    shape.entries = 0;
+    shape.longestChain = 0;
+    shape.chains.assign(1, 0);
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        int length = 0;
+        for (HashTableEntry* curr = hashTable[i]; curr != nullptr; curr = curr->next) {
+            length++;
+        }
+        if (length > shape.longestChain) {
+            shape.longestChain = length;
+            shape.chains.resize(length + 1, 0);
+        }
+        shape.chains[length]++;
+        shape.entries += length;
+    }
+    shape.loadFactor = static_cast<double>(shape.entries) / TABLE_SIZE;
+    shape.bytes = sizeof(hashTable) + static_cast<long>(shape.entries) * sizeof(HashTableEntry);
+}
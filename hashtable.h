@@ -9,6 +9,7 @@
 #include <cstdlib>
 #include <string>
 #include <cstdio>
+#include <vector>
 #include "patron.h"
 #include "constants.h"
 using namespace std;
@@ -112,13 +113,14 @@ class HashTable {
     /*-------------------------------------------------------------------------
     * hashFunc(int)
     *
-    * Returns the hash value based on the integer passed. 
+    * Returns the hash value based on the integer passed. Negative IDs (not
+    * valid, but they can be typed into a command) still map into the table.
     * @pre: integer passed to function represents possible IDs of patrons 
     * @post: index of passed patronID in the hashtable 
     * @param: int - patronID we're using to identify a Patron object
     * @return: int - index given by hashing the passed patronID
     */
-    int hashFunc(int);         
+    int hashFunc(int) const;         
 
     /*-------------------------------------------------------------------------
     * insert(int, Patron*)
@@ -144,6 +146,50 @@ class HashTable {
     * @param: int - patronID of the Patron object to be retrieved
     * @param: Patron*& - Reference to the location of the patron in 
     * the hashTable[], if not found: reference will be nullptr 
+    * @return: int - entries of the chain that were visited
     */
-    void retrieve(int, Patron*&); 
+    int retrieve(int, Patron*&); 
+
+    /*-------------------------------------------------------------------------
+    * prefetch(int)
+    *
+    * Hints the CPU to start loading the first entry of the chain for
+    * the given ID, so a retrieve() issued a little later doesn't stall on
+    * memory. Purely a performance hint.
+    * @pre: hashTable[] is initialized
+    * @post: HashTable is unchanged
+    * @param: int - patronID that will be retrieved soon
+    */
+    void prefetch(int) const;
+
+    /*-------------------------------------------------------------------------
+    * collect(vector<Patron*>&)
+    *
+    * Appends every Patron in the table to the given list, index by index and
+    * in chain order within an index. The table still owns the Patrons.
+    * @pre: hashTable[] is initialized
+    * @post: HashTable is unchanged, list holds every Patron in the table
+    * @param: vector<Patron*>& - the list the Patrons are appended to
+    */
+    void collect(vector<Patron*>&) const;
+
+    // shape and memory of the table, as measured by measure()
+    struct Shape {
+        int buckets;           // size of hashTable[]
+        int entries;           // Patrons in the table
+        double loadFactor;     // entries per bucket
+        int longestChain;      // entries in the longest chain
+        long bytes;            // memory of hashTable[] and the entries
+        vector<int> chains;    // buckets per chain length, from length 0
+    };
+
+    /*-------------------------------------------------------------------------
+    * measure(Shape&)
+    *
+    * Walks every chain of the table to find its load and chain lengths
+    * @pre: hashTable[] is initialized
+    * @post: HashTable is unchanged
+    * @param: Shape& - set to the load, chain lengths and memory of the table
+    */
+    void measure(Shape&) const;
 };
\ No newline at end of file
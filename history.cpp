@@ -17,7 +17,8 @@
 * @param: None
 */
 History::History() : Transaction() {
-    
+    patronID = 0;
+    patron = nullptr;
 }
 
 /*-------------------------------------------------------------------------
@@ -48,32 +49,75 @@ History* History::create() const {
 }
 
 /*-------------------------------------------------------------------------
-* execute(Library&, ifstream&)
+* load(const Command&)
+*
+* Stores the patronID whose history should be displayed.
+* @pre: command.type is H
+* @post: patronID is stored
+* @param: const Command& - the parsed command
+*/
+void History::load(const Command& command) {
+    patronID = command.patronID;
+}
+
+/*-------------------------------------------------------------------------
+* getPatronID()
 *
-* Executes the History command: Displays a Patron's recorded transaction 
-* history.
+* Returns the patron ID loaded by load(), used for prefetching
+* @pre: load() has been called
+* @post: History is unchanged
+* @return: int - the patron ID of this command
+*/
+int History::getPatronID() const {
+    return patronID;
+}
+
+/*-------------------------------------------------------------------------
+* findPatron(Library&)
+*
+* Looks up the patron whose history should be displayed.
+* @pre: load() has been called
+* @post: patron is set, or nullptr if the ID is invalid
+* @param: Library& - the library the patron is looked up in
+*/
+void History::findPatron(Library& currLibrary) {
+    patron = nullptr;
+    currLibrary.retrievePatron(patronID, patron);
+}
+
+/*-------------------------------------------------------------------------
+* findItem(Library&)
+*
+* A history has no item, nothing is looked up.
+* @pre: None
+* @post: Nothing is changed
+* @param: Library& - unused
+*/
+void History::findItem(Library&) {
+    // nothing to look up
+}
+
+/*-------------------------------------------------------------------------
+* apply(Library&)
+*
+* Displays the patron's recorded transaction history, or an error if
+* the patronID is invalid.
+* @pre: earlier commands have been applied
 * @post: Transaction data for a Patron is printed in a formatted manner.
-* @param: ifstream& - the ifstream providing data for commands (1 per line),
-* in this case marked by an H, followed by a 4 digit number for patronID. 
-* @return: returns a bool marking whether or not to save this History
-* to patron history. Always returns false, as there is no information to 
-* save or print in the future related to this History object.
+* @param: Library& - the library an invalid patron ID is reported to, the
+* patron was found by findPatron()
+* @return: always false, there is no information to save for a History
 */
-bool History::execute(Library& currLibrary, ifstream& infile) {
-    int patronID;
-    infile >> patronID; 
-    Patron* potentialPatron = nullptr;
-    currLibrary.retrievePatron(patronID, potentialPatron);
-    if (potentialPatron){
-        potentialPatron->displayHistory();
+bool History::apply(Library& currLibrary) {
+    if (patron){
+        patron->displayHistory();
     }else{
         cout << endl;
         cout << "Cannot print history for invalid Patron ID: " << patronID << endl;
+        currLibrary.getStatistics().error(CommandStats::INVALID_PATRON);
     }
     return false;
-} 
-
-
+}
 
 /*-------------------------------------------------------------------------
 * display() 
@@ -89,4 +133,32 @@ bool History::execute(Library& currLibrary, ifstream& infile) {
 */
 void History::display() const {
     // nothing to display, not saved as part of a patron's transaction list
+}
+
+/*-------------------------------------------------------------------------
+* replay(Patron*, char, Item*, int&)
+*
+* A History never changes the library, so it is never logged and there
+* is nothing to redo.
+* @pre: Nothing
+* @post: Nothing is changed
+* @param: Patron*, char, Item* - unused
+* @param: int& - set to 0, a History never changes stock
+* @return: always false, a History is never saved to patron history
+*/
+bool History::replay(Patron*, char, Item*, int& stockChange) {
+    stockChange = 0;
+    return false;
+}
+
+/*-------------------------------------------------------------------------
+* save(ostream&)
+*
+* Never called, a History is not saved to any patron history.
+* @pre: Nothing
+* @post: Nothing is written
+* @param: ostream& - the stream the record is written to
+*/
+void History::save(ostream&) const {
+    // nothing to save, not part of a patron's transaction list
 }
\ No newline at end of file
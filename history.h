@@ -11,8 +11,8 @@
 // -- Displays a Patron's history of transactions at a Library.
 //
 // Assumptions/implementation:
-// -- Calling execute(Library&, ifstream&) won't be done with uninitialized 
-//    objects. 
+// -- Calling execute(Library&, const Command&) (or its stages) won't be
+//    done with uninitialized objects. 
 // -- The patron's history can be empty or contain Transactions. 
 // -- Library is accessed and passed by reference to history so that 
 //    the list of patrons and their associated transactions can be accessed. 
@@ -56,19 +56,61 @@ class History : public Transaction {
         */
         virtual History* create() const; 
 
+        // letter of the command, for its registration in TransactionTypes
+        static const char TYPE = 'H';
+
+        /*-------------------------------------------------------------------------
+        * load(const Command&)
+        *
+        * Stores the patronID whose history should be displayed.
+        * @pre: command.type is H
+        * @post: patronID is stored
+        * @param: const Command& - the parsed command
+        */
+        virtual void load(const Command&);
+
+        /*-------------------------------------------------------------------------
+        * getPatronID()
+        *
+        * Returns the patron ID loaded by load(), used for prefetching
+        * @pre: load() has been called
+        * @post: History is unchanged
+        * @return: int - the patron ID of this command
+        */
+        virtual int getPatronID() const;
+
         /*-------------------------------------------------------------------------
-        * execute(Library&, ifstream&)
+        * findPatron(Library&)
         *
-        * Executes the History command: Displays a Patron's recorded transaction 
-        * history.
+        * Looks up the patron whose history should be displayed.
+        * @pre: load() has been called
+        * @post: patron is set, or nullptr if the ID is invalid
+        * @param: Library& - the library the patron is looked up in
+        */
+        virtual void findPatron(Library&);
+
+        /*-------------------------------------------------------------------------
+        * findItem(Library&)
+        *
+        * A history has no item, nothing is looked up.
+        * @pre: None
+        * @post: Nothing is changed
+        * @param: Library& - unused
+        */
+        virtual void findItem(Library&);
+
+        /*-------------------------------------------------------------------------
+        * apply(Library&)
+        *
+        * Displays the patron's recorded transaction history, or an error if
+        * the patronID is invalid.
+        * @pre: earlier commands have been applied
         * @post: Transaction data for a Patron is printed in a formatted manner.
-        * @param: ifstream& - the ifstream providing data for commands (1 per line),
-        * in this case marked by an H, followed by a 4 digit number for patronID. 
-        * @return: returns a bool marking whether or not to save this History
-        * to patron history. Always returns false, as there is no information to 
-        * save or print in the future related to this History object.
+        * @param: Library& - the library an invalid patron ID is reported to, the
+        * patron was found by findPatron()
+        * @return: always false, there is no information to save for a History
         */
-        virtual bool execute(Library&, ifstream&);
+        virtual bool apply(Library&);
 
         /*-------------------------------------------------------------------------
         * display() 
@@ -83,8 +125,32 @@ class History : public Transaction {
         * @param: None
         */
         virtual void display() const;
+
+        /*-------------------------------------------------------------------------
+        * replay(Patron*, char, Item*, int&)
+        *
+        * A History never changes the library, so it is never logged and there
+        * is nothing to redo.
+        * @pre: Nothing
+        * @post: Nothing is changed
+        * @param: Patron*, char, Item* - unused
+        * @param: int& - set to 0, a History never changes stock
+        * @return: always false, a History is never saved to patron history
+        */
+        virtual bool replay(Patron*, char, Item*, int&);
+
+        /*-------------------------------------------------------------------------
+        * save(ostream&)
+        *
+        * Never called, a History is not saved to any patron history.
+        * @pre: Nothing
+        * @post: Nothing is written
+        * @param: ostream& - the stream the record is written to
+        */
+        virtual void save(ostream&) const;
   private:
-    int patronID;
+    int patronID;      // ID of the patron whose history is displayed
+    Patron* patron;    // patron found by findPatron(), nullptr if invalid
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,331 @@
+/*---------------------------------------------------------------------------
+* @file: inlinestring.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file (and template implementation) of the InlineString
+* class
+*/
+//---------------------------------------------------------------------------
+// InlineString Class: String field of an Item (title, author) that keeps
+// its characters inside the Item. A std::string only does that up to 15
+// characters and allocates for anything longer, which is most titles; an
+// InlineString holds up to Capacity - 1 characters in place, so an Item
+// is one record with nothing on the heap.
+// --------------------------------------------------------------------------
+// Features:
+//  -- Exactly Capacity bytes, with no alignment of their own: the
+//     characters, then one byte of length.
+//  -- Longer values (rare: display only shows TITLE_WIDTH - 1 and
+//     MONTH_AUTHOR_WIDTH - 1 characters anyway) are kept whole on the heap,
+//     owned by the field, and the field holds a pointer to them. pool()
+//     moves such a value to the StringPool, once the Item is in a section:
+//     the probes built for every command never reach the pool.
+//  -- The parts of std::string the Items use: assignment, getline(),
+//     comparisons, substr(), output, and a hash equal to std::hash of the
+//     same string.
+//  -- Copies share a pooled value and copy an owned one.
+//
+// Assumptions/implementation:
+// -- Capacity is at most 254 (the length is one byte, two values of it
+//    mark a value on the heap) and at least 9 (the pointer to a value on
+//    the heap takes the place of the characters).
+// -- A template, so everything is defined in this header.
+//---------------------------------------------------------------------------
+#ifndef INLINESTRING_H
+#define INLINESTRING_H
+
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <functional>
+#include "stringpool.h"
+
+using namespace std;
+
+template <size_t Capacity>
+class InlineString {
+    static_assert(Capacity >= sizeof(const string*) + 1 && Capacity <= 254,
+                  "InlineString capacity must hold a pointer and fit its length in a byte");
+
+public:
+    /*-------------------------------------------------------------------------
+    * InlineString Constructor
+    *
+    * @pre: None
+    * @post: empty string exists
+    */
+    InlineString() {
+        length = 0;
+    }
+
+    /*-------------------------------------------------------------------------
+    * InlineString Copy Constructor
+    *
+    * @pre: None
+    * @post: the string holds the other one's value (an owned value is
+    * copied, a pooled one shared)
+    * @param: const InlineString& other - the string copied
+    */
+    InlineString(const InlineString &other) {
+        copy(other);
+    }
+
+    /*-------------------------------------------------------------------------
+    * InlineString Destructor
+    *
+    * @pre: None
+    * @post: an owned value is freed (a pooled one stays in the pool)
+    */
+    ~InlineString() {
+        release();
+    }
+
+    /*-------------------------------------------------------------------------
+    * operator=(const InlineString&)
+    *
+    * @pre: None
+    * @post: the string holds the other one's value, as copied above
+    * @param: const InlineString& other - the string copied
+    * @return: InlineString& - this string
+    */
+    InlineString &operator=(const InlineString &other) {
+        if (this != &other) {
+            release();
+            copy(other);
+        }
+        return *this;
+    }
+
+    /*-------------------------------------------------------------------------
+    * operator=
+    *
+    * @pre: None
+    * @post: the string holds a copy of value (in place if it fits, on the
+    * heap otherwise)
+    * @param: const string& or const char* - the new value
+    * @return: InlineString& - this string
+    */
+    InlineString &operator=(const string &value) {
+        assign(value.data(), value.size());
+        return *this;
+    }
+
+    InlineString &operator=(const char *value) {
+        assign(value, strlen(value));
+        return *this;
+    }
+
+    /*-------------------------------------------------------------------------
+    * assign(const char*, size_t)
+    *
+    * @pre: None
+    * @post: the string holds a copy of the characters
+    * @param: const char* text - the characters
+    * @param: size_t size - how many
+    */
+    void assign(const char *text, size_t size) {
+        release();
+        if (size < Capacity) {
+            memcpy(characters, text, size);
+            length = static_cast<unsigned char>(size);
+        } else {
+            point(new string(text, size), OWNED);
+        }
+    }
+
+    /*-------------------------------------------------------------------------
+    * pool()
+    *
+    * Moves a value kept on the heap to the StringPool, where every field
+    * holding it shares one copy that lasts as long as the program
+    * @pre: None
+    * @post: an owned value is pooled (and its own copy freed), anything
+    * else is unchanged
+    */
+    void pool() {
+        if (length != OWNED) {
+            return;
+        }
+        const string *owned = onHeap();
+        const string *copy = StringPool::intern(owned->data(), owned->size());
+        delete owned;
+        point(copy, POOLED);
+    }
+
+    /*-------------------------------------------------------------------------
+    * size()
+    *
+    * @pre: None
+    * @post: string is unchanged
+    * @return: size_t - number of characters
+    */
+    size_t size() const {
+        return (length >= OWNED) ? onHeap()->size() : length;
+    }
+
+    /*-------------------------------------------------------------------------
+    * data()
+    *
+    * @pre: None
+    * @post: string is unchanged
+    * @return: const char* - the characters, not 0 terminated
+    */
+    const char *data() const {
+        return (length >= OWNED) ? onHeap()->data() : characters;
+    }
+
+    /*-------------------------------------------------------------------------
+    * isPooled()
+    *
+    * @pre: None
+    * @post: string is unchanged
+    * @return: bool - true if the value is kept in the StringPool
+    */
+    bool isPooled() const {
+        return length == POOLED;
+    }
+
+    /*-------------------------------------------------------------------------
+    * str()
+    *
+    * @pre: None
+    * @post: string is unchanged
+    * @return: string - a copy of the value
+    */
+    string str() const {
+        return string(data(), size());
+    }
+
+    /*-------------------------------------------------------------------------
+    * substr(size_t, size_t)
+    *
+    * @pre: None
+    * @post: string is unchanged
+    * @param: size_t start - first character
+    * @param: size_t count - most characters returned
+    * @return: string - the characters from start, at most count of them
+    */
+    string substr(size_t start, size_t count) const {
+        size_t total = size();
+        if (start > total) {
+            start = total;
+        }
+        if (count > total - start) {
+            count = total - start;
+        }
+        return string(data() + start, count);
+    }
+
+    /*-------------------------------------------------------------------------
+    * compare(const InlineString&)
+    *
+    * @pre: None
+    * @post: both strings are unchanged
+    * @param: const InlineString& other - the string compared to
+    * @return: int - negative, 0 or positive as this string sorts before,
+    * with or after the other one (as string::compare)
+    */
+    int compare(const InlineString &other) const {
+        size_t mine = size();
+        size_t theirs = other.size();
+        int order = memcmp(data(), other.data(), (mine < theirs) ? mine : theirs);
+        if (order != 0) {
+            return order;
+        }
+        return (mine < theirs) ? -1 : (mine > theirs) ? 1 : 0;
+    }
+
+    bool operator==(const InlineString &other) const {
+        return size() == other.size() && memcmp(data(), other.data(), size()) == 0;
+    }
+
+    bool operator<(const InlineString &other) const {
+        return compare(other) < 0;
+    }
+
+    bool operator>(const InlineString &other) const {
+        return compare(other) > 0;
+    }
+
+    /*-------------------------------------------------------------------------
+    * hash()
+    *
+    * @pre: None
+    * @post: string is unchanged
+    * @return: size_t - std::hash of the value
+    */
+    size_t hash() const {
+        return std::hash<string_view>()(string_view(data(), size()));
+    }
+
+    /*-------------------------------------------------------------------------
+    * heapSize()
+    *
+    * @pre: None
+    * @post: string is unchanged
+    * @return: int - bytes of the copy of the value on the heap (a pooled
+    * one is shared with the other fields holding it), 0 if the value is in
+    * place
+    */
+    int heapSize() const {
+        return (length >= OWNED) ? static_cast<int>(onHeap()->capacity() + 1) : 0;
+    }
+
+private:
+    // length of a value on the heap: owned by this field, or in the
+    // StringPool
+    static const unsigned char OWNED = 0xfe;
+    static const unsigned char POOLED = 0xff;
+
+    char characters[Capacity - 1];  // the value, or a pointer to its copy
+    unsigned char length;           // characters in place, OWNED or POOLED
+
+    // the copy of the value on the heap (only if length is OWNED or POOLED)
+    const string *onHeap() const {
+        const string *copy;
+        memcpy(&copy, characters, sizeof(copy));
+        return copy;
+    }
+
+    // holds a pointer to a copy of the value on the heap
+    void point(const string *copy, unsigned char where) {
+        memcpy(characters, &copy, sizeof(copy));
+        length = where;
+    }
+
+    // the other string's value: its bytes, or a copy of an owned value
+    void copy(const InlineString &other) {
+        if (other.length == OWNED) {
+            point(new string(*other.onHeap()), OWNED);
+        } else {
+            memcpy(characters, other.characters, sizeof(characters));
+            length = other.length;
+        }
+    }
+
+    // frees an owned value, before the string holds another one
+    void release() {
+        if (length == OWNED) {
+            delete onHeap();
+        }
+        length = 0;
+    }
+};
+
+// writes the value, as operator<< does for a string
+template <size_t Capacity>
+ostream &operator<<(ostream &out, const InlineString<Capacity> &text) {
+    return out << string_view(text.data(), text.size());
+}
+
+// reads up to the delimiter, as getline does for a string
+template <size_t Capacity>
+istream &getline(istream &in, InlineString<Capacity> &text, char delimiter) {
+    string value;
+    getline(in, value, delimiter);
+    text = value;
+    return in;
+}
+
+#endif //INLINESTRING_H
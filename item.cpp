@@ -40,7 +40,43 @@ Item::~Item() {}
 * @return: returns the title member of the Item
 */
 string Item::getTitle() const{
-    return this->title;
+    return this->title.str();
+}
+
+/*-------------------------------------------------------------------------
+* getStringSize()
+*
+* Returns the heap memory held by the Item's strings. Strings short 
+* enough to be stored inside the object count 0. Derived classes with
+* strings of their own add them.
+* @pre: Item exists
+* @post: Item is unchanged
+* @param: None
+* @return: int - bytes allocated for strings
+*/
+int Item::getStringSize() const {
+    return heapSize(title);
+}
+
+/*-------------------------------------------------------------------------
+* poolStrings()
+*
+* Moves the Item's fields too long to be kept in place to the
+* StringPool. Called by the Library when a section takes the Item; the
+* Items built to look others up keep their own copies, freed with them.
+* Derived classes with strings of their own pool them too.
+* @pre: Item exists
+* @post: the long fields are shared with the other Items holding them
+* @param: None
+*/
+void Item::poolStrings() {
+    title.pool();
+}
+
+// heap bytes held by a string, 0 if it fits inside the string object
+int Item::heapSize(const string& text) {
+    static const size_t INSIDE = string().capacity();
+    return (text.capacity() > INSIDE) ? text.capacity() + 1 : 0;
 }
 
 /*-------------------------------------------------------------------------
@@ -9,6 +9,9 @@
 // Features: 
 //  -- Can get title of Item
 //  -- Can modify and get stock of Item
+//  -- The title is an InlineString: kept inside the Item up to
+//     ITEM_TITLE_BYTES - 1 characters, on the heap beyond (in the
+//     StringPool once a section holds the Item, see poolStrings())
 //
 // Assumptions/implementation:
 // -- Any derived class will have a title and stock
@@ -19,6 +22,9 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <functional>
+#include "inlinestring.h"
+#include "constants.h"
 using namespace std;
 
 class Item {
@@ -103,7 +109,7 @@ public:
     virtual void setData(ifstream&) = 0;   // sets item data (for input file ONLY)
 
     /*-------------------------------------------------------------------------
-    * setTransactionData(ifstream&)
+    * setTransactionData(istream&)
     *
     * pure virtual function that is implemented by derived classes to uniquely 
     * set the data members for that derived class, independent of Item
@@ -111,7 +117,19 @@ public:
     * @pre: dependent upon derived implementation
     * @post: dependent upon derived implementation
     */
-    virtual void setTransactionData(ifstream&) = 0; // sets item data (for command file ONLY)
+    virtual void setTransactionData(istream&) = 0; // sets item data (command file or log)
+
+    /*-------------------------------------------------------------------------
+    * writeTransactionData(ostream&)
+    *
+    * pure virtual function that is implemented by derived classes to write 
+    * the identifying data members in the same layout setTransactionData() 
+    * reads them, so an Item can be found again from a log or snapshot file
+    * @pre: dependent upon derived implementation
+    * @post: Item is unchanged
+    * @param: ostream& - stream the command-format data is written to
+    */
+    virtual void writeTransactionData(ostream&) const = 0;
 
     /*-------------------------------------------------------------------------
     * setFormat(char) 
@@ -128,6 +146,18 @@ public:
     */
     virtual void setFormat(char) = 0;
 
+    /*-------------------------------------------------------------------------
+    * getFormat()
+    *
+    * pure virtual function that is implemented by derived classes to return
+    * the format character set by setFormat()
+    * @pre: dependent upon derived implementation
+    * @post: Item is unchanged
+    * @param: None
+    * @return: char - the format of the Item
+    */
+    virtual char getFormat() const = 0;
+
     /*-------------------------------------------------------------------------
     * create()
     
@@ -140,6 +170,60 @@ public:
     */
     virtual Item* create() const = 0;
 
+    /*-------------------------------------------------------------------------
+    * getObjectSize()
+    *
+    * Pure virtual function that will be implemented by derived classes.
+    * Returns the size of the object itself (of its derived class), used to
+    * report the memory a library section takes.
+    * @pre: Item exists
+    * @post: Item is unchanged
+    * @param: None
+    * @return: int - bytes of the object
+    */
+    virtual int getObjectSize() const = 0;
+
+    /*-------------------------------------------------------------------------
+    * getStringSize()
+    *
+    * Returns the memory the Item's strings hold outside it. Fields short
+    * enough to be stored inside the object count 0, longer ones count
+    * their copy on the heap (shared by the Items holding the same value,
+    * once pooled).
+    * Derived classes with strings of their own add them.
+    * @pre: Item exists
+    * @post: Item is unchanged
+    * @param: None
+    * @return: int - bytes allocated for strings
+    */
+    virtual int getStringSize() const;
+
+    /*-------------------------------------------------------------------------
+    * poolStrings()
+    *
+    * Moves the Item's fields too long to be kept in place to the
+    * StringPool. Called by the Library when a section takes the Item; the
+    * Items built to look others up keep their own copies, freed with them.
+    * Derived classes with strings of their own pool them too.
+    * @pre: Item exists
+    * @post: the long fields are shared with the other Items holding them
+    * @param: None
+    */
+    virtual void poolStrings();
+
+    /*-------------------------------------------------------------------------
+    * keyHash()
+    *
+    * Pure virtual function that will be implemented by derived classes.
+    * Hashes the fields the derived class's compare() orders by, so Items
+    * with compare() == 0 have the same hash (see KeyIndex).
+    * @pre: Item exists
+    * @post: Item is unchanged
+    * @param: None
+    * @return: size_t - hash of the Item's key
+    */
+    virtual size_t keyHash() const = 0;
+
     /*-------------------------------------------------------------------------
     * operator==
     *
@@ -215,8 +299,23 @@ public:
     */
     virtual bool operator>(const Item &) const = 0;
 protected:
-    string title; // the identifying title/name
+    InlineString<ITEM_TITLE_BYTES> title; // the identifying title/name
     int stock;    // quantity available
+
+    // heap bytes held by a string, 0 if it fits inside the string object
+    static int heapSize(const string&);
+
+    // pooled bytes of an InlineString field, 0 if it is in place
+    template <size_t Capacity>
+    static int heapSize(const InlineString<Capacity>& text) {
+        return text.heapSize();
+    }
+
+    // hash of a key made of several fields: the hash so far mixed with the
+    // hash of the next field
+    static size_t combineHash(size_t seed, size_t value) {
+        return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+    }
 };
 
 #endif
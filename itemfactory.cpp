@@ -4,9 +4,6 @@
 * @brief: implementation for ItemFactory class 
 //------------------------------------------------------------------------*/
 #include "itemfactory.h"
-#include "fictionbook.h"
-#include "childrenbook.h"
-#include "periodicalbook.h"
 
 /*-------------------------------------------------------------------------
 * Constructor
@@ -19,17 +16,13 @@
 ItemFactory::ItemFactory() {
     
     // For reference in .h file: Book* itemFactory[BOOK_TYPES]; // array for hashtable
-    for (int i = 0; i < ITEM_TYPES; i++){
+    for (int i = 0; i < TYPE_SLOTS; i++){
         itemFactory[i] = nullptr;
     }
-    // position 2
-    itemFactory[C_HASH_VALUE] = new ChildrenBook;
-
-    // positon 5
-    itemFactory[F_HASH_VALUE] = new FictionBook;
-
-    // position 15 
-    itemFactory[P_HASH_VALUE] = new PeriodicalBook;
+    // one prototype per type in MediaTypes, at the position its letter
+    // hashes to (C at 2, F at 5, P at 15)
+    PrototypeRegistrar<Item> prototypes = {itemFactory};
+    forEachType(prototypes, MediaTypes());
 }
 
 /*-------------------------------------------------------------------------
@@ -41,7 +34,7 @@ ItemFactory::ItemFactory() {
 * @param: None
 */
 ItemFactory::~ItemFactory() {
-    for (int i = 0; i < ITEM_TYPES; i++) {
+    for (int i = 0; i < TYPE_SLOTS; i++) {
         if (itemFactory[i] != nullptr) {
             delete itemFactory[i];
             itemFactory[i] = nullptr;
@@ -61,25 +54,28 @@ ItemFactory::~ItemFactory() {
 * @return: returns the new Item object
 */
 Item* ItemFactory::createItem(char type) {
-    int subscript = hashItem(type);
-    if (itemFactory[subscript] == nullptr) { 
-        cout << endl;
-        cout << "ERROR: " << type << " is not a valid item type." << endl;
+    // parsed commands can hold any character (or ' ' if the item is missing),
+    // all of them hash inside the array
+    Item* prototype = itemFactory[hashItem(type)];
+    if (prototype == nullptr) { 
+        // one buffered write, no flushes: cheap even when most lines are bad
+        cout << "\nERROR: " << type << " is not a valid item type.\n";
         return nullptr;
     }else{
-        return itemFactory[subscript]->create();
+        return prototype->create();
     }
 }
 
 /*-------------------------------------------------------------------------
 * hashItem
 *
-* Hashes a given character by subtracting 'A'
+* Hashes a given character with typeIndex(): 'A'-'Z' subtract 'A', any
+* other character gives the UNKNOWN_TYPE slot, which is never filled
 * @pre: ItemFactory object exists 
 * @post: An integer is returned
 * @param: char - the key to be hashed against to find right kind of object
 * @return: int - the index of the right Item type inside itemFactory[]
 */
 int ItemFactory::hashItem(char type) const {
-    return type - 'A';
+    return typeIndex(type);
 }
\ No newline at end of file
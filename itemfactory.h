@@ -13,8 +13,8 @@
 // Assumptions/implementation:
 // -- All Item creation is dependent upon hashing and array indicies .
 // -- Switch-Cases and if/else statements are never used. 
-// -- Items can't be created unless explicitly instantiated in constructor
-//    and stored in the factory's array
+// -- Items can't be created unless their class is listed in MediaTypes,
+//    the constructor stores a prototype of every listed type in the array
 // -- Items stored in the factory array must have a create() method that 
 //    returns a new object of that same type.
 //---------------------------------------------------------------------------
@@ -22,8 +22,17 @@
 #ifndef ITEMFACTORY_H
 #define ITEMFACTORY_H
 #include "book.h"
+#include "fictionbook.h"
+#include "childrenbook.h"
+#include "periodicalbook.h"
+#include "typelist.h"
+#include "typecodes.h"
 #include "constants.h"
 
+// every kind of Item the library stores, each gets a prototype in the
+// ItemFactory and a section (tree) in the Library
+typedef TypeList<ChildrenBook, FictionBook, PeriodicalBook> MediaTypes;
+
 class ItemFactory {
   public:
     /*-------------------------------------------------------------------------
@@ -59,12 +68,13 @@ class ItemFactory {
     */
     Item* createItem(char); // creates a specific book using hash function
   private:
-    Item* itemFactory[ITEM_TYPES]; // array for hashtable
+    Item* itemFactory[TYPE_SLOTS]; // array for hashtable, with the UNKNOWN_TYPE slot
 
     /*-------------------------------------------------------------------------
     * hashItem
     *
-    * Hashes a given character by subtracting 'A'
+    * Hashes a given character with typeIndex(): 'A'-'Z' subtract 'A', any
+    * other character gives the UNKNOWN_TYPE slot, which is never filled
     * @pre: ItemFactory object exists 
     * @post: An integer is returned
     * @param: char - the key to be hashed against to find right kind of object
@@ -0,0 +1,137 @@
+/*---------------------------------------------------------------------------
+* @file: keyindex.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: implementation of the KeyIndex class
+---------------------------------------------------------------------------*/
+#include "keyindex.h"
+#include "constants.h"
+
+using namespace std;
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* @pre: None
+* @post: empty index exists, no table is allocated yet
+* @param: None
+*/
+KeyIndex::KeyIndex() {
+    slots = nullptr;
+    mask = 0;
+    count = 0;
+}
+
+/*-------------------------------------------------------------------------
+* Destructor
+*
+* @pre: index exists
+* @post: the table is freed (the Items are not)
+* @param: None
+*/
+KeyIndex::~KeyIndex() {
+    clear();
+}
+
+/*-------------------------------------------------------------------------
+* insert(size_t, Item*)
+*
+* @pre: item is not indexed, no indexed Item has the same key
+* @post: item is found by its key
+* @param: size_t - the Item's keyHash()
+* @param: Item* - the Item, as stored in its section
+*/
+void KeyIndex::insert(size_t hash, Item* item) {
+    // at most half full, so probe sequences stay short
+    if (slots == nullptr || 2 * (count + 1) > mask + 1) {
+        grow();
+    }
+    size_t slot = hash & mask;
+    while (slots[slot].item != nullptr) {
+        slot = (slot + 1) & mask;
+    }
+    slots[slot].hash = hash;
+    slots[slot].item = item;
+    count++;
+}
+
+/*-------------------------------------------------------------------------
+* remove(size_t, const Item*)
+*
+* @pre: None
+* @post: item is no longer found
+* @param: size_t - the Item's keyHash()
+* @param: const Item* - the Item, as stored in its section
+* @return: bool - true if it was indexed
+*/
+bool KeyIndex::remove(size_t hash, const Item* item) {
+    if (count == 0) {
+        return false;
+    }
+    size_t slot = hash & mask;
+    while (slots[slot].item != item) {
+        if (slots[slot].item == nullptr) {
+            return false;
+        }
+        slot = (slot + 1) & mask;
+    }
+    // later Items of the probe sequence move back into the hole, unless
+    // their own home is after it
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & mask; slots[next].item != nullptr; next = (next + 1) & mask) {
+        size_t home = slots[next].hash & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+    }
+    slots[hole].item = nullptr;
+    count--;
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* clear()
+*
+* @pre: None
+* @post: index is empty and its table freed
+* @param: None
+*/
+void KeyIndex::clear() {
+    delete[] slots;
+    slots = nullptr;
+    mask = 0;
+    count = 0;
+}
+
+/*-------------------------------------------------------------------------
+* getBytes()
+*
+* @pre: None
+* @post: index is unchanged
+* @return: long - memory of the table
+*/
+long KeyIndex::getBytes() const {
+    return (slots == nullptr) ? 0 : static_cast<long>(sizeof(Slot) * (mask + 1));
+}
+
+// moves every Item into a table twice as big
+void KeyIndex::grow() {
+    size_t size = (slots == nullptr) ? KEY_INDEX_SLOTS : 2 * (mask + 1);
+    Slot* old = slots;
+    size_t oldSize = (old == nullptr) ? 0 : mask + 1;
+    slots = new Slot[size];
+    for (size_t i = 0; i < size; i++) {
+        slots[i].item = nullptr;
+    }
+    mask = size - 1;
+    for (size_t i = 0; i < oldSize; i++) {
+        if (old[i].item != nullptr) {
+            size_t slot = old[i].hash & mask;
+            while (slots[slot].item != nullptr) {
+                slot = (slot + 1) & mask;
+            }
+            slots[slot] = old[i];
+        }
+    }
+    delete[] old;
+}
@@ -0,0 +1,146 @@
+/*---------------------------------------------------------------------------
+* @file: keyindex.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the KeyIndex class
+---------------------------------------------------------------------------*/
+// KeyIndex Class: Hash index from the key of an Item (the fields its type's
+// compare() orders by) to the Item in its section. Checkouts and returns
+// only look Items up by their whole key, so a section answers them with
+// one probe here instead of a descent of its tree.
+//---------------------------------------------------------------------------
+// Features:
+// -- Open addressing with linear probing. Each slot keeps the key's hash
+//    next to the Item pointer, so probing compares numbers and only a slot
+//    with the same hash is compared as an Item.
+// -- The table doubles when it gets half full, so a probe sequence is
+//    short (about 1.5 slots for a hit).
+// -- findAs<Type>() compares with Type's own non-virtual compare(), as
+//    the sections' retrieveAs() do, given the hash its caller computed.
+//
+// Assumptions/implementation:
+// -- Items with the same key (compare() == 0) are never both indexed: a
+//    section rejects the second one as a duplicate before indexing it.
+// -- The index does not own the Items, its section does.
+// -- Removal shifts the rest of the probe sequence back, there are no
+//    tombstones to slow lookups down after many removals.
+//---------------------------------------------------------------------------
+#ifndef KEYINDEX_H
+#define KEYINDEX_H
+
+#include <cstddef>
+#include "item.h"
+
+class KeyIndex {
+  public:
+    /*-------------------------------------------------------------------------
+    * Constructor
+    *
+    * @pre: None
+    * @post: empty index exists, no table is allocated yet
+    * @param: None
+    */
+    KeyIndex();
+
+    /*-------------------------------------------------------------------------
+    * Destructor
+    *
+    * @pre: index exists
+    * @post: the table is freed (the Items are not)
+    * @param: None
+    */
+    ~KeyIndex();
+
+    /*-------------------------------------------------------------------------
+    * insert(size_t, Item*)
+    *
+    * @pre: item is not indexed, no indexed Item has the same key
+    * @post: item is found by its key
+    * @param: size_t - the Item's keyHash()
+    * @param: Item* - the Item, as stored in its section
+    */
+    void insert(size_t, Item*);
+
+    /*-------------------------------------------------------------------------
+    * remove(size_t, const Item*)
+    *
+    * @pre: None
+    * @post: item is no longer found
+    * @param: size_t - the Item's keyHash()
+    * @param: const Item* - the Item, as stored in its section
+    * @return: bool - true if it was indexed
+    */
+    bool remove(size_t, const Item*);
+
+    /*-------------------------------------------------------------------------
+    * findAs(const Type&, size_t, Item*&, int&)
+    *
+    * Finds the Item with target's key and format, as retrieve() would
+    * @pre: the index holds Items of Type only
+    * @post: index is unchanged
+    * @param: const Type& - the Item to find
+    * @param: size_t - target's keyHash()
+    * @param: Item*& - set to the Item found, unchanged if not found
+    * @param: int& - set to the number of slots probed
+    * @return: bool - true if found
+    */
+    template <class Type>
+    bool findAs(const Type& target, size_t hash, Item*& found, int& probes) const {
+        probes = 0;
+        if (count == 0) {
+            return false;
+        }
+        for (size_t slot = hash & mask; slots[slot].item != nullptr; slot = (slot + 1) & mask) {
+            probes++;
+            if (slots[slot].hash == hash) {
+                const Type& item = static_cast<const Type&>(*slots[slot].item);
+                if (item.compare(target) == 0) {
+                    // one Item per key, another format is not found
+                    if (!item.sameFormat(target)) {
+                        return false;
+                    }
+                    found = slots[slot].item;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /*-------------------------------------------------------------------------
+    * clear()
+    *
+    * @pre: None
+    * @post: index is empty and its table freed
+    * @param: None
+    */
+    void clear();
+
+    /*-------------------------------------------------------------------------
+    * getBytes()
+    *
+    * @pre: None
+    * @post: index is unchanged
+    * @return: long - memory of the table
+    */
+    long getBytes() const;
+
+  private:
+    // an indexed Item and the hash of its key, empty if item is nullptr
+    struct Slot {
+        size_t hash;
+        Item* item;
+    };
+
+    Slot* slots;    // the table, a power of two of slots
+    size_t mask;    // number of slots - 1
+    int count;      // Items indexed
+
+    // moves every Item into a table twice as big
+    void grow();
+
+    // copying would share the table
+    KeyIndex(const KeyIndex&);
+    KeyIndex& operator=(const KeyIndex&);
+};
+
+#endif //KEYINDEX_H
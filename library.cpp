@@ -4,12 +4,109 @@
 * @brief: Implementation for the Library class 
 //------------------------------------------------------------------------*/
 #include "library.h"
+#include "valuesection.h"
+#include "eytzingersection.h"
+#include "lsmsection.h"
+#include "calendarsection.h"
+#include "checkout.h"
+#include "stringpool.h"
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <thread>
+#include <cstdio>
+#include <iomanip>
 #include "string"
 
 using namespace std;
 
+// lookup in the key index of a section holding only Items of Type, the
+// same for both storages
+template <class Type>
+static bool retrieveIndexed(const Section& section, const Item& target,
+                            Item*& found, int& probes) {
+    return section.retrieveByKey(static_cast<const Type&>(target), found, probes);
+}
+
+// insert into a tree holding only Items of Type
+template <class Type>
+static bool insertTree(Section& section, Item* item) {
+    return static_cast<BinarySearchTree&>(section).insertAs<Type>(item);
+}
+
+// insert into a value section of Type (the Item is copied and deleted)
+template <class Type>
+static bool insertValues(Section& section, Item* item) {
+    return static_cast<ValueSection<Type>&>(section).ValueSection<Type>::insert(item);
+}
+
+// insert into an Eytzinger section of Type (the Item is copied and deleted)
+template <class Type>
+static bool insertLaidOut(Section& section, Item* item) {
+    return static_cast<EytzingerSection<Type>&>(section).EytzingerSection<Type>::insert(item);
+}
+
+// insert into an LSM section of Type (a duplicate is deleted)
+template <class Type>
+static bool insertLogged(Section& section, Item* item) {
+    return static_cast<LsmSection<Type>&>(section).LsmSection<Type>::insert(item);
+}
+
+// lookup of a periodical in the calendar section: its month's bucket,
+// then its title
+static bool retrieveDated(const Section& section, const Item& target,
+                          Item*& found, int& probes) {
+    return static_cast<const CalendarSection&>(section).retrieveAs(
+        static_cast<const PeriodicalBook&>(target), found, probes);
+}
+
+// insert into the calendar section (a duplicate is deleted)
+static bool insertDated(Section& section, Item* item) {
+    return static_cast<CalendarSection&>(section).insert(item);
+}
+
+// lays out an Eytzinger section of Type
+template <class Type>
+static void layoutSection(Section& section) {
+    static_cast<EytzingerSection<Type>&>(section).layout();
+}
+
+// creates the section of every visited media type, stored the way the
+// library was asked to, and points its lookup and insert at the versions
+// compiled for that type and storage
+struct Library::SectionRegistrar {
+    Library* library;
+    SectionStorage storage;
+
+    template <class Type>
+    void visit() {
+        int index = library->hash(Type::TYPE);
+        if (storage == VALUE_SECTIONS) {
+            library->libraryStorage[index] = new ValueSection<Type>(Type::sectionName(), Type::sectionColumns());
+            library->sectionRetrieve[index] = &retrieveIndexed<Type>;
+            library->sectionInsert[index] = &insertValues<Type>;
+        } else if (storage == EYTZINGER_SECTIONS) {
+            library->libraryStorage[index] = new EytzingerSection<Type>(Type::sectionName(), Type::sectionColumns());
+            library->sectionRetrieve[index] = &retrieveIndexed<Type>;
+            library->sectionInsert[index] = &insertLaidOut<Type>;
+            library->sectionLayout[index] = &layoutSection<Type>;
+        } else if (storage == LSM_SECTIONS) {
+            library->libraryStorage[index] = new LsmSection<Type>(Type::sectionName(), Type::sectionColumns());
+            library->sectionRetrieve[index] = &retrieveIndexed<Type>;
+            library->sectionInsert[index] = &insertLogged<Type>;
+        } else if (Type::TYPE == PeriodicalBook::TYPE) {
+            // periodicals are looked up by date, filed by month
+            library->libraryStorage[index] = new CalendarSection(Type::sectionName(), Type::sectionColumns());
+            library->sectionRetrieve[index] = &retrieveDated;
+            library->sectionInsert[index] = &insertDated;
+        } else {
+            library->libraryStorage[index] = new BinarySearchTree(Type::sectionName(), Type::sectionColumns());
+            library->sectionRetrieve[index] = &retrieveIndexed<Type>;
+            library->sectionInsert[index] = &insertTree<Type>;
+        }
+    }
+};
+
 
 /*-------------------------------------------------------------------------
 * Constructor
@@ -19,23 +116,24 @@ using namespace std;
 * and the patron hashTable[]. 
 * @pre: None
 * @post: Library object gets created 
-* @param: None
+* @param: SectionStorage - how the sections store their Items: trees of
+* heap Items (the default), Items embedded in the tree nodes, Items
+* laid out in Eytzinger order once the books are built, or a write
+* buffer and sorted runs
 */
-Library::Library() {
+Library::Library(SectionStorage storage) {
     for (int i = 0; i < MEDIA_TYPES; i++) {
         libraryStorage[i] = nullptr;
+        sectionRetrieve[i] = nullptr;
+        sectionInsert[i] = nullptr;
+        sectionLayout[i] = nullptr;
     }
-    // Stores all CHILDREN books in sorted 
-    // order (sorted by: title, then by author)
-    libraryStorage[C_HASH_VALUE] = new BinarySearchTree("CHILDREN BOOKS", "AVAIL,TITLE,AUTHOR,YEAR");
-    
-    // Stores all FICTION books in sorted 
-    // order (sorted by: author, then title)
-    libraryStorage[F_HASH_VALUE] = new BinarySearchTree("FICTION BOOKS", "AVAIL,TITLE,AUTHOR,YEAR");
-
-    // Stores all PERIODICAL books in sorted 
-    // order (sorted by: year, then month)
-    libraryStorage[P_HASH_VALUE] = new BinarySearchTree("PERIODICALS", "AVAIL,TITLE,MONTH,YEAR");
+    // one tree per media type, each sorted by its type's compare():
+    // CHILDREN books by title then author, FICTION books by author then
+    // title, PERIODICALS by year then month (in month buckets, not a
+    // tree, with the default storage)
+    SectionRegistrar sections = {this, storage};
+    forEachType(sections, MediaTypes());
 
     // book factory
     itemFactory = new ItemFactory();
@@ -43,9 +141,24 @@ Library::Library() {
     // patron list 
     patrons = new HashTable();
 
+    // autocomplete over every section's titles
+    titles = new TitleTrie();
+
+    // keyword search over every section's titles
+    words = new WordIndex();
+
     // transaction factory
     transactionFactory = new TransactionFactory();
 
+    // no transaction log or snapshots until asked for
+    logSequence = 0;
+    snapshotPath = "";
+    snapshotInterval = 0;
+
+    // no statistics dumps until asked for
+    statisticsPath = "";
+    statisticsInterval = 0;
+    commandsSinceDump = 0;
 }
 
 /*-------------------------------------------------------------------------
@@ -65,6 +178,8 @@ Library::~Library() {
     }
     delete itemFactory;
     delete patrons;
+    delete titles;
+    delete words;
     delete transactionFactory;
 }
 
@@ -75,7 +190,8 @@ Library::~Library() {
 * data and can be categorized by the first character on each line 
 * @pre: Library object and the file that ifstream& references must exist 
 * @post: Media trees in Library object now contain any entries in the given
-* book data
+* book data. Eytzinger sections are laid out. The title trie and the word
+* index hold the titles of every section.
 * @param: ifstream& - references the file that contains book data
 */        
 void Library::buildBooksFromFile(ifstream& infile) {
@@ -89,13 +205,35 @@ void Library::buildBooksFromFile(ifstream& infile) {
             // sets all book formats to hard copy, 
             // would be changed to read from file if given format 
             newItem->setData(infile); 
-            libraryStorage[hash(type)]->insert(newItem);
+            newItem->poolStrings();
+            sectionInsert[hash(type)](*libraryStorage[hash(type)], newItem);
         } else {
             string oldLine = "";
             getline(infile, oldLine);
         }
         infile >> type;
     }
+    // nothing points into the sections yet, their Items can still move
+    for (int i = 0; i < MEDIA_TYPES; i++) {
+        if (sectionLayout[i] != nullptr) {
+            sectionLayout[i](*libraryStorage[i]);
+        }
+    }
+    // the titles are read from the sections, after the Items found their
+    // places; duplicates were rejected and aren't counted
+    titles->makeEmpty();
+    words->makeEmpty();
+    vector<Item*> items;
+    for (int i = 0; i < MEDIA_TYPES; i++) {
+        if (libraryStorage[i] != nullptr) {
+            items.clear();
+            libraryStorage[i]->collect(items);
+            for (size_t j = 0; j < items.size(); j++) {
+                titles->insert(*items[j]);
+                words->insert(items[j]);
+            }
+        }
+    }
 }
 
 /*-------------------------------------------------------------------------
@@ -122,32 +260,362 @@ void Library::buildPatronsFromFile(ifstream& infile) {
 }
 
 /*-------------------------------------------------------------------------
-* acceptTransactions(ifstream&)
+* applyCatalogDelta(ifstream&)
 * 
-* Executes all the transactions from the given data file. Each transaction 
-* contains data and can be categorized by the first character on each line
+* Changes the catalog in place from a delta file, one change per line:
+*   + F Kerouac Jack, On the Road, 1957    add (a books file line)
+*   - F H Kerouac Jack, On the Road,       remove (type, format, key
+*                                          fields, as in a command)
+*   ~ -2 F H Kerouac Jack, On the Road,    change the stock by a count
+* Lines are read and their Items created DELTA_BATCH_RECORDS at a time,
+* then the batch is applied in file order. Only the Items named are
+* touched, so the cost follows the size of the delta, not the catalog.
 * @pre: Library object and the file that ifstream& references must exist 
+* @post: sections changed as the lines say. Removed Items are kept (not
+* freed) until the library is deleted, so patrons holding them, and
+* their histories, keep valid pointers.
+* @param: ifstream& - references the delta file
+* @return: DeltaCounts - lines applied (by operation) and rejected
+*/        
+DeltaCounts Library::applyCatalogDelta(ifstream& infile) {
+    DeltaCounts counts = {0, 0, 0, 0};
+    vector<DeltaRecord> batch;
+    batch.reserve(DELTA_BATCH_RECORDS);
+    char operation;
+
+    while (infile >> operation) {
+        DeltaRecord record = {operation, ' ', 0, nullptr};
+        if (operation == '+' || operation == '-' || operation == '~') {
+            if (operation == '~') {
+                infile >> record.count;
+            }
+            infile >> record.itemType;
+            record.item = infile ? itemFactory->createItem(record.itemType) : nullptr;
+        }
+        if (record.item != nullptr && operation == '+') {
+            record.item->setData(infile);
+        } else if (record.item != nullptr) {
+            char format;
+            infile >> format;
+            record.item->setTransactionData(infile);
+            record.item->setFormat(format);
+        }
+        if (infile.fail()) {
+            // a field was missing or not a number, the line is dropped
+            infile.clear();
+            delete record.item;
+            record.item = nullptr;
+        }
+        string rest;
+        getline(infile, rest);
+
+        if (record.item == nullptr) {
+            counts.rejected++;
+        } else {
+            batch.push_back(record);
+            if (batch.size() == DELTA_BATCH_RECORDS) {
+                applyDeltaBatch(batch, counts);
+            }
+        }
+    }
+    applyDeltaBatch(batch, counts);
+    return counts;
+}
+
+/*-------------------------------------------------------------------------
+* freeze()
+* 
+* Freezes every section for a catalog that only changes stock from now on:
+* each section's keys get a minimal perfect hash index (see
+* PerfectHashIndex), so a checkout or return finds its Item in one or two
+* memory accesses. A later catalog delta thaws the sections it changes.
+* @pre: Library object exists
+* @post: sections are frozen, unless their perfect hash could not be built.
+* The calendar section of the periodicals has no hash index and stays as
+* it is.
+* @return: bool - true if every section that has a hash index was frozen
+*/
+bool Library::freeze() {
+    bool frozen = true;
+    for (int i = 0; i < MEDIA_TYPES; i++) {
+        if (libraryStorage[i] != nullptr && !libraryStorage[i]->freeze()) {
+            frozen = false;
+        }
+    }
+    return frozen;
+}
+
+/*-------------------------------------------------------------------------
+* applyDeltaBatch(vector<DeltaRecord>&, DeltaCounts&)
+* 
+* Applies a batch of delta lines in order and empties it. Added Items
+* go to their section, probes are deleted.
+* @pre: every record has a valid operation and type
+* @post: sections are changed, counts are updated, batch is empty
+* @param: vector<DeltaRecord>& - the batch
+* @param: DeltaCounts& - counts of what was applied
+*/
+void Library::applyDeltaBatch(vector<DeltaRecord>& batch, DeltaCounts& counts) {
+    for (int i = 0; i < batch.size(); i++) {
+        DeltaRecord& record = batch[i];
+        int index = hash(record.itemType);
+        Item* found = nullptr;
+        int depth = 0;
+        bool exists = findInSection(record.itemType, *record.item, found, depth);
+
+        if (record.operation == '+' && !exists) {
+            // the section takes the Item (a value section copies it), so
+            // the word index is given the Item found by a probe afterwards
+            Item* probe = probeFor(record.itemType, *record.item);
+            titles->insert(*record.item);
+            record.item->poolStrings();
+            sectionInsert[index](*libraryStorage[index], record.item);
+            record.item = probe;
+            if (findInSection(record.itemType, *probe, found, depth)) {
+                words->insert(found);
+            }
+            counts.added++;
+        } else if (record.operation == '-' && exists) {
+            titles->remove(*found);
+            words->remove(found);
+            libraryStorage[index]->remove(*record.item, found);
+            counts.removed++;
+        } else if (record.operation == '~' && exists && found->getStock() + record.count >= 0) {
+            found->modifyStock(record.count);
+            counts.adjusted++;
+        } else {
+            counts.rejected++;
+        }
+        delete record.item;
+    }
+    batch.clear();
+}
+
+/*-------------------------------------------------------------------------
+* probeFor(char, const Item&)
+* 
+* Copies the key fields of an Item into a new Item of its type, as the
+* log does (writeTransactionData, then setTransactionData)
+* @pre: type is the Item's type
+* @post: Library object is unchanged
+* @param: char - the Item type
+* @param: const Item& - the Item copied
+* @return: Item* - a newly allocated probe that finds the Item
+*/
+Item* Library::probeFor(char type, const Item& item) {
+    stringstream data;
+    item.writeTransactionData(data);
+    Item* probe = itemFactory->createItem(type);
+    probe->setTransactionData(data);
+    probe->setFormat(item.getFormat());
+    return probe;
+}
+
+/*-------------------------------------------------------------------------
+* acceptTransactions(istream&)
+* 
+* Executes all the transactions from the given stream (a file, a string or
+* a socket buffer). Each transaction contains data and can be categorized
+* by the first character on each line. Lines are parsed into Commands on
+* a separate thread while this thread executes them in order.
+* @pre: Library object and the stream that istream& references must exist 
 * @post: Patrons in Patron HashTable and Items in the media trees are 
 * changed or unchanged. Transactions are recorded for Patrons, when needed.
-* @param: infile& - references the file that contains transaction data 
+* @param: infile& - references the stream that contains transaction data 
 */ 
-void Library::acceptTransactions(ifstream& infile) {
-    char type; 
-    infile >> type;
-    while (!infile.eof()) {
-        Transaction* newTransaction = transactionFactory->createTransaction(type);
-        bool transactionKept;
-        if (newTransaction) {
-            transactionKept = newTransaction->execute(*this, infile);
-            if (!transactionKept) {
-                delete newTransaction;
+void Library::acceptTransactions(istream& infile) {
+    if (thread::hardware_concurrency() < 2) {
+        // a second thread would only take turns with this one
+        Command command;
+        string line;
+        while (getline(infile, line)) {
+            if (CommandParser::parse(line, command)) {
+                acceptCommand(command);
             }
-        }else{
-            string oldLine = "";
-            getline(infile, oldLine);
         }
-        infile >> type;
+        return;
     }
+    CommandQueue queue(COMMAND_QUEUE_CHUNKS);
+    thread parser(CommandParser::parseStream, ref(infile), ref(queue));
+    vector<Command> chunk;
+    while (queue.pop(chunk)) {
+        for (int i = 0; i < chunk.size(); i++) {
+            acceptCommand(chunk[i]);
+        }
+    }
+    parser.join();
+}
+
+/*-------------------------------------------------------------------------
+* acceptTransactions(LineReader&)
+* 
+* Same as acceptTransactions(istream&), for commands streamed from any
+* byte source (stdin, a pipe, a socket or a file). Memory stays bounded
+* however long the stream is: the reader's buffer and the queue of
+* parsed chunks are both of fixed size, and a full queue stops reading.
+* @pre: Library object exists
+* @post: as acceptTransactions(istream&), the stream has ended
+* @param: LineReader& - the source of the commands
+*/ 
+void Library::acceptTransactions(LineReader& reader) {
+    if (thread::hardware_concurrency() < 2) {
+        // a second thread would only take turns with this one
+        Command command;
+        const char* begin;
+        const char* end;
+        while (reader.next(begin, end)) {
+            if (CommandParser::parse(begin, end, command)) {
+                acceptCommand(command);
+            }
+        }
+        return;
+    }
+    CommandQueue queue(COMMAND_QUEUE_CHUNKS);
+    thread parser(CommandParser::parseLines, ref(reader), ref(queue));
+    vector<Command> chunk;
+    while (queue.pop(chunk)) {
+        for (int i = 0; i < chunk.size(); i++) {
+            acceptCommand(chunk[i]);
+        }
+    }
+    parser.join();
+}
+
+/*-------------------------------------------------------------------------
+* acceptTransactions(ParallelParser&)
+* 
+* Same as acceptTransactions(istream&), for a command file already in
+* memory (mapped) that is parsed by several threads at once. Commands
+* are still executed one at a time, in the order of the file.
+* @pre: Library object exists
+* @post: as acceptTransactions(istream&), every block was executed
+* @param: ParallelParser& - the parser of the command file
+*/ 
+void Library::acceptTransactions(ParallelParser& parser) {
+    vector<Command> chunk;
+    while (parser.next(chunk)) {
+        for (int i = 0; i < chunk.size(); i++) {
+            acceptCommand(chunk[i]);
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------
+* acceptCommand(const Command&)
+* 
+* Executes one parsed command and logs it if it was saved to a patron's 
+* history. An invalid transaction type is reported.
+* @pre: Library object exists
+* @post: Patrons in Patron HashTable and Items in the media trees are 
+* changed or unchanged. The transaction is recorded for its Patron, when
+* needed.
+* @param: const Command& - the parsed command
+*/ 
+void Library::acceptCommand(const Command& command) {
+    long long started = statistics.now();
+    Transaction* newTransaction = transactionFactory->createTransaction(command.type);
+    if (newTransaction) {
+        if (newTransaction->execute(*this, command)) {
+            logTransaction(newTransaction);
+        } else {
+            delete newTransaction;
+        }
+        statistics.finish(command.type, statistics.now() - started);
+    } else {
+        statistics.unknownCommand();
+    }
+    countForDump();
+}
+
+/*-------------------------------------------------------------------------
+* acceptBatch(const vector<string>&, vector<string>&)
+* 
+* Executes a batch of command lines (one command per line) in stages 
+* instead of one command at a time: every line is parsed first, then 
+* every patron is looked up (prefetching the chains a few commands ahead),
+* then every item, and finally the commands are applied in order. Lookups
+* only read the library, so the result is the same as executing the lines
+* one by one, only with fewer stalls on memory.
+* @pre: Library object exists
+* @post: Library is changed as by acceptTransactions() on the same lines,
+* saved transactions are logged
+* @param: const vector<string>& - the command lines
+* @param: vector<string>& - set to what each command printed, in order
+*/ 
+void Library::acceptBatch(const vector<string>& lines, vector<string>& answers) {
+    int count = lines.size();
+    vector<Transaction*> batch(count, nullptr);
+    vector<char> types(count, ' ');      // ' ' for blank lines
+    vector<long long> elapsed(count, 0); // time spent on each command so far
+    vector<ostringstream> printed(count);
+    streambuf* console = cout.rdbuf();
+    long long started;
+
+    // stage 1: parse every line, bad types are reported to their own answer
+    Command command;
+    for (int i = 0; i < count; i++) {
+        started = statistics.now();
+        if (CommandParser::parse(lines[i], command)) {
+            cout.rdbuf(printed[i].rdbuf());
+            types[i] = command.type;
+            batch[i] = transactionFactory->createTransaction(command.type);
+            if (batch[i]) {
+                batch[i]->load(command);
+            } else {
+                statistics.unknownCommand();
+            }
+        }
+        elapsed[i] += statistics.now() - started;
+    }
+    cout.rdbuf(console);
+
+    // stage 2: find patrons, the chains of later commands load meanwhile
+    for (int i = 0; i < count && i < PREFETCH_DISTANCE; i++) {
+        if (batch[i]) {
+            patrons->prefetch(batch[i]->getPatronID());
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        if (i + PREFETCH_DISTANCE < count && batch[i + PREFETCH_DISTANCE]) {
+            patrons->prefetch(batch[i + PREFETCH_DISTANCE]->getPatronID());
+        }
+        if (batch[i]) {
+            started = statistics.now();
+            batch[i]->findPatron(*this);
+            elapsed[i] += statistics.now() - started;
+        }
+    }
+
+    // stage 3: find items
+    for (int i = 0; i < count; i++) {
+        if (batch[i]) {
+            started = statistics.now();
+            cout.rdbuf(printed[i].rdbuf());
+            batch[i]->findItem(*this);
+            elapsed[i] += statistics.now() - started;
+        }
+    }
+    cout.rdbuf(console);
+
+    // stage 4: apply in order, each command sees the ones before it
+    answers.resize(count);
+    for (int i = 0; i < count; i++) {
+        if (batch[i]) {
+            started = statistics.now();
+            cout.rdbuf(printed[i].rdbuf());
+            if (batch[i]->apply(*this)) {
+                logTransaction(batch[i]);
+            } else {
+                delete batch[i];
+            }
+            statistics.finish(types[i], elapsed[i] + statistics.now() - started);
+        }
+        if (types[i] != ' ') {
+            countForDump();
+        }
+        answers[i] = printed[i].str();
+    }
+    cout.rdbuf(console);
 }
 
 /*-------------------------------------------------------------------------
@@ -176,6 +644,69 @@ void Library::display() const{
     cout << "----------------------------------------" << endl;
 }
 
+/*-------------------------------------------------------------------------
+* startDisplay(DisplayProgress&)
+* 
+* Starts a display that is printed in parts by displayPart(), so other 
+* commands can run between the parts. Together the parts print exactly
+* what display() prints.
+* @pre: None
+* @post: the opening line of the display is printed
+* @param: DisplayProgress& - set to the start of the display
+*/
+void Library::startDisplay(DisplayProgress& progress) const {
+    cout << "----------------------------------------";
+    cout << "----------------------------------------";
+    progress.section = -1;
+    progress.items.clear();
+    progress.next = 0;
+    progress.empty = true;
+}
+
+/*-------------------------------------------------------------------------
+* displayPart(DisplayProgress&, int)
+* 
+* Prints the next items of a display started by startDisplay(), along 
+* with the section headers and closing line they come with. Sections are
+* never added or removed while serving, so a section can be picked up
+* again after other commands ran; stock shown is the stock at the time 
+* each part is printed.
+* @pre: startDisplay() was called with this progress
+* @post: up to the given number of items are printed
+* @param: DisplayProgress& - where the display is, advanced
+* @param: int - most items to print
+* @return: bool - true once the whole display has been printed
+*/
+bool Library::displayPart(DisplayProgress& progress, int count) const {
+    while (count > 0) {
+        if (progress.next < progress.items.size()) {
+            progress.items[progress.next]->displayItem();
+            progress.next++;
+            count--;
+            continue;
+        }
+        // section done, move on to the next one
+        progress.section++;
+        while (progress.section < MEDIA_TYPES && libraryStorage[progress.section] == nullptr) {
+            progress.section++;
+        }
+        if (progress.section >= MEDIA_TYPES) {
+            if (progress.empty) {
+                cout << "Library is empty, There is nothing to display." << endl;
+            }
+            cout << "----------------------------------------";
+            cout << "----------------------------------------" << endl;
+            return true;
+        }
+        libraryStorage[progress.section]->displayHeader();
+        progress.items.clear();
+        libraryStorage[progress.section]->collect(progress.items);
+        progress.next = 0;
+        progress.empty = false;
+    }
+    return false;
+}
+
 // **************************************** // 
 // ***** Helper Functions start here ****** // 
 // **************************************** // 
@@ -191,7 +722,7 @@ void Library::display() const{
 * being retrieved.
 */  
 void Library::retrievePatron(int patronID, Patron*& potentialPatron) const {
-    patrons->retrieve(patronID, potentialPatron);
+    statistics.patronLookup(patrons->retrieve(patronID, potentialPatron));
 }
 
 /*-------------------------------------------------------------------------
@@ -216,17 +747,264 @@ Item* Library::createItem(char type) {
 * @post: Library object is unchanged
 * @param: char type - the character associated with the Item type of the 
 * tree to be found
-* @return: BinarySearchTree* - returns pointer to the tree to be found
+* @return: Section* - returns pointer to the tree to be found
 */ 
-BinarySearchTree* Library::findTree(char type) const {
+Section* Library::findTree(char type) const {
     return libraryStorage[hash(type)];
 }
 
+/*-------------------------------------------------------------------------
+* retrieveItem(char, const Item&, Item*&)
+* 
+* Searches the section of the given Item type for the target (one probe
+* of its key index). If found, the parameter reference now points to the
+* Item in the library. Method is only used once type is validated.
+* @pre: Library exists, type has a tree
+* @post: Library object is unchanged (the lookup is counted)
+* @param: char - the Item type of the tree searched
+* @param: const Item& - the item to find
+* @param: Item*& - set to the Item found, unchanged if not found
+* @return: bool - true if found
+*/
+bool Library::retrieveItem(char type, const Item& target, Item*& found) const {
+    int depth = 0;
+    bool result = findInSection(type, target, found, depth);
+    statistics.treeLookup(depth);
+    return result;
+}
+
+/*-------------------------------------------------------------------------
+* completeTitle(const string&, vector<const TitleTrie::Title*>&)
+* 
+* Autocomplete over the titles of every section: the titles starting
+* with a prefix, most checked out first (see TitleTrie)
+* @pre: Library exists
+* @post: Library object is unchanged
+* @param: const string& - the prefix, as typed (case and extra blanks
+* don't matter)
+* @param: vector<const TitleTrie::Title*>& - set to the titles found,
+* at most AUTOCOMPLETE_RESULTS. They stay valid until the catalog is
+* rebuilt or changed by a delta.
+* @return: int - number of titles found
+*/
+int Library::completeTitle(const string& prefix, vector<const TitleTrie::Title*>& found) const {
+    return titles->complete(prefix, found);
+}
+
+/*-------------------------------------------------------------------------
+* countCheckout(const Item&)
+* 
+* Counts a checkout towards the popularity of the Item's title, which
+* ranks autocomplete results
+* @pre: the Item is in one of the sections
+* @post: its title has one more checkout
+* @param: const Item& - the Item checked out
+*/
+void Library::countCheckout(const Item& item) {
+    titles->countCheckout(item, 1);
+}
+
+/*-------------------------------------------------------------------------
+* searchTitles(const string&, vector<Item*>&)
+* 
+* Keyword search over the titles of every section: the Items whose
+* titles hold every word given, the titles they make up most of
+* first (see WordIndex)
+* @pre: Library exists
+* @post: Library object is unchanged
+* @param: const string& - the words, in any order and case
+* @param: vector<Item*>& - set to the best Items found, at most
+* WORD_SEARCH_RESULTS
+* @return: long - number of Items whose titles hold every word
+*/
+long Library::searchTitles(const string& query, vector<Item*>& found) const {
+    return words->search(query, found);
+}
+
+/*-------------------------------------------------------------------------
+* collectYear(int, vector<Item*>&)
+* 
+* The periodicals of a year, in date order. With the default storage
+* they are one run of month buckets of the calendar section; the other
+* storages walk the whole section and keep that year's issues.
+* @pre: Library exists
+* @post: Library object is unchanged
+* @param: int - the year
+* @param: vector<Item*>& - set to the issues of that year, by month
+* then title. They stay valid until the library is deleted.
+*/
+void Library::collectYear(int year, vector<Item*>& issues) const {
+    issues.clear();
+    int index = hash(PeriodicalBook::TYPE);
+    if (libraryStorage[index] == nullptr) {
+        return;
+    }
+    if (sectionRetrieve[index] == &retrieveDated) {
+        static_cast<const CalendarSection*>(libraryStorage[index])->collectMonths(year, 1, year, 12, issues);
+        return;
+    }
+    vector<Item*> all;
+    libraryStorage[index]->collect(all);
+    for (size_t i = 0; i < all.size(); i++) {
+        if (static_cast<PeriodicalBook*>(all[i])->getYear() == year) {
+            issues.push_back(all[i]);
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------
+* getStatistics()
+* 
+* Gives access to the command statistics, so transactions can report
+* their errors and servers can count what they execute on their own
+* @pre: Library exists
+* @post: None
+* @return: CommandStats& - the library's statistics
+*/
+CommandStats& Library::getStatistics() const {
+    return statistics;
+}
+
+/*-------------------------------------------------------------------------
+* displayStatistics(ostream&)
+* 
+* Prints the command statistics kept since the library was built
+* @pre: Library exists
+* @post: Library object is unchanged
+* @param: ostream& - where the statistics are printed
+*/
+void Library::displayStatistics(ostream& out) const {
+    statistics.display(out);
+}
+
+// prints counts[first..] summed over power of two ranges: 1, 2-3, 4-7, ...
+static void displayRanges(ostream& out, const vector<int>& counts, int first) {
+    int low = first;
+    while (low < counts.size()) {
+        int high = (low == 0) ? 0 : 2 * low - 1;
+        long sum = 0;
+        for (int i = low; i <= high && i < counts.size(); i++) {
+            sum += counts[i];
+        }
+        if (sum > 0) {
+            out << "  " << low;
+            if (high > low) {
+                out << '-' << high;
+            }
+            out << ':' << sum;
+        }
+        low = high + 1;
+    }
+    out << endl;
+}
+
+/*-------------------------------------------------------------------------
+* displayStorage(ostream&)
+* 
+* Prints the shape and memory of every section's tree (items, height, 
+* average lookup depth, bytes, index bytes, items per MB, depth histogram),
+* the size of the StringPool, and the shape of the patron 
+* HashTable (load factor, longest chain, chain length histogram)
+* @pre: Library exists
+* @post: Library object is unchanged
+* @param: ostream& - where the storage report is printed
+*/
+void Library::displayStorage(ostream& out) const {
+    out << "----------------------------------------";
+    out << "----------------------------------------" << endl;
+    out << "STORAGE" << endl << endl;
+    out << left << setw(18) << "SECTION" << right << setw(9) << "ITEMS" << setw(9) << "HEIGHT"
+        << setw(11) << "AVG DEPTH" << setw(11) << "NODE KB" << setw(11) << "ITEM KB"
+        << setw(11) << "STRING KB" << setw(11) << "INDEX KB" << setw(10) << "ITEMS/MB" << endl;
+    out << fixed << setprecision(1);
+    vector<Section::Shape> shapes(MEDIA_TYPES);
+    for (int i = 0; i < MEDIA_TYPES; i++) {
+        if (libraryStorage[i] == nullptr) {
+            continue;
+        }
+        Section::Shape& shape = shapes[i];
+        libraryStorage[i]->measure(shape);
+        out << left << setw(18) << libraryStorage[i]->getName() << right
+            << setw(9) << shape.nodes << setw(9) << shape.height
+            << setw(11) << shape.averageDepth << setw(11) << shape.nodeBytes / 1024.0
+            << setw(11) << shape.itemBytes / 1024.0 << setw(11) << shape.stringBytes / 1024.0
+            << setw(11) << shape.indexBytes / 1024.0;
+        long bytes = shape.nodeBytes + shape.itemBytes + shape.stringBytes + shape.indexBytes;
+        out << setw(10) << ((bytes > 0) ? shape.nodes / (bytes / 1e6) : 0.0) << endl;
+    }
+    out << endl << "items per depth:" << endl;
+    for (int i = 0; i < MEDIA_TYPES; i++) {
+        if (libraryStorage[i] != nullptr) {
+            out << left << setw(18) << libraryStorage[i]->getName() << right;
+            displayRanges(out, shapes[i].depths, 1);
+        }
+    }
+    out << endl << "frozen (perfect hash index):";
+    for (int i = 0; i < MEDIA_TYPES; i++) {
+        if (libraryStorage[i] != nullptr && libraryStorage[i]->isFrozen()) {
+            out << " " << libraryStorage[i]->getName();
+        }
+    }
+    out << endl;
+    out << "string pool (titles and authors too long for the Items): "
+        << StringPool::getCount() << " strings, " << StringPool::getBytes() / 1024.0 << " KB"
+        << endl;
+    out << "title trie (autocomplete): " << titles->getTitleCount() << " titles in "
+        << titles->getNodeCount() << " nodes, " << titles->getBytes() / 1024.0 << " KB" << endl;
+    out << "word index (keyword search): " << words->getItemCount() << " items, "
+        << words->getWordCount() << " words, " << words->getPostingCount() << " postings, "
+        << words->getBytes() / 1024.0 << " KB" << endl;
+
+    HashTable::Shape table;
+    patrons->measure(table);
+    out << endl << "PATRONS: " << table.entries << " in " << table.buckets
+        << " buckets, load factor " << setprecision(2) << table.loadFactor
+        << ", longest chain " << table.longestChain << ", " << setprecision(1)
+        << table.bytes / 1024.0 << " KB" << endl;
+    out << "buckets per chain length:" << endl << left << setw(18) << "" << right;
+    displayRanges(out, table.chains, 0);
+    out.unsetf(ios::floatfield);
+    out << setprecision(6);
+    out << "----------------------------------------";
+    out << "----------------------------------------" << endl;
+}
+
+/*-------------------------------------------------------------------------
+* setStatisticsDump(const string&, int)
+* 
+* Sets where and how often the statistics and storage report are 
+* written while commands run. Like snapshots, the file is written to a
+* temporary file and renamed into place, so it is always complete.
+* @pre: Library object exists
+* @post: the file is rewritten every interval commands from now on
+* (interval <= 0 disables it)
+* @param: const string& - path of the statistics file
+* @param: int - number of commands between dumps
+*/
+void Library::setStatisticsDump(const string& path, int interval) {
+    statisticsPath = path;
+    statisticsInterval = interval;
+    commandsSinceDump = 0;
+}
+
+/*-------------------------------------------------------------------------
+* dumpStatistics(ostream&)
+* 
+* Writes the command statistics followed by the storage report
+* @pre: Library object exists
+* @post: Library object is unchanged
+* @param: ostream& - where the statistics are written
+*/
+void Library::dumpStatistics(ostream& out) const {
+    displayStatistics(out);
+    displayStorage(out);
+}
+
 /*-------------------------------------------------------------------------
 * hash(char type)
 * 
 * Finds the index for a certain Item tree using hashing on the parameter 
-* char
+* char, with typeIndex() like the factories (any character is safe)
 * @pre: Library exists
 * @post: Library object is unchanged
 * @param: char type - the character associated with the Item type of the 
@@ -234,5 +1012,403 @@ BinarySearchTree* Library::findTree(char type) const {
 * @return: int - index of tree to be found in libraryStorage[]
 */ 
 int Library::hash(char type) const {
-    return type - 'A';
-}
\ No newline at end of file
+    return typeIndex(type);
+}
+
+/*-------------------------------------------------------------------------
+* findInSection(char, const Item&, Item*&, int&)
+* 
+* Searches the section of the given type with the lookup compiled for
+* that type. Nothing is counted, so recovery threads can use it.
+* @pre: type has a section, target is of that type
+* @post: Library object is unchanged
+* @param: char - the Item type of the section searched
+* @param: const Item& - the item to find
+* @param: Item*& - set to the Item found, unchanged if not found
+* @param: int& - set to the number of nodes visited
+* @return: bool - true if found
+*/ 
+bool Library::findInSection(char type, const Item& target, Item*& found, int& depth) const {
+    int index = hash(type);
+    return sectionRetrieve[index](*libraryStorage[index], target, found, depth);
+}
+
+// **************************************** // 
+// *** Logging and recovery start here **** // 
+// **************************************** // 
+/*-------------------------------------------------------------------------
+* openTransactionLog(const string&)
+* 
+* Opens (appending to) the transaction log. Every transaction that is 
+* saved to a patron history by acceptTransactions() is written to the log
+* as one line: a sequence number followed by the transaction record. The
+* log is flushed after every record.
+* @pre: Library object exists
+* @post: saved transactions are logged from now on
+* @param: const string& - path of the log file
+* @return: bool - true if the log could be opened
+*/
+bool Library::openTransactionLog(const string& path) {
+    // a record torn by a crash has no newline, start on a fresh line so the 
+    // next record isn't glued onto it
+    bool tornTail = false;
+    ifstream existing(path.c_str());
+    if (existing.seekg(-1, ios::end)) {
+        tornTail = (existing.get() != '\n');
+    }
+    existing.close();
+
+    transactionLog.open(path.c_str(), ios::app);
+    if (tornTail) {
+        transactionLog << endl;
+    }
+    return transactionLog.is_open();
+}
+
+/*-------------------------------------------------------------------------
+* setSnapshotPolicy(const string&, int)
+* 
+* Sets where and how often snapshots are taken. A snapshot is written 
+* every time the number of logged records reaches a multiple of the 
+* interval. Snapshots are written to a temporary file and renamed into 
+* place, so the snapshot file is always complete.
+* @pre: Library object exists, transaction log is open
+* @post: snapshots are taken from now on (interval <= 0 disables them)
+* @param: const string& - path of the snapshot file
+* @param: int - number of logged records between snapshots
+*/
+void Library::setSnapshotPolicy(const string& path, int interval) {
+    snapshotPath = path;
+    snapshotInterval = interval;
+}
+
+/*-------------------------------------------------------------------------
+* saveSnapshot(ostream&)
+* 
+* Writes the current log sequence number, the stock of every Item and the
+* saved history of every Patron.
+* @pre: Library object exists
+* @post: Library object is unchanged
+* @param: ostream& - stream the snapshot is written to
+*/
+void Library::saveSnapshot(ostream& out) const {
+    out << "SNAPSHOT " << logSequence << '\n';
+
+    // every item with its section, in sorted order per section
+    vector<Item*> items;
+    vector<char> itemTypes;
+    for (int i = 0; i < MEDIA_TYPES; i++) {
+        if (libraryStorage[i] != nullptr) {
+            libraryStorage[i]->collect(items);
+            itemTypes.resize(items.size(), 'A' + i);
+        }
+    }
+    out << "ITEMS " << items.size() << '\n';
+    for (int i = 0; i < items.size(); i++) {
+        out << itemTypes[i] << ' ' << items[i]->getStock() << ' ' 
+            << items[i]->getFormat();
+        items[i]->writeTransactionData(out);
+        out << '\n';
+    }
+
+    // every patron's history, which also rebuilds their checked out items
+    vector<Patron*> patronList;
+    patrons->collect(patronList);
+    out << "PATRONS " << patronList.size() << '\n';
+    for (int i = 0; i < patronList.size(); i++) {
+        patronList[i]->saveHistory(out);
+    }
+}
+
+/*-------------------------------------------------------------------------
+* recover(ifstream&, ifstream&)
+* 
+* Rebuilds stock, checked out items and patron histories after a crash. 
+* The snapshot is loaded first, then every log record newer than the 
+* snapshot is redone. Nothing is printed and nothing is re-validated, 
+* the log only holds transactions that were valid when executed. Redo is
+* partitioned by patron and runs on all available cores.
+* @pre: books and patrons were built from the same files as before the 
+* crash, and no transactions were accepted yet. Either stream may be 
+* unopened or empty (no snapshot taken yet, or no log).
+* @post: Library is in the state it was in after the last logged record
+* @param: ifstream& - the snapshot file
+* @param: ifstream& - the transaction log
+*/
+void Library::recover(ifstream& snapshot, ifstream& log) {
+    long snapshotSequence = loadSnapshot(snapshot);
+    logSequence = snapshotSequence;
+
+    vector<LogRecord> records;
+    string line;
+    while (getline(log, line)) {
+        long sequence = 0;
+        LogRecord record;
+        if (readRecord(line, true, sequence, record)) {
+            if (sequence > snapshotSequence) {
+                records.push_back(record);
+                logSequence = sequence;
+            } else {
+                delete record.item;
+            }
+        }
+    }
+    redo(records, true);
+}
+
+/*-------------------------------------------------------------------------
+* logTransaction(const Transaction*)
+* 
+* Appends a saved transaction to the log (if open) and takes a snapshot 
+* when the snapshot interval is reached
+* @pre: transaction has been executed and saved to a patron's history
+* @post: log holds the transaction record
+* @param: const Transaction* - the transaction to log
+*/
+void Library::logTransaction(const Transaction* transaction) {
+    if (!transactionLog.is_open()) {
+        return;
+    }
+    logSequence++;
+    transactionLog << logSequence << ' ';
+    transaction->save(transactionLog);
+    transactionLog << endl;
+
+    if (snapshotInterval > 0 && snapshotPath != "" && 
+        logSequence % snapshotInterval == 0) {
+        takeSnapshot();
+    }
+}
+
+/*-------------------------------------------------------------------------
+* readRecord(const string&, bool, long&, LogRecord&)
+* 
+* Parses one line of the log (sequence number first) or of a snapshot's 
+* patron histories. Lines that were torn by a crash are rejected.
+* @pre: Library exists
+* @post: on success, record holds a newly allocated probe item
+* @param: const string& - the line to parse
+* @param: bool - true if the line starts with a sequence number
+* @param: long& - set to the sequence number, if there is one
+* @param: LogRecord& - the parsed record
+* @return: bool - true if the line was a complete record
+*/
+bool Library::readRecord(const string& line, bool hasSequence, long& sequence, 
+                         LogRecord& record) {
+    // every complete record ends with the comma closing its item data
+    size_t last = line.find_last_not_of(" \r");
+    if (last == string::npos || line[last] != ',') {
+        return false;
+    }
+    istringstream fields(line);
+    if (hasSequence) {
+        fields >> sequence;
+    }
+    char itemFormat;
+    fields >> record.type >> record.patronID >> record.itemType >> itemFormat;
+    if (!fields) {
+        return false;
+    }
+    record.item = itemFactory->createItem(record.itemType);
+    if (record.item == nullptr) {
+        return false;
+    }
+    record.item->setTransactionData(fields);
+    record.item->setFormat(itemFormat);
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* loadSnapshot(ifstream&)
+* 
+* Sets the stock of every Item and replays every patron history found 
+* in the snapshot
+* @pre: no transactions were accepted yet
+* @post: Library is in the state it was in when the snapshot was taken
+* @param: ifstream& - the snapshot file
+* @return: long - log sequence number of the snapshot (0 if none)
+*/
+long Library::loadSnapshot(ifstream& infile) {
+    string label;
+    long sequence = 0;
+    int count = 0;
+    if (!(infile >> label >> sequence)) {
+        return 0;
+    }
+
+    // stock of every item
+    infile >> label >> count;
+    for (int i = 0; i < count; i++) {
+        char itemType;
+        int stock;
+        char itemFormat;
+        infile >> itemType >> stock >> itemFormat;
+        Item* probe = itemFactory->createItem(itemType);
+        if (probe == nullptr) {
+            string oldLine = "";
+            getline(infile, oldLine);
+            continue;
+        }
+        probe->setTransactionData(infile);
+        probe->setFormat(itemFormat);
+        Item* realItem = nullptr;
+        int depth = 0;
+        if (findInSection(itemType, *probe, realItem, depth)) {
+            realItem->modifyStock(stock - realItem->getStock());
+        }
+        delete probe;
+    }
+
+    // history of every patron, replayed without touching stock
+    vector<LogRecord> records;
+    infile >> label >> count;
+    for (int i = 0; i < count; i++) {
+        int patronID;
+        int historyLength;
+        infile >> patronID >> historyLength;
+        string line;
+        getline(infile, line); // rest of the patron line
+        for (int j = 0; j < historyLength && getline(infile, line); j++) {
+            long unused;
+            LogRecord record;
+            if (readRecord(line, false, unused, record)) {
+                records.push_back(record);
+            }
+        }
+    }
+    redo(records, false);
+    return sequence;
+}
+
+/*-------------------------------------------------------------------------
+* redo(vector<LogRecord>&, bool)
+* 
+* Replays records on one thread per core. Records are partitioned by 
+* patron so each patron's history is rebuilt in log order by a single 
+* thread. Stock changes and checkouts are summed per thread and applied
+* afterwards. Deletes the probe items of all records.
+* @pre: trees and patrons are not changed by anyone else meanwhile
+* @post: patrons reflect the records, stock as well if asked to. The
+* checkouts among them count towards their titles' popularity either way.
+* @param: vector<LogRecord>& - records in log order
+* @param: bool - true if stock should be changed by the records
+*/
+void Library::redo(vector<LogRecord>& records, bool changeStock) {
+    unsigned int workers = thread::hardware_concurrency();
+    if (workers == 0) {
+        workers = 1;
+    }
+
+    // all records of one patron land in the same partition, in log order
+    vector<vector<LogRecord*> > partitions(workers);
+    for (int i = 0; i < records.size(); i++) {
+        unsigned int owner = static_cast<unsigned int>(records[i].patronID) % workers;
+        partitions[owner].push_back(&records[i]);
+    }
+
+    // trees and the patron table are only read, each patron is only 
+    // written by its own partition's thread
+    vector<map<Item*, int> > stockChanges(workers);
+    vector<map<Item*, long> > checkouts(workers);
+    vector<thread> threads;
+    for (unsigned int i = 0; i < workers; i++) {
+        threads.push_back(thread(&Library::redoPartition, this, 
+                                 cref(partitions[i]), ref(stockChanges[i]), ref(checkouts[i])));
+    }
+    for (int i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    if (changeStock) {
+        for (int i = 0; i < stockChanges.size(); i++) {
+            map<Item*, int>::iterator change;
+            for (change = stockChanges[i].begin(); change != stockChanges[i].end(); ++change) {
+                change->first->modifyStock(change->second);
+            }
+        }
+    }
+    // the trie isn't safe to change from the threads
+    for (int i = 0; i < checkouts.size(); i++) {
+        map<Item*, long>::iterator count;
+        for (count = checkouts[i].begin(); count != checkouts[i].end(); ++count) {
+            titles->countCheckout(*count->first, count->second);
+        }
+    }
+    for (int i = 0; i < records.size(); i++) {
+        delete records[i].item;
+        records[i].item = nullptr;
+    }
+}
+
+/*-------------------------------------------------------------------------
+* redoPartition(const vector<LogRecord*>&, map<Item*, int>&, map<Item*, long>&)
+* 
+* Replays one partition of records (see redo) on the calling thread
+* @pre: no other thread works on the same patrons
+* @post: patrons in the partition reflect the records
+* @param: const vector<LogRecord*>& - records of this partition in order
+* @param: map<Item*, int>& - stock change per Item of this partition
+* @param: map<Item*, long>& - checkouts per Item of this partition (kept
+* apart from the stock: a return gives the stock back, not the popularity)
+*/
+void Library::redoPartition(const vector<LogRecord*>& partition, 
+                            map<Item*, int>& stockChanges, map<Item*, long>& checkouts) {
+    for (int i = 0; i < partition.size(); i++) {
+        const LogRecord* record = partition[i];
+        Patron* patron = nullptr;
+        // straight to the table, statistics aren't safe to count from threads
+        patrons->retrieve(record->patronID, patron);
+        Item* realItem = nullptr;
+        int depth = 0;
+        if (patron == nullptr || !findInSection(record->itemType, *record->item, realItem, depth)) {
+            continue; // library files don't match the log, nothing to redo
+        }
+        Transaction* transaction = transactionFactory->createTransaction(record->type);
+        if (transaction) {
+            int stockChange = 0;
+            if (!transaction->replay(patron, record->itemType, realItem, stockChange)) {
+                delete transaction;
+            }
+            stockChanges[realItem] += stockChange;
+            if (record->type == Checkout::TYPE) {
+                checkouts[realItem]++;
+            }
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------
+* takeSnapshot()
+* 
+* Writes a snapshot to a temporary file and renames it over snapshotPath
+* @pre: snapshotPath is set
+* @post: snapshotPath holds the current state
+*/
+void Library::takeSnapshot() {
+    string tempPath = snapshotPath + ".tmp";
+    ofstream outfile(tempPath.c_str());
+    saveSnapshot(outfile);
+    outfile.close();
+    rename(tempPath.c_str(), snapshotPath.c_str());
+}
+
+/*-------------------------------------------------------------------------
+* countForDump()
+* 
+* Counts an executed command and rewrites the statistics file when the
+* dump interval is reached
+* @pre: a command was just executed
+* @post: statisticsPath holds the current statistics, if it was time
+*/
+void Library::countForDump() {
+    if (statisticsInterval <= 0 || statisticsPath == "" || 
+        ++commandsSinceDump < statisticsInterval) {
+        return;
+    }
+    commandsSinceDump = 0;
+    string tempPath = statisticsPath + ".tmp";
+    ofstream outfile(tempPath.c_str());
+    dumpStatistics(outfile);
+    outfile.close();
+    rename(tempPath.c_str(), statisticsPath.c_str());
+}
@@ -14,6 +14,14 @@
 //    and transactions. These transactions are executed in the order 
 //    received and update the library's data each time something is modified. 
 // -- entire library can be displayed to the user 
+// -- Saved transactions can be appended to a transaction log, and periodic
+//    snapshots of stock and patron history can be written. recover() rebuilds
+//    the state from the latest snapshot plus the newer log records.
+// -- The catalog can be changed in place by a delta file (adds, removals,
+//    stock adjustments) instead of being rebuilt from the books file.
+// -- Titles of every section can be autocompleted from a prefix, most
+//    checked out first (a TitleTrie kept in step with the sections).
+// -- Titles can be searched by their words (a WordIndex, also kept in step).
 //
 // Assumptions/implementation: 
 // -- For the library to be fully functional, all .txt files used for building
@@ -24,7 +32,16 @@
 // -- Library storage uses binarysearchtrees which are hashed to within the 
 //    libraryStorage array. This allows the implementation to avoid using 
 //    switch-cases or if/else statements for determining and accessing proper 
-//    item storage.
+//    item storage. Each section is a Section: a BinarySearchTree of heap
+//    Items, or a ValueSection with the Items inside its nodes when the
+//    Library is created with VALUE_SECTIONS, or an EytzingerSection that
+//    lays the loaded books out in one array (for display and the ordered
+//    walks) with EYTZINGER_SECTIONS, or
+//    an LsmSection (write buffer and sorted runs) with LSM_SECTIONS.
+//    Exact lookups (checkouts,
+//    returns, recovery) go to the section's key index, not its tree; with
+//    the default storage the periodicals are a CalendarSection, looked up
+//    in the bucket of their month instead.
 // -- Library uses HashTable to store Patrons for instant lookup by ID.
 // -- Library uses factories to create both Items and Transactions.
 // -- Library must be dynamically allocated and deleted in order for there to 
@@ -34,16 +51,32 @@
 #ifndef LIBRARY_H
 #define LIBRARY_H
 #include <vector>
+#include <map>
+#include <fstream>
+#include <string>
 #include "binarysearchtree.h"
 #include "itemfactory.h"
 #include "item.h"
 #include "hashtable.h"
 #include "transactionfactory.h"
+#include "command.h"
+#include "commandstats.h"
 #include "patron.h"
 #include "constants.h"
+#include "linereader.h"
+#include "titletrie.h"
+#include "wordindex.h"
 
 using namespace std;
 
+// what applyCatalogDelta() did with the lines of a delta file
+struct DeltaCounts {
+    long added;      // Items added to their section
+    long removed;    // Items taken out of their section
+    long adjusted;   // stock adjustments applied
+    long rejected;   // lines not applied: bad operation or type, Item
+                     // already there or not found, stock below 0
+};
 
 class Library {
     public:
@@ -55,9 +88,12 @@ class Library {
         * and the patron hashTable[]. 
         * @pre: None
         * @post: Library object gets created 
-        * @param: None
+        * @param: SectionStorage - how the sections store their Items: trees of
+        * heap Items (the default), Items embedded in the tree nodes, Items
+        * laid out in Eytzinger order once the books are built, or a write
+        * buffer and sorted runs
         */
-        Library();
+        Library(SectionStorage storage = POINTER_SECTIONS);
 
         /*-------------------------------------------------------------------------
         * Destructor
@@ -76,7 +112,7 @@ class Library {
         * data and can be categorized by the first character on each line 
         * @pre: Library object and the file that ifstream& references must exist 
         * @post: Media trees in Library object now contain any entries in the given
-        * book data
+        * book data. Eytzinger sections are laid out.
         * @param: ifstream& - references the file that contains book data
         */                          
         void buildBooksFromFile(ifstream&); 
@@ -93,18 +129,110 @@ class Library {
         * @param: Ifstream& - references the file that contains patron data 
         */         
         void buildPatronsFromFile(ifstream&); 
-        
+
         /*-------------------------------------------------------------------------
-        * acceptTransactions(ifstream&)
+        * applyCatalogDelta(ifstream&)
         * 
-        * Executes all the transactions from the given data file. Each transaction 
-        * contains data and can be categorized by the first character on each line
+        * Changes the catalog in place from a delta file, one change per line:
+        *   + F Kerouac Jack, On the Road, 1957    add (a books file line)
+        *   - F H Kerouac Jack, On the Road,       remove (type, format, key
+        *                                          fields, as in a command)
+        *   ~ -2 F H Kerouac Jack, On the Road,    change the stock by a count
+        * Lines are read and their Items created DELTA_BATCH_RECORDS at a time,
+        * then the batch is applied in file order. Only the Items named are
+        * touched, so the cost follows the size of the delta, not the catalog.
         * @pre: Library object and the file that ifstream& references must exist 
+        * @post: sections changed as the lines say. Removed Items are kept (not
+        * freed) until the library is deleted, so patrons holding them, and
+        * their histories, keep valid pointers.
+        * @param: ifstream& - references the delta file
+        * @return: DeltaCounts - lines applied (by operation) and rejected
+        */         
+        DeltaCounts applyCatalogDelta(ifstream&);
+
+        /*-------------------------------------------------------------------------
+        * freeze()
+        * 
+        * Freezes every section for a catalog that only changes stock from now on:
+        * each section's keys get a minimal perfect hash index (see
+        * PerfectHashIndex), so a checkout or return finds its Item in one or two
+        * memory accesses. A later catalog delta thaws the sections it changes.
+        * @pre: Library object exists
+        * @post: sections are frozen, unless their perfect hash could not be built.
+        * The calendar section of the periodicals has no hash index and stays as
+        * it is.
+        * @return: bool - true if every section that has a hash index was frozen
+        */
+        bool freeze();
+        
+        /*-------------------------------------------------------------------------
+        * acceptTransactions(istream&)
+        * 
+        * Executes all the transactions from the given stream (a file, a string or
+        * a socket buffer). Each transaction contains data and can be categorized
+        * by the first character on each line. Lines are parsed into Commands on
+        * a separate thread while this thread executes them in order.
+        * @pre: Library object and the stream that istream& references must exist 
         * @post: Patrons in Patron HashTable and Items in the media trees are 
         * changed or unchanged. Transactions are recorded for Patrons, when needed.
-        * @param: infile& - references the file that contains transaction data 
+        * @param: infile& - references the stream that contains transaction data 
         */         
-        void acceptTransactions(ifstream&);
+        void acceptTransactions(istream&);
+
+        /*-------------------------------------------------------------------------
+        * acceptTransactions(LineReader&)
+        * 
+        * Same as acceptTransactions(istream&), for commands streamed from any
+        * byte source (stdin, a pipe, a socket or a file). Memory stays bounded
+        * however long the stream is: the reader's buffer and the queue of
+        * parsed chunks are both of fixed size, and a full queue stops reading.
+        * @pre: Library object exists
+        * @post: as acceptTransactions(istream&), the stream has ended
+        * @param: LineReader& - the source of the commands
+        */         
+        void acceptTransactions(LineReader&);
+
+        /*-------------------------------------------------------------------------
+        * acceptTransactions(ParallelParser&)
+        * 
+        * Same as acceptTransactions(istream&), for a command file already in
+        * memory (mapped) that is parsed by several threads at once. Commands
+        * are still executed one at a time, in the order of the file.
+        * @pre: Library object exists
+        * @post: as acceptTransactions(istream&), every block was executed
+        * @param: ParallelParser& - the parser of the command file
+        */         
+        void acceptTransactions(ParallelParser&);
+
+        /*-------------------------------------------------------------------------
+        * acceptCommand(const Command&)
+        * 
+        * Executes one parsed command and logs it if it was saved to a patron's 
+        * history. An invalid transaction type is reported.
+        * @pre: Library object exists
+        * @post: Patrons in Patron HashTable and Items in the media trees are 
+        * changed or unchanged. The transaction is recorded for its Patron, when
+        * needed.
+        * @param: const Command& - the parsed command
+        */         
+        void acceptCommand(const Command&);
+
+        /*-------------------------------------------------------------------------
+        * acceptBatch(const vector<string>&, vector<string>&)
+        * 
+        * Executes a batch of command lines (one command per line) in stages 
+        * instead of one command at a time: every line is parsed first, then 
+        * every patron is looked up (prefetching the chains a few commands ahead),
+        * then every item, and finally the commands are applied in order. Lookups
+        * only read the library, so the result is the same as executing the lines
+        * one by one, only with fewer stalls on memory.
+        * @pre: Library object exists
+        * @post: Library is changed as by acceptTransactions() on the same lines,
+        * saved transactions are logged
+        * @param: const vector<string>& - the command lines
+        * @param: vector<string>& - set to what each command printed, in order
+        */         
+        void acceptBatch(const vector<string>&, vector<string>&);
 
         /*-------------------------------------------------------------------------
         * display() 
@@ -117,6 +245,42 @@ class Library {
         */         
         void display() const;
 
+        // how far a display run in parts (startDisplay, displayPart) has got
+        struct DisplayProgress {
+            int section;            // section being displayed, -1 before any
+            vector<Item*> items;    // items of that section in display order
+            size_t next;            // next item of the section to display
+            bool empty;             // no section has been displayed
+        };
+
+        /*-------------------------------------------------------------------------
+        * startDisplay(DisplayProgress&)
+        * 
+        * Starts a display that is printed in parts by displayPart(), so other 
+        * commands can run between the parts. Together the parts print exactly
+        * what display() prints.
+        * @pre: None
+        * @post: the opening line of the display is printed
+        * @param: DisplayProgress& - set to the start of the display
+        */
+        void startDisplay(DisplayProgress&) const;
+
+        /*-------------------------------------------------------------------------
+        * displayPart(DisplayProgress&, int)
+        * 
+        * Prints the next items of a display started by startDisplay(), along 
+        * with the section headers and closing line they come with. Sections are
+        * never added or removed while serving, so a section can be picked up
+        * again after other commands ran; stock shown is the stock at the time 
+        * each part is printed.
+        * @pre: startDisplay() was called with this progress
+        * @post: up to the given number of items are printed
+        * @param: DisplayProgress& - where the display is, advanced
+        * @param: int - most items to print
+        * @return: bool - true once the whole display has been printed
+        */
+        bool displayPart(DisplayProgress&, int) const;
+
         /*-------------------------------------------------------------------------
         * retrievePatron(int, Patron*&)
         * 
@@ -150,28 +314,373 @@ class Library {
         * @post: Library object is unchanged
         * @param: char type - the character associated with the Item type of the 
         * tree to be found
-        * @return: BinarySearchTree* - returns pointer to the tree to be found
+        * @return: Section* - returns pointer to the tree to be found
         */         
-        BinarySearchTree* findTree(char type) const;
+        Section* findTree(char type) const;
+
+        /*-------------------------------------------------------------------------
+        * retrieveItem(char, const Item&, Item*&)
+        * 
+        * Searches the section of the given Item type for the target (one probe
+        * of its key index). If found, the parameter reference now points to the
+        * Item in the library. Method is only used once type is validated.
+        * @pre: Library exists, type has a tree
+        * @post: Library object is unchanged (the lookup is counted)
+        * @param: char - the Item type of the tree searched
+        * @param: const Item& - the item to find
+        * @param: Item*& - set to the Item found, unchanged if not found
+        * @return: bool - true if found
+        */
+        bool retrieveItem(char, const Item&, Item*&) const;
+
+        /*-------------------------------------------------------------------------
+        * completeTitle(const string&, vector<const TitleTrie::Title*>&)
+        * 
+        * Autocomplete over the titles of every section: the titles starting
+        * with a prefix, most checked out first (see TitleTrie)
+        * @pre: Library exists
+        * @post: Library object is unchanged
+        * @param: const string& - the prefix, as typed (case and extra blanks
+        * don't matter)
+        * @param: vector<const TitleTrie::Title*>& - set to the titles found,
+        * at most AUTOCOMPLETE_RESULTS. They stay valid until the catalog is
+        * rebuilt or changed by a delta.
+        * @return: int - number of titles found
+        */
+        int completeTitle(const string&, vector<const TitleTrie::Title*>&) const;
+
+        /*-------------------------------------------------------------------------
+        * countCheckout(const Item&)
+        * 
+        * Counts a checkout towards the popularity of the Item's title, which
+        * ranks autocomplete results
+        * @pre: the Item is in one of the sections
+        * @post: its title has one more checkout
+        * @param: const Item& - the Item checked out
+        */
+        void countCheckout(const Item&);
+
+        /*-------------------------------------------------------------------------
+        * searchTitles(const string&, vector<Item*>&)
+        * 
+        * Keyword search over the titles of every section: the Items whose
+        * titles hold every word given, the titles they make up most of
+        * first (see WordIndex)
+        * @pre: Library exists
+        * @post: Library object is unchanged
+        * @param: const string& - the words, in any order and case
+        * @param: vector<Item*>& - set to the best Items found, at most
+        * WORD_SEARCH_RESULTS
+        * @return: long - number of Items whose titles hold every word
+        */
+        long searchTitles(const string&, vector<Item*>&) const;
+
+        /*-------------------------------------------------------------------------
+        * collectYear(int, vector<Item*>&)
+        * 
+        * The periodicals of a year, in date order. With the default storage
+        * they are one run of month buckets of the calendar section; the other
+        * storages walk the whole section and keep that year's issues.
+        * @pre: Library exists
+        * @post: Library object is unchanged
+        * @param: int - the year
+        * @param: vector<Item*>& - set to the issues of that year, by month
+        * then title. They stay valid until the library is deleted.
+        */
+        void collectYear(int, vector<Item*>&) const;
+
+        /*-------------------------------------------------------------------------
+        * getStatistics()
+        * 
+        * Gives access to the command statistics, so transactions can report
+        * their errors and servers can count what they execute on their own
+        * @pre: Library exists
+        * @post: None
+        * @return: CommandStats& - the library's statistics
+        */
+        CommandStats& getStatistics() const;
+
+        /*-------------------------------------------------------------------------
+        * displayStatistics(ostream&)
+        * 
+        * Prints the command statistics kept since the library was built
+        * @pre: Library exists
+        * @post: Library object is unchanged
+        * @param: ostream& - where the statistics are printed
+        */
+        void displayStatistics(ostream&) const;
+
+        /*-------------------------------------------------------------------------
+        * displayStorage(ostream&)
+        * 
+        * Prints the shape and memory of every section's tree (items, height, 
+        * average lookup depth, bytes, index bytes, items per MB, depth histogram),
+        * the size of the StringPool, the title trie and the word index, and the shape of the patron 
+        * HashTable (load factor, longest chain, chain length histogram)
+        * @pre: Library exists
+        * @post: Library object is unchanged
+        * @param: ostream& - where the storage report is printed
+        */
+        void displayStorage(ostream&) const;
+
+        /*-------------------------------------------------------------------------
+        * setStatisticsDump(const string&, int)
+        * 
+        * Sets where and how often the statistics and storage report are 
+        * written while commands run. Like snapshots, the file is written to a
+        * temporary file and renamed into place, so it is always complete.
+        * @pre: Library object exists
+        * @post: the file is rewritten every interval commands from now on
+        * (interval <= 0 disables it)
+        * @param: const string& - path of the statistics file
+        * @param: int - number of commands between dumps
+        */
+        void setStatisticsDump(const string&, int);
+
+        /*-------------------------------------------------------------------------
+        * dumpStatistics(ostream&)
+        * 
+        * Writes the command statistics followed by the storage report
+        * @pre: Library object exists
+        * @post: Library object is unchanged
+        * @param: ostream& - where the statistics are written
+        */
+        void dumpStatistics(ostream&) const;
+
+        /*-------------------------------------------------------------------------
+        * openTransactionLog(const string&)
+        * 
+        * Opens (appending to) the transaction log. Every transaction that is 
+        * saved to a patron history by acceptTransactions() is written to the log
+        * as one line: a sequence number followed by the transaction record. The
+        * log is flushed after every record.
+        * @pre: Library object exists
+        * @post: saved transactions are logged from now on
+        * @param: const string& - path of the log file
+        * @return: bool - true if the log could be opened
+        */
+        bool openTransactionLog(const string&);
+
+        /*-------------------------------------------------------------------------
+        * setSnapshotPolicy(const string&, int)
+        * 
+        * Sets where and how often snapshots are taken. A snapshot is written 
+        * every time the number of logged records reaches a multiple of the 
+        * interval. Snapshots are written to a temporary file and renamed into 
+        * place, so the snapshot file is always complete.
+        * @pre: Library object exists, transaction log is open
+        * @post: snapshots are taken from now on (interval <= 0 disables them)
+        * @param: const string& - path of the snapshot file
+        * @param: int - number of logged records between snapshots
+        */
+        void setSnapshotPolicy(const string&, int);
+
+        /*-------------------------------------------------------------------------
+        * saveSnapshot(ostream&)
+        * 
+        * Writes the current log sequence number, the stock of every Item and the
+        * saved history of every Patron.
+        * @pre: Library object exists
+        * @post: Library object is unchanged
+        * @param: ostream& - stream the snapshot is written to
+        */
+        void saveSnapshot(ostream&) const;
+
+        /*-------------------------------------------------------------------------
+        * recover(ifstream&, ifstream&)
+        * 
+        * Rebuilds stock, checked out items and patron histories after a crash. 
+        * The snapshot is loaded first, then every log record newer than the 
+        * snapshot is redone. Nothing is printed and nothing is re-validated, 
+        * the log only holds transactions that were valid when executed. Redo is
+        * partitioned by patron and runs on all available cores.
+        * @pre: books and patrons were built from the same files as before the 
+        * crash, and no transactions were accepted yet. Either stream may be 
+        * unopened or empty (no snapshot taken yet, or no log).
+        * @post: Library is in the state it was in after the last logged record
+        * @param: ifstream& - the snapshot file
+        * @param: ifstream& - the transaction log
+        */
+        void recover(ifstream&, ifstream&);
 private:
         // Array to store all media type trees. 
         // Uses hash function to determine correct tree 
-        BinarySearchTree* libraryStorage[MEDIA_TYPES]; 
+        Section* libraryStorage[MEDIA_TYPES]; 
+
+        // lookup (in the key index) and insert of every section, compiled for
+        // its media type and storage (see SectionRegistrar), so neither makes
+        // a virtual call
+        typedef bool (*SectionRetrieve)(const Section&, const Item&, Item*&, int&);
+        typedef bool (*SectionInsert)(Section&, Item*);
+        SectionRetrieve sectionRetrieve[MEDIA_TYPES];
+        SectionInsert sectionInsert[MEDIA_TYPES];
+
+        // lays a section out once its books are built, nullptr for the
+        // storages that have nothing to lay out
+        typedef void (*SectionLayout)(Section&);
+        SectionLayout sectionLayout[MEDIA_TYPES];
+
+        // adds the section of every type in MediaTypes, defined in library.cpp
+        struct SectionRegistrar;
 
         // HashTable class to store patrons 
         HashTable* patrons;
+
+        // titles of every section, for autocomplete
+        TitleTrie* titles;
+
+        // words of the titles of every section, for keyword search
+        WordIndex* words;
         
         // generates transactions for Patrons
         TransactionFactory* transactionFactory; 
         
         // generates items for library tree   
         ItemFactory* itemFactory;          
+
+        // counts and times commands and lookups, changed by const lookups too
+        mutable CommandStats statistics;
+        string statisticsPath;   // where statistics are dumped while running
+        int statisticsInterval;  // commands between dumps (0 = never)
+        long commandsSinceDump;  // commands executed since the last dump
+
+        /*-------------------------------------------------------------------------
+        * countForDump()
+        * 
+        * Counts an executed command and rewrites the statistics file when the
+        * dump interval is reached
+        * @pre: a command was just executed
+        * @post: statisticsPath holds the current statistics, if it was time
+        */
+        void countForDump();
+
+        // one transaction record read back from the log or a snapshot. The 
+        // item is a probe built from the record, not the Item in the library
+        struct LogRecord {
+            char type;      // transaction type
+            int patronID;   // patron the transaction belongs to
+            char itemType;  // item type (section) of the item
+            Item* item;     // probe used to find the Item in its section
+        };
+
+        // one line of a catalog delta file, read but not applied yet
+        struct DeltaRecord {
+            char operation;  // '+' add, '-' remove, '~' adjust the stock
+            char itemType;   // item type (section) of the item
+            int count;       // stock change of an adjustment
+            Item* item;      // Item to add, or probe to find the one changed
+        };
+
+        /*-------------------------------------------------------------------------
+        * applyDeltaBatch(vector<DeltaRecord>&, DeltaCounts&)
+        * 
+        * Applies a batch of delta lines in order and empties it. Added Items
+        * go to their section, probes are deleted.
+        * @pre: every record has a valid operation and type
+        * @post: sections are changed, counts are updated, batch is empty
+        * @param: vector<DeltaRecord>& - the batch
+        * @param: DeltaCounts& - counts of what was applied
+        */
+        void applyDeltaBatch(vector<DeltaRecord>&, DeltaCounts&);
+
+        /*-------------------------------------------------------------------------
+        * probeFor(char, const Item&)
+        * 
+        * Copies the key fields of an Item into a new Item of its type, as the
+        * log does (writeTransactionData, then setTransactionData)
+        * @pre: type is the Item's type
+        * @post: Library object is unchanged
+        * @param: char - the Item type
+        * @param: const Item& - the Item copied
+        * @return: Item* - a newly allocated probe that finds the Item
+        */
+        Item* probeFor(char, const Item&);
+
+        ofstream transactionLog; // write-ahead log of saved transactions
+        long logSequence;        // sequence number of the last logged record
+        string snapshotPath;     // where snapshots are written
+        int snapshotInterval;    // logged records between snapshots (0 = never)
+
+        /*-------------------------------------------------------------------------
+        * logTransaction(const Transaction*)
+        * 
+        * Appends a saved transaction to the log (if open) and takes a snapshot 
+        * when the snapshot interval is reached
+        * @pre: transaction has been executed and saved to a patron's history
+        * @post: log holds the transaction record
+        * @param: const Transaction* - the transaction to log
+        */
+        void logTransaction(const Transaction*);
+
+        /*-------------------------------------------------------------------------
+        * readRecord(const string&, bool, long&, LogRecord&)
+        * 
+        * Parses one line of the log (sequence number first) or of a snapshot's 
+        * patron histories. Lines that were torn by a crash are rejected.
+        * @pre: Library exists
+        * @post: on success, record holds a newly allocated probe item
+        * @param: const string& - the line to parse
+        * @param: bool - true if the line starts with a sequence number
+        * @param: long& - set to the sequence number, if there is one
+        * @param: LogRecord& - the parsed record
+        * @return: bool - true if the line was a complete record
+        */
+        bool readRecord(const string&, bool, long&, LogRecord&);
+
+        /*-------------------------------------------------------------------------
+        * loadSnapshot(ifstream&)
+        * 
+        * Sets the stock of every Item and replays every patron history found 
+        * in the snapshot
+        * @pre: no transactions were accepted yet
+        * @post: Library is in the state it was in when the snapshot was taken
+        * @param: ifstream& - the snapshot file
+        * @return: long - log sequence number of the snapshot (0 if none)
+        */
+        long loadSnapshot(ifstream&);
+
+        /*-------------------------------------------------------------------------
+        * redo(vector<LogRecord>&, bool)
+        * 
+        * Replays records on one thread per core. Records are partitioned by 
+        * patron so each patron's history is rebuilt in log order by a single 
+        * thread. Stock changes and checkouts are summed per thread and applied
+        * afterwards. Deletes the probe items of all records.
+        * @pre: trees and patrons are not changed by anyone else meanwhile
+        * @post: patrons reflect the records, stock as well if asked to. The
+        * checkouts among them count towards their titles' popularity either way.
+        * @param: vector<LogRecord>& - records in log order
+        * @param: bool - true if stock should be changed by the records
+        */
+        void redo(vector<LogRecord>&, bool);
+
+        /*-------------------------------------------------------------------------
+        * redoPartition(const vector<LogRecord*>&, map<Item*, int>&, map<Item*, long>&)
+        * 
+        * Replays one partition of records (see redo) on the calling thread
+        * @pre: no other thread works on the same patrons
+        * @post: patrons in the partition reflect the records
+        * @param: const vector<LogRecord*>& - records of this partition in order
+        * @param: map<Item*, int>& - stock change per Item of this partition
+        * @param: map<Item*, long>& - checkouts per Item of this partition (kept
+        * apart from the stock: a return gives the stock back, not the popularity)
+        */
+        void redoPartition(const vector<LogRecord*>&, map<Item*, int>&, map<Item*, long>&);
+
+        /*-------------------------------------------------------------------------
+        * takeSnapshot()
+        * 
+        * Writes a snapshot to a temporary file and renames it over snapshotPath
+        * @pre: snapshotPath is set
+        * @post: snapshotPath holds the current state
+        */
+        void takeSnapshot();
         
         /*-------------------------------------------------------------------------
         * hash(char type)
         * 
         * Finds the index for a certain Item tree using hashing on the parameter 
-        * char
+        * char, with typeIndex() like the factories (any character is safe)
         * @pre: Library exists
         * @post: Library object is unchanged
         * @param: char type - the character associated with the Item type of the 
@@ -179,6 +688,21 @@ private:
         * @return: int - index of tree to be found in libraryStorage[]
         */ 
         int hash(char) const;              
+
+        /*-------------------------------------------------------------------------
+        * findInSection(char, const Item&, Item*&, int&)
+        * 
+        * Searches the section of the given type with the lookup compiled for
+        * that type. Nothing is counted, so recovery threads can use it.
+        * @pre: type has a section, target is of that type
+        * @post: Library object is unchanged
+        * @param: char - the Item type of the section searched
+        * @param: const Item& - the item to find
+        * @param: Item*& - set to the Item found, unchanged if not found
+        * @param: int& - set to the number of nodes visited
+        * @return: bool - true if found
+        */ 
+        bool findInSection(char, const Item&, Item*&, int&) const;
     
 };
 #endif //LIBRARY_H
\ No newline at end of file
@@ -0,0 +1,164 @@
+/*---------------------------------------------------------------------------
+* @file: linereader.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: implementation of the LineReader class
+---------------------------------------------------------------------------*/
+#include "linereader.h"
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "constants.h"
+
+using namespace std;
+
+static_assert(STREAM_BUFFER_SIZE > MAX_COMMAND_LENGTH, "a whole command line must fit in the buffer");
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* Reads from an open file descriptor, which the reader now owns
+* @pre: None (a descriptor < 0 is an empty stream)
+* @post: LineReader object exists, nothing is read yet
+* @param: int - the file descriptor
+*/
+LineReader::LineReader(int source) {
+    descriptor = source;
+    buffer = new char[STREAM_BUFFER_SIZE];
+    start = 0;
+    filled = 0;
+    ended = (source < 0);
+    skipping = false;
+    skipped = 0;
+}
+
+/*-------------------------------------------------------------------------
+* Destructor
+*
+* Frees the buffer and closes the descriptor (unless it is stdin)
+* @pre: LineReader object exists
+* @post: LineReader object is released
+* @param: None
+*/
+LineReader::~LineReader() {
+    delete[] buffer;
+    buffer = nullptr;
+    if (descriptor > STDIN_FILENO) {
+        close(descriptor);
+    }
+}
+
+/*-------------------------------------------------------------------------
+* open(const string&)
+*
+* Opens a byte source by name
+* @pre: None
+* @post: None
+* @param: const string& - "-" for stdin, the path of a Unix domain
+* socket to connect to, or of a file or FIFO to open
+* @return: int - the file descriptor, -1 if it could not be opened
+*/
+int LineReader::open(const string& name) {
+    if (name == "-") {
+        return STDIN_FILENO;
+    }
+    struct stat status;
+    if (stat(name.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)) {
+        sockaddr_un address;
+        if (name.size() >= sizeof(address.sun_path)) {
+            return -1;
+        }
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, name.c_str(), sizeof(address.sun_path) - 1);
+        int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connection >= 0 && connect(connection, reinterpret_cast<sockaddr*>(&address),
+                                       sizeof(address)) != 0) {
+            close(connection);
+            connection = -1;
+        }
+        return connection;
+    }
+    return ::open(name.c_str(), O_RDONLY);
+}
+
+/*-------------------------------------------------------------------------
+* next(const char*&, const char*&)
+*
+* Finds the next line, reading from the source when needed (and
+* waiting for the source if it has nothing yet)
+* @pre: None
+* @post: the previous line is no longer valid
+* @param: const char*& - set to the first character of the line
+* @param: const char*& - set to one past its last character (the '\n')
+* @return: bool - false at the end of the stream
+*/
+bool LineReader::next(const char*& begin, const char*& end) {
+    while (true) {
+        char* newline = static_cast<char*>(memchr(buffer + start, '\n', filled - start));
+        if (newline != nullptr) {
+            begin = buffer + start;
+            end = newline;
+            start = newline + 1 - buffer;
+            if (skipping) {
+                skipping = false; // the rest of a long line, drop it
+            } else if (end - begin > MAX_COMMAND_LENGTH) {
+                skipped++;
+            } else {
+                return true;
+            }
+            continue;
+        }
+        if (!skipping && filled - start > MAX_COMMAND_LENGTH) {
+            skipping = true;
+            skipped++;
+        }
+        if (skipping) {
+            start = filled = 0;
+        }
+        if (ended) {
+            if (start < filled) { // last line, without a newline
+                begin = buffer + start;
+                end = buffer + filled;
+                start = filled;
+                return true;
+            }
+            return false;
+        }
+        fill();
+    }
+}
+
+/*-------------------------------------------------------------------------
+* getSkipped()
+*
+* Number of lines skipped for being longer than MAX_COMMAND_LENGTH
+* @pre: None
+* @post: LineReader is unchanged
+* @return: long - lines skipped
+*/
+long LineReader::getSkipped() const {
+    return skipped;
+}
+
+// reads more of the source behind what the buffer holds
+void LineReader::fill() {
+    // the part of a line left over moves to the front
+    if (start > 0) {
+        memmove(buffer, buffer + start, filled - start);
+        filled -= start;
+        start = 0;
+    }
+    ssize_t got;
+    do {
+        got = read(descriptor, buffer + filled, STREAM_BUFFER_SIZE - filled);
+    } while (got < 0 && errno == EINTR);
+    if (got <= 0) {
+        ended = true;
+    } else {
+        filled += got;
+    }
+}
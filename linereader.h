@@ -0,0 +1,109 @@
+/*---------------------------------------------------------------------------
+* @file: linereader.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the LineReader class
+---------------------------------------------------------------------------*/
+// LineReader Class: Reads the lines of any byte source behind a file
+// descriptor: a file, stdin, a pipe (named or not) or a connected socket.
+// Lines are handed out in place, as pointers into one fixed buffer, so
+// CommandParser::parse can read them without a copy.
+//---------------------------------------------------------------------------
+// Features:
+// -- Memory is bounded by the buffer (STREAM_BUFFER_SIZE), however long
+//    or unbounded the stream is.
+// -- Backpressure: the source is only read when the buffer has no whole
+//    line left. A writer that gets ahead of the library fills its pipe or
+//    socket and blocks until more is read.
+// -- open() picks the source from a name: "-" is stdin, a Unix domain
+//    socket is connected to, anything else is opened as a file or FIFO.
+//
+// Assumptions/implementation:
+// -- Lines end with '\n' (a '\r' before it is left in, the parser skips
+//    it). A last line without '\n' is still a line, as with getline().
+// -- A line longer than MAX_COMMAND_LENGTH is not a command: it is
+//    skipped (and counted) without being buffered whole.
+// -- A line handed out is valid until the next call to next().
+// -- Read errors end the stream, like its end would.
+//---------------------------------------------------------------------------
+#ifndef LINEREADER_H
+#define LINEREADER_H
+
+#include <string>
+
+using namespace std;
+
+class LineReader {
+  public:
+    /*-------------------------------------------------------------------------
+    * Constructor
+    *
+    * Reads from an open file descriptor, which the reader now owns
+    * @pre: None (a descriptor < 0 is an empty stream)
+    * @post: LineReader object exists, nothing is read yet
+    * @param: int - the file descriptor
+    */
+    LineReader(int);
+
+    /*-------------------------------------------------------------------------
+    * Destructor
+    *
+    * Frees the buffer and closes the descriptor (unless it is stdin)
+    * @pre: LineReader object exists
+    * @post: LineReader object is released
+    * @param: None
+    */
+    ~LineReader();
+
+    /*-------------------------------------------------------------------------
+    * open(const string&)
+    *
+    * Opens a byte source by name
+    * @pre: None
+    * @post: None
+    * @param: const string& - "-" for stdin, the path of a Unix domain
+    * socket to connect to, or of a file or FIFO to open
+    * @return: int - the file descriptor, -1 if it could not be opened
+    */
+    static int open(const string&);
+
+    /*-------------------------------------------------------------------------
+    * next(const char*&, const char*&)
+    *
+    * Finds the next line, reading from the source when needed (and
+    * waiting for the source if it has nothing yet)
+    * @pre: None
+    * @post: the previous line is no longer valid
+    * @param: const char*& - set to the first character of the line
+    * @param: const char*& - set to one past its last character (the '\n')
+    * @return: bool - false at the end of the stream
+    */
+    bool next(const char*&, const char*&);
+
+    /*-------------------------------------------------------------------------
+    * getSkipped()
+    *
+    * Number of lines skipped for being longer than MAX_COMMAND_LENGTH
+    * @pre: None
+    * @post: LineReader is unchanged
+    * @return: long - lines skipped
+    */
+    long getSkipped() const;
+
+  private:
+    int descriptor;    // the source
+    char* buffer;      // STREAM_BUFFER_SIZE bytes read from the source
+    int start;         // first byte not handed out yet
+    int filled;        // bytes of the buffer holding data
+    bool ended;        // the source has nothing more to read
+    bool skipping;     // inside a line that is too long
+    long skipped;      // lines too long
+
+    // reads more of the source behind what the buffer holds
+    void fill();
+
+    // copying would share (and free twice) the buffer and descriptor
+    LineReader(const LineReader&);
+    LineReader& operator=(const LineReader&);
+};
+
+#endif //LINEREADER_H
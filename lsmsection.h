@@ -0,0 +1,558 @@
+/*---------------------------------------------------------------------------
+* @file: lsmsection.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file (and template implementation) of the LsmSection class
+*/
+//---------------------------------------------------------------------------
+// LsmSection Class: Section for a catalog that keeps receiving new Items
+// while it is read, built like a log structured merge tree. New Items go
+// to a small write buffer; a full buffer becomes an immutable sorted run,
+// and a background thread merges runs into bigger ones, so most Items sit
+// in a few large sorted arrays.
+// --------------------------------------------------------------------------
+// Features:
+//  -- The write buffer is a balanced tree (std::set, a red-black tree) of
+//     up to LSM_BUFFER_ITEMS Items.
+//  -- Each run is a sorted array of Item pointers with the Items' keys,
+//     front coded (FrontCodedKeys), and a BloomFilter of them. retrieve()
+//     looks in the buffer, then in the runs from the newest to the
+//     oldest, and only searches the keys of the runs whose filter may hold
+//     the key: a search reads the keys' blocks, not the Items.
+//  -- Runs are merged by size tier: the newest runs are merged once the
+//     run before them is no bigger than they are together, so there are
+//     about log2(Items / LSM_BUFFER_ITEMS) runs and every Item is merged
+//     that many times.
+//  -- Merges run on the section's own thread, without the lock: readers
+//     keep using the old runs, and the merged run replaces them in one
+//     step under the lock.
+//  -- Same insert/retrieve/remove/display contract as BinarySearchTree.
+//
+// Assumptions/implementation:
+// -- Items are heap objects owned by the section and never move (runs
+//    hold pointers to them), so the pointers handed out stay valid.
+// -- Runs are never changed: a removed Item that is in a run is recorded
+//    as a tombstone, skipped by reads and dropped by the next merge of its
+//    run. Removed Items are kept until makeEmpty(), as in BinarySearchTree.
+// -- Inserts, removals and reads come from one thread (the Library's);
+//    the lock is only shared with the section's merge thread.
+// -- A template, so everything is defined in this header.
+//---------------------------------------------------------------------------
+#ifndef LSMSECTION_H
+#define LSMSECTION_H
+
+#include <vector>
+#include <set>
+#include <unordered_set>
+#include <typeinfo>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "section.h"
+#include "bloomfilter.h"
+#include "frontcodedkeys.h"
+#include "constants.h"
+
+template <class Type>
+class LsmSection : public Section {
+
+public:
+    /*-------------------------------------------------------------------------
+    * LsmSection Constructor (with name and header)
+    *
+    * @pre: nothing
+    * @post: empty section exists, its merge thread is waiting for runs
+    * @param: string name - name of the section
+    * @param: string header - combination of headers used for display
+    */
+    LsmSection(string name, string header) : Section(name, header) {
+        live = 0;
+        merging = false;
+        stopping = false;
+        merger = thread(&LsmSection::mergeLoop, this);
+    }
+
+    /*-------------------------------------------------------------------------
+    * LsmSection Destructor
+    *
+    * @pre: section exists
+    * @post: the merge thread is stopped, every Item is destroyed
+    * @param: None
+    */
+    ~LsmSection() {
+        {
+            lock_guard<mutex> lock(guard);
+            stopping = true;
+        }
+        work.notify_all();
+        merger.join();
+        makeEmpty();
+    }
+
+    /*-------------------------------------------------------------------------
+    * retrieve()
+    *
+    * Section lookup for any Item: targets of another type are never found
+    * @pre: None
+    * @post: if a match is found, found points to the Item in the section
+    * @return: bool - true if found, false if not
+    */
+    bool retrieve(const Item &target, Item *&found) const {
+        int depth = 0;
+        return retrieve(target, found, depth);
+    }
+
+    bool retrieve(const Item &target, Item *&found, int &depth) const {
+        depth = 0;
+        if (typeid(target) != typeid(Type)) {
+            return false;
+        }
+        return retrieveAs(static_cast<const Type &>(target), found, depth);
+    }
+
+    /*-------------------------------------------------------------------------
+    * retrieveAs()
+    *
+    * same as retrieve() with depth, with a target already of Type
+    * @pre: None
+    * @post: as retrieve(), depth is the number of keys compared to target
+    * (the buffer's descent counted as one)
+    * @param: const Type& target - the Item to find
+    * @param: Item*& found - set to the Item found, unchanged if not found
+    * @param: int& depth - set to the number of keys compared
+    * @return: bool - true if found, false if not
+    */
+    bool retrieveAs(const Type &target, Item *&found, int &depth) const {
+        depth = 0;
+        Type *item = locate(target, depth);
+        // one Item per key, another format is not found
+        if (item == nullptr || !item->sameFormat(target)) {
+            return false;
+        }
+        found = item;
+        return true;
+    }
+
+    /*-------------------------------------------------------------------------
+    * insert()
+    *
+    * @pre: data is a Type allocated with new
+    * @post: data is in the section (if not a duplicate, otherwise it is
+    * deleted). A full buffer becomes a run, and the merge thread is woken
+    * if runs can be merged.
+    * @param: Item* data - the Item object to be inserted
+    * @return: true if inserted correctly, false if a duplicate
+    */
+    bool insert(Item *data) {
+        Type *item = static_cast<Type *>(data);
+        int depth = 0;
+        if (locate(*item, depth) != nullptr) {
+            delete data;
+            return false; // no dupes allowed
+        }
+        thaw();
+        buffer.insert(item);
+        size_t hash = item->Type::keyHash();
+        index.insert(hash, item);
+        filterKey(hash);
+        live++;
+        if (buffer.size() >= LSM_BUFFER_ITEMS) {
+            flush();
+        }
+        return true;
+    }
+
+    /*-------------------------------------------------------------------------
+    * remove()
+    *
+    * Takes the Item retrieve() would find for target out of the section:
+    * out of the buffer, or marked with a tombstone if it is in a run
+    * @pre: None (targets of another type are never found)
+    * @post: if a match is found, it is no longer found, displayed or
+    * collected, but is kept until makeEmpty()
+    * @param: const Item& target - the Item to remove
+    * @param: Item*& removed - set to the Item removed, unchanged if not found
+    * @return: bool - true if removed, false if not found
+    */
+    bool remove(const Item &target, Item *&removed) {
+        if (typeid(target) != typeid(Type)) {
+            return false;
+        }
+        const Type &key = static_cast<const Type &>(target);
+        int depth = 0;
+        Type *item = locate(key, depth);
+        if (item == nullptr || !item->sameFormat(key)) {
+            return false;
+        }
+        thaw();
+        typename Buffer::iterator inBuffer = buffer.find(item);
+        if (inBuffer != buffer.end() && *inBuffer == item) {
+            buffer.erase(inBuffer);
+        } else {
+            lock_guard<mutex> lock(guard);
+            tombstones.insert(item);
+        }
+        index.remove(item->Type::keyHash(), item);
+        removedItems.push_back(item);
+        live--;
+        removed = item;
+        return true;
+    }
+
+    /*-------------------------------------------------------------------------
+    * isEmpty()
+    *
+    * @pre: section exists
+    * @post: section is unchanged
+    * @return boolean - true if the section holds no Items
+    */
+    bool isEmpty() const {
+        return live == 0;
+    }
+
+    /*-------------------------------------------------------------------------
+    * makeEmpty()
+    *
+    * @pre: section exists (empty or not)
+    * @post: waits for a merge in progress, then every Item (removed ones
+    * too) is destroyed and every run freed
+    * @param: None
+    */
+    void makeEmpty() {
+        unique_lock<mutex> lock(guard);
+        idle.wait(lock, [this] { return !merging; });
+        for (size_t r = 0; r < runs.size(); r++) {
+            for (size_t i = 0; i < runs[r]->items.size(); i++) {
+                if (tombstones.count(runs[r]->items[i]) == 0) {
+                    delete runs[r]->items[i];
+                }
+            }
+            delete runs[r];
+        }
+        runs.clear();
+        tombstones.clear();
+        for (typename Buffer::iterator it = buffer.begin(); it != buffer.end(); ++it) {
+            delete *it;
+        }
+        buffer.clear();
+        for (size_t i = 0; i < removedItems.size(); i++) {
+            delete removedItems[i];
+        }
+        removedItems.clear();
+        clearIndexes();
+        live = 0;
+    }
+
+    /*-------------------------------------------------------------------------
+    * display()
+    *
+    * @pre: section exists (empty or not)
+    * @post: the header, then every Item in sorted order is printed
+    * @param: None
+    */
+    void display() const {
+        displayHeader();
+        vector<Item*> items;
+        collect(items);
+        for (size_t i = 0; i < items.size(); i++) {
+            items[i]->displayItem();
+        }
+    }
+
+    /*-------------------------------------------------------------------------
+    * collect()
+    *
+    * @pre: section exists (empty or not)
+    * @post: every Item is appended to the vector in sorted order: the
+    * buffer and the runs merged, tombstoned Items left out
+    * @param: vector<Item*>& items - the list the Items are appended to
+    */
+    void collect(vector<Item*> &items) const {
+        lock_guard<mutex> lock(guard);
+        vector<const vector<Type*>*> sources;
+        vector<Type*> buffered(buffer.begin(), buffer.end());
+        sources.push_back(&buffered);
+        for (size_t r = 0; r < runs.size(); r++) {
+            sources.push_back(&runs[r]->items);
+        }
+        // a k-way merge: the smallest next Item of any source, in turn
+        vector<size_t> next(sources.size(), 0);
+        while (true) {
+            int smallest = -1;
+            for (size_t s = 0; s < sources.size(); s++) {
+                if (next[s] < sources[s]->size()
+                    && (smallest < 0 || (*sources[s])[next[s]]->compare(
+                                            *(*sources[smallest])[next[smallest]]) < 0)) {
+                    smallest = s;
+                }
+            }
+            if (smallest < 0) {
+                break;
+            }
+            Type *item = (*sources[smallest])[next[smallest]++];
+            if (tombstones.count(item) == 0) {
+                items.push_back(item);
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------
+    * waitForMerges()
+    *
+    * Waits until the merge thread has nothing left to merge, so the runs
+    * are as few as they will get (for benchmarks and reports)
+    * @pre: section exists
+    * @post: no merge is running or due
+    * @param: None
+    */
+    void waitForMerges() const {
+        unique_lock<mutex> lock(guard);
+        idle.wait(lock, [this] { return !merging && mergeCount() < 2; });
+    }
+
+    /*-------------------------------------------------------------------------
+    * getRunCount()
+    *
+    * @pre: section exists
+    * @post: section is unchanged
+    * @return: int - number of sorted runs (the buffer is not one)
+    */
+    int getRunCount() const {
+        lock_guard<mutex> lock(guard);
+        return runs.size();
+    }
+
+    /*-------------------------------------------------------------------------
+    * measure()
+    *
+    * @pre: section exists (empty or not)
+    * @post: section is unchanged
+    * @param: Shape& shape - set to the height, depths and memory. The
+    * depth of an Item is the number of places looked in before its own
+    * (the buffer, then the newer runs) plus the halvings to find it
+    * there (block heads halved over, then keys scanned in the block).
+    * Node bytes are the buffer's tree nodes, the runs' pointers and the
+    * tombstones; index bytes include the runs' keys and filters.
+    */
+    void measure(Shape &shape) const {
+        resetShape(shape);
+        lock_guard<mutex> lock(guard);
+        long depthSum = 0;
+        int bufferDepth = levels(buffer.size());
+        for (typename Buffer::const_iterator it = buffer.begin(); it != buffer.end(); ++it) {
+            count(shape, bufferDepth, **it, depthSum);
+        }
+        shape.nodeBytes = static_cast<long>(buffer.size()) * LSM_BUFFER_NODE_BYTES;
+        int passed = 1;
+        for (size_t r = runs.size(); r-- > 0; ) {
+            size_t blocks = (runs[r]->items.size() + FRONT_CODING_BLOCK_KEYS - 1) / FRONT_CODING_BLOCK_KEYS;
+            int heads = passed + levels(blocks);
+            for (size_t i = 0; i < runs[r]->items.size(); i++) {
+                if (tombstones.count(runs[r]->items[i]) == 0) {
+                    count(shape, heads + i % FRONT_CODING_BLOCK_KEYS, *runs[r]->items[i], depthSum);
+                }
+            }
+            shape.nodeBytes += static_cast<long>(runs[r]->items.size() * sizeof(Type*));
+            shape.indexBytes += runs[r]->keys.getBytes() + runs[r]->filter.getBytes();
+            passed++;
+        }
+        shape.nodeBytes += static_cast<long>(tombstones.size() * sizeof(Type*) * 2);
+        shape.itemBytes = static_cast<long>(sizeof(Type)) * (live + removedItems.size());
+        shape.indexBytes += ((frozen != nullptr) ? frozen->getBytes() : index.getBytes())
+                            + filter.getBytes();
+        if (shape.nodes > 0) {
+            shape.averageDepth = static_cast<double>(depthSum) / shape.nodes;
+        }
+    }
+
+private:
+    // orders the buffer by key, and finds a key given as an Item
+    struct ByKey {
+        typedef void is_transparent;
+        bool operator()(const Type *a, const Type *b) const { return a->compare(*b) < 0; }
+        bool operator()(const Type *a, const Type &b) const { return a->compare(b) < 0; }
+        bool operator()(const Type &a, const Type *b) const { return b->compare(a) > 0; }
+    };
+    typedef set<Type*, ByKey> Buffer;
+
+    // an immutable sorted run, its keys (front coded, searched instead
+    // of the Items) and the filter of its keys
+    struct Run {
+        vector<Type*> items;
+        FrontCodedKeys keys;
+        BloomFilter filter;
+
+        // builds the keys and the filter once the items are in
+        void seal() {
+            filter.reset(items.size());
+            string key;
+            for (size_t i = 0; i < items.size(); i++) {
+                key.clear();
+                items[i]->appendSortKey(key);
+                keys.add(key);
+                filter.add(items[i]->Type::keyHash());
+            }
+        }
+    };
+
+    Buffer buffer;                       // newest Items, up to LSM_BUFFER_ITEMS
+    vector<Run*> runs;                   // oldest (biggest) first
+    unordered_set<const Item*> tombstones; // removed Items still in a run
+    vector<Item*> removedItems;          // removed Items, kept until makeEmpty()
+    long live;                           // Items found, in the buffer or runs
+
+    mutable mutex guard;                 // runs and tombstones, with mergeLoop
+    mutable condition_variable work;     // wakes the merge thread
+    mutable condition_variable idle;     // a merge ended
+    bool merging;                        // the merge thread is merging runs
+    bool stopping;                       // the section is being deleted
+    thread merger;                       // runs mergeLoop()
+
+    // Item with target's key (any format), or nullptr
+    Type *locate(const Type &target, int &depth) const {
+        depth++;
+        typename Buffer::const_iterator inBuffer = buffer.find(target);
+        if (inBuffer != buffer.end()) {
+            return *inBuffer;
+        }
+        size_t hash = target.Type::keyHash();
+        string key;
+        lock_guard<mutex> lock(guard);
+        for (size_t r = runs.size(); r-- > 0; ) {
+            if (!runs[r]->filter.mayContain(hash)) {
+                continue;
+            }
+            if (key.empty()) {
+                target.appendSortKey(key);
+            }
+            long rank = runs[r]->keys.find(key, depth);
+            if (rank >= 0) {
+                Type *item = runs[r]->items[rank];
+                // if removed, an older run can't hold the key either
+                return (tombstones.count(item) == 0) ? item : nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    // turns the buffer into the newest run, and wakes the merge thread
+    void flush() {
+        Run *run = new Run;
+        run->items.assign(buffer.begin(), buffer.end());
+        run->seal();
+        buffer.clear();
+        {
+            lock_guard<mutex> lock(guard);
+            runs.push_back(run);
+        }
+        work.notify_one();
+    }
+
+    // newest runs due to be merged (fewer than 2: nothing to merge), the
+    // caller holds the lock
+    size_t mergeCount() const {
+        if (runs.size() < 2) {
+            return 0;
+        }
+        size_t first = runs.size() - 1;
+        size_t total = runs[first]->items.size();
+        while (first > 0 && runs[first - 1]->items.size() <= total) {
+            first--;
+            total += runs[first]->items.size();
+        }
+        return runs.size() - first;
+    }
+
+    // body of the merge thread: merges due runs until the section is deleted
+    void mergeLoop() {
+        unique_lock<mutex> lock(guard);
+        while (true) {
+            work.wait(lock, [this] { return stopping || mergeCount() >= 2; });
+            if (stopping) {
+                return;
+            }
+            size_t merged = mergeCount();
+            size_t first = runs.size() - merged;
+            vector<Run*> inputs(runs.begin() + first, runs.end());
+            unordered_set<const Item*> removed(tombstones);
+            merging = true;
+            lock.unlock();
+
+            // only this thread replaces runs, the others only append: the
+            // inputs stay where they are while they are merged
+            Run *output = new Run;
+            vector<const Item*> dropped;
+            mergeRuns(inputs, removed, output->items, dropped);
+            output->seal();
+
+            lock.lock();
+            runs.erase(runs.begin() + first, runs.begin() + first + merged);
+            runs.insert(runs.begin() + first, output);
+            for (size_t i = 0; i < dropped.size(); i++) {
+                tombstones.erase(dropped[i]);
+            }
+            for (size_t i = 0; i < inputs.size(); i++) {
+                delete inputs[i];
+            }
+            merging = false;
+            idle.notify_all();
+        }
+    }
+
+    // merges sorted runs into one, leaving out (and listing) removed Items
+    static void mergeRuns(const vector<Run*> &inputs, const unordered_set<const Item*> &removed,
+                          vector<Type*> &output, vector<const Item*> &dropped) {
+        size_t total = 0;
+        for (size_t r = 0; r < inputs.size(); r++) {
+            total += inputs[r]->items.size();
+        }
+        output.reserve(total);
+        vector<size_t> next(inputs.size(), 0);
+        while (true) {
+            int smallest = -1;
+            for (size_t r = 0; r < inputs.size(); r++) {
+                if (next[r] < inputs[r]->items.size()
+                    && (smallest < 0 || inputs[r]->items[next[r]]->compare(
+                                            *inputs[smallest]->items[next[smallest]]) < 0)) {
+                    smallest = r;
+                }
+            }
+            if (smallest < 0) {
+                break;
+            }
+            Type *item = inputs[smallest]->items[next[smallest]++];
+            if (removed.count(item) != 0) {
+                dropped.push_back(item);
+            } else {
+                output.push_back(item);
+            }
+        }
+    }
+
+    // levels of a balanced tree (or halvings of a search) over n Items
+    static int levels(size_t n) {
+        int depth = 0;
+        while (n > 0) {
+            depth++;
+            n >>= 1;
+        }
+        return depth;
+    }
+
+    // counts one Item found at depth in a Shape
+    static void count(Shape &shape, int depth, const Type &item, long &depthSum) {
+        shape.nodes++;
+        depthSum += depth;
+        if (depth > shape.height) {
+            shape.height = depth;
+            shape.depths.resize(depth + 1, 0);
+        }
+        shape.depths[depth]++;
+        shape.stringBytes += item.getStringSize();
+    }
+
+    // copying would leave two sections owning the same Items
+    LsmSection(const LsmSection &);
+    LsmSection &operator=(const LsmSection &);
+};
+
+#endif //LSMSECTION_H
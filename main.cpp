@@ -11,35 +11,278 @@
 //   -- Inserts items (in this case books) into the library
 //   -- Creates Patrons and associates them with the library
 //   -- Executes all commands on the library
+//   -- Optionally logs saved transactions, takes periodic snapshots and
+//      recovers from them before executing commands:
+//        -l <file>   append saved transactions to the transaction log
+//        -s <file>   snapshot file (written every -n records, read by -r)
+//        -n <count>  logged records between snapshots
+//        -r          recover from the snapshot and log first
+//        -c <file>   command file (default data4commands.txt), "-" for
+//                    stdin, or a FIFO or Unix domain socket to stream from
+//   -- Can stay resident and serve commands to clients instead of running
+//      the command file (see server.h for the protocol):
+//        -u <path>   listen on a Unix domain socket
+//        -p <port>   listen on a localhost TCP port
+//        -a <count>  serve with coroutine sessions on count worker threads
+//                    (see asyncserver.h, needs a C++20 build)
+//   -- Can write the command statistics (see commandstats.h) and the 
+//      storage report (tree and table shapes) at exit, or periodically:
+//        -t <file>   statistics file, written once commands or serving end
+//        -i <count>  also rewrite it every count commands
+//   -- Can store the sections' Items by value inside the tree nodes
+//      (see valuesection.h) instead of one heap object per Item:
+//        -v          value sections
+//      or lay the loaded books out in one array per section, in Eytzinger
+//      order (see eytzingersection.h), for display and the ordered walks;
+//      checkouts and returns still find Items in the key index:
+//        -e          Eytzinger sections
+//      or keep a write buffer and sorted runs per section, merged in the
+//      background (see lsmsection.h):
+//        -w          LSM sections
+//   -- Can parse a command file on several threads (see ParallelParser
+//      in command.h); commands still execute in file order:
+//        -j <count>  parsing threads, for a regular file (-c); other
+//                    sources are streamed as without -j
+//   -- Can change the catalog built from the books file before anything
+//      else (see Library::applyCatalogDelta for the format):
+//        -d <file>   catalog delta file, may be given more than once and
+//                    is applied in order
+//   -- Can freeze the catalog once it is built (see Library::freeze), so
+//      item lookups use perfect hash indexes:
+//        -f          freeze after the deltas and recovery
 //
 // Assumptions:
-//   -- all three data files (books, patrons, commands) are stored 
-//   in the same directory as main.cpp 
+//   -- all three data files (books, patrons, commands) are stored
+//   in the same directory as main.cpp
 //   -- library.h is stored in the same directory as main.cpp
 //---------------------------------------------------------------------------
 
 #include <iostream>
-#include <fstream> 
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <csignal>
+#include <sys/resource.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 using namespace std;
 #include "library.h"
+#include "server.h"
+#include "asyncserver.h"
+
+// server being run, stopped by SIGINT/SIGTERM
+static LibraryServer* runningServer = nullptr;
+#if defined(__cpp_impl_coroutine)
+static AsyncLibraryServer* runningAsyncServer = nullptr;
+#endif
+
+// signal handler, lets the server finish its loop and clean up
+static void stopServer(int) {
+    if (runningServer) {
+        runningServer->stop();
+    }
+#if defined(__cpp_impl_coroutine)
+    if (runningAsyncServer) {
+        runningAsyncServer->stop();
+    }
+#endif
+}
+
+// every client is a socket, allow as many as the system lets this process
+static void raiseFileLimit() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+// maps a regular file whole, nullptr for anything else (or an empty file)
+static const char* mapCommandFile(const string& path, size_t& size) {
+    int source = open(path.c_str(), O_RDONLY);
+    if (source < 0) {
+        return nullptr;
+    }
+    struct stat status;
+    void* data = MAP_FAILED;
+    if (fstat(source, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+        size = status.st_size;
+        data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, source, 0);
+    }
+    close(source); // the mapping stays valid
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+    madvise(data, size, MADV_SEQUENTIAL);
+    return static_cast<const char*>(data);
+}
+
+int main(int argc, char* argv[]) {
+    string logPath = "";
+    string snapshotPath = "";
+    string commandPath = "data4commands.txt";
+    string socketPath = "";
+    string statsPath = "";
+    vector<string> deltaPaths;
+    int port = 0;
+    int workerThreads = 0;
+    int snapshotInterval = 0;
+    int statsInterval = 0;
+    int parseThreads = 0;
+    bool recovering = false;
+    bool freezing = false;
+    const char* commandFile = nullptr;
+    size_t commandSize = 0;
+    SectionStorage storage = POINTER_SECTIONS;
+
+    // read options, each file option is followed by its value
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        if (option == "-r") {
+            recovering = true;
+        } else if (option == "-f") {
+            freezing = true;
+        } else if (option == "-v") {
+            storage = VALUE_SECTIONS;
+        } else if (option == "-e") {
+            storage = EYTZINGER_SECTIONS;
+        } else if (option == "-w") {
+            storage = LSM_SECTIONS;
+        } else if (i + 1 < argc && option == "-l") {
+            logPath = argv[++i];
+        } else if (i + 1 < argc && option == "-s") {
+            snapshotPath = argv[++i];
+        } else if (i + 1 < argc && option == "-n") {
+            snapshotInterval = atoi(argv[++i]);
+        } else if (i + 1 < argc && option == "-c") {
+            commandPath = argv[++i];
+        } else if (i + 1 < argc && option == "-u") {
+            socketPath = argv[++i];
+        } else if (i + 1 < argc && option == "-p") {
+            port = atoi(argv[++i]);
+        } else if (i + 1 < argc && option == "-a") {
+            workerThreads = atoi(argv[++i]);
+        } else if (i + 1 < argc && option == "-t") {
+            statsPath = argv[++i];
+        } else if (i + 1 < argc && option == "-i") {
+            statsInterval = atoi(argv[++i]);
+        } else if (i + 1 < argc && option == "-d") {
+            deltaPaths.push_back(argv[++i]);
+        } else if (i + 1 < argc && option == "-j") {
+            parseThreads = atoi(argv[++i]);
+        } else {
+            cerr << "usage: " << argv[0] << " [-l log] [-s snapshot] [-n count]"
+                 << " [-r] [-c commands | (-u socket | -p port) [-a threads]]"
+                 << " [-t statistics [-i count]] [-v | -e | -w] [-j threads] [-d delta]... [-f]" << endl;
+            return 1;
+        }
+    }
 
-int main() {
-    
     // load data files
     ifstream libraryData("data4books.txt");
     ifstream patronData("data4patrons.txt");
-    ifstream transactionData("data4commands.txt");
 
     // instantiate the library object
-    Library* ourLibrary = new Library();
-    
-    // call build methods on library object 
+    Library* ourLibrary = new Library(storage);
+
+    // call build methods on library object
     ourLibrary->buildBooksFromFile(libraryData);
-    ourLibrary->buildPatronsFromFile(patronData); 
+    ourLibrary->buildPatronsFromFile(patronData);
+
+    // catalog changes since the books file, before any state is rebuilt
+    for (int i = 0; i < deltaPaths.size(); i++) {
+        ifstream deltaData(deltaPaths[i].c_str());
+        if (!deltaData) {
+            cerr << "cannot read catalog delta " << deltaPaths[i] << endl;
+            continue;
+        }
+        DeltaCounts counts = ourLibrary->applyCatalogDelta(deltaData);
+        cerr << deltaPaths[i] << ": " << counts.added << " added, " << counts.removed
+             << " removed, " << counts.adjusted << " adjusted, " << counts.rejected
+             << " rejected" << endl;
+    }
+
+    // rebuild the state left by the last run before logging anything new
+    if (recovering) {
+        ifstream snapshotData(snapshotPath.c_str());
+        ifstream logData(logPath.c_str());
+        ourLibrary->recover(snapshotData, logData);
+    }
+    if (freezing && !ourLibrary->freeze()) {
+        cerr << "some sections could not be frozen, they keep their hash tables" << endl;
+    }
+    if (logPath != "") {
+        ourLibrary->openTransactionLog(logPath);
+        ourLibrary->setSnapshotPolicy(snapshotPath, snapshotInterval);
+    }
+    if (statsPath != "") {
+        ourLibrary->setStatisticsDump(statsPath, statsInterval);
+    }
+
+    if ((socketPath != "" || port > 0) && workerThreads > 0) {
+        // serve clients as coroutine sessions on a pool of threads
+        raiseFileLimit();
+#if defined(__cpp_impl_coroutine)
+        AsyncLibraryServer* server = new AsyncLibraryServer(*ourLibrary, workerThreads);
+        bool listening = (socketPath != "") ? server->listenUnix(socketPath)
+                                            : server->listenTcp(port);
+        if (listening) {
+            runningAsyncServer = server;
+            signal(SIGINT, stopServer);
+            signal(SIGTERM, stopServer);
+            server->run();
+            runningAsyncServer = nullptr;
+        }
+        delete server;
+#else
+        cerr << "ERROR: -a needs a C++20 build (g++ -std=c++20 *.cpp)" << endl;
+#endif
+    } else if (socketPath != "" || port > 0) {
+        // serve commands from clients until interrupted
+        raiseFileLimit();
+        LibraryServer* server = new LibraryServer(*ourLibrary);
+        bool listening = (socketPath != "") ? server->listenUnix(socketPath)
+                                            : server->listenTcp(port);
+        if (listening) {
+            runningServer = server;
+            signal(SIGINT, stopServer);
+            signal(SIGTERM, stopServer);
+            server->run();
+            runningServer = nullptr;
+        }
+        delete server;
+    } else if (parseThreads > 0 && (commandFile = mapCommandFile(commandPath, commandSize))) {
+        // execute all the commands of the file, parsed on several threads
+        ParallelParser* parser = new ParallelParser(commandFile, commandSize, parseThreads);
+        ourLibrary->acceptTransactions(*parser);
+        if (parser->getSkipped() > 0) {
+            cerr << parser->getSkipped() << " command lines longer than "
+                 << MAX_COMMAND_LENGTH << " bytes were skipped" << endl;
+        }
+        delete parser;
+        munmap(const_cast<char*>(commandFile), commandSize);
+    } else {
+        // execute all the commands from the command file or stream
+        int source = LineReader::open(commandPath);
+        if (source < 0) {
+            cerr << "cannot read commands from " << commandPath << endl;
+        }
+        LineReader transactionData(source);
+        ourLibrary->acceptTransactions(transactionData);
+        if (transactionData.getSkipped() > 0) {
+            cerr << transactionData.getSkipped() << " command lines longer than "
+                 << MAX_COMMAND_LENGTH << " bytes were skipped" << endl;
+        }
+    }
 
-    // execute all the commands from command file
-    ourLibrary->acceptTransactions(transactionData);        
+    if (statsPath != "") {
+        ofstream statsData(statsPath.c_str());
+        ourLibrary->dumpStatistics(statsData);
+    }
 
     // library is a ptr, need to deallocate memory
     delete ourLibrary;
-}
\ No newline at end of file
+}
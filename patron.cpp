@@ -170,3 +170,21 @@ void Patron::displayHistory() const {
 void Patron::display() const {
     cout << "Patron: " << ID << " " << firstName << " " << lastName << endl;
 }
+
+/*-------------------------------------------------------------------------
+* saveHistory(ostream&)
+*
+* Writes the patron's ID and history length on one line, followed by 
+* every saved transaction in the history, one record per line and oldest
+* first, so the history can be replayed later
+* @pre: Patron object exists
+* @post: Patron is unchanged
+* @param: ostream& - the stream the records are written to
+*/
+void Patron::saveHistory(ostream& out) const {
+    out << ID << ' ' << transactions.size() << '\n';
+    for (int i = 0; i < transactions.size(); i++) {
+        transactions[i]->save(out);
+        out << '\n';
+    }
+}
\ No newline at end of file
@@ -154,6 +154,18 @@ class Patron {
         */
         void display() const;
 
+        /*-------------------------------------------------------------------------
+        * saveHistory(ostream&)
+        *
+        * Writes the patron's ID and history length on one line, followed by 
+        * every saved transaction in the history, one record per line and oldest
+        * first, so the history can be replayed later
+        * @pre: Patron object exists
+        * @post: Patron is unchanged
+        * @param: ostream& - the stream the records are written to
+        */
+        void saveHistory(ostream&) const;
+
     private:
         int ID;             // patron's ID number
         string firstName;   // patron's first name
@@ -0,0 +1,232 @@
+/*---------------------------------------------------------------------------
+* @file: perfecthash.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: implementation of the PerfectHashIndex class
+---------------------------------------------------------------------------*/
+#include "perfecthash.h"
+#include <algorithm>
+#include "constants.h"
+
+using namespace std;
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* @pre: None
+* @post: empty index exists (nothing is found)
+* @param: None
+*/
+PerfectHashIndex::PerfectHashIndex() {
+    pilots = nullptr;
+    slots = nullptr;
+    remap = nullptr;
+    count = 0;
+    range = 0;
+    buckets = 0;
+    denseBuckets = 0;
+    seed = 0;
+}
+
+/*-------------------------------------------------------------------------
+* Destructor
+*
+* @pre: index exists
+* @post: the tables are freed (the Items are not)
+* @param: None
+*/
+PerfectHashIndex::~PerfectHashIndex() {
+    clear();
+}
+
+/*-------------------------------------------------------------------------
+* build(const vector<Item*>&)
+*
+* Builds the index over every Item given, replacing what it held
+* @pre: no two Items have the same key
+* @post: on success every Item is found by its key, on failure the
+* index is empty
+* @param: const vector<Item*>& - the Items of the section
+* @return: bool - false if two keys have the same keyHash(), or an Item
+* pointer does not fit in 48 bits
+*/
+bool PerfectHashIndex::build(const vector<Item*>& source) {
+    clear();
+    if (source.empty()) {
+        return true;
+    }
+    vector<uint64_t> hashes(source.size());
+    for (size_t i = 0; i < source.size(); i++) {
+        if (reinterpret_cast<uintptr_t>(source[i]) & ~POINTER_MASK) {
+            return false; // the fingerprint would overwrite part of it
+        }
+        hashes[i] = source[i]->keyHash();
+    }
+    // two keys with one hash would always share a slot
+    vector<uint64_t> sorted(hashes);
+    sort(sorted.begin(), sorted.end());
+    if (adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+        return false;
+    }
+    sorted.clear();
+    sorted.shrink_to_fit();
+
+    count = source.size();
+    range = count * 100 / PERFECT_HASH_LOAD_PERCENT + 1;
+    buckets = max(static_cast<size_t>(2), (count + PERFECT_HASH_BUCKET_KEYS - 1) / PERFECT_HASH_BUCKET_KEYS);
+    denseBuckets = max(static_cast<size_t>(1), buckets * 3 / 10);
+    pilots = new uint32_t[buckets];
+    slots = new uint64_t[count];
+    remap = new uint32_t[range - count];
+    // another seed gives other buckets, if a pilot could not be found
+    for (int attempt = 0; attempt < PERFECT_HASH_ATTEMPTS; attempt++) {
+        seed = mix(0x9e3779b97f4a7c15ULL * (attempt + 1));
+        if (place(hashes, source)) {
+            return true;
+        }
+    }
+    clear();
+    return false;
+}
+
+/*-------------------------------------------------------------------------
+* getSize()
+*
+* @pre: None
+* @post: index is unchanged
+* @return: size_t - number of Items (and slots)
+*/
+size_t PerfectHashIndex::getSize() const {
+    return count;
+}
+
+/*-------------------------------------------------------------------------
+* getItem(size_t)
+*
+* @pre: slot < getSize()
+* @post: index is unchanged
+* @param: size_t - a slot
+* @return: Item* - the Item in that slot
+*/
+Item* PerfectHashIndex::getItem(size_t slot) const {
+    return reinterpret_cast<Item*>(slots[slot] & POINTER_MASK);
+}
+
+/*-------------------------------------------------------------------------
+* getBytes()
+*
+* @pre: None
+* @post: index is unchanged
+* @return: long - memory of the pilots, slots and remap table
+*/
+long PerfectHashIndex::getBytes() const {
+    return static_cast<long>(buckets * sizeof(uint32_t) + count * sizeof(uint64_t)
+                             + (range - count) * sizeof(uint32_t));
+}
+
+// gives a pilot to every bucket, false if one can't be placed
+bool PerfectHashIndex::place(const vector<uint64_t>& hashes, const vector<Item*>& source) {
+    // keys grouped by bucket: bucket b has keys[first[b]] to keys[first[b + 1] - 1]
+    vector<uint32_t> first(buckets + 1, 0);
+    vector<uint32_t> keyBucket(count);
+    for (size_t i = 0; i < count; i++) {
+        keyBucket[i] = bucketOf(hashes[i]);
+        first[keyBucket[i] + 1]++;
+    }
+    size_t largest = 0;
+    for (size_t b = 0; b < buckets; b++) {
+        largest = max(largest, static_cast<size_t>(first[b + 1]));
+        first[b + 1] += first[b];
+    }
+    vector<uint32_t> keys(count);
+    {
+        vector<uint32_t> next(first.begin(), first.end() - 1);
+        for (size_t i = 0; i < count; i++) {
+            keys[next[keyBucket[i]]++] = i;
+        }
+    }
+    keyBucket.clear();
+    keyBucket.shrink_to_fit();
+
+    // buckets from the biggest to the smallest (a counting sort by size)
+    vector<uint32_t> bySize(largest + 2, 0);
+    for (size_t b = 0; b < buckets; b++) {
+        bySize[largest - (first[b + 1] - first[b]) + 1]++;
+    }
+    for (size_t s = 0; s <= largest; s++) {
+        bySize[s + 1] += bySize[s];
+    }
+    vector<uint32_t> order(buckets);
+    for (size_t b = 0; b < buckets; b++) {
+        order[bySize[largest - (first[b + 1] - first[b])]++] = b;
+    }
+
+    vector<uint64_t> taken((range + 63) / 64, 0);
+    vector<size_t> landed(largest);
+    vector<uint64_t> placed(range - count, 0);   // slot words put past the last slot
+    for (size_t i = 0; i < buckets; i++) {
+        uint32_t bucket = order[i];
+        size_t size = first[bucket + 1] - first[bucket];
+        pilots[bucket] = 0;
+        if (size == 0) {
+            continue;
+        }
+        // try pilots until every key of the bucket lands on its own free slot
+        uint64_t pilot = 0;
+        bool fits = false;
+        for (; pilot <= UINT32_MAX && !fits; pilot++) {
+            fits = true;
+            for (size_t k = 0; k < size && fits; k++) {
+                size_t slot = position(hashes[keys[first[bucket] + k]], pilot);
+                fits = !(taken[slot / 64] & (1ULL << (slot % 64)));
+                for (size_t j = 0; j < k && fits; j++) {
+                    fits = (landed[j] != slot);
+                }
+                landed[k] = slot;
+            }
+        }
+        if (!fits) {
+            return false;
+        }
+        pilots[bucket] = pilot - 1;
+        for (size_t k = 0; k < size; k++) {
+            uint32_t key = keys[first[bucket] + k];
+            uint64_t word = (fingerprint(hashes[key]) << POINTER_BITS)
+                            | reinterpret_cast<uintptr_t>(source[key]);
+            taken[landed[k] / 64] |= 1ULL << (landed[k] % 64);
+            if (landed[k] < count) {
+                slots[landed[k]] = word;
+            } else {
+                placed[landed[k] - count] = word;
+            }
+        }
+    }
+
+    // keys past the last slot move to the slots left free, in order
+    size_t hole = 0;
+    for (size_t extra = 0; extra < range - count; extra++) {
+        remap[extra] = 0; // no key lands here, a miss is rejected by slot 0
+        if (!(taken[(count + extra) / 64] & (1ULL << ((count + extra) % 64)))) {
+            continue;
+        }
+        while (taken[hole / 64] & (1ULL << (hole % 64))) {
+            hole++;
+        }
+        slots[hole] = placed[extra];
+        remap[extra] = hole++;
+    }
+    return true;
+}
+
+// frees the tables, the index is empty
+void PerfectHashIndex::clear() {
+    delete[] pilots;
+    delete[] slots;
+    delete[] remap;
+    pilots = nullptr;
+    slots = nullptr;
+    remap = nullptr;
+    count = 0;
+    range = 0;
+    buckets = 0;
+    denseBuckets = 0;
+}
@@ -0,0 +1,208 @@
+/*---------------------------------------------------------------------------
+* @file: perfecthash.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the PerfectHashIndex class
+---------------------------------------------------------------------------*/
+// PerfectHashIndex Class: Read-only index from the key of an Item to the
+// Item, built once over a section that no longer changes (see
+// Section::freeze()). A minimal perfect hash gives every key its own slot,
+// so a lookup computes the slot and looks at it: no probing, no chains.
+//---------------------------------------------------------------------------
+// Features:
+// -- Hash and displace (as in CHD and PTHash): keys are split into small
+//    buckets, and each bucket gets a pilot, a number that sends all of its
+//    keys to free slots. A lookup reads the pilot of the key's bucket and
+//    the slot the pilot gives, two memory accesses.
+// -- Each slot is one 64 bit word: the Item pointer, with a 16 bit
+//    fingerprint of its key in the top bits the pointer doesn't use. A
+//    miss is rejected by the slot alone (1 in 65536 gets to compare()).
+// -- Slots are exactly as many as the keys: about 9 bytes per key (the
+//    slot, and a 4 byte pilot per PERFECT_HASH_BUCKET_KEYS keys).
+//
+// Assumptions/implementation:
+// -- Built from the Items' keyHash(), which must differ for every key. A
+//    section with two keys of the same hash is not frozen (build() fails).
+// -- Buckets are skewed as in PTHash (60% of keys in 30% of buckets) and
+//    placed biggest first, while the table is emptiest.
+// -- Pilots place keys in a range PERFECT_HASH_LOAD_PERCENT full, so the
+//    last buckets still find free slots quickly. The few keys placed past
+//    the last slot are moved to the slots left free, through a remap
+//    table: a third memory access for about 3% of the keys.
+// -- Item pointers must fit in 48 bits (user space addresses on x86-64
+//    and AArch64 Linux do), otherwise build() fails.
+// -- Stock can still change, keys can't: any insert or removal needs the
+//    section to go back to its KeyIndex first.
+//---------------------------------------------------------------------------
+#ifndef PERFECTHASH_H
+#define PERFECTHASH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "item.h"
+#include "constants.h"
+
+using namespace std;
+
+class PerfectHashIndex {
+  public:
+    /*-------------------------------------------------------------------------
+    * Constructor
+    *
+    * @pre: None
+    * @post: empty index exists (nothing is found)
+    * @param: None
+    */
+    PerfectHashIndex();
+
+    /*-------------------------------------------------------------------------
+    * Destructor
+    *
+    * @pre: index exists
+    * @post: the tables are freed (the Items are not)
+    * @param: None
+    */
+    ~PerfectHashIndex();
+
+    /*-------------------------------------------------------------------------
+    * build(const vector<Item*>&)
+    *
+    * Builds the index over every Item given, replacing what it held
+    * @pre: no two Items have the same key
+    * @post: on success every Item is found by its key, on failure the
+    * index is empty
+    * @param: const vector<Item*>& - the Items of the section
+    * @return: bool - false if two keys have the same keyHash(), or an Item
+    * pointer does not fit in 48 bits
+    */
+    bool build(const vector<Item*>&);
+
+    /*-------------------------------------------------------------------------
+    * findAs(const Type&, size_t, Item*&, int&)
+    *
+    * Finds the Item with target's key and format, as retrieve() would
+    * @pre: the index holds Items of Type only
+    * @post: index is unchanged
+    * @param: const Type& - the Item to find
+    * @param: size_t - target's keyHash()
+    * @param: Item*& - set to the Item found, unchanged if not found
+    * @param: int& - set to the number of slots looked at (the remap table
+    * counts as one)
+    * @return: bool - true if found
+    */
+    template <class Type>
+    bool findAs(const Type& target, size_t hash, Item*& found, int& probes) const {
+        probes = 0;
+        if (count == 0) {
+            return false;
+        }
+        size_t slot = position(hash, pilots[bucketOf(hash)]);
+        probes = 1;
+        if (slot >= count) {
+            slot = remap[slot - count];
+            probes++;
+        }
+        if ((slots[slot] >> POINTER_BITS) != fingerprint(hash)) {
+            return false;
+        }
+        Item* candidate = reinterpret_cast<Item*>(slots[slot] & POINTER_MASK);
+        const Type& item = static_cast<const Type&>(*candidate);
+        if (item.compare(target) != 0 || !item.sameFormat(target)) {
+            return false;
+        }
+        found = candidate;
+        return true;
+    }
+
+    /*-------------------------------------------------------------------------
+    * getSize()
+    *
+    * @pre: None
+    * @post: index is unchanged
+    * @return: size_t - number of Items (and slots)
+    */
+    size_t getSize() const;
+
+    /*-------------------------------------------------------------------------
+    * getItem(size_t)
+    *
+    * @pre: slot < getSize()
+    * @post: index is unchanged
+    * @param: size_t - a slot
+    * @return: Item* - the Item in that slot
+    */
+    Item* getItem(size_t) const;
+
+    /*-------------------------------------------------------------------------
+    * getBytes()
+    *
+    * @pre: None
+    * @post: index is unchanged
+    * @return: long - memory of the pilots, slots and remap table
+    */
+    long getBytes() const;
+
+  private:
+    uint32_t* pilots;        // pilot of every bucket
+    uint64_t* slots;         // Item pointer and key fingerprint of every slot
+    uint32_t* remap;         // slot of the keys placed past the last slot
+    size_t count;            // keys, and slots
+    size_t range;            // positions pilots place keys in (>= count)
+    size_t buckets;          // buckets of keys
+    size_t denseBuckets;     // first buckets, that get 60% of the keys
+    uint64_t seed;           // mixed into every hash, changed if a build fails
+
+    // finalizer of MurmurHash3: spreads every bit of x over the result
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    // value in [0, range) from the high bits of x, without a division
+    static size_t scale(uint64_t x, size_t range) {
+        return static_cast<size_t>((static_cast<unsigned __int128>(x) * range) >> 64);
+    }
+
+    // bucket of a key
+    size_t bucketOf(uint64_t hash) const {
+        uint64_t mixed = mix(hash ^ seed);
+        // the low bits pick dense or sparse buckets, the high bits which one
+        if (static_cast<uint32_t>(mixed) < PERFECT_HASH_DENSE_CUT) {
+            return scale(mixed, denseBuckets);
+        }
+        return denseBuckets + scale(mixed, buckets - denseBuckets);
+    }
+
+    // position a pilot sends a key to, in [0, range)
+    size_t position(uint64_t hash, uint32_t pilot) const {
+        return scale(mix(hash ^ mix(pilot + seed)), range);
+    }
+
+    // bits of the key kept in its slot to reject misses
+    static uint64_t fingerprint(uint64_t hash) {
+        return hash & 0xFFFF;
+    }
+
+    // low bits of a slot that hold the Item pointer, the rest is fingerprint
+    static const int POINTER_BITS = 48;
+    static const uint64_t POINTER_MASK = (1ULL << POINTER_BITS) - 1;
+
+    // 60% of 2^32: keys whose mixed hash is below go to the dense buckets
+    static const uint32_t PERFECT_HASH_DENSE_CUT = 2576980378U;
+
+    // gives a pilot to every bucket, false if one can't be placed
+    bool place(const vector<uint64_t>& hashes, const vector<Item*>& source);
+
+    // frees the tables, the index is empty
+    void clear();
+
+    // copying would share the tables
+    PerfectHashIndex(const PerfectHashIndex&);
+    PerfectHashIndex& operator=(const PerfectHashIndex&);
+};
+
+#endif //PERFECTHASH_H
@@ -50,6 +50,19 @@ PeriodicalBook* PeriodicalBook::create() const {
     return new PeriodicalBook();
 }
 
+/*-------------------------------------------------------------------------
+* getObjectSize()
+* 
+* Inherited from Item - size of a PeriodicalBook object
+* @pre: PeriodicalBook object exists
+* @post: PeriodicalBook is unchanged
+* @param: None 
+* @return: int - bytes of the object
+*/
+int PeriodicalBook::getObjectSize() const {
+    return sizeof(PeriodicalBook);
+}
+
 /*-------------------------------------------------------------------------
 * setData(ifstream&)
 * 
@@ -71,7 +84,7 @@ void PeriodicalBook::setData(ifstream &infile) {
 }
 
 /*-------------------------------------------------------------------------
-* setTransactionData(ifstream&)
+* setTransactionData(istream&)
 * 
 * Inherited from Item - Sets the data of the current PeriodicalBook to the data
 * that is fed in from the command data file. Only differs from setData due to 
@@ -79,9 +92,9 @@ void PeriodicalBook::setData(ifstream &infile) {
 * @pre: PeriodicalBook object exists 
 * @post: the current PeriodicalBook object's members are set to the current
 * line of the command ifstream data.
-* @param: ifstream& infile - a file stream allowing processing of file data
+* @param: istream& infile - a stream (command file or log) allowing processing of data
 */
-void PeriodicalBook::setTransactionData(ifstream &infile) {
+void PeriodicalBook::setTransactionData(istream &infile) {
     infile >> year;  // input year
     infile >> month; // input month
     infile.get();                // get (and ignore) blank before title
@@ -89,6 +102,20 @@ void PeriodicalBook::setTransactionData(ifstream &infile) {
     getline(infile, title, ','); // input author, looks for comma terminator
 }
 
+/*-------------------------------------------------------------------------
+* writeTransactionData(ostream&)
+* 
+* Inherited from Item - writes the PeriodicalBook's identifying data in the 
+* command file layout (year month title), so setTransactionData() can 
+* read it back
+* @pre: PeriodicalBook object exists
+* @post: PeriodicalBook is unchanged
+* @param: ostream& out - stream the data is written to
+*/
+void PeriodicalBook::writeTransactionData(ostream& out) const {
+    out << ' ' << year << ' ' << month << ' ' << title << ',';
+}
+
 /*-------------------------------------------------------------------------
 * displayItem() 
 * 
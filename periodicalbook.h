@@ -65,6 +65,17 @@ class PeriodicalBook : public Book {
     */
     PeriodicalBook* create() const;
 
+    /*-------------------------------------------------------------------------
+    * getObjectSize()
+    * 
+    * Inherited from Item - size of a PeriodicalBook object
+    * @pre: PeriodicalBook object exists
+    * @post: PeriodicalBook is unchanged
+    * @param: None 
+    * @return: int - bytes of the object
+    */
+    int getObjectSize() const;
+
     /*-------------------------------------------------------------------------
     * setData(ifstream&)
     * 
@@ -78,7 +89,7 @@ class PeriodicalBook : public Book {
     void setData(ifstream &);
 
     /*-------------------------------------------------------------------------
-    * setTransactionData(ifstream&)
+    * setTransactionData(istream&)
     * 
     * Inherited from Item - Sets the data of the current PeriodicalBook to the data
     * that is fed in from the command data file. Only differs from setData due to 
@@ -86,9 +97,21 @@ class PeriodicalBook : public Book {
     * @pre: PeriodicalBook object exists 
     * @post: the current PeriodicalBook object's members are set to the current
     * line of the command ifstream data.
-    * @param: ifstream& infile - a file stream allowing processing of file data
+    * @param: istream& infile - a stream (command file or log) allowing processing of data
     */
-    void setTransactionData(ifstream&);
+    void setTransactionData(istream&);
+
+    /*-------------------------------------------------------------------------
+    * writeTransactionData(ostream&)
+    * 
+    * Inherited from Item - writes the PeriodicalBook's identifying data in the 
+    * command file layout (year month title), so setTransactionData() can 
+    * read it back
+    * @pre: PeriodicalBook object exists
+    * @post: PeriodicalBook is unchanged
+    * @param: ostream& out - stream the data is written to
+    */
+    void writeTransactionData(ostream&) const;
 
     /*-------------------------------------------------------------------------
     * displayItem() 
@@ -151,6 +174,90 @@ class PeriodicalBook : public Book {
     * Compares by years then month
     */
     virtual bool operator>(const Item&) const;
+
+    /*-------------------------------------------------------------------------
+    * compare(const PeriodicalBook&)
+    * 
+    * Non-virtual three way comparison, by year, month then title, for code that
+    * knows the type at compile time (BinarySearchTree::retrieveAs and
+    * insertAs). Orders like operator< and operator>, without copying.
+    * @pre: None
+    * @post: PeriodicalBook is unchanged
+    * @param: const PeriodicalBook& - the book compared to
+    * @return: int - negative, 0 or positive as this book sorts before, with
+    * or after the other one
+    */
+    int compare(const PeriodicalBook& other) const {
+        if (year != other.year) {
+            return (year < other.year) ? -1 : 1;
+        }
+        if (month != other.month) {
+            return (month < other.month) ? -1 : 1;
+        }
+        return title.compare(other.title);
+    }
+
+    /*-------------------------------------------------------------------------
+    * getYear(), getMonth()
+    * 
+    * Non-virtual, the date the periodical is filed under (CalendarSection)
+    * @pre: None
+    * @post: PeriodicalBook is unchanged
+    * @param: None
+    * @return: int - year, or month (1 to 12 for valid data)
+    */
+    int getYear() const { return year; }
+    int getMonth() const { return month; }
+
+    /*-------------------------------------------------------------------------
+    * keyHash()
+    * 
+    * Inherited from Item - hashes the key compare() orders by (year, month then title).
+    * Also called non-virtually by KeyIndex::findAs.
+    * @pre: None
+    * @post: PeriodicalBook is unchanged
+    * @param: None
+    * @return: size_t - hash of the key
+    */
+    size_t keyHash() const {
+        // year and month packed into one number, so no two dates share it,
+        // then mixed (both steps are one to one) so the year reaches the low
+        // bits a table indexes by: packed as is, a title's issues of every
+        // year would share a slot
+        size_t date = ((static_cast<size_t>(year) << 32) | static_cast<unsigned int>(month))
+                      * 0x9e3779b97f4a7c15ULL;
+        date ^= date >> 29;
+        return combineHash(date, title.hash());
+    }
+
+    /*-------------------------------------------------------------------------
+    * appendSortKey(string&)
+    * 
+    * Non-virtual, appends the key compare() orders by as bytes (year and
+    * month as 4 big endian bytes each, offset so negative numbers sort
+    * first, then title), so that comparing the bytes of two keys orders
+    * their books like compare(). Used for the front coded keys of
+    * LsmSection runs.
+    * @pre: None
+    * @post: PeriodicalBook is unchanged
+    * @param: string& - the key is appended to it
+    */
+    void appendSortKey(string& key) const {
+        const int numbers[2] = {year, month};
+        for (int n = 0; n < 2; n++) {
+            unsigned int bits = static_cast<unsigned int>(numbers[n]) ^ 0x80000000U;
+            for (int shift = 24; shift >= 0; shift -= 8) {
+                key.push_back(static_cast<char>((bits >> shift) & 0xff));
+            }
+        }
+        key.append(title.data(), title.size());
+    }
+
+    // registration in the MediaTypes list: letter of the type in data and
+    // command files, and name and column headings of its section
+    static const char TYPE = 'P';
+    static const char* sectionName() { return "PERIODICALS"; }
+    static const char* sectionColumns() { return "AVAIL,TITLE,MONTH,YEAR"; }
   private:
     int month;    // Month of book
 };
@@ -16,8 +16,8 @@
 //  -- Can display entire return and all associated data fields 
 //
 // Assumptions/implementation:
-// -- Calling execute(Library&, ifstream&) won't be done with uninitialized 
-//    objects.
+// -- Calling execute(Library&, const Command&) (or its stages) won't be
+//    done with uninitialized objects.
 // -- Deleting a Return doesn't delete the Item associated with it.
 //---------------------------------------------------------------------------
 
@@ -40,7 +40,8 @@ class Return : public Transaction {
     * Destructor
     *
     * Nulls out the member item. Transactions aren't responsible for deleting
-    * Item objects they are associated with.
+    * Item objects they are associated with, only the requested copy built by
+    * findItem() if apply() never ran.
     * @pre: Return object exists
     * @post: Memory associated with that Return object is released (except
     * for item)
@@ -61,24 +62,67 @@ class Return : public Transaction {
     */
     virtual Return* create() const;
 
+    // letter of the command, for its registration in TransactionTypes
+    static const char TYPE = 'R';
+
+    /*-------------------------------------------------------------------------
+    * load(const Command&)
+    *
+    * Stores the patronID and the item part of the command (item type, format
+    * and item data). The item data is parsed once the patron is known to exist.
+    * @pre: command.type is R
+    * @post: patronID and the item part of the command are stored
+    * @param: const Command& - the parsed command
+    */
+    virtual void load(const Command&);
+
+    /*-------------------------------------------------------------------------
+    * getPatronID()
+    *
+    * Returns the patron ID loaded by load(), used for prefetching
+    * @pre: load() has been called
+    * @post: Return is unchanged
+    * @return: int - the patron ID of this command
+    */
+    virtual int getPatronID() const;
+
+    /*-------------------------------------------------------------------------
+    * findPatron(Library&)
+    *
+    * Looks up the patron returning something.
+    * @pre: load() has been called
+    * @post: patron is set, or nullptr if the ID is invalid
+    * @param: Library& - the library the patron is looked up in
+    */
+    virtual void findPatron(Library&);
+
     /*-------------------------------------------------------------------------
-    * execute(Library&, ifstream&)
+    * findItem(Library&)
     *
-    * Executes the Return command: validates the patronID, validates the item 
-    * that is requested to be checked out, assigns the Return to the patron's 
-    * history, and adds 1 quantity of that item to the library quantity. 
-    * @pre: Library and a command file exist
+    * If the patron exists, creates the returned item from the command data
+    * (printing an error for an invalid item type) and finds it in its section.
+    * @pre: findPatron() has been called
+    * @post: requested and item are set, or nullptr if invalid / not found
+    * @param: Library& - the library the item is looked up in
+    */
+    virtual void findItem(Library&);
+
+    /*-------------------------------------------------------------------------
+    * apply(Library&)
+    *
+    * Validates the patronID, validates the item that is requested to be
+    * returned, assigns the Return to the patron's history, and adds 1
+    * quantity of that item to the library quantity. Prints an error for
+    * anything invalid.
+    * @pre: findItem() has been called, earlier commands have been applied
     * @post: An item in zero or one library trees is modified, associated with
     * this Return, and associated with the Patron given by command data.
     * @param: Library& - the library the command should change
-    * @param: ifstream& - the ifstream providing data for commands (1 per line),
-    * in this case marked by an R as the first char of the line. The rest of the
-    * line should provide patronID, item type and item data
     * @return: returns a bool marking whether or not to save this Return
     * to patron history. Returns true if the Return should be saved, and
     * false otherwise (determined by validity of data for Return objects).
     */
-    virtual bool execute(Library&, ifstream&);
+    virtual bool apply(Library&);
 
 
     /*-------------------------------------------------------------------------
@@ -91,10 +135,43 @@ class Return : public Transaction {
     * @param: None
     */
     virtual void display() const;
+
+    /*-------------------------------------------------------------------------
+    * replay(Patron*, char, Item*, int&)
+    *
+    * Redoes an already validated return from a log or snapshot without
+    * printing anything: the item is taken back from the patron and this
+    * Return is added to the patron's history.
+    * @pre: the patron and item exist and the return was valid when logged
+    * @post: this Return is associated with the patron and item
+    * @param: Patron* - the patron named by the logged Return
+    * @param: char - the item type (section) of the logged Return
+    * @param: Item* - the item in the library named by the logged Return
+    * @param: int& - set to the change in stock this Return caused
+    * @return: returns a bool marking whether or not this Return was saved
+    * to the patron history, as execute() does
+    */
+    virtual bool replay(Patron*, char, Item*, int&);
+
+    /*-------------------------------------------------------------------------
+    * save(ostream&)
+    *
+    * Writes this Return as one command-format record (R, patronID, item
+    * type, format and item data) that replay() can be driven from.
+    * @pre: execute() or replay() has already been called by this object.
+    * @post: Return is unchanged
+    * @param: ostream& - the stream the record is written to
+    */
+    virtual void save(ostream&) const;
     
   private:
     int patronID; // ID of the patron returning something in the library
+    char itemType; // type (section) of the item, needed to save this record
+    char itemFormat; // format of the item named by the command
     Item* item; // item being returned to the library
+    Patron* patron; // patron found by findPatron(), nullptr if invalid
+    string itemData; // key fields of the item, parsed by findItem()
+    Item* requested; // item built from the command, owned until apply()
 }; //RETURN_H
 
 #endif
\ No newline at end of file
@@ -0,0 +1,182 @@
+/*---------------------------------------------------------------------------
+* @file: search.cpp
+* @authors: Braxton Goss & Elijah Shaw
+* @brief: implementation of the transaction type - search
+--------------------------------------------------------------------------*/
+
+#include "transaction.h"
+#include "search.h"
+#include "library.h"
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* Initializes patronID to be 0 and the words to be empty
+* @pre: Nothing
+* @post: new Search object exists
+* @param: None
+*/
+Search::Search() : Transaction() {
+    patronID = 0;
+    itemType = ' ';
+    query = "";
+    patron = nullptr;
+}
+
+/*-------------------------------------------------------------------------
+* Destructor
+*
+* Nothing to delete
+* @pre: Search object exists
+* @post: Memory associated with that Search object is released
+* @param: None
+*/
+Search::~Search() {}
+
+/*-------------------------------------------------------------------------
+* create()
+*
+* Returns a pointer to a newly created & empty Search object
+* This method is used inside of TransactionFactory to create new objects
+* without using Switch-Case or If-else statements.
+* @pre: Nothing
+* @post: empty Search object is returned to the caller
+* @param: None
+* @return: returns the new Search object
+*/
+Search* Search::create() const {
+    return new Search();
+}
+
+/*-------------------------------------------------------------------------
+* load(const Command&)
+*
+* Stores the patronID, the "*" and the words typed.
+* @pre: command.type is K
+* @post: patronID, itemType and query are stored
+* @param: const Command& - the parsed command
+*/
+void Search::load(const Command& command) {
+    patronID = command.patronID;
+    itemType = command.itemType;
+    // the parser takes the first character after the item type as a
+    // format: here it is the first letter of the words
+    query.clear();
+    if (command.format != ' ') {
+        query += command.format;
+    }
+    query += command.itemData;
+}
+
+/*-------------------------------------------------------------------------
+* getPatronID()
+*
+* Returns the patron ID loaded by load(), used for prefetching
+* @pre: load() has been called
+* @post: Search is unchanged
+* @return: int - the patron ID of this command
+*/
+int Search::getPatronID() const {
+    return patronID;
+}
+
+/*-------------------------------------------------------------------------
+* findPatron(Library&)
+*
+* Looks up the patron searching.
+* @pre: load() has been called
+* @post: patron is set, or nullptr if the ID is invalid
+* @param: Library& - the library the patron is looked up in
+*/
+void Search::findPatron(Library& currLibrary) {
+    patron = nullptr;
+    currLibrary.retrievePatron(patronID, patron);
+}
+
+/*-------------------------------------------------------------------------
+* findItem(Library&)
+*
+* A search names no item, the Items are found by apply().
+* @pre: None
+* @post: Nothing is changed
+* @param: Library& - unused
+*/
+void Search::findItem(Library&) {
+    // nothing to look up
+}
+
+/*-------------------------------------------------------------------------
+* apply(Library&)
+*
+* Prints the Items whose titles hold the words, or an error if the
+* patronID is invalid or the item type isn't "*".
+* @pre: earlier commands have been applied
+* @post: the Items found are printed, the library is unchanged
+* @param: Library& - the library whose titles are searched
+* @return: always false, there is no information to save for an
+* Search
+*/
+bool Search::apply(Library& currLibrary) {
+    if (patron == nullptr) {
+        cout << endl;
+        cout << "ERROR: Cannot search for invalid Patron ID: " << patronID << endl;
+        currLibrary.getStatistics().error(CommandStats::INVALID_PATRON);
+    } else if (itemType != '*') {
+        cout << endl;
+        cout << "ERROR: Cannot search for item type: " << itemType
+             << " (titles of every section are searched, use *)" << endl;
+        currLibrary.getStatistics().error(CommandStats::INVALID_TYPE);
+    } else {
+        // one list per thread, a search allocates nothing once it has grown
+        static thread_local vector<Item*> items;
+        long matches = currLibrary.searchTitles(query, items);
+        cout << endl << "Titles with the words \"" << query << "\": " << matches
+             << " found" << endl;
+        for (size_t i = 0; i < items.size(); i++) {
+            items[i]->displayItem();
+        }
+    }
+    return false;
+}
+
+/*-------------------------------------------------------------------------
+* display()
+*
+* Prints to the std::cout the Search action, which is always
+* nothing: apply() printed the Items found.
+* @pre: execute() has already been called by this object.
+* @post: Nothing is printed
+* @param: None
+*/
+void Search::display() const {
+
+}
+
+/*-------------------------------------------------------------------------
+* replay(Patron*, char, Item*, int&)
+*
+* An Search never changes the library, so it is never logged and
+* there is nothing to redo.
+* @pre: Nothing
+* @post: Nothing is changed
+* @param: Patron*, char, Item* - unused
+* @param: int& - set to 0, a Search never changes stock
+* @return: always false, a Search is never saved to patron
+* history
+*/
+bool Search::replay(Patron*, char, Item*, int& stockChange) {
+    stockChange = 0;
+    return false;
+}
+
+/*-------------------------------------------------------------------------
+* save(ostream&)
+*
+* Never called, a Search is not saved to any patron history.
+* @pre: Nothing
+* @post: Nothing is written
+* @param: ostream& - the stream the record is written to
+*/
+void Search::save(ostream&) const {
+    // nothing to save, not part of a patron's transaction list
+}
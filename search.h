@@ -0,0 +1,158 @@
+/*---------------------------------------------------------------------------
+* @file: search.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the search (type of transaction) class
+//------------------------------------------------------------------------*/
+// Search Class: Keyword search, the Items whose titles hold every word a
+// patron typed. Command line: "K 1000 * homework machine", the patron,
+// then "*" where other commands name the item type (titles come from
+// every section), then the words.
+// Features:
+// -- Prints how many Items match, then up to WORD_SEARCH_RESULTS of them
+//    (the titles the words make up most of first) from the library's word
+//    index (see WordIndex).
+//
+// Assumptions/implementation:
+// -- The words are the rest of the line, in any order and case.
+// -- Like a History, it changes nothing, so it is never saved or logged.
+// -- Only the posting lists of the words are read, never the titles.
+//---------------------------------------------------------------------------
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+class Search : public Transaction {
+    public:
+
+        /*-------------------------------------------------------------------------
+        * Constructor
+        *
+        * Initializes patronID to be 0 and the words to be empty
+        * @pre: Nothing
+        * @post: new Search object exists
+        * @param: None
+        */
+        Search();
+
+        /*-------------------------------------------------------------------------
+        * Destructor
+        *
+        * Nothing to delete
+        * @pre: Search object exists
+        * @post: Memory associated with that Search object is released
+        * @param: None
+        */
+        ~Search();
+
+        /*-------------------------------------------------------------------------
+        * create()
+        *
+        * Returns a pointer to a newly created & empty Search object
+        * This method is used inside of TransactionFactory to create new objects
+        * without using Switch-Case or If-else statements.
+        * @pre: Nothing
+        * @post: empty Search object is returned to the caller
+        * @param: None
+        * @return: returns the new Search object
+        */
+        virtual Search* create() const;
+
+        // letter of the command, for its registration in TransactionTypes
+        static const char TYPE = 'K';
+
+        /*-------------------------------------------------------------------------
+        * load(const Command&)
+        *
+        * Stores the patronID, the "*" and the words typed.
+        * @pre: command.type is K
+        * @post: patronID, itemType and query are stored
+        * @param: const Command& - the parsed command
+        */
+        virtual void load(const Command&);
+
+        /*-------------------------------------------------------------------------
+        * getPatronID()
+        *
+        * Returns the patron ID loaded by load(), used for prefetching
+        * @pre: load() has been called
+        * @post: Search is unchanged
+        * @return: int - the patron ID of this command
+        */
+        virtual int getPatronID() const;
+
+        /*-------------------------------------------------------------------------
+        * findPatron(Library&)
+        *
+        * Looks up the patron searching.
+        * @pre: load() has been called
+        * @post: patron is set, or nullptr if the ID is invalid
+        * @param: Library& - the library the patron is looked up in
+        */
+        virtual void findPatron(Library&);
+
+        /*-------------------------------------------------------------------------
+        * findItem(Library&)
+        *
+        * A search names no item, the Items are found by apply().
+        * @pre: None
+        * @post: Nothing is changed
+        * @param: Library& - unused
+        */
+        virtual void findItem(Library&);
+
+        /*-------------------------------------------------------------------------
+        * apply(Library&)
+        *
+        * Prints the Items whose titles hold the words, or an error if the
+        * patronID is invalid or the item type isn't "*".
+        * @pre: earlier commands have been applied
+        * @post: the Items found are printed, the library is unchanged
+        * @param: Library& - the library whose titles are searched
+        * @return: always false, there is no information to save for an
+        * Search
+        */
+        virtual bool apply(Library&);
+
+        /*-------------------------------------------------------------------------
+        * display()
+        *
+        * Prints to the std::cout the Search action, which is always
+        * nothing: apply() printed the Items found.
+        * @pre: execute() has already been called by this object.
+        * @post: Nothing is printed
+        * @param: None
+        */
+        virtual void display() const;
+
+        /*-------------------------------------------------------------------------
+        * replay(Patron*, char, Item*, int&)
+        *
+        * An Search never changes the library, so it is never logged and
+        * there is nothing to redo.
+        * @pre: Nothing
+        * @post: Nothing is changed
+        * @param: Patron*, char, Item* - unused
+        * @param: int& - set to 0, a Search never changes stock
+        * @return: always false, a Search is never saved to patron
+        * history
+        */
+        virtual bool replay(Patron*, char, Item*, int&);
+
+        /*-------------------------------------------------------------------------
+        * save(ostream&)
+        *
+        * Never called, a Search is not saved to any patron history.
+        * @pre: Nothing
+        * @post: Nothing is written
+        * @param: ostream& - the stream the record is written to
+        */
+        virtual void save(ostream&) const;
+
+    private:
+        int patronID;      // ID of the patron searching
+        char itemType;     // "*" for every section, anything else is an error
+        string query;      // the words looked for
+        Patron* patron;    // patron found by findPatron(), nullptr if invalid
+};
+
+#endif
@@ -0,0 +1,156 @@
+/*
+* @file: section.cpp
+* @authors: Braxton Goss & Elijah Shaw
+* @brief: implementation of the parts shared by every Section
+*/
+
+#include "section.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include "constants.h"
+using namespace std;
+
+/*-------------------------------------------------------------------------
+* Section Constructor (with name and header)
+*
+* @pre: nothing
+* @post: empty section exists
+* @param: string name - name of the section
+* @param: string header - combination of headers used for display
+*/
+Section::Section(string name, string header) {
+    this->name = name;
+    this->header = header;
+    frozen = nullptr;
+}
+
+/*-------------------------------------------------------------------------
+* Section Destructor
+*
+* @pre: section exists
+* @post: the section and its Items are released
+* @param: None
+*/
+Section::~Section() {
+    delete frozen;
+}
+
+/*-------------------------------------------------------------------------
+* freeze()
+*
+* Builds a perfect hash index of the section's keys and drops the
+* KeyIndex, for as long as no Item is inserted or removed
+* @pre: section exists (empty or not)
+* @post: on success, retrieveByKey() uses the perfect hash index
+* @return: bool - false if it could not be built (the section is left
+* as it was)
+*/
+bool Section::freeze() {
+    if (frozen != nullptr) {
+        return true;
+    }
+    vector<Item*> items;
+    collect(items);
+    PerfectHashIndex *built = new PerfectHashIndex();
+    if (!built->build(items)) {
+        delete built;
+        return false;
+    }
+    frozen = built;
+    index.clear();
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* isFrozen()
+*
+* @pre: section exists
+* @post: section is unchanged
+* @return: bool - true if lookups use the perfect hash index
+*/
+bool Section::isFrozen() const {
+    return frozen != nullptr;
+}
+
+// goes back from the perfect hash to the KeyIndex, before the keys change
+void Section::thaw() {
+    if (frozen == nullptr) {
+        return;
+    }
+    for (size_t slot = 0; slot < frozen->getSize(); slot++) {
+        Item *item = frozen->getItem(slot);
+        index.insert(item->keyHash(), item);
+    }
+    delete frozen;
+    frozen = nullptr;
+}
+
+// adds an inserted Item's key to the filter, rebuilt bigger when full
+void Section::filterKey(size_t hash) {
+    if (filter.add(hash)) {
+        return;
+    }
+    // the inserted Item is already in the section, collect() finds it
+    vector<Item*> items;
+    collect(items);
+    filter.reset(items.size() * 2);
+    for (size_t i = 0; i < items.size(); i++) {
+        filter.add(items[i]->keyHash());
+    }
+}
+
+// empties both indexes and the filter, when the section is emptied
+void Section::clearIndexes() {
+    delete frozen;
+    frozen = nullptr;
+    index.clear();
+    filter.clear();
+}
+
+/*-------------------------------------------------------------------------
+* displayHeader()
+*
+* @pre: section exists (empty or not)
+* @post: the section name and column headers are printed, the same way
+* display() starts
+* @param: None
+*/
+void Section::displayHeader() const {
+    cout << '\n' << this->name << endl;
+    // Header AVAIL, AUTHOR, TITLE, YEAR ETC
+    stringstream headers(header);
+    string currentHeader;
+    getline(headers, currentHeader, ',');
+    cout << setw(AVAIL_WIDTH) << left << currentHeader;
+    getline(headers, currentHeader, ',');
+    cout << setw(TITLE_WIDTH)<< left << currentHeader;
+    getline(headers, currentHeader, ',');
+    cout << setw(MONTH_AUTHOR_WIDTH) << left << currentHeader;
+    getline(headers, currentHeader, ',');
+    cout << setw(YEAR_WIDTH) << left << currentHeader << endl;
+}
+
+/*-------------------------------------------------------------------------
+* getName()
+*
+* @pre: section exists
+* @post: section is unchanged
+* @param: None
+* @return: string - the identifying name of the section
+*/
+string Section::getName() const {
+    return name;
+}
+
+// clears every count of a Shape, before it is measured
+void Section::resetShape(Shape &shape) {
+    shape.nodes = 0;
+    shape.height = 0;
+    shape.averageDepth = 0;
+    shape.nodeBytes = 0;
+    shape.itemBytes = 0;
+    shape.stringBytes = 0;
+    shape.indexBytes = 0;
+    shape.depths.assign(1, 0);
+}
@@ -0,0 +1,274 @@
+/*---------------------------------------------------------------------------
+* @file: section.h
+* @authors: Braxton Goss & Elijah Shaw
+* @brief: header file for the Section interface
+*/
+//---------------------------------------------------------------------------
+// Section Class: What the Library expects from the storage of one media
+// type (one section of the library): sorted insertion, exact lookups, an
+// in-order display and a measure of its shape and memory.
+// --------------------------------------------------------------------------
+// Features:
+//  -- BinarySearchTree stores pointers to heap allocated Items.
+//  -- ValueSection<Type> stores its Items by value inside its tree nodes.
+//  -- EytzingerSection<Type> lays a loaded catalog out in one array, in
+//     the breadth first order of a complete tree.
+//  -- The name and column headers (displayHeader()) are shared by both.
+//  -- Every section keeps a KeyIndex of its Items next to its tree.
+//     retrieveByKey() answers exact lookups (checkouts, returns) from the
+//     index, the tree is left to display, collect and the ordered walks.
+//  -- freeze() swaps the KeyIndex for a PerfectHashIndex while the keys
+//     don't change. The next insert or removal thaws the section first.
+//  -- A BloomFilter of the keys is checked before either index, so a key
+//     the section never held is turned away with one cache line read.
+//  -- CalendarSection files the periodicals by month and is looked up
+//     there, it keeps neither index nor filter and is never frozen.
+//
+// Assumptions/implementation:
+// -- A section holds Items of a single type, in that type's order.
+// -- A section owns its Items, pointers handed out by retrieve() and
+//    collect() stay valid until the section is emptied or deleted, even
+//    if the Item was removed meanwhile (patrons may still hold it).
+//---------------------------------------------------------------------------
+#ifndef SECTION_H
+#define SECTION_H
+
+#include <vector>
+#include <string>
+#include "item.h"
+#include "keyindex.h"
+#include "perfecthash.h"
+#include "bloomfilter.h"
+
+using namespace std;
+
+// how a Library stores the Items of its sections
+enum SectionStorage {
+    POINTER_SECTIONS,   // BinarySearchTree, a heap Item per node
+    VALUE_SECTIONS,     // ValueSection, Items embedded in the nodes
+    EYTZINGER_SECTIONS, // EytzingerSection, Items in one array in
+                        // Eytzinger order once the catalog is loaded
+    LSM_SECTIONS        // LsmSection, a write buffer and sorted runs
+                        // merged in the background
+};
+
+class Section {
+
+public:
+    /*-------------------------------------------------------------------------
+    * Section Constructor (with name and header)
+    *
+    * @pre: nothing
+    * @post: empty section exists
+    * @param: string name - name of the section
+    * @param: string header - combination of headers used for display
+    */
+    Section(string name, string header);
+
+    /*-------------------------------------------------------------------------
+    * Section Destructor
+    *
+    * @pre: section exists
+    * @post: the section and its Items are released
+    * @param: None
+    */
+    virtual ~Section();
+
+    /*-------------------------------------------------------------------------
+    * retrieve()
+    *
+    * finds the Item equal (operator==) to target
+    * @pre: target is of the section's type
+    * @post: if a match is found, found points to the Item in the section
+    * @param: const Item& target - the Item to find
+    * @param: Item*& found - set to the Item found, unchanged if not found
+    * @return: bool - true if found, false if not
+    */
+    virtual bool retrieve(const Item &target, Item *&found) const = 0;
+
+    /*-------------------------------------------------------------------------
+    * retrieve() with depth
+    *
+    * same as retrieve() above, and also reports how deep the search went
+    * @pre: target is of the section's type
+    * @post: as retrieve(), depth is the number of nodes compared to target
+    * @param: int& depth - set to the number of nodes visited
+    * @return: bool - true if found, false if not
+    */
+    virtual bool retrieve(const Item &target, Item *&found, int &depth) const = 0;
+
+    /*-------------------------------------------------------------------------
+    * insert()
+    *
+    * @pre: data is of the section's type
+    * @post: data is inserted (if not a duplicate)
+    * @param: Item* data - the Item object to be inserted
+    * @return: true if inserted correctly, false if a duplicate
+    */
+    virtual bool insert(Item *data) = 0;
+
+    /*-------------------------------------------------------------------------
+    * remove()
+    *
+    * Takes the Item retrieve() would find for target out of the section.
+    * It is no longer found, displayed or collected, but is not destroyed
+    * before the section is emptied, so pointers to it stay valid.
+    * @pre: target is of the section's type
+    * @post: if a match is found, it is unlinked from the section
+    * @param: const Item& target - the Item to remove
+    * @param: Item*& removed - set to the Item removed, unchanged if not found
+    * @return: bool - true if removed, false if not found
+    */
+    virtual bool remove(const Item &target, Item *&removed) = 0;
+
+    /*-------------------------------------------------------------------------
+    * isEmpty()
+    *
+    * @pre: section exists
+    * @post: section is unchanged
+    * @param: None
+    * @return boolean - true if the section holds no Items
+    */
+    virtual bool isEmpty() const = 0;
+
+    /*-------------------------------------------------------------------------
+    * makeEmpty()
+    *
+    * @pre: section exists (empty or not)
+    * @post: every Item is released, the section is empty
+    * @param: None
+    */
+    virtual void makeEmpty() = 0;
+
+    /*-------------------------------------------------------------------------
+    * display()
+    *
+    * @pre: section exists (empty or not)
+    * @post: the header, then every Item in sorted order is printed
+    * @param: None
+    */
+    virtual void display() const = 0;
+
+    /*-------------------------------------------------------------------------
+    * displayHeader()
+    *
+    * @pre: section exists (empty or not)
+    * @post: the section name and column headers are printed, the same way
+    * display() starts
+    * @param: None
+    */
+    void displayHeader() const;
+
+    /*-------------------------------------------------------------------------
+    * getName()
+    *
+    * @pre: section exists
+    * @post: section is unchanged
+    * @param: None
+    * @return: string - the identifying name of the section
+    */
+    string getName() const;
+
+    /*-------------------------------------------------------------------------
+    * collect()
+    *
+    * @pre: section exists (empty or not)
+    * @post: every Item in the section is appended to the vector in sorted
+    * order. The section still owns the Items.
+    * @param: vector<Item*>& items - the list the Items are appended to
+    */
+    virtual void collect(vector<Item*> &items) const = 0;
+
+    /*-------------------------------------------------------------------------
+    * retrieveByKey()
+    *
+    * Finds what retrieve() finds, with one probe of the key index instead
+    * of a descent of the tree. Keys the Bloom filter rules out are not
+    * looked for in the index at all.
+    * @pre: the section holds Items of Type
+    * @post: if a match is found, found points to the Item in the section
+    * @param: const Type& target - the Item to find
+    * @param: Item*& found - set to the Item found, unchanged if not found
+    * @param: int& probes - set to the number of index slots probed (0 if
+    * the filter turned the key away)
+    * @return: bool - true if found, false if not
+    */
+    template <class Type>
+    bool retrieveByKey(const Type &target, Item *&found, int &probes) const {
+        size_t hash = target.Type::keyHash();
+        if (!filter.mayContain(hash)) {
+            probes = 0;
+            return false;
+        }
+        if (frozen != nullptr) {
+            return frozen->findAs(target, hash, found, probes);
+        }
+        return index.findAs(target, hash, found, probes);
+    }
+
+    /*-------------------------------------------------------------------------
+    * freeze()
+    *
+    * Builds a perfect hash index of the section's keys and drops the
+    * KeyIndex, for as long as no Item is inserted or removed
+    * @pre: section exists (empty or not)
+    * @post: on success, retrieveByKey() uses the perfect hash index
+    * @return: bool - false if it could not be built (the section is left
+    * as it was)
+    */
+    virtual bool freeze();
+
+    /*-------------------------------------------------------------------------
+    * isFrozen()
+    *
+    * @pre: section exists
+    * @post: section is unchanged
+    * @return: bool - true if lookups use the perfect hash index
+    */
+    bool isFrozen() const;
+
+    // shape and memory of a section, as measured by measure()
+    struct Shape {
+        int nodes;             // Items in the section
+        int height;            // nodes on the longest path (deepest lookup)
+        double averageDepth;   // nodes visited by the average successful lookup
+        long nodeBytes;        // memory of the nodes, without the Items
+        long itemBytes;        // memory of the Item objects
+        long stringBytes;      // heap memory of the Items' strings
+        long indexBytes;       // memory of the key index (or perfect hash)
+                               // and of the Bloom filter
+        vector<int> depths;    // nodes per depth, the root is at depth 1
+    };
+
+    /*-------------------------------------------------------------------------
+    * measure()
+    *
+    * @pre: section exists (empty or not)
+    * @post: section is unchanged
+    * @param: Shape& shape - set to the height, depths and memory
+    */
+    virtual void measure(Shape &shape) const = 0;
+
+protected:
+    string name;   // name of the section
+    string header; // column headers, separated by commas
+    KeyIndex index; // every Item in the tree, by key (kept up to date by
+                    // insert(), remove() and makeEmpty()), empty if frozen
+    PerfectHashIndex *frozen; // every Item by key while frozen, or nullptr
+    BloomFilter filter;       // keys of the Items inserted (and of some
+                              // removed since the last rebuild)
+
+    // goes back from the perfect hash to the KeyIndex, before the keys change
+    void thaw();
+
+    // adds an inserted Item's key to the filter, rebuilt bigger when full
+    void filterKey(size_t hash);
+
+    // empties both indexes and the filter, when the section is emptied
+    void clearIndexes();
+
+    // clears every count of a Shape, before it is measured
+    static void resetShape(Shape &shape);
+};
+
+#endif //SECTION_H
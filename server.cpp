@@ -0,0 +1,332 @@
+/*---------------------------------------------------------------------------
+* @file: server.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: implementation of the LibraryServer class
+---------------------------------------------------------------------------*/
+#include "server.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "constants.h"
+
+using namespace std;
+
+// line that ends the answer to every command
+static const char* const ANSWER_END = ".\n";
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* Creates the epoll instance, nothing is listened on yet
+* @pre: Library object exists and is built
+* @post: LibraryServer object exists
+* @param: Library& - the library commands are executed against
+*/
+LibraryServer::LibraryServer(Library& library) : library(library) {
+    epollFd = epoll_create1(0);
+    listenFd = -1;
+    socketPath = "";
+    stopping = 0;
+}
+
+/*-------------------------------------------------------------------------
+* Destructor
+*
+* Closes every connection and the listening socket, and removes the Unix
+* socket file if one was created
+* @pre: LibraryServer object exists
+* @post: all sockets are closed
+* @param: None
+*/
+LibraryServer::~LibraryServer() {
+    while (!connections.empty()) {
+        closeConnection(connections.begin()->second);
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+    }
+    if (socketPath != "") {
+        unlink(socketPath.c_str());
+    }
+    close(epollFd);
+}
+
+/*-------------------------------------------------------------------------
+* listenUnix(const string&)
+*
+* Listens on a Unix domain socket at the given path (replacing a stale
+* socket file left behind by an earlier run)
+* @pre: server is not listening yet
+* @post: clients can connect to the path
+* @param: const string& - file system path of the socket
+* @return: bool - true if the socket is listening
+*/
+bool LibraryServer::listenUnix(const string& path) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        cerr << "ERROR: socket path is too long: " << path << endl;
+        return false;
+    }
+    strcpy(address.sun_path, path.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str());
+    if (fd < 0 || bind(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+        cerr << "ERROR: cannot bind " << path << ": " << strerror(errno) << endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+    socketPath = path;
+    return startListening(fd);
+}
+
+/*-------------------------------------------------------------------------
+* listenTcp(int)
+*
+* Listens on the given TCP port of 127.0.0.1 only
+* @pre: server is not listening yet
+* @post: clients can connect to localhost:port
+* @param: int - the port number
+* @return: bool - true if the socket is listening
+*/
+bool LibraryServer::listenTcp(int port) {
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    if (fd >= 0) {
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    }
+    if (fd < 0 || bind(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+        cerr << "ERROR: cannot bind port " << port << ": " << strerror(errno) << endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+    return startListening(fd);
+}
+
+/*-------------------------------------------------------------------------
+* startListening(int)
+*
+* Makes a bound socket non-blocking, listens and registers it with epoll
+* @pre: socket is bound
+* @post: socket is listening, or closed on failure
+* @param: int - the bound socket
+* @return: bool - true if listening
+*/
+bool LibraryServer::startListening(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (listen(fd, SERVER_BACKLOG) < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        cerr << "ERROR: cannot listen: " << strerror(errno) << endl;
+        close(fd);
+        return false;
+    }
+    listenFd = fd;
+    return true;
+}
+
+/*-------------------------------------------------------------------------
+* run()
+*
+* Runs the event loop until stop() is called
+* @pre: listenUnix() or listenTcp() succeeded
+* @post: every accepted connection has been served and closed
+* @param: None
+*/
+void LibraryServer::run() {
+    epoll_event events[MAX_EVENTS];
+    while (!stopping) {
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, EVENT_TIMEOUT);
+        for (int i = 0; i < ready; i++) {
+            if (events[i].data.fd == listenFd) {
+                acceptConnections();
+                continue;
+            }
+            map<int, Connection*>::iterator found = connections.find(events[i].data.fd);
+            if (found == connections.end()) {
+                continue;
+            }
+            Connection* connection = found->second;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                dropConnection(connection);
+                continue;
+            }
+            if (events[i].events & EPOLLIN) {
+                readConnection(connection);
+            }
+            if (events[i].events & EPOLLOUT) {
+                writeConnection(connection);
+                executeLines(connection); // output drained, resume input
+                writeConnection(connection);
+            }
+            updateConnection(connection);
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------
+* stop()
+*
+* Asks the event loop to return. Safe to call from a signal handler.
+* @pre: None
+* @post: run() returns within one loop timeout
+* @param: None
+*/
+void LibraryServer::stop() {
+    stopping = 1;
+}
+
+// accepts every pending client on the listening socket
+void LibraryServer::acceptConnections() {
+    int fd = accept(listenFd, nullptr, nullptr);
+    while (fd >= 0) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        Connection* connection = new Connection();
+        connection->fd = fd;
+        connection->written = 0;
+        connection->peerClosed = false;
+        connections[fd] = connection;
+
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        fd = accept(listenFd, nullptr, nullptr);
+    }
+}
+
+// reads one chunk from the client (epoll reports the rest), then executes it
+void LibraryServer::readConnection(Connection* connection) {
+    char buffer[READ_CHUNK_SIZE];
+    ssize_t count = recv(connection->fd, buffer, sizeof(buffer), 0);
+    if (count > 0) {
+        connection->input.append(buffer, count);
+    } else if (count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        connection->peerClosed = true;
+    }
+    executeLines(connection);
+    writeConnection(connection);
+}
+
+// executes every complete line of input while output has room, in batches
+void LibraryServer::executeLines(Connection* connection) {
+    size_t start = 0;
+    size_t end = connection->input.find('\n');
+    vector<string> lines;
+    while (end != string::npos && connection->output.size() < MAX_PENDING_OUTPUT) {
+        lines.clear();
+        while (end != string::npos && lines.size() < COMMAND_BATCH_SIZE) {
+            lines.push_back(connection->input.substr(start, end - start));
+            start = end + 1;
+            end = connection->input.find('\n', start);
+        }
+        executeBatch(lines, connection->output);
+    }
+    connection->input.erase(0, start);
+
+    // the last command of a client that is done sending may lack its newline
+    if (connection->peerClosed && end == string::npos && !connection->input.empty()) {
+        lines.assign(1, connection->input);
+        executeBatch(lines, connection->output);
+        connection->input.clear();
+    }
+    if (connection->input.size() > MAX_COMMAND_LENGTH) {
+        // not a command line, stop listening to this client
+        connection->input.clear();
+        connection->peerClosed = true;
+    }
+}
+
+// executes a batch of command lines, appending their answers to the output
+void LibraryServer::executeBatch(const vector<string>& lines, string& output) {
+    vector<string> answers;
+    library.acceptBatch(lines, answers);
+    for (int i = 0; i < answers.size(); i++) {
+        output += answers[i];
+        output += ANSWER_END;
+    }
+}
+
+// writes as much pending output as the socket takes
+void LibraryServer::writeConnection(Connection* connection) {
+    while (connection->written < connection->output.size()) {
+        ssize_t count = send(connection->fd, connection->output.data() + connection->written,
+                             connection->output.size() - connection->written, MSG_NOSIGNAL);
+        if (count <= 0) {
+            if (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                // client is gone, nothing more can be delivered
+                connection->peerClosed = true;
+                connection->output.clear();
+                connection->written = 0;
+            }
+            return;
+        }
+        connection->written += count;
+    }
+    connection->output.clear();
+    connection->written = 0;
+}
+
+// picks read/write interest for the connection, closes it when done
+void LibraryServer::updateConnection(Connection* connection) {
+    bool pendingOutput = connection->written < connection->output.size();
+    if (connection->peerClosed && !pendingOutput && connection->input.empty()) {
+        closeConnection(connection);
+        return;
+    }
+    epoll_event event;
+    event.events = 0;
+    if (!connection->peerClosed && connection->output.size() < MAX_PENDING_OUTPUT) {
+        event.events |= EPOLLIN;
+    }
+    if (pendingOutput) {
+        event.events |= EPOLLOUT;
+    }
+    event.data.fd = connection->fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection->fd, &event);
+}
+
+// executes whatever the vanished client sent, then closes the connection
+void LibraryServer::dropConnection(Connection* connection) {
+    char buffer[READ_CHUNK_SIZE];
+    ssize_t count = recv(connection->fd, buffer, sizeof(buffer), 0);
+    while (count > 0) {
+        connection->input.append(buffer, count);
+        count = recv(connection->fd, buffer, sizeof(buffer), 0);
+    }
+    connection->peerClosed = true;
+    while (!connection->input.empty()) {
+        connection->output.clear();
+        connection->written = 0;
+        executeLines(connection);
+    }
+    closeConnection(connection);
+}
+
+// removes the connection from epoll, closes and deletes it
+void LibraryServer::closeConnection(Connection* connection) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->fd, nullptr);
+    close(connection->fd);
+    connections.erase(connection->fd);
+    delete connection;
+}
@@ -0,0 +1,164 @@
+/*---------------------------------------------------------------------------
+* @file: server.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the LibraryServer class
+---------------------------------------------------------------------------*/
+// LibraryServer Class: Keeps a Library resident in memory and executes the
+// same C/R/D/H commands as the command file, received from clients over a
+// Unix domain socket or a localhost TCP port.
+//---------------------------------------------------------------------------
+// Features:
+// -- Single threaded epoll event loop, any number of clients.
+// -- Protocol is line based: a client sends command lines exactly as they
+//    appear in data4commands.txt. For every command, the server answers with
+//    everything the command printed, followed by a line holding only ".".
+// -- Requests can be pipelined: every complete line that has arrived is
+//    executed in order and the answers are queued in the connection's own
+//    output buffer, which is drained whenever the socket is writable.
+// -- A client that stops reading stops being read from once its output
+//    buffer passes MAX_PENDING_OUTPUT (backpressure), and is resumed once
+//    the buffer drains.
+//
+// Assumptions/implementation:
+// -- Complete lines are handed to Library::acceptBatch() up to
+//    COMMAND_BATCH_SIZE at a time, which parses and looks up the whole batch
+//    before applying it in order. Answers are the same as one at a time.
+// -- Commands print to std::cout. While a batch runs, std::cout is
+//    redirected into one buffer per command, each then appended to the
+//    connection's output. Only one batch runs at a time, so answers never
+//    mix.
+// -- A client that half-closes its socket still gets every answer before
+//    the connection is closed.
+// -- The Library is owned by the caller and must outlive the server.
+//---------------------------------------------------------------------------
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <string>
+#include <map>
+#include <vector>
+#include <csignal>
+#include "library.h"
+
+using namespace std;
+
+class LibraryServer {
+  public:
+    /*-------------------------------------------------------------------------
+    * Constructor
+    *
+    * Creates the epoll instance, nothing is listened on yet
+    * @pre: Library object exists and is built
+    * @post: LibraryServer object exists
+    * @param: Library& - the library commands are executed against
+    */
+    LibraryServer(Library&);
+
+    /*-------------------------------------------------------------------------
+    * Destructor
+    *
+    * Closes every connection and the listening socket, and removes the Unix
+    * socket file if one was created
+    * @pre: LibraryServer object exists
+    * @post: all sockets are closed
+    * @param: None
+    */
+    ~LibraryServer();
+
+    /*-------------------------------------------------------------------------
+    * listenUnix(const string&)
+    *
+    * Listens on a Unix domain socket at the given path (replacing a stale
+    * socket file left behind by an earlier run)
+    * @pre: server is not listening yet
+    * @post: clients can connect to the path
+    * @param: const string& - file system path of the socket
+    * @return: bool - true if the socket is listening
+    */
+    bool listenUnix(const string&);
+
+    /*-------------------------------------------------------------------------
+    * listenTcp(int)
+    *
+    * Listens on the given TCP port of 127.0.0.1 only
+    * @pre: server is not listening yet
+    * @post: clients can connect to localhost:port
+    * @param: int - the port number
+    * @return: bool - true if the socket is listening
+    */
+    bool listenTcp(int);
+
+    /*-------------------------------------------------------------------------
+    * run()
+    *
+    * Runs the event loop until stop() is called
+    * @pre: listenUnix() or listenTcp() succeeded
+    * @post: every accepted connection has been served and closed
+    * @param: None
+    */
+    void run();
+
+    /*-------------------------------------------------------------------------
+    * stop()
+    *
+    * Asks the event loop to return. Safe to call from a signal handler.
+    * @pre: None
+    * @post: run() returns within one loop timeout
+    * @param: None
+    */
+    void stop();
+
+  private:
+    // one client and its buffered, not yet executed input and its not yet
+    // written output
+    struct Connection {
+        int fd;             // client socket
+        string input;       // received bytes, possibly ending mid-line
+        string output;      // answers waiting to be written
+        size_t written;     // bytes of output already written
+        bool peerClosed;    // client will send no more commands
+    };
+
+    Library& library;                    // library commands run against
+    int epollFd;                         // epoll instance
+    int listenFd;                        // listening socket, -1 if none
+    string socketPath;                   // Unix socket file, "" for TCP
+    map<int, Connection*> connections;   // open connections by fd
+    volatile sig_atomic_t stopping;      // set by stop()
+
+    /*-------------------------------------------------------------------------
+    * startListening(int)
+    *
+    * Makes a bound socket non-blocking, listens and registers it with epoll
+    * @pre: socket is bound
+    * @post: socket is listening, or closed on failure
+    * @param: int - the bound socket
+    * @return: bool - true if listening
+    */
+    bool startListening(int);
+
+    // accepts every pending client on the listening socket
+    void acceptConnections();
+
+    // reads one chunk from the client (epoll reports the rest), then executes it
+    void readConnection(Connection*);
+
+    // executes every complete line of input while output has room, in batches
+    void executeLines(Connection*);
+
+    // executes a batch of command lines, appending their answers to the output
+    void executeBatch(const vector<string>&, string&);
+
+    // writes as much pending output as the socket takes
+    void writeConnection(Connection*);
+
+    // picks read/write interest for the connection, closes it when done
+    void updateConnection(Connection*);
+
+    // executes whatever a vanished client sent, then closes the connection
+    void dropConnection(Connection*);
+
+    // removes the connection from epoll, closes and deletes it
+    void closeConnection(Connection*);
+};
+#endif //SERVER_H
@@ -0,0 +1,146 @@
+/*---------------------------------------------------------------------------
+* @file: statistics.cpp
+* @authors: Braxton Goss & Elijah Shaw
+* @brief: implementation of the transaction type - statistics
+--------------------------------------------------------------------------*/
+
+#include "transaction.h"
+#include "statistics.h"
+#include "library.h"
+
+/*-------------------------------------------------------------------------
+* Constructor 
+*
+* Nothing to initialize
+* @pre: Nothing
+* @post: new Statistics object exists
+* @param: None
+*/
+Statistics::Statistics() : Transaction() {}
+
+/*-------------------------------------------------------------------------
+* Destructor
+*
+* Nothing to delete
+* @pre: Statistics object exists
+* @post: Memory associated with that Statistics object is released
+* @param: None
+*/
+Statistics::~Statistics() {}
+
+/*-------------------------------------------------------------------------
+* create()
+*
+* Returns a pointer to a newly created & empty Statistics object
+* This method is used inside of TransactionFactory to create new objects 
+* without using Switch-Case or If-else statements. 
+* @pre: Nothing 
+* @post: empty Statistics object is returned to the caller 
+* @param: None
+* @return: returns the new Statistics object
+*/
+Statistics* Statistics::create() const {
+    return new Statistics();
+}
+
+/*-------------------------------------------------------------------------
+* load(const Command&)
+*
+* A statistics command has no fields, nothing is stored.
+* @pre: command.type is S
+* @post: Nothing is changed
+* @param: const Command& - unused
+*/
+void Statistics::load(const Command&) {
+    // nothing to store
+}
+
+/*-------------------------------------------------------------------------
+* getPatronID()
+*
+* A statistics command has no patron, there is nothing to prefetch.
+* @pre: None
+* @post: Statistics is unchanged
+* @return: int - always 0
+*/
+int Statistics::getPatronID() const {
+    return 0;
+}
+
+/*-------------------------------------------------------------------------
+* findPatron(Library&)
+*
+* A statistics command has no patron, nothing is looked up.
+* @pre: None
+* @post: Nothing is changed
+* @param: Library& - unused
+*/
+void Statistics::findPatron(Library&) {
+    // nothing to look up
+}
+
+/*-------------------------------------------------------------------------
+* findItem(Library&)
+*
+* A statistics command has no item, nothing is looked up.
+* @pre: None
+* @post: Nothing is changed
+* @param: Library& - unused
+*/
+void Statistics::findItem(Library&) {
+    // nothing to look up
+}
+
+/*-------------------------------------------------------------------------
+* apply(Library&)
+*
+* Prints the library's command statistics.
+* @pre: earlier commands have been applied
+* @post: statistics are printed, the library is unchanged
+* @param: Library& - the library whose statistics are printed
+* @return: always false, there is no information to save for a Statistics
+*/
+bool Statistics::apply(Library& currLibrary) {
+    currLibrary.displayStatistics(cout);
+    return false;
+}
+
+/*-------------------------------------------------------------------------
+* display()
+*
+* Prints to the std::cout the Statistics action, which is always nothing.
+* @pre: execute() has already been called by this object.
+* @post: Nothing is printed.
+* @param: None
+*/
+void Statistics::display() const {
+    
+}
+
+/*-------------------------------------------------------------------------
+* replay(Patron*, char, Item*, int&)
+*
+* A Statistics never changes the library, so it is never logged and there
+* is nothing to redo.
+* @pre: Nothing
+* @post: Nothing is changed
+* @param: Patron*, char, Item* - unused
+* @param: int& - set to 0, a Statistics never changes stock
+* @return: always false, a Statistics is never saved to patron history
+*/
+bool Statistics::replay(Patron*, char, Item*, int& stockChange) {
+    stockChange = 0;
+    return false;
+}
+
+/*-------------------------------------------------------------------------
+* save(ostream&)
+*
+* Never called, a Statistics is not saved to any patron history.
+* @pre: Nothing
+* @post: Nothing is written
+* @param: ostream& - the stream the record is written to
+*/
+void Statistics::save(ostream&) const {
+    // nothing to save, not part of a patron's transaction list
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*---------------------------------------------------------------------------
+* @file: statistics.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the statistics (type of transaction) class 
+//------------------------------------------------------------------------*/
+// Statistics Class: Shows the command statistics the library has kept so
+// far (see commandstats.h). Command line: "S".
+// Features:
+// -- Prints counts, errors by reason and latency percentiles per command
+//    type, and the depth of item and patron lookups
+//
+// Assumptions/implementation:
+// -- Like a Display, it has no patron or item and changes nothing, so it
+//    is never saved or logged.
+// -- The S command itself is counted once it is done, so it shows up in 
+//    the next statistics printed.
+//---------------------------------------------------------------------------
+
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+class Statistics : public Transaction {
+    public:
+
+        /*-------------------------------------------------------------------------
+        * Constructor 
+        *
+        * Nothing to initialize
+        * @pre: Nothing
+        * @post: new Statistics object exists
+        * @param: None
+        */
+        Statistics();
+
+        /*-------------------------------------------------------------------------
+        * Destructor
+        *
+        * Nothing to delete
+        * @pre: Statistics object exists
+        * @post: Memory associated with that Statistics object is released
+        * @param: None
+        */
+        ~Statistics();
+
+        /*-------------------------------------------------------------------------
+        * create()
+        *
+        * Returns a pointer to a newly created & empty Statistics object
+        * This method is used inside of TransactionFactory to create new objects 
+        * without using Switch-Case or If-else statements. 
+        * @pre: Nothing 
+        * @post: empty Statistics object is returned to the caller 
+        * @param: None
+        * @return: returns the new Statistics object
+        */
+        virtual Statistics* create() const;  // creates new Statistics object
+
+        // letter of the command, for its registration in TransactionTypes
+        static const char TYPE = 'S';
+
+        /*-------------------------------------------------------------------------
+        * load(const Command&)
+        *
+        * A statistics command has no fields, nothing is stored.
+        * @pre: command.type is S
+        * @post: Nothing is changed
+        * @param: const Command& - unused
+        */
+        virtual void load(const Command&);
+
+        /*-------------------------------------------------------------------------
+        * getPatronID()
+        *
+        * A statistics command has no patron, there is nothing to prefetch.
+        * @pre: None
+        * @post: Statistics is unchanged
+        * @return: int - always 0
+        */
+        virtual int getPatronID() const;
+
+        /*-------------------------------------------------------------------------
+        * findPatron(Library&)
+        *
+        * A statistics command has no patron, nothing is looked up.
+        * @pre: None
+        * @post: Nothing is changed
+        * @param: Library& - unused
+        */
+        virtual void findPatron(Library&);
+
+        /*-------------------------------------------------------------------------
+        * findItem(Library&)
+        *
+        * A statistics command has no item, nothing is looked up.
+        * @pre: None
+        * @post: Nothing is changed
+        * @param: Library& - unused
+        */
+        virtual void findItem(Library&);
+
+        /*-------------------------------------------------------------------------
+        * apply(Library&)
+        *
+        * Prints the library's command statistics.
+        * @pre: earlier commands have been applied
+        * @post: statistics are printed, the library is unchanged
+        * @param: Library& - the library whose statistics are printed
+        * @return: always false, there is no information to save for a Statistics
+        */
+        virtual bool apply(Library&);
+
+        
+
+        /*-------------------------------------------------------------------------
+        * display()
+        *
+        * Prints to the std::cout the Statistics action, which is always nothing.
+        * @pre: execute() has already been called by this object.
+        * @post: Nothing is printed
+        * @param: None
+        */
+        virtual void display() const;
+
+        /*-------------------------------------------------------------------------
+        * replay(Patron*, char, Item*, int&)
+        *
+        * A Statistics never changes the library, so it is never logged and there
+        * is nothing to redo.
+        * @pre: Nothing
+        * @post: Nothing is changed
+        * @param: Patron*, char, Item* - unused
+        * @param: int& - set to 0, a Statistics never changes stock
+        * @return: always false, a Statistics is never saved to patron history
+        */
+        virtual bool replay(Patron*, char, Item*, int&);
+
+        /*-------------------------------------------------------------------------
+        * save(ostream&)
+        *
+        * Never called, a Statistics is not saved to any patron history.
+        * @pre: Nothing
+        * @post: Nothing is written
+        * @param: ostream& - the stream the record is written to
+        */
+        virtual void save(ostream&) const;
+    
+}; //STATISTICS_H
+
+#endif
\ No newline at end of file
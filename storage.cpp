@@ -0,0 +1,146 @@
+/*---------------------------------------------------------------------------
+* @file: storage.cpp
+* @authors: Braxton Goss & Elijah Shaw
+* @brief: implementation of the transaction type - storage
+--------------------------------------------------------------------------*/
+
+#include "transaction.h"
+#include "storage.h"
+#include "library.h"
+
+/*-------------------------------------------------------------------------
+* Constructor 
+*
+* Nothing to initialize
+* @pre: Nothing
+* @post: new Storage object exists
+* @param: None
+*/
+Storage::Storage() : Transaction() {}
+
+/*-------------------------------------------------------------------------
+* Destructor
+*
+* Nothing to delete
+* @pre: Storage object exists
+* @post: Memory associated with that Storage object is released
+* @param: None
+*/
+Storage::~Storage() {}
+
+/*-------------------------------------------------------------------------
+* create()
+*
+* Returns a pointer to a newly created & empty Storage object
+* This method is used inside of TransactionFactory to create new objects 
+* without using Switch-Case or If-else statements. 
+* @pre: Nothing 
+* @post: empty Storage object is returned to the caller 
+* @param: None
+* @return: returns the new Storage object
+*/
+Storage* Storage::create() const {
+    return new Storage();
+}
+
+/*-------------------------------------------------------------------------
+* load(const Command&)
+*
+* A storage command has no fields, nothing is stored.
+* @pre: command.type is M
+* @post: Nothing is changed
+* @param: const Command& - unused
+*/
+void Storage::load(const Command&) {
+    // nothing to store
+}
+
+/*-------------------------------------------------------------------------
+* getPatronID()
+*
+* A storage command has no patron, there is nothing to prefetch.
+* @pre: None
+* @post: Storage is unchanged
+* @return: int - always 0
+*/
+int Storage::getPatronID() const {
+    return 0;
+}
+
+/*-------------------------------------------------------------------------
+* findPatron(Library&)
+*
+* A storage command has no patron, nothing is looked up.
+* @pre: None
+* @post: Nothing is changed
+* @param: Library& - unused
+*/
+void Storage::findPatron(Library&) {
+    // nothing to look up
+}
+
+/*-------------------------------------------------------------------------
+* findItem(Library&)
+*
+* A storage command has no item, nothing is looked up.
+* @pre: None
+* @post: Nothing is changed
+* @param: Library& - unused
+*/
+void Storage::findItem(Library&) {
+    // nothing to look up
+}
+
+/*-------------------------------------------------------------------------
+* apply(Library&)
+*
+* Prints the shape and memory of the library's storage.
+* @pre: earlier commands have been applied
+* @post: the storage report is printed, the library is unchanged
+* @param: Library& - the library whose storage is measured
+* @return: always false, there is no information to save for a Storage
+*/
+bool Storage::apply(Library& currLibrary) {
+    currLibrary.displayStorage(cout);
+    return false;
+}
+
+/*-------------------------------------------------------------------------
+* display()
+*
+* Prints to the std::cout the Storage action, which is always nothing.
+* @pre: execute() has already been called by this object.
+* @post: Nothing is printed.
+* @param: None
+*/
+void Storage::display() const {
+    
+}
+
+/*-------------------------------------------------------------------------
+* replay(Patron*, char, Item*, int&)
+*
+* A Storage never changes the library, so it is never logged and there
+* is nothing to redo.
+* @pre: Nothing
+* @post: Nothing is changed
+* @param: Patron*, char, Item* - unused
+* @param: int& - set to 0, a Storage never changes stock
+* @return: always false, a Storage is never saved to patron history
+*/
+bool Storage::replay(Patron*, char, Item*, int& stockChange) {
+    stockChange = 0;
+    return false;
+}
+
+/*-------------------------------------------------------------------------
+* save(ostream&)
+*
+* Never called, a Storage is not saved to any patron history.
+* @pre: Nothing
+* @post: Nothing is written
+* @param: ostream& - the stream the record is written to
+*/
+void Storage::save(ostream&) const {
+    // nothing to save, not part of a patron's transaction list
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+/*---------------------------------------------------------------------------
+* @file: storage.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the storage (type of transaction) class 
+//------------------------------------------------------------------------*/
+// Storage Class: Measures how the library stores its items and patrons.
+// Command line: "M".
+// Features:
+// -- Prints, per section, the tree's item count, height, average lookup
+//    depth, memory and depth histogram, and for the patron HashTable the 
+//    load factor, longest chain and chain length histogram
+//
+// Assumptions/implementation:
+// -- Like a Display, it has no patron or item and changes nothing, so it
+//    is never saved or logged.
+// -- Every tree is walked, so it takes about as long as a Display (without
+//    the printing).
+//---------------------------------------------------------------------------
+
+#ifndef STORAGE_H
+#define STORAGE_H
+
+class Storage : public Transaction {
+    public:
+
+        /*-------------------------------------------------------------------------
+        * Constructor 
+        *
+        * Nothing to initialize
+        * @pre: Nothing
+        * @post: new Storage object exists
+        * @param: None
+        */
+        Storage();
+
+        /*-------------------------------------------------------------------------
+        * Destructor
+        *
+        * Nothing to delete
+        * @pre: Storage object exists
+        * @post: Memory associated with that Storage object is released
+        * @param: None
+        */
+        ~Storage();
+
+        /*-------------------------------------------------------------------------
+        * create()
+        *
+        * Returns a pointer to a newly created & empty Storage object
+        * This method is used inside of TransactionFactory to create new objects 
+        * without using Switch-Case or If-else statements. 
+        * @pre: Nothing 
+        * @post: empty Storage object is returned to the caller 
+        * @param: None
+        * @return: returns the new Storage object
+        */
+        virtual Storage* create() const;  // creates new Storage object
+
+        // letter of the command, for its registration in TransactionTypes
+        static const char TYPE = 'M';
+
+        /*-------------------------------------------------------------------------
+        * load(const Command&)
+        *
+        * A storage command has no fields, nothing is stored.
+        * @pre: command.type is M
+        * @post: Nothing is changed
+        * @param: const Command& - unused
+        */
+        virtual void load(const Command&);
+
+        /*-------------------------------------------------------------------------
+        * getPatronID()
+        *
+        * A storage command has no patron, there is nothing to prefetch.
+        * @pre: None
+        * @post: Storage is unchanged
+        * @return: int - always 0
+        */
+        virtual int getPatronID() const;
+
+        /*-------------------------------------------------------------------------
+        * findPatron(Library&)
+        *
+        * A storage command has no patron, nothing is looked up.
+        * @pre: None
+        * @post: Nothing is changed
+        * @param: Library& - unused
+        */
+        virtual void findPatron(Library&);
+
+        /*-------------------------------------------------------------------------
+        * findItem(Library&)
+        *
+        * A storage command has no item, nothing is looked up.
+        * @pre: None
+        * @post: Nothing is changed
+        * @param: Library& - unused
+        */
+        virtual void findItem(Library&);
+
+        /*-------------------------------------------------------------------------
+        * apply(Library&)
+        *
+        * Prints the shape and memory of the library's storage.
+        * @pre: earlier commands have been applied
+        * @post: the storage report is printed, the library is unchanged
+        * @param: Library& - the library whose storage is measured
+        * @return: always false, there is no information to save for a Storage
+        */
+        virtual bool apply(Library&);
+
+        
+
+        /*-------------------------------------------------------------------------
+        * display()
+        *
+        * Prints to the std::cout the Storage action, which is always nothing.
+        * @pre: execute() has already been called by this object.
+        * @post: Nothing is printed
+        * @param: None
+        */
+        virtual void display() const;
+
+        /*-------------------------------------------------------------------------
+        * replay(Patron*, char, Item*, int&)
+        *
+        * A Storage never changes the library, so it is never logged and there
+        * is nothing to redo.
+        * @pre: Nothing
+        * @post: Nothing is changed
+        * @param: Patron*, char, Item* - unused
+        * @param: int& - set to 0, a Storage never changes stock
+        * @return: always false, a Storage is never saved to patron history
+        */
+        virtual bool replay(Patron*, char, Item*, int&);
+
+        /*-------------------------------------------------------------------------
+        * save(ostream&)
+        *
+        * Never called, a Storage is not saved to any patron history.
+        * @pre: Nothing
+        * @post: Nothing is written
+        * @param: ostream& - the stream the record is written to
+        */
+        virtual void save(ostream&) const;
+    
+}; //STORAGE_H
+
+#endif
\ No newline at end of file
@@ -0,0 +1,68 @@
+/*---------------------------------------------------------------------------
+* @file: stringpool.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: implementation of the StringPool class
+---------------------------------------------------------------------------*/
+#include "stringpool.h"
+#include <unordered_set>
+#include <mutex>
+
+using namespace std;
+
+// the pool's strings (a node table: a string never moves once added) and
+// the lock every access takes, created on first use so Items built during
+// static initialization find them
+static unordered_set<string>& strings() {
+    static unordered_set<string> pooled;
+    return pooled;
+}
+
+static mutex& poolLock() {
+    static mutex lock;
+    return lock;
+}
+
+/*-------------------------------------------------------------------------
+* intern(const char*, size_t)
+*
+* @pre: None
+* @post: the pool holds a copy of the string
+* @param: const char* - the string's characters
+* @param: size_t - its length
+* @return: const string* - the pool's copy, the same for equal strings
+*/
+const string* StringPool::intern(const char* text, size_t length) {
+    lock_guard<mutex> lock(poolLock());
+    return &*strings().insert(string(text, length)).first;
+}
+
+/*-------------------------------------------------------------------------
+* getCount()
+*
+* @pre: None
+* @post: pool is unchanged
+* @return: long - number of strings in the pool
+*/
+long StringPool::getCount() {
+    lock_guard<mutex> lock(poolLock());
+    return static_cast<long>(strings().size());
+}
+
+/*-------------------------------------------------------------------------
+* getBytes()
+*
+* @pre: None
+* @post: pool is unchanged
+* @return: long - memory of the strings and the table holding them
+*/
+long StringPool::getBytes() {
+    lock_guard<mutex> lock(poolLock());
+    const unordered_set<string>& pooled = strings();
+    // a node holds the string and its next pointer and hash, the
+    // characters are allocated apart
+    long bytes = static_cast<long>(pooled.bucket_count() * sizeof(void*));
+    for (unordered_set<string>::const_iterator it = pooled.begin(); it != pooled.end(); ++it) {
+        bytes += sizeof(string) + 2 * sizeof(void*) + it->capacity() + 1;
+    }
+    return bytes;
+}
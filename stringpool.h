@@ -0,0 +1,72 @@
+/*---------------------------------------------------------------------------
+* @file: stringpool.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the StringPool class
+---------------------------------------------------------------------------*/
+// StringPool Class: Where the strings too long for an Item's InlineString
+// fields are kept. Each different string is kept once, and every field
+// holding it points to that copy.
+//---------------------------------------------------------------------------
+// Features:
+// -- intern() returns the pool's copy of a string, adding it the first
+//    time it is asked for. The copy never moves, so fields keep pointing
+//    at it.
+// -- Only the Items a section takes are pooled (Item::poolStrings(), when
+//    the Library inserts them). The Items built to look others up, one
+//    per checkout or return, keep their own copies and free them, so
+//    commands never grow the pool and never take its lock.
+// -- Safe to call from several threads, as a bench or server may build
+//    more than one Library at a time.
+//
+// Assumptions/implementation:
+// -- Long titles and authors are rare, and only catalog loads and deltas
+//    add them, so one lock around the table is enough.
+// -- Strings are never removed: a removed Item stays in its section (and
+//    its string in the pool) until the section is emptied, and the pool
+//    grows only with the different long values the catalog ever held.
+//---------------------------------------------------------------------------
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+class StringPool {
+  public:
+    /*-------------------------------------------------------------------------
+    * intern(const char*, size_t)
+    *
+    * @pre: None
+    * @post: the pool holds a copy of the string
+    * @param: const char* - the string's characters
+    * @param: size_t - its length
+    * @return: const string* - the pool's copy, the same for equal strings
+    */
+    static const string* intern(const char*, size_t);
+
+    /*-------------------------------------------------------------------------
+    * getCount()
+    *
+    * @pre: None
+    * @post: pool is unchanged
+    * @return: long - number of strings in the pool
+    */
+    static long getCount();
+
+    /*-------------------------------------------------------------------------
+    * getBytes()
+    *
+    * @pre: None
+    * @post: pool is unchanged
+    * @return: long - memory of the strings and the table holding them
+    */
+    static long getBytes();
+
+  private:
+    // only static members, nothing to create
+    StringPool();
+};
+
+#endif //STRINGPOOL_H
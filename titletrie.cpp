@@ -0,0 +1,456 @@
+/*---------------------------------------------------------------------------
+* @file: titletrie.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: implementation of the TitleTrie class
+---------------------------------------------------------------------------*/
+#include "titletrie.h"
+#include <algorithm>
+#include <cctype>
+
+using namespace std;
+
+// heap bytes of a string, 0 if it fits in the string itself
+static long stringBytes(const string& text) {
+    static const size_t INSIDE = string().capacity();
+    return (text.capacity() > INSIDE) ? text.capacity() + 1 : 0;
+}
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* @pre: None
+* @post: empty trie exists
+* @param: None
+*/
+TitleTrie::TitleTrie() {
+    root = new Node();
+    root->title = nullptr;
+    titleCount = 0;
+    nodeCount = 1;
+}
+
+/*-------------------------------------------------------------------------
+* Destructor
+*
+* @pre: trie exists
+* @post: every node and title is freed
+* @param: None
+*/
+TitleTrie::~TitleTrie() {
+    destroy(root);
+}
+
+/*-------------------------------------------------------------------------
+* insert(const Item&)
+*
+* @pre: None
+* @post: the Item's title is in the trie (with no checkouts if it is
+* new, one more Item if it was there). Blank titles are not added.
+* @param: const Item& - the Item added to a section
+*/
+void TitleTrie::insert(const Item& item) {
+    string key = normalize(item.getTitle());
+    if (key.empty()) {
+        return;
+    }
+    vector<Node*> path(1, root);
+    Node* node = root;
+    size_t done = 0;
+    while (done < key.size()) {
+        Node* next = child(node, key[done]);
+        if (next == nullptr) {
+            // nothing branches off here yet: the rest of the key is a leaf
+            next = new Node();
+            next->label = key.substr(done);
+            next->title = nullptr;
+            vector<Node*>::iterator place = node->children.begin();
+            while (place != node->children.end() && (*place)->label[0] < key[done]) {
+                ++place;
+            }
+            node->children.insert(place, next);
+            nodeCount++;
+            path.push_back(next);
+            node = next;
+            break;
+        }
+        size_t shared = 0;
+        while (shared < next->label.size() && done + shared < key.size() &&
+               next->label[shared] == key[done + shared]) {
+            shared++;
+        }
+        if (shared < next->label.size()) {
+            // the key leaves the edge part way: split it there. The new
+            // node has the same titles below it as the old one had
+            Node* split = new Node();
+            split->label = next->label.substr(0, shared);
+            split->children.push_back(next);
+            split->best = next->best;
+            split->title = nullptr;
+            next->label.erase(0, shared);
+            for (size_t i = 0; i < node->children.size(); i++) {
+                if (node->children[i] == next) {
+                    node->children[i] = split;
+                }
+            }
+            nodeCount++;
+            next = split;
+        }
+        path.push_back(next);
+        node = next;
+        done += shared;
+    }
+
+    if (node->title != nullptr) {
+        node->title->items++;
+        return;
+    }
+    node->title = new Title();
+    node->title->title = item.getTitle();
+    node->title->checkouts = 0;
+    node->title->items = 1;
+    titleCount++;
+    for (size_t i = 0; i < path.size(); i++) {
+        promote(path[i], node->title);
+    }
+}
+
+/*-------------------------------------------------------------------------
+* remove(const Item&)
+*
+* @pre: the Item was inserted and not removed since
+* @post: the title has one Item less, and is gone once it has none
+* @param: const Item& - the Item removed from its section
+*/
+void TitleTrie::remove(const Item& item) {
+    vector<Node*> path;
+    Node* node = locate(normalize(item.getTitle()), path);
+    if (node == nullptr || node->title == nullptr || --node->title->items > 0) {
+        return;
+    }
+    Title* gone = node->title;
+    node->title = nullptr;
+    titleCount--;
+
+    if (node != root) {
+        Node* parent = path[path.size() - 2];
+        if (node->children.empty()) {
+            // a leaf with no title is of no use: unlink it, which may leave
+            // its parent a plain pass-through
+            parent->children.erase(find(parent->children.begin(), parent->children.end(), node));
+            delete node;
+            nodeCount--;
+            path.pop_back();
+            if (parent != root && parent->title == nullptr && parent->children.size() == 1) {
+                merge(path[path.size() - 2], parent);
+                path.pop_back();
+            }
+        } else if (node->children.size() == 1) {
+            merge(parent, node);
+            path.pop_back();
+        }
+    }
+    // the nodes still on the path hold everything they held, but gone:
+    // their lists are rebuilt bottom up, from lists already correct
+    for (size_t i = path.size(); i-- > 0;) {
+        Node* above = path[i];
+        if (find(above->best.begin(), above->best.end(), gone) != above->best.end()) {
+            rebuild(above);
+        }
+    }
+    delete gone;
+}
+
+/*-------------------------------------------------------------------------
+* countCheckout(const Item&, long)
+*
+* @pre: None
+* @post: the Item's title has count more checkouts, and is moved up in
+* the nodes above it. Nothing happens for a title not in the trie.
+* @param: const Item& - the Item checked out
+* @param: long - checkouts to add (more than 1 when recovery replays a
+* log)
+*/
+void TitleTrie::countCheckout(const Item& item, long count) {
+    vector<Node*> path;
+    Node* node = locate(normalize(item.getTitle()), path);
+    if (node == nullptr || node->title == nullptr) {
+        return;
+    }
+    node->title->checkouts += count;
+    for (size_t i = 0; i < path.size(); i++) {
+        promote(path[i], node->title);
+    }
+}
+
+/*-------------------------------------------------------------------------
+* complete(const string&, vector<const Title*>&)
+*
+* @pre: None
+* @post: trie is unchanged
+* @param: const string& - what was typed, normalized like the titles
+* (a blank at its end stays, so "the " doesn't complete to "theory")
+* @param: vector<const Title*>& - set to the titles starting with it,
+* best first, at most AUTOCOMPLETE_RESULTS of them
+* @return: int - number of titles found
+*/
+int TitleTrie::complete(const string& prefix, vector<const Title*>& titles) const {
+    titles.clear();
+    string key = normalize(prefix);
+    if (!key.empty() && !prefix.empty() && isspace(static_cast<unsigned char>(prefix.back()))) {
+        key += ' ';
+    }
+    const Node* node = root;
+    size_t done = 0;
+    while (done < key.size()) {
+        node = child(node, key[done]);
+        if (node == nullptr) {
+            return 0;
+        }
+        // the prefix may end inside the edge: the titles below its end
+        // are the ones below the node
+        size_t length = min(node->label.size(), key.size() - done);
+        if (node->label.compare(0, length, key, done, length) != 0) {
+            return 0;
+        }
+        done += length;
+    }
+    titles.assign(node->best.begin(), node->best.end());
+    return static_cast<int>(titles.size());
+}
+
+/*-------------------------------------------------------------------------
+* makeEmpty()
+*
+* @pre: None
+* @post: the trie holds no titles
+* @param: None
+*/
+void TitleTrie::makeEmpty() {
+    destroy(root);
+    root = new Node();
+    root->title = nullptr;
+    titleCount = 0;
+    nodeCount = 1;
+}
+
+/*-------------------------------------------------------------------------
+* getTitleCount(), getNodeCount()
+*
+* @pre: None
+* @post: trie is unchanged
+* @return: long - titles held, nodes holding them
+*/
+long TitleTrie::getTitleCount() const {
+    return titleCount;
+}
+
+long TitleTrie::getNodeCount() const {
+    return nodeCount;
+}
+
+/*-------------------------------------------------------------------------
+* getBytes()
+*
+* @pre: None
+* @post: trie is unchanged
+* @return: long - memory of the nodes, their edges and lists, and the
+* titles
+*/
+long TitleTrie::getBytes() const {
+    return measure(root);
+}
+
+/*-------------------------------------------------------------------------
+* normalize(const string&)
+*
+* @pre: None
+* @post: None
+* @param: const string& - a title
+* @return: string - the title as the trie keys it (see the header)
+*/
+string TitleTrie::normalize(const string& title) {
+    string key;
+    key.reserve(title.size());
+    bool blank = false;
+    for (size_t i = 0; i < title.size(); i++) {
+        unsigned char character = static_cast<unsigned char>(title[i]);
+        if (isspace(character)) {
+            blank = true;
+            continue;
+        }
+        if (blank && !key.empty()) {
+            key += ' ';
+        }
+        blank = false;
+        key += static_cast<char>(tolower(character));
+    }
+    return key;
+}
+
+/*-------------------------------------------------------------------------
+* locate(const string&, vector<Node*>&)
+*
+* @pre: None
+* @post: trie is unchanged
+* @param: const string& - a normalized key
+* @param: vector<Node*>& - set to the nodes from the root to the node
+* found, both included
+* @return: Node* - the node the key ends at, nullptr if none does
+*/
+TitleTrie::Node* TitleTrie::locate(const string& key, vector<Node*>& path) const {
+    path.assign(1, root);
+    Node* node = root;
+    size_t done = 0;
+    while (done < key.size()) {
+        node = child(node, key[done]);
+        if (node == nullptr || key.compare(done, node->label.size(), node->label) != 0) {
+            return nullptr;
+        }
+        path.push_back(node);
+        done += node->label.size();
+    }
+    return node;
+}
+
+/*-------------------------------------------------------------------------
+* child(const Node*, char)
+*
+* @pre: None
+* @post: trie is unchanged
+* @param: const Node* - the node
+* @param: char - first character of the edge wanted
+* @return: Node* - the child, nullptr if no edge starts with it
+*/
+TitleTrie::Node* TitleTrie::child(const Node* node, char first) {
+    // a handful of children at most nodes, a scan beats a search
+    for (size_t i = 0; i < node->children.size(); i++) {
+        char label = node->children[i]->label[0];
+        if (label == first) {
+            return node->children[i];
+        }
+        if (label > first) {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+/*-------------------------------------------------------------------------
+* better(const Title*, const Title*)
+*
+* @pre: None
+* @post: None
+* @param: const Title* - a title
+* @param: const Title* - another title
+* @return: bool - true if the first ranks before the second
+*/
+bool TitleTrie::better(const Title* first, const Title* second) {
+    if (first->checkouts != second->checkouts) {
+        return first->checkouts > second->checkouts;
+    }
+    return first->title < second->title;
+}
+
+/*-------------------------------------------------------------------------
+* promote(Node*, Title*)
+*
+* @pre: the title ranks no lower than it did when the list was made
+* @post: the list holds the best titles at or below the node, in order
+* @param: Node* - a node at or above the title
+* @param: Title* - the title that was added or checked out
+*/
+void TitleTrie::promote(Node* node, Title* title) {
+    vector<Title*>& best = node->best;
+    size_t place = find(best.begin(), best.end(), title) - best.begin();
+    if (place == best.size()) {
+        if (best.size() < AUTOCOMPLETE_RESULTS) {
+            best.push_back(title);
+        } else if (better(title, best.back())) {
+            place--;
+            best[place] = title;
+        } else {
+            return;
+        }
+    }
+    while (place > 0 && better(title, best[place - 1])) {
+        best[place] = best[place - 1];
+        place--;
+    }
+    best[place] = title;
+}
+
+/*-------------------------------------------------------------------------
+* rebuild(Node*)
+*
+* @pre: the lists of the node's children are correct
+* @post: the node's list is correct
+* @param: Node* - the node
+*/
+void TitleTrie::rebuild(Node* node) {
+    vector<Title*> candidates;
+    if (node->title != nullptr) {
+        candidates.push_back(node->title);
+    }
+    for (size_t i = 0; i < node->children.size(); i++) {
+        const vector<Title*>& below = node->children[i]->best;
+        candidates.insert(candidates.end(), below.begin(), below.end());
+    }
+    size_t kept = min(candidates.size(), static_cast<size_t>(AUTOCOMPLETE_RESULTS));
+    partial_sort(candidates.begin(), candidates.begin() + kept, candidates.end(), better);
+    node->best.assign(candidates.begin(), candidates.begin() + kept);
+}
+
+/*-------------------------------------------------------------------------
+* merge(Node*, Node*)
+*
+* @pre: node is a child of parent, with no title and one child
+* @post: the node's child takes its place, node is freed
+* @param: Node* - the parent
+* @param: Node* - the node merged away
+*/
+void TitleTrie::merge(Node* parent, Node* node) {
+    Node* only = node->children[0];
+    only->label.insert(0, node->label);
+    for (size_t i = 0; i < parent->children.size(); i++) {
+        if (parent->children[i] == node) {
+            parent->children[i] = only;
+        }
+    }
+    delete node;
+    nodeCount--;
+}
+
+/*-------------------------------------------------------------------------
+* destroy(Node*)
+*
+* @pre: None
+* @post: the node, its titles and everything below it are freed
+* @param: Node* - the node
+*/
+void TitleTrie::destroy(Node* node) {
+    for (size_t i = 0; i < node->children.size(); i++) {
+        destroy(node->children[i]);
+    }
+    delete node->title;
+    delete node;
+}
+
+/*-------------------------------------------------------------------------
+* measure(const Node*)
+*
+* @pre: None
+* @post: trie is unchanged
+* @param: const Node* - the node
+* @return: long - memory of the node, its title and everything below it
+*/
+long TitleTrie::measure(const Node* node) {
+    long bytes = sizeof(Node) + stringBytes(node->label)
+        + node->children.capacity() * sizeof(Node*) + node->best.capacity() * sizeof(Title*);
+    if (node->title != nullptr) {
+        bytes += sizeof(Title) + stringBytes(node->title->title);
+    }
+    for (size_t i = 0; i < node->children.size(); i++) {
+        bytes += measure(node->children[i]);
+    }
+    return bytes;
+}
@@ -0,0 +1,199 @@
+/*---------------------------------------------------------------------------
+* @file: titletrie.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the TitleTrie class
+---------------------------------------------------------------------------*/
+// TitleTrie Class: Radix trie of the titles of every section, for
+// autocomplete: the titles starting with what a patron has typed so far,
+// most checked out first. Each node keeps its best titles, so a query is
+// a walk down the prefix and a copy, whatever the size of the catalog.
+//---------------------------------------------------------------------------
+// Features:
+// -- Titles are normalized first: letters lowercased, every run of blanks
+//    made one space, no blanks at either end. "The  Hobbit" and "the
+//    hobbit" are the same title, and a prefix matches either.
+// -- The trie is compressed: an edge holds the characters no other title
+//    branches off in, so a node is where titles differ (or one ends).
+// -- Every node keeps the AUTOCOMPLETE_RESULTS best titles ending at or
+//    below it: most checkouts first, ties in title order. complete()
+//    returns the ones of the node the prefix leads to.
+// -- Items with the same title (the issues of a periodical, books of
+//    different authors) make one title, completed once, with the
+//    checkouts of all of them.
+//
+// Assumptions/implementation:
+// -- Checkouts only ever add to a title, so a title is moved up in the
+//    lists of the nodes above it and never needs more than those lists.
+//    Removing a title's last Item rebuilds the lists it was in, from the
+//    lists of the nodes below (they hold the best of their titles, so the
+//    best of their union is exact).
+// -- A node left with no title and one child is merged into it, so the
+//    trie stays compressed when titles are removed.
+// -- Holds pointers to its titles only, never to Items: the sections may
+//    move or free their Items without telling it.
+//---------------------------------------------------------------------------
+#ifndef TITLETRIE_H
+#define TITLETRIE_H
+
+#include <string>
+#include <vector>
+#include "item.h"
+#include "constants.h"
+
+using namespace std;
+
+class TitleTrie {
+  public:
+    // a title of the trie, shared by every Item with that normalized title
+    struct Title {
+        string title;    // as the first Item inserted spelled it
+        long checkouts;  // checkouts of all its Items
+        int items;       // Items with this title
+    };
+
+    /*-------------------------------------------------------------------------
+    * Constructor
+    *
+    * @pre: None
+    * @post: empty trie exists
+    * @param: None
+    */
+    TitleTrie();
+
+    /*-------------------------------------------------------------------------
+    * Destructor
+    *
+    * @pre: trie exists
+    * @post: every node and title is freed
+    * @param: None
+    */
+    ~TitleTrie();
+
+    /*-------------------------------------------------------------------------
+    * insert(const Item&)
+    *
+    * @pre: None
+    * @post: the Item's title is in the trie (with no checkouts if it is
+    * new, one more Item if it was there). Blank titles are not added.
+    * @param: const Item& - the Item added to a section
+    */
+    void insert(const Item&);
+
+    /*-------------------------------------------------------------------------
+    * remove(const Item&)
+    *
+    * @pre: the Item was inserted and not removed since
+    * @post: the title has one Item less, and is gone once it has none
+    * @param: const Item& - the Item removed from its section
+    */
+    void remove(const Item&);
+
+    /*-------------------------------------------------------------------------
+    * countCheckout(const Item&, long)
+    *
+    * @pre: None
+    * @post: the Item's title has count more checkouts, and is moved up in
+    * the nodes above it. Nothing happens for a title not in the trie.
+    * @param: const Item& - the Item checked out
+    * @param: long - checkouts to add (more than 1 when recovery replays a
+    * log)
+    */
+    void countCheckout(const Item&, long);
+
+    /*-------------------------------------------------------------------------
+    * complete(const string&, vector<const Title*>&)
+    *
+    * @pre: None
+    * @post: trie is unchanged
+    * @param: const string& - what was typed, normalized like the titles
+    * (a blank at its end stays, so "the " doesn't complete to "theory")
+    * @param: vector<const Title*>& - set to the titles starting with it,
+    * best first, at most AUTOCOMPLETE_RESULTS of them
+    * @return: int - number of titles found
+    */
+    int complete(const string&, vector<const Title*>&) const;
+
+    /*-------------------------------------------------------------------------
+    * makeEmpty()
+    *
+    * @pre: None
+    * @post: the trie holds no titles
+    * @param: None
+    */
+    void makeEmpty();
+
+    /*-------------------------------------------------------------------------
+    * getTitleCount(), getNodeCount()
+    *
+    * @pre: None
+    * @post: trie is unchanged
+    * @return: long - titles held, nodes holding them
+    */
+    long getTitleCount() const;
+    long getNodeCount() const;
+
+    /*-------------------------------------------------------------------------
+    * getBytes()
+    *
+    * @pre: None
+    * @post: trie is unchanged
+    * @return: long - memory of the nodes, their edges and lists, and the
+    * titles
+    */
+    long getBytes() const;
+
+    /*-------------------------------------------------------------------------
+    * normalize(const string&)
+    *
+    * @pre: None
+    * @post: None
+    * @param: const string& - a title
+    * @return: string - the title as the trie keys it (see the header)
+    */
+    static string normalize(const string&);
+
+  private:
+    struct Node {
+        string label;            // characters of the edge from the parent
+        vector<Node*> children;  // sorted by the first character of label
+        vector<Title*> best;     // best titles at or below, best first
+        Title* title;            // title ending here, nullptr if none
+    };
+
+    Node* root;       // empty label, the node of the empty prefix
+    long titleCount;  // titles held
+    long nodeCount;   // nodes, the root included
+
+    // node a normalized key ends at and the nodes from the root to it
+    // (both included), nullptr if no node ends exactly there
+    Node* locate(const string& key, vector<Node*>& path) const;
+
+    // child of a node whose label starts with a character, nullptr if none
+    static Node* child(const Node* node, char first);
+
+    // true if a title ranks before another (more checkouts, then title)
+    static bool better(const Title* first, const Title* second);
+
+    // title moved to its place in a node's list, added if it now ranks
+    // among the best
+    static void promote(Node* node, Title* title);
+
+    // list of a node rebuilt from its own title and its children's lists
+    static void rebuild(Node* node);
+
+    // node with no title and one child replaced by the child (labels
+    // joined) in the parent's children
+    void merge(Node* parent, Node* node);
+
+    // frees a node and everything below it
+    static void destroy(Node* node);
+
+    // memory of a node and everything below it
+    static long measure(const Node* node);
+
+    // copying would leave two tries owning the same nodes
+    TitleTrie(const TitleTrie&);
+    TitleTrie& operator=(const TitleTrie&);
+};
+
+#endif //TITLETRIE_H
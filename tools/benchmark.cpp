@@ -0,0 +1,245 @@
+/*---------------------------------------------------------------------------
+* @file: benchmark.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: end to end benchmark driver for the Library class
+---------------------------------------------------------------------------*/
+// Benchmark: Runs the library through its phases on a set of data files
+// (usually made by workload.cpp) and writes what it measured as JSON.
+//---------------------------------------------------------------------------
+// Usage:
+//   g++ -O2 -pthread -I. -o benchmark tools/benchmark.cpp
+//       $(ls *.cpp | grep -v main.cpp)      (one command line)
+//   ./benchmark [-b books] [-p patrons] [-c commands] [-o output.json]
+//               [-m pointer|value|eytzinger|lsm]
+//
+// Features:
+// -- load: builds the books and patrons from their files.
+// -- commands: executes every command of the command file one at a time,
+//    timing each, while saved transactions go to a transaction log.
+// -- replay: builds a second library and recovers it from that log, the
+//    way a restart after a crash would.
+// -- display: displays the whole library once.
+// -- For every phase: seconds, operations and operations per second. The
+//    commands phase adds latency percentiles, and the run adds peak RSS.
+// -- -m value runs it all with value sections (see valuesection.h), -m
+//    eytzinger with Eytzinger sections (see eytzingersection.h), -m lsm
+//    with LSM sections (see lsmsection.h).
+//
+// Assumptions/implementation:
+// -- Everything the library prints goes to a discarding stream, so the
+//    numbers don't include terminal or file output.
+// -- The log is written to <output>.log next to the JSON and removed at
+//    the end.
+//---------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <sys/resource.h>
+#include "library.h"
+#include "command.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+// stream buffer that drops everything written to it
+class NullBuffer : public streambuf {
+  protected:
+    int overflow(int c) { return c; }
+    streamsize xsputn(const char*, streamsize count) { return count; }
+};
+
+// what one phase measured
+struct Phase {
+    string name;
+    double seconds;
+    long operations;
+};
+
+// seconds since the given time
+static double since(Clock::time_point start) {
+    chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+// latency at the given fraction of the sorted list
+static double percentile(const vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+// lines of a file that hold something
+static long countLines(const string& path) {
+    ifstream infile(path.c_str());
+    string line;
+    long count = 0;
+    while (getline(infile, line)) {
+        count += line.empty() ? 0 : 1;
+    }
+    return count;
+}
+
+// string with JSON special characters escaped
+static string jsonString(const string& text) {
+    string escaped = "\"";
+    for (int i = 0; i < text.size(); i++) {
+        if (text[i] == '"' || text[i] == '\\') {
+            escaped += '\\';
+        }
+        escaped += text[i];
+    }
+    return escaped + "\"";
+}
+
+/*-------------------------------------------------------------------------
+* buildLibrary(const string&, const string&, SectionStorage)
+*
+* Creates a library from a book file and a patron file
+* @pre: files exist
+* @post: None
+* @param: const string& - the book file
+* @param: const string& - the patron file
+* @param: SectionStorage - how the library stores its sections
+* @return: Library* - the new library, owned by the caller
+*/
+static Library* buildLibrary(const string& booksPath, const string& patronsPath,
+                             SectionStorage storage) {
+    ifstream libraryData(booksPath.c_str());
+    ifstream patronData(patronsPath.c_str());
+    Library* library = new Library(storage);
+    library->buildBooksFromFile(libraryData);
+    library->buildPatronsFromFile(patronData);
+    return library;
+}
+
+int main(int argc, char* argv[]) {
+    string booksPath = "data4books.txt";
+    string patronsPath = "data4patrons.txt";
+    string commandsPath = "data4commands.txt";
+    string outputPath = "benchmark.json";
+    SectionStorage storage = POINTER_SECTIONS;
+    for (int i = 1; i < argc; i += 2) {
+        // an option without its value is as wrong as an unknown one
+        string option = (i + 1 < argc) ? argv[i] : "";
+        if (option == "-b") {
+            booksPath = argv[i + 1];
+        } else if (option == "-p") {
+            patronsPath = argv[i + 1];
+        } else if (option == "-c") {
+            commandsPath = argv[i + 1];
+        } else if (option == "-o") {
+            outputPath = argv[i + 1];
+        } else if (option == "-m" && (string(argv[i + 1]) == "pointer" || string(argv[i + 1]) == "value"
+                                      || string(argv[i + 1]) == "eytzinger" || string(argv[i + 1]) == "lsm")) {
+            string mode = argv[i + 1];
+            storage = (mode == "value") ? VALUE_SECTIONS
+                      : (mode == "eytzinger") ? EYTZINGER_SECTIONS
+                      : (mode == "lsm") ? LSM_SECTIONS : POINTER_SECTIONS;
+        } else {
+            cerr << "usage: " << argv[0] << " [-b books] [-p patrons] [-c commands]"
+                 << " [-o output.json] [-m pointer|value|eytzinger|lsm]" << endl;
+            return 1;
+        }
+    }
+    string logPath = outputPath + ".log";
+    remove(logPath.c_str());
+
+    NullBuffer discard;
+    streambuf* console = cout.rdbuf(&discard);
+    vector<Phase> phases;
+
+    // load
+    Clock::time_point start = Clock::now();
+    Library* library = buildLibrary(booksPath, patronsPath, storage);
+    Phase load = {"load", since(start), countLines(booksPath) + countLines(patronsPath)};
+    phases.push_back(load);
+
+    // commands, parsed up front so only execution is timed
+    vector<Command> commands;
+    {
+        ifstream commandData(commandsPath.c_str());
+        string line;
+        Command command;
+        while (getline(commandData, line)) {
+            if (CommandParser::parse(line, command)) {
+                commands.push_back(command);
+            }
+        }
+    }
+    library->openTransactionLog(logPath);
+    vector<double> latencies(commands.size());
+    start = Clock::now();
+    for (int i = 0; i < commands.size(); i++) {
+        Clock::time_point before = Clock::now();
+        library->acceptCommand(commands[i]);
+        chrono::duration<double, micro> latency = Clock::now() - before;
+        latencies[i] = latency.count();
+    }
+    Phase executed = {"commands", since(start), (long)commands.size()};
+    phases.push_back(executed);
+
+    // replay the log into a fresh library
+    delete library; // closes the log
+    library = buildLibrary(booksPath, patronsPath, storage);
+    long records = countLines(logPath);
+    start = Clock::now();
+    {
+        ifstream noSnapshot;
+        ifstream logData(logPath.c_str());
+        library->recover(noSnapshot, logData);
+    }
+    Phase replay = {"replay", since(start), records};
+    phases.push_back(replay);
+
+    // display
+    start = Clock::now();
+    library->display();
+    Phase display = {"display", since(start), 1};
+    phases.push_back(display);
+    delete library;
+    remove(logPath.c_str());
+    cout.rdbuf(console);
+
+    sort(latencies.begin(), latencies.end());
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    ofstream json(outputPath.c_str());
+    json << "{\n";
+    json << "  \"files\": {\"books\": " << jsonString(booksPath) << ", \"patrons\": "
+         << jsonString(patronsPath) << ", \"commands\": " << jsonString(commandsPath) << "},\n";
+    json << "  \"sections\": " << jsonString(storage == VALUE_SECTIONS ? "value"
+                                                : storage == EYTZINGER_SECTIONS ? "eytzinger"
+                                                : storage == LSM_SECTIONS ? "lsm" : "pointer") << ",\n";
+    json << "  \"phases\": [\n";
+    for (int i = 0; i < phases.size(); i++) {
+        double perSecond = (phases[i].seconds > 0) ? phases[i].operations / phases[i].seconds : 0;
+        json << "    {\"name\": " << jsonString(phases[i].name) << ", \"seconds\": "
+             << phases[i].seconds << ", \"operations\": " << phases[i].operations
+             << ", \"per_second\": " << perSecond;
+        if (phases[i].name == "commands") {
+            json << ",\n     \"latency_us\": {\"p50\": " << percentile(latencies, 0.50)
+                 << ", \"p90\": " << percentile(latencies, 0.90)
+                 << ", \"p99\": " << percentile(latencies, 0.99)
+                 << ", \"p99.9\": " << percentile(latencies, 0.999)
+                 << ", \"max\": " << (latencies.empty() ? 0 : latencies.back()) << "}";
+        }
+        json << "}" << (i + 1 < phases.size() ? "," : "") << "\n";
+    }
+    json << "  ],\n";
+    json << "  \"peak_rss_kb\": " << usage.ru_maxrss << "\n";
+    json << "}\n";
+    json.close();
+
+    ifstream written(outputPath.c_str());
+    cout << written.rdbuf();
+    return 0;
+}
@@ -0,0 +1,207 @@
+/*---------------------------------------------------------------------------
+* @file: calendarbench.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: periodical lookups and year slices in the calendar section
+---------------------------------------------------------------------------*/
+// Calendarbench: Files the same periodicals in a CalendarSection and in a
+// pointer tree (BinarySearchTree, with its key index), then counts lookups
+// per second of each way of finding an issue, and times collecting the
+// issues of a year: collectMonths() on the calendar, against collecting
+// the whole tree and keeping that year, as the other storages do.
+//---------------------------------------------------------------------------
+// Usage:
+//   g++ -O2 -pthread -I. -o calendarbench tools/calendarbench.cpp
+//       $(ls *.cpp | grep -v main.cpp)      (one command line)
+//   ./calendarbench [-t titles] [-y years] [-l lookups] [-s seed]
+//
+// Features:
+// -- The catalog is -t titles (default 20), each with an issue every month
+//    of -y years (default 60) from 1950: 14400 issues by default.
+// -- Prints for the calendar, the tree descent and the key index: millions
+//    of lookups per second and Items compared (or index slots probed) per
+//    lookup, for -l lookups (default 2000000) of random issues.
+// -- Then microseconds to collect the issues of a random year (1000
+//    years), both ways.
+//
+// Assumptions/implementation:
+// -- Issues are inserted in shuffled order, so the tree is as deep as a
+//    books file would make it.
+//---------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include "book.h"
+#include "periodicalbook.h"
+#include "binarysearchtree.h"
+#include "calendarsection.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+// keeps lookup results alive, so the loops aren't optimized away
+static volatile long sink;
+
+// seconds since the given time
+static double since(Clock::time_point start) {
+    chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+// sets book to issue number key: title key % titles, month key / titles
+// counted from January 1950
+static void setBook(PeriodicalBook& book, int key, int titles, istringstream& data) {
+    int month = key / titles;
+    stringstream text;
+    text << " " << 1950 + month / 12 << " " << 1 + month % 12
+         << " Communications of the Society " << key % titles << ",";
+    data.clear();
+    data.str(text.str());
+    book.setTransactionData(data);
+    book.setFormat('H');
+}
+
+// the way a periodical is looked up
+enum Lookup { CALENDAR, TREE_DESCENT, KEY_INDEX };
+
+// lookups of the probes, as millions per second, and Items compared
+static double timeLookups(const CalendarSection& calendar, const BinarySearchTree& tree,
+                          Lookup lookup, const vector<PeriodicalBook>& probes, double& compared) {
+    long found = 0;
+    long depths = 0;
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < probes.size(); i++) {
+        Item* item = nullptr;
+        int depth = 0;
+        if (lookup == CALENDAR) {
+            found += calendar.retrieveAs(probes[i], item, depth);
+        } else if (lookup == TREE_DESCENT) {
+            found += tree.retrieveAs<PeriodicalBook>(probes[i], item, depth);
+        } else {
+            found += tree.retrieveByKey(probes[i], item, depth);
+        }
+        depths += depth;
+    }
+    double elapsed = since(start);
+    sink = found;
+    if (found != static_cast<long>(probes.size())) {
+        cerr << "found " << found << " of " << probes.size() << " issues" << endl;
+    }
+    compared = static_cast<double>(depths) / probes.size();
+    return probes.size() / elapsed / 1e6;
+}
+
+// one line of results
+static void report(const char* name, double rate, double compared) {
+    cout << left << setw(14) << name << right << fixed << setw(12) << setprecision(2) << rate
+         << setw(11) << setprecision(1) << compared << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int titles = 20;
+    int years = 60;
+    int lookups = 2000000;
+    unsigned seed = 42;
+    for (int i = 1; i < argc; i += 2) {
+        // an option without its value is as wrong as an unknown one
+        string option = (i + 1 < argc) ? argv[i] : "";
+        if (option == "-t") {
+            titles = atoi(argv[i + 1]);
+        } else if (option == "-y") {
+            years = atoi(argv[i + 1]);
+        } else if (option == "-l") {
+            lookups = atoi(argv[i + 1]);
+        } else if (option == "-s") {
+            seed = atoi(argv[i + 1]);
+        } else {
+            cerr << "usage: " << argv[0] << " [-t titles] [-y years] [-l lookups] [-s seed]"
+                 << endl;
+            return 1;
+        }
+    }
+    if (titles < 1 || years < 1 || lookups < 1) {
+        cerr << "titles, years and lookups must be positive" << endl;
+        return 1;
+    }
+    mt19937 random(seed);
+    istringstream data;
+    int n = titles * years * 12;
+
+    vector<int> order(n);
+    for (int i = 0; i < n; i++) {
+        order[i] = i;
+    }
+    shuffle(order.begin(), order.end(), random);
+    CalendarSection calendar("BENCH", "");
+    BinarySearchTree tree("BENCH", "");
+    for (int i = 0; i < n; i++) {
+        PeriodicalBook* issue = new PeriodicalBook();
+        setBook(*issue, order[i], titles, data);
+        calendar.insert(issue);
+        issue = new PeriodicalBook();
+        setBook(*issue, order[i], titles, data);
+        tree.insertAs<PeriodicalBook>(issue);
+    }
+    vector<PeriodicalBook> probes(lookups);
+    for (int i = 0; i < lookups; i++) {
+        setBook(probes[i], random() % n, titles, data);
+    }
+
+    cout << n << " issues (" << titles << " titles, " << years << " years)" << endl;
+    cout << left << setw(14) << "lookup" << right << setw(12) << "M lookups/s" << setw(11)
+         << "compared" << endl;
+    double compared = 0;
+    double rate = timeLookups(calendar, tree, CALENDAR, probes, compared);
+    report("calendar", rate, compared);
+    rate = timeLookups(calendar, tree, TREE_DESCENT, probes, compared);
+    report("tree descent", rate, compared);
+    rate = timeLookups(calendar, tree, KEY_INDEX, probes, compared);
+    report("key index", rate, compared);
+
+    // the issues of a year: a run of 12 buckets, or a walk of every issue
+    const int slices = 1000;
+    vector<int> asked(slices);
+    for (int i = 0; i < slices; i++) {
+        asked[i] = 1950 + random() % years;
+    }
+    vector<Item*> issues;
+    long collected = 0;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < slices; i++) {
+        issues.clear();
+        calendar.collectMonths(asked[i], 1, asked[i], 12, issues);
+        collected += issues.size();
+    }
+    double months = since(start) / slices * 1e6;
+    sink = collected;
+
+    vector<Item*> all;
+    collected = 0;
+    start = Clock::now();
+    for (int i = 0; i < slices; i++) {
+        all.clear();
+        issues.clear();
+        tree.collect(all);
+        for (size_t j = 0; j < all.size(); j++) {
+            if (static_cast<PeriodicalBook*>(all[j])->getYear() == asked[i]) {
+                issues.push_back(all[j]);
+            }
+        }
+        collected += issues.size();
+    }
+    double walk = since(start) / slices * 1e6;
+    sink = collected;
+
+    cout << endl << "a year's " << titles * 12 << " issues:" << endl;
+    cout << left << setw(14) << "collectMonths" << right << setw(12) << setprecision(2)
+         << months << " us" << endl;
+    cout << left << setw(14) << "tree walk" << right << setw(12) << setprecision(2)
+         << walk << " us" << endl;
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*---------------------------------------------------------------------------
+* @file: completebench.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: speed and memory of title autocomplete
+---------------------------------------------------------------------------*/
+// Completebench: Fills a TitleTrie with a catalog of made up titles, counts
+// checkouts on them, then times prefix queries against what answering
+// them took before: a scan of every title, keeping the best 10.
+//---------------------------------------------------------------------------
+// Usage:
+//   g++ -O2 -pthread -I. -o completebench tools/completebench.cpp
+//       $(ls *.cpp | grep -v main.cpp)      (one command line)
+//   ./completebench [-n sizes] [-q queries] [-s seed]
+//
+// Features:
+// -- Sizes (-n 100000,1000000) are numbers of titles of each catalog,
+//    2 to 6 words from a 2000 word vocabulary, common words more often.
+// -- Checkouts (4 per title) go mostly to a few titles, as they do in a
+//    library, so the ranking matters.
+// -- Prints for every catalog: seconds to insert the titles, nodes and
+//    megabytes of the trie, then microseconds per query of the trie and of
+//    the scan (-q queries, default 100000 for the trie, 0.1% of that for the
+//    scan), for prefixes of 1 to 8 characters of titles in the catalog.
+//
+// Assumptions/implementation:
+// -- The titles are made up, only their shape matters: shared first words
+//    ("the", "a", ...) and long tails, as in the books file.
+//---------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include "book.h"
+#include "fictionbook.h"
+#include "titletrie.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+// keeps query results alive, so the loops aren't optimized away
+static volatile long sink;
+
+// seconds since the given time
+static double since(Clock::time_point start) {
+    chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+// comma separated list of sizes
+static vector<int> parseSizes(const string& list) {
+    vector<int> sizes;
+    stringstream items(list);
+    string size;
+    while (getline(items, size, ',')) {
+        sizes.push_back(atoi(size.c_str()));
+    }
+    return sizes;
+}
+
+// made up word number index, 3 to 9 letters
+static string word(int index) {
+    static const char* const LETTERS = "etaoinshrdlucmfwypvbgkqjxz";
+    string text;
+    int length = 3 + index % 7;
+    unsigned value = index * 2654435761u;
+    for (int i = 0; i < length; i++) {
+        text += LETTERS[value % 26];
+        value = value / 26 + index * 7 + i;
+    }
+    return text;
+}
+
+// a title of 2 to 6 words, low (common) word numbers more often
+static string makeTitle(mt19937& random) {
+    exponential_distribution<double> common(1.0 / 200);
+    int words = 2 + random() % 5;
+    string title;
+    for (int i = 0; i < words; i++) {
+        if (i > 0) {
+            title += ' ';
+        }
+        string next = word(min(1999, static_cast<int>(common(random))));
+        if (i == 0) {
+            next[0] = static_cast<char>(toupper(next[0]));
+        }
+        title += next;
+    }
+    return title;
+}
+
+// sets book to a title
+static void setBook(FictionBook& book, const string& title, istringstream& data) {
+    data.clear();
+    data.str(" Kerouac Jack, " + title + ",");
+    book.setTransactionData(data);
+    book.setFormat('H');
+}
+
+// one catalog of n titles: build, then both ways of answering timed
+static void run(int n, int queries, mt19937& random) {
+    istringstream data;
+    vector<string> titles(n);
+    for (int i = 0; i < n; i++) {
+        titles[i] = makeTitle(random);
+    }
+    FictionBook book;
+    TitleTrie trie;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < n; i++) {
+        setBook(book, titles[i], data);
+        trie.insert(book);
+    }
+    double building = since(start);
+
+    // the scan's view of the catalog: every title with its checkouts
+    vector<long> checkouts(n, 0);
+    geometric_distribution<int> popular(0.001);
+    for (long i = 0; i < 4L * n; i++) {
+        int title = popular(random) % n;
+        setBook(book, titles[title], data);
+        trie.countCheckout(book, 1);
+        checkouts[title]++;
+    }
+
+    vector<string> prefixes(queries);
+    for (int i = 0; i < queries; i++) {
+        prefixes[i] = TitleTrie::normalize(titles[random() % n]).substr(0, 1 + random() % 8);
+    }
+
+    vector<const TitleTrie::Title*> found;
+    start = Clock::now();
+    for (int i = 0; i < queries; i++) {
+        sink += trie.complete(prefixes[i], found);
+    }
+    double trieTime = since(start) / queries * 1e6;
+
+    int scans = max(1, queries / 1000);
+    vector<pair<long, int> > matches;
+    start = Clock::now();
+    for (int i = 0; i < scans; i++) {
+        matches.clear();
+        for (int j = 0; j < n; j++) {
+            if (TitleTrie::normalize(titles[j]).compare(0, prefixes[i].size(), prefixes[i]) == 0) {
+                matches.push_back(make_pair(-checkouts[j], j));
+            }
+        }
+        size_t best = min(matches.size(), static_cast<size_t>(AUTOCOMPLETE_RESULTS));
+        partial_sort(matches.begin(), matches.begin() + best, matches.end());
+        sink += best;
+    }
+    double scanTime = since(start) / scans * 1e6;
+
+    cout << setw(10) << n << setw(10) << building << setw(10) << trie.getNodeCount()
+         << setw(10) << trie.getBytes() / 1e6 << setw(12) << trieTime
+         << setw(12) << scanTime << endl;
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> sizes = parseSizes("100000,1000000");
+    int queries = 100000;
+    unsigned seed = 1;
+    for (int i = 1; i < argc; i += 2) {
+        // an option without its value is as wrong as an unknown one
+        string option = (i + 1 < argc) ? argv[i] : "";
+        if (option == "-n") {
+            sizes = parseSizes(argv[i + 1]);
+        } else if (option == "-q") {
+            queries = atoi(argv[i + 1]);
+        } else if (option == "-s") {
+            seed = static_cast<unsigned>(atoi(argv[i + 1]));
+        } else {
+            cerr << "usage: " << argv[0] << " [-n sizes] [-q queries] [-s seed]" << endl;
+            return 1;
+        }
+    }
+    mt19937 random(seed);
+    cout << fixed << setprecision(2);
+    cout << setw(10) << "TITLES" << setw(10) << "BUILD S" << setw(10) << "NODES"
+         << setw(10) << "MB" << setw(12) << "TRIE US" << setw(12) << "SCAN US" << endl;
+    for (size_t i = 0; i < sizes.size(); i++) {
+        run(sizes[i], queries, random);
+    }
+    return 0;
+}
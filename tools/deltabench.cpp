@@ -0,0 +1,186 @@
+/*---------------------------------------------------------------------------
+* @file: deltabench.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: cost of applying catalog delta files against catalog size
+---------------------------------------------------------------------------*/
+// Deltabench: Builds catalogs of several sizes and applies delta files of
+// several sizes to each, to show that a delta costs what its own lines
+// cost, however big the catalog it is applied to.
+//---------------------------------------------------------------------------
+// Usage:
+//   g++ -O2 -pthread -I. -o deltabench tools/deltabench.cpp
+//       $(ls *.cpp | grep -v main.cpp)      (one command line)
+//   ./deltabench [-n catalog sizes] [-d delta sizes] [-m pointer|value]
+//                [-s seed]
+//
+// Features:
+// -- Catalogs (-n 10000,100000,1000000) are fiction books with distinct
+//    keys, in shuffled order so the trees are not degenerate.
+// -- Deltas (-d 100,1000,10000) are one third adds of new books (with
+//    random keys, as sorted ones would grow a list), one third removals and one third stock adjustments of books in the
+//    catalog. Each is applied once to the catalog left by the last one.
+// -- Prints the time of each applyCatalogDelta() call (reading the file
+//    included) and the time per line. Per line times that stay flat as
+//    the catalog grows (apart from the log of the tree depth) mean nothing
+//    but the named Items is touched.
+// -- Before every delta, an Item it removes is looked up and kept, as a
+//    patron would keep it; the run checks it is still readable after.
+//
+// Assumptions/implementation:
+// -- The books and delta files are written to the current directory and
+//    removed at the end. Writing them is not timed.
+//---------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include "library.h"
+
+using namespace std;
+
+static const char* BOOKS_PATH = "deltabench_books.txt";
+static const char* DELTA_PATH = "deltabench_delta.txt";
+
+// stream buffer that drops everything written to it
+class NullBuffer : public streambuf {
+  protected:
+    int overflow(int c) { return c; }
+    streamsize xsputn(const char*, streamsize count) { return count; }
+};
+
+// comma separated list of sizes
+static vector<int> parseSizes(const string& list) {
+    vector<int> sizes;
+    stringstream items(list);
+    string size;
+    while (getline(items, size, ',')) {
+        sizes.push_back(atoi(size.c_str()));
+    }
+    return sizes;
+}
+
+// author and title of book number key, as a command writes them. Books
+// added by a delta have another initial, so they sort among the others
+static string bookKey(int key, char initial = 'A') {
+    stringstream text;
+    text << "Author" << setw(8) << setfill('0') << key << " " << initial << ", Title "
+         << setw(8) << setfill('0') << key << ",";
+    return text.str();
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> catalogSizes = parseSizes("10000,100000,1000000");
+    vector<int> deltaSizes = parseSizes("100,1000,10000");
+    SectionStorage storage = POINTER_SECTIONS;
+    unsigned seed = 42;
+    for (int i = 1; i < argc; i += 2) {
+        // an option without its value is as wrong as an unknown one
+        string option = (i + 1 < argc) ? argv[i] : "";
+        if (option == "-n") {
+            catalogSizes = parseSizes(argv[i + 1]);
+        } else if (option == "-d") {
+            deltaSizes = parseSizes(argv[i + 1]);
+        } else if (option == "-m" && (string(argv[i + 1]) == "pointer" || string(argv[i + 1]) == "value")) {
+            storage = (string(argv[i + 1]) == "value") ? VALUE_SECTIONS : POINTER_SECTIONS;
+        } else if (option == "-s") {
+            seed = atoi(argv[i + 1]);
+        } else {
+            cerr << "usage: " << argv[0] << " [-n sizes] [-d sizes] [-m pointer|value]"
+                 << " [-s seed]" << endl;
+            return 1;
+        }
+    }
+    mt19937 random(seed);
+    bool pointersKept = true;
+
+    cout << setw(10) << "catalog" << setw(10) << "delta" << setw(12) << "ms"
+         << setw(12) << "us/line" << endl;
+    for (int n = 0; n < catalogSizes.size(); n++) {
+        // keys in the catalog, shuffled, removals take them from the back
+        vector<int> keys(catalogSizes[n]);
+        for (int i = 0; i < keys.size(); i++) {
+            keys[i] = i;
+        }
+        shuffle(keys.begin(), keys.end(), random);
+        {
+            ofstream books(BOOKS_PATH);
+            for (int i = 0; i < keys.size(); i++) {
+                books << "F " << bookKey(keys[i]) << " 1990\n";
+            }
+        }
+        Library* library = new Library(storage);
+        {
+            ifstream books(BOOKS_PATH);
+            library->buildBooksFromFile(books);
+        }
+        set<int> addedKeys;
+
+        for (int d = 0; d < deltaSizes.size(); d++) {
+            int removals = 0;
+            {
+                ofstream delta(DELTA_PATH);
+                for (int i = 0; i < deltaSizes[d]; i++) {
+                    int kind = i % 3;
+                    if (kind == 0 || keys.size() < 2) {
+                        int key = random() % 100000000;
+                        while (!addedKeys.insert(key).second) {
+                            key = random() % 100000000;
+                        }
+                        delta << "+ F " << bookKey(key, 'B') << " 2024\n";
+                    } else if (kind == 1) {
+                        delta << "- F H " << bookKey(keys.back()) << "\n";
+                        keys.pop_back();
+                        removals++;
+                    } else {
+                        int key = keys[random() % keys.size()];
+                        delta << "~ 1 F H " << bookKey(key) << "\n";
+                    }
+                }
+            }
+
+            // hold on to the first Item the delta removes
+            Item* held = nullptr;
+            if (removals > 0) {
+                Item* probe = library->createItem('F');
+                istringstream data(" " + bookKey(keys[keys.size() + removals - 1]));
+                probe->setTransactionData(data);
+                probe->setFormat('H');
+                library->retrieveItem('F', *probe, held);
+                delete probe;
+            }
+            string heldTitle = (held != nullptr) ? held->getTitle() : "";
+
+            NullBuffer discard;
+            streambuf* console = cout.rdbuf(&discard);
+            ifstream delta(DELTA_PATH);
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            DeltaCounts counts = library->applyCatalogDelta(delta);
+            chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+            cout.rdbuf(console);
+
+            if (held != nullptr && held->getTitle() != heldTitle) {
+                pointersKept = false;
+            }
+            if (counts.rejected > 0) {
+                cerr << counts.rejected << " delta lines were rejected" << endl;
+            }
+            cout << setw(10) << catalogSizes[n] << setw(10) << deltaSizes[d]
+                 << fixed << setprecision(2) << setw(12) << elapsed.count()
+                 << setw(12) << elapsed.count() * 1000 / deltaSizes[d] << endl;
+        }
+        delete library;
+    }
+    cout << "removed items still readable: " << (pointersKept ? "yes" : "NO") << endl;
+    remove(BOOKS_PATH);
+    remove(DELTA_PATH);
+    return pointersKept ? 0 : 1;
+}
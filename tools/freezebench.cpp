@@ -0,0 +1,168 @@
+/*---------------------------------------------------------------------------
+* @file: freezebench.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: build cost, size and lookup time of the frozen key index
+---------------------------------------------------------------------------*/
+// Freezebench: Builds the perfect hash index of a frozen section
+// (PerfectHashIndex) and the hash table of a live one (KeyIndex) over the
+// same books, up to catalog sizes in the tens of millions, and compares
+// their build time, memory per key and lookup time.
+//---------------------------------------------------------------------------
+// Usage:
+//   g++ -O2 -pthread -I. -o freezebench tools/freezebench.cpp
+//       $(ls *.cpp | grep -v main.cpp)      (one command line)
+//   ./freezebench [-n sizes] [-l lookups] [-s seed]
+//
+// Features:
+// -- Sizes (-n 1000000,20000000) are numbers of fiction books, keyed by
+//    author and title.
+// -- Prints for both indexes: build milliseconds, bytes per key, and the
+//    nanoseconds of a lookup that hits and of one that misses (-l
+//    lookups of each, random keys, default 1000000).
+//
+// Assumptions/implementation:
+// -- The books live in one array, not in a section, so 20M of them fit in
+//    a few GB: keys are short enough for the strings to stay inside the
+//    objects (no heap strings).
+// -- The KeyIndex is built by inserting every book, as a section's inserts
+//    would; the perfect hash is built in one go, as freeze() does.
+//---------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include "book.h"
+#include "fictionbook.h"
+#include "keyindex.h"
+#include "perfecthash.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+// keeps lookup results alive, so the loops aren't optimized away
+static volatile long sink;
+
+// milliseconds since the given time
+static double since(Clock::time_point start) {
+    chrono::duration<double, milli> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+// comma separated list of sizes
+static vector<int> parseSizes(const string& list) {
+    vector<int> sizes;
+    stringstream items(list);
+    string size;
+    while (getline(items, size, ',')) {
+        sizes.push_back(atoi(size.c_str()));
+    }
+    return sizes;
+}
+
+// sets book to number key, the same key for the same number
+static void setBook(FictionBook& book, int key, istringstream& data) {
+    stringstream text;
+    text << " A" << key << ", T" << key << ",";
+    data.clear();
+    data.str(text.str());
+    book.setTransactionData(data);
+    book.setFormat('H');
+}
+
+// nanoseconds per lookup of the probes, and how many were found
+template <class Index>
+static double timeLookups(const Index& index, const vector<FictionBook>& probes, long& found) {
+    found = 0;
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < probes.size(); i++) {
+        Item* item = nullptr;
+        int probed = 0;
+        found += index.findAs(probes[i], probes[i].FictionBook::keyHash(), item, probed);
+    }
+    double elapsed = since(start);
+    sink = found;
+    return elapsed * 1e6 / probes.size();
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> sizes = parseSizes("1000000,20000000");
+    int lookups = 1000000;
+    unsigned seed = 42;
+    for (int i = 1; i < argc; i += 2) {
+        // an option without its value is as wrong as an unknown one
+        string option = (i + 1 < argc) ? argv[i] : "";
+        if (option == "-n") {
+            sizes = parseSizes(argv[i + 1]);
+        } else if (option == "-l") {
+            lookups = atoi(argv[i + 1]);
+        } else if (option == "-s") {
+            seed = atoi(argv[i + 1]);
+        } else {
+            cerr << "usage: " << argv[0] << " [-n sizes] [-l lookups] [-s seed]" << endl;
+            return 1;
+        }
+    }
+    mt19937 random(seed);
+    istringstream data;
+
+    cout << left << setw(12) << "index" << right << setw(10) << "keys" << setw(12) << "build ms"
+         << setw(12) << "bytes/key" << setw(10) << "hit ns" << setw(10) << "miss ns" << endl;
+    for (int s = 0; s < sizes.size(); s++) {
+        int n = sizes[s];
+        vector<FictionBook> books(n);
+        vector<Item*> items(n);
+        for (int i = 0; i < n; i++) {
+            setBook(books[i], i, data);
+            items[i] = &books[i];
+        }
+        // probes for keys in the catalog and keys past its end
+        vector<FictionBook> hits(lookups);
+        vector<FictionBook> misses(lookups);
+        for (int i = 0; i < lookups; i++) {
+            setBook(hits[i], random() % n, data);
+            setBook(misses[i], n + random() % n, data);
+        }
+        long hitCount = 0;
+        long missCount = 0;
+
+        PerfectHashIndex* frozen = new PerfectHashIndex();
+        Clock::time_point start = Clock::now();
+        bool built = frozen->build(items);
+        double buildTime = since(start);
+        if (!built) {
+            cerr << "perfect hash could not be built for " << n << " keys" << endl;
+        } else {
+            double hitTime = timeLookups(*frozen, hits, hitCount);
+            double missTime = timeLookups(*frozen, misses, missCount);
+            cout << left << setw(12) << "perfect" << right << setw(10) << n << fixed
+                 << setprecision(1) << setw(12) << buildTime << setw(12)
+                 << static_cast<double>(frozen->getBytes()) / n << setw(10) << hitTime
+                 << setw(10) << missTime << endl;
+            if (hitCount != lookups || missCount != 0) {
+                cerr << "perfect hash found " << hitCount << " of " << lookups << " hits and "
+                     << missCount << " misses" << endl;
+            }
+        }
+        delete frozen;
+
+        KeyIndex* table = new KeyIndex();
+        start = Clock::now();
+        for (int i = 0; i < n; i++) {
+            table->insert(books[i].keyHash(), items[i]);
+        }
+        buildTime = since(start);
+        double hitTime = timeLookups(*table, hits, hitCount);
+        double missTime = timeLookups(*table, misses, missCount);
+        cout << left << setw(12) << "hash table" << right << setw(10) << n << fixed
+             << setprecision(1) << setw(12) << buildTime << setw(12)
+             << static_cast<double>(table->getBytes()) / n << setw(10) << hitTime
+             << setw(10) << missTime << endl;
+        delete table;
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+/*---------------------------------------------------------------------------
+* @file: frontbench.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: memory and lookup speed of front coded keys
+---------------------------------------------------------------------------*/
+// Frontbench: Sorts a catalog of books the way a sorted run of an
+// LsmSection holds them, stores their keys front coded (FrontCodedKeys)
+// and compares it with what the run did before: halving over the sorted
+// Item pointers, each step comparing against an Item.
+//---------------------------------------------------------------------------
+// Usage:
+//   g++ -O2 -pthread -I. -o frontbench tools/frontbench.cpp
+//       $(ls *.cpp | grep -v main.cpp)      (one command line)
+//   ./frontbench [-n sizes] [-l lookups] [-s seed]
+//
+// Features:
+// -- Sizes (-n 100000,1000000) are numbers of books of each catalog:
+//    fiction, sorted by author (16 books per author, long titles that
+//    share their start), and periodicals, sorted by date then title (300
+//    issues per title).
+// -- Prints for every catalog: megabytes of the keys as plain strings and
+//    front coded (with the block offsets), their ratio, and millions of
+//    lookups per second of both searches (-l lookups of keys in the
+//    catalog, uniformly random, default 1000000). A front coded lookup
+//    includes building the target's key, as LsmSection does.
+//
+// Assumptions/implementation:
+// -- The names are made up, only their shape matters: repeated authors and
+//    titles, as in the books file.
+//---------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include "book.h"
+#include "fictionbook.h"
+#include "periodicalbook.h"
+#include "frontcodedkeys.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+// keeps lookup results alive, so the loops aren't optimized away
+static volatile long sink;
+
+// seconds since the given time
+static double since(Clock::time_point start) {
+    chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+// comma separated list of sizes
+static vector<int> parseSizes(const string& list) {
+    vector<int> sizes;
+    stringstream items(list);
+    string size;
+    while (getline(items, size, ',')) {
+        sizes.push_back(atoi(size.c_str()));
+    }
+    return sizes;
+}
+
+// sets book to number key: author key / 16, the same book for the same key
+static void setBook(FictionBook& book, int key, istringstream& data) {
+    stringstream text;
+    text << " Kerouac" << key / 16 << " Jack, The Collected Stories Volume " << key % 16 << ",";
+    data.clear();
+    data.str(text.str());
+    book.setTransactionData(data);
+    book.setFormat('H');
+}
+
+// sets book to number key: title key / 300, one issue a month from 1950
+static void setBook(PeriodicalBook& book, int key, istringstream& data) {
+    int issue = key % 300;
+    stringstream text;
+    text << " " << 1950 + issue / 12 << " " << 1 + issue % 12
+         << " Communications of the Society " << key / 300 << ",";
+    data.clear();
+    data.str(text.str());
+    book.setTransactionData(data);
+    book.setFormat('H');
+}
+
+// orders book pointers like their books
+template <class Type>
+static bool before(const Type* a, const Type* b) {
+    return a->compare(*b) < 0;
+}
+
+// halving over the sorted books, as a run searched before front coding
+template <class Type>
+static long halve(const vector<Type*>& sorted, const Type& target) {
+    size_t low = 0;
+    size_t high = sorted.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        int order = sorted[middle]->compare(target);
+        if (order == 0) {
+            return middle;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return -1;
+}
+
+// one catalog of n books: sizes, then both searches timed
+template <class Type>
+static void run(const char* name, int n, int lookups, mt19937& random) {
+    istringstream data;
+    vector<Type*> sorted(n);
+    for (int i = 0; i < n; i++) {
+        sorted[i] = new Type();
+        setBook(*sorted[i], i, data);
+    }
+    sort(sorted.begin(), sorted.end(), before<Type>);
+    FrontCodedKeys keys;
+    string key;
+    for (int i = 0; i < n; i++) {
+        key.clear();
+        sorted[i]->appendSortKey(key);
+        keys.add(key);
+    }
+    vector<Type> probes(lookups);
+    for (int i = 0; i < lookups; i++) {
+        setBook(probes[i], random() % n, data);
+    }
+
+    long found = 0;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < lookups; i++) {
+        found += halve(sorted, probes[i]) >= 0;
+    }
+    double halving = lookups / since(start) / 1e6;
+
+    start = Clock::now();
+    int compared = 0;
+    for (int i = 0; i < lookups; i++) {
+        key.clear();
+        probes[i].appendSortKey(key);
+        found += keys.find(key, compared) >= 0;
+    }
+    double coded = lookups / since(start) / 1e6;
+    sink = found;
+    if (found != 2L * lookups) {
+        cerr << "found " << found << " of " << 2L * lookups << " keys" << endl;
+    }
+
+    double plain = keys.getKeyBytes() / 1e6;
+    double packed = keys.getBytes() / 1e6;
+    cout << left << setw(12) << name << right << setw(10) << n << fixed << setprecision(1)
+         << setw(10) << plain << setw(10) << packed << setw(8) << plain / packed
+         << setprecision(2) << setw(10) << halving << setw(10) << coded << endl;
+    for (int i = 0; i < n; i++) {
+        delete sorted[i];
+    }
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> sizes = parseSizes("100000,1000000");
+    int lookups = 1000000;
+    unsigned seed = 42;
+    for (int i = 1; i < argc; i += 2) {
+        // an option without its value is as wrong as an unknown one
+        string option = (i + 1 < argc) ? argv[i] : "";
+        if (option == "-n") {
+            sizes = parseSizes(argv[i + 1]);
+        } else if (option == "-l") {
+            lookups = atoi(argv[i + 1]);
+        } else if (option == "-s") {
+            seed = atoi(argv[i + 1]);
+        } else {
+            cerr << "usage: " << argv[0] << " [-n sizes] [-l lookups] [-s seed]" << endl;
+            return 1;
+        }
+    }
+    mt19937 random(seed);
+
+    cout << left << setw(12) << "catalog" << right << setw(10) << "books" << setw(10) << "keys MB"
+         << setw(10) << "coded MB" << setw(8) << "ratio" << setw(10) << "halving" << setw(10)
+         << "coded" << "   (M lookups/s)" << endl;
+    for (size_t s = 0; s < sizes.size(); s++) {
+        run<FictionBook>("fiction", sizes[s], lookups, random);
+        run<PeriodicalBook>("periodical", sizes[s], lookups, random);
+    }
+    return 0;
+}
@@ -0,0 +1,227 @@
+/*---------------------------------------------------------------------------
+* @file: layoutbench.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: tree descents in the pointer, value and Eytzinger sections
+---------------------------------------------------------------------------*/
+// Layoutbench: Fills a section of each storage with the same books, in the
+// same shuffled order, and counts how many lookups per second a descent
+// of its tree answers: the pointer tree (BinarySearchTree), the value tree
+// (ValueSection) and the same Items laid out in Eytzinger order
+// (EytzingerSection, after layout()). The key index, which the Library
+// uses for exact lookups, is timed too for reference.
+//---------------------------------------------------------------------------
+// Usage:
+//   g++ -O2 -pthread -I. -o layoutbench tools/layoutbench.cpp
+//       $(ls *.cpp | grep -v main.cpp)      (one command line)
+//   ./layoutbench [-n sizes] [-l lookups] [-s seed] [-k short|catalog]
+//
+// Features:
+// -- Sizes (-n 1000000,10000000) are numbers of fiction books, keyed by
+//    author and title.
+// -- Prints for every layout: build seconds (inserts, and layout() for
+//    the Eytzinger section), millions of lookups per second, the
+//    average number of Items compared per lookup (-l lookups of keys in
+//    the section, uniformly random, default 1000000), and books per MB of
+//    the section (nodes, Items, their strings and the indexes, as
+//    measure() counts them).
+// -- -k catalog names the books like the books file does (an author of 20
+//    characters, a title of 37), instead of the short default keys.
+//
+// Assumptions/implementation:
+// -- Short keys fit inside any string, so a comparison only reads the
+//    Item itself. Catalog keys are longer than a std::string keeps in
+//    place, but fit the Items' InlineString fields.
+// -- One section is in memory at a time: about 180 bytes per book for
+//    the pointer tree, and twice the 88 byte Items while layout() copies
+//    them. 50M books would need about 9 GB.
+//---------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include "book.h"
+#include "fictionbook.h"
+#include "binarysearchtree.h"
+#include "eytzingersection.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+// keeps lookup results alive, so the loops aren't optimized away
+static volatile long sink;
+
+// seconds since the given time
+static double since(Clock::time_point start) {
+    chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+// comma separated list of sizes
+static vector<int> parseSizes(const string& list) {
+    vector<int> sizes;
+    stringstream items(list);
+    string size;
+    while (getline(items, size, ',')) {
+        sizes.push_back(atoi(size.c_str()));
+    }
+    return sizes;
+}
+
+// books named like the books file (-k catalog), not with short keys
+static bool catalogKeys = false;
+
+// sets book to number key, the same key for the same number
+static void setBook(FictionBook& book, int key, istringstream& data) {
+    stringstream text;
+    if (catalogKeys) {
+        text << " Kerouac" << setw(8) << setfill('0') << key << " Jack, The Collected Stories Volume "
+             << setw(8) << key << ",";
+    } else {
+        text << " A" << key << ", T" << key << ",";
+    }
+    data.clear();
+    data.str(text.str());
+    book.setTransactionData(data);
+    book.setFormat('H');
+}
+
+// the way a section is searched
+enum Descent { POINTER_TREE, VALUE_TREE, EYTZINGER, KEY_INDEX };
+
+// lookups of the probes, as millions per second, and Items compared
+template <class Tree>
+static double timeLookups(const Tree& section, Descent descent, const vector<FictionBook>& probes,
+                          double& compared) {
+    long found = 0;
+    long depths = 0;
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < probes.size(); i++) {
+        Item* item = nullptr;
+        int depth = 0;
+        if (descent == KEY_INDEX) {
+            found += section.retrieveByKey(probes[i], item, depth);
+        } else {
+            found += section.retrieveAs(probes[i], item, depth);
+        }
+        depths += depth;
+    }
+    double elapsed = since(start);
+    sink = found;
+    if (found != static_cast<long>(probes.size())) {
+        cerr << "found " << found << " of " << probes.size() << " keys" << endl;
+    }
+    compared = static_cast<double>(depths) / probes.size();
+    return probes.size() / elapsed / 1e6;
+}
+
+// books per MB of a section, from its measure()
+static double booksPerMB(const Section& section) {
+    Section::Shape shape;
+    section.measure(shape);
+    long bytes = shape.nodeBytes + shape.itemBytes + shape.stringBytes + shape.indexBytes;
+    return (bytes > 0) ? shape.nodes / (bytes / 1e6) : 0;
+}
+
+// one line of results
+static void report(const char* name, int n, double build, double rate, double compared,
+                   double density) {
+    cout << left << setw(12) << name << right << setw(10) << n << fixed << setprecision(1)
+         << setw(10) << build << setw(12) << setprecision(2) << rate << setw(11)
+         << setprecision(1) << compared << setw(10) << setprecision(0) << density << endl;
+}
+
+// BinarySearchTree::retrieveAs called the way the pointer storage does
+struct PointerTree {
+    const BinarySearchTree& tree;
+
+    bool retrieveAs(const FictionBook& target, Item*& found, int& depth) const {
+        return tree.retrieveAs<FictionBook>(target, found, depth);
+    }
+
+    bool retrieveByKey(const FictionBook& target, Item*& found, int& probes) const {
+        return tree.retrieveByKey(target, found, probes);
+    }
+};
+
+int main(int argc, char* argv[]) {
+    vector<int> sizes = parseSizes("1000000,10000000");
+    int lookups = 1000000;
+    unsigned seed = 42;
+    for (int i = 1; i < argc; i += 2) {
+        // an option without its value is as wrong as an unknown one
+        string option = (i + 1 < argc) ? argv[i] : "";
+        if (option == "-n") {
+            sizes = parseSizes(argv[i + 1]);
+        } else if (option == "-l") {
+            lookups = atoi(argv[i + 1]);
+        } else if (option == "-s") {
+            seed = atoi(argv[i + 1]);
+        } else if (option == "-k" && (string(argv[i + 1]) == "short" || string(argv[i + 1]) == "catalog")) {
+            catalogKeys = string(argv[i + 1]) == "catalog";
+        } else {
+            cerr << "usage: " << argv[0] << " [-n sizes] [-l lookups] [-s seed] [-k short|catalog]"
+                 << endl;
+            return 1;
+        }
+    }
+    mt19937 random(seed);
+    istringstream data;
+
+    cout << left << setw(12) << "layout" << right << setw(10) << "books" << setw(10) << "build s"
+         << setw(12) << "M lookups/s" << setw(11) << "compared" << setw(10) << "books/MB" << endl;
+    for (int s = 0; s < sizes.size(); s++) {
+        int n = sizes[s];
+        vector<int> order(n);
+        for (int i = 0; i < n; i++) {
+            order[i] = i;
+        }
+        shuffle(order.begin(), order.end(), random);
+        vector<FictionBook> probes(lookups);
+        for (int i = 0; i < lookups; i++) {
+            setBook(probes[i], random() % n, data);
+        }
+        double compared = 0;
+
+        BinarySearchTree* tree = new BinarySearchTree("BENCH", "");
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < n; i++) {
+            FictionBook* book = new FictionBook();
+            setBook(*book, order[i], data);
+            tree->insertAs<FictionBook>(book);
+        }
+        double build = since(start);
+        PointerTree pointers = {*tree};
+        double rate = timeLookups(pointers, POINTER_TREE, probes, compared);
+        double density = booksPerMB(*tree);
+        report("pointer", n, build, rate, compared, density);
+        delete tree;
+
+        EytzingerSection<FictionBook>* section = new EytzingerSection<FictionBook>("BENCH", "");
+        start = Clock::now();
+        for (int i = 0; i < n; i++) {
+            FictionBook* book = new FictionBook();
+            setBook(*book, order[i], data);
+            section->insert(book);
+        }
+        build = since(start);
+        rate = timeLookups(*section, VALUE_TREE, probes, compared);
+        report("value", n, build, rate, compared, booksPerMB(*section));
+
+        start = Clock::now();
+        section->layout();
+        build += since(start);
+        rate = timeLookups(*section, EYTZINGER, probes, compared);
+        density = booksPerMB(*section);
+        report("eytzinger", n, build, rate, compared, density);
+        rate = timeLookups(*section, KEY_INDEX, probes, compared);
+        report("key index", n, build, rate, compared, density);
+        delete section;
+    }
+    return 0;
+}
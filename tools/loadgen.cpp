@@ -0,0 +1,399 @@
+/*---------------------------------------------------------------------------
+* @file: loadgen.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: load generator for the library server (main.cpp -u / -p)
+---------------------------------------------------------------------------*/
+// LoadGen: Opens a number of client connections to a running library
+// server, sends a mixed C/R/H/D workload built from the book and patron
+// files, and reports throughput and latency percentiles.
+//---------------------------------------------------------------------------
+// Usage:
+//   g++ -O2 -pthread -o loadgen tools/loadgen.cpp
+//   ./loadgen (-u socket | -p port) [-c connections] [-d depth]
+//             [-n commands per connection] [-m C,R,H,D]
+//             [-b books file] [-P patrons file] [-i idle connections]
+//
+// Features:
+// -- One thread and one connection per client. Each client keeps up to
+//    "depth" commands in flight (pipelining) and measures every command
+//    from the moment it was sent until the "." ending its answer arrives.
+// -- The mix gives relative weights of checkouts, returns, histories and
+//    displays. Returns give back the oldest item the same client checked
+//    out, so most of them are valid. Clients use disjoint sets of patrons.
+// -- Idle connections are opened before the clients start and held open,
+//    silent, until they finish (e.g. -i 10000 -c 100 -d 1 for 10K idle and
+//    100 active clients).
+//
+// Assumptions/implementation:
+// -- The book and patron files are the ones the server was built from.
+// -- Latencies are in microseconds.
+//---------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+// where the server is and what to send it
+struct Options {
+    string socketPath;
+    int port;
+    int connections;
+    int depth;
+    long commands;
+    int weights[4];    // C, R, H, D
+    string booksPath;
+    string patronsPath;
+    int idle;          // connections held open without sending anything
+};
+
+// what one client measured
+struct ClientResult {
+    vector<double> latencies;
+    long bytesReceived;
+    bool failed;
+};
+
+/*-------------------------------------------------------------------------
+* itemCommands(const string&)
+*
+* Turns every line of the book file into the item part of a command, in the
+* command file layout (type, format, item data)
+* @pre: file exists
+* @post: None
+* @param: const string& - path of the book file
+* @return: vector<string> - e.g. "F H Kerouac Jack, On the Road,"
+*/
+static vector<string> itemCommands(const string& path) {
+    vector<string> items;
+    ifstream infile(path.c_str());
+    string line;
+    while (getline(infile, line)) {
+        if (line.size() < 3) {
+            continue;
+        }
+        char type = line[0];
+        string rest = line.substr(2);
+        size_t comma = rest.find(", ");
+        size_t lastComma = rest.rfind(", ");
+        if (comma == string::npos || lastComma == string::npos) {
+            continue;
+        }
+        string first = rest.substr(0, comma);
+        if (type == 'P') {
+            // title, month year -> year month title,
+            int month = 0;
+            int year = 0;
+            istringstream date(rest.substr(comma + 2));
+            date >> month >> year;
+            ostringstream item;
+            item << "P H " << year << ' ' << month << ' ' << first << ',';
+            items.push_back(item.str());
+        } else if (type == 'F' || type == 'C') {
+            // author, title, year -> fiction by author, children's by title
+            string second = rest.substr(comma + 2, lastComma - comma - 2);
+            if (type == 'F') {
+                items.push_back(string("F H ") + first + ", " + second + ",");
+            } else {
+                items.push_back(string("C H ") + second + ", " + first + ",");
+            }
+        }
+    }
+    return items;
+}
+
+/*-------------------------------------------------------------------------
+* patronIDs(const string&)
+*
+* Reads every patron ID from the patron file
+* @pre: file exists
+* @post: None
+* @param: const string& - path of the patron file
+* @return: vector<int> - the IDs
+*/
+static vector<int> patronIDs(const string& path) {
+    vector<int> ids;
+    ifstream infile(path.c_str());
+    string line;
+    while (getline(infile, line)) {
+        int id;
+        if (istringstream(line) >> id) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+/*-------------------------------------------------------------------------
+* connectServer(const Options&)
+*
+* Opens a blocking connection to the server
+* @pre: server is listening
+* @post: None
+* @param: const Options& - where the server is
+* @return: int - connected socket, -1 on failure
+*/
+static int connectServer(const Options& options) {
+    int fd;
+    if (options.socketPath != "") {
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, options.socketPath.c_str(), sizeof(address.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+            close(fd);
+            fd = -1;
+        }
+    } else {
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(options.port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    return fd;
+}
+
+/*-------------------------------------------------------------------------
+* runClient(...)
+*
+* Sends this client's share of the workload and times every answer
+* @pre: items and patrons are not empty
+* @post: result holds one latency per command
+*/
+static void runClient(const Options& options, int client, const vector<string>& items,
+                      const vector<int>& patrons, ClientResult& result) {
+    result.bytesReceived = 0;
+    result.failed = false;
+    int fd = connectServer(options);
+    if (fd < 0) {
+        result.failed = true;
+        return;
+    }
+
+    // this client's patrons
+    vector<int> mine;
+    for (int i = client; i < patrons.size(); i += options.connections) {
+        mine.push_back(patrons[i]);
+    }
+    if (mine.empty()) {
+        mine.push_back(patrons[client % patrons.size()]);
+    }
+
+    unsigned int seed = 12345u + client * 7919u;
+    int totalWeight = options.weights[0] + options.weights[1] + options.weights[2] + options.weights[3];
+    deque<pair<int, int> > checkedOut; // patron, item
+    deque<Clock::time_point> inFlight;
+    long sent = 0;
+    long answered = 0;
+    bool lineStart = true;
+    bool dotSeen = false;
+    char buffer[64 * 1024];
+
+    while (answered < options.commands) {
+        // keep the pipeline full
+        string batch;
+        while (sent < options.commands && inFlight.size() < options.depth) {
+            int pick = rand_r(&seed) % totalWeight;
+            int patron = mine[rand_r(&seed) % mine.size()];
+            ostringstream command;
+            if (pick < options.weights[0] || (pick < options.weights[0] + options.weights[1]
+                                              && checkedOut.empty())) {
+                int item = rand_r(&seed) % items.size();
+                checkedOut.push_back(make_pair(patron, item));
+                command << "C " << patron << ' ' << items[item] << '\n';
+            } else if (pick < options.weights[0] + options.weights[1]) {
+                command << "R " << checkedOut.front().first << ' '
+                        << items[checkedOut.front().second] << '\n';
+                checkedOut.pop_front();
+            } else if (pick < options.weights[0] + options.weights[1] + options.weights[2]) {
+                command << "H " << patron << '\n';
+            } else {
+                command << "D\n";
+            }
+            batch += command.str();
+            inFlight.push_back(Clock::now());
+            sent++;
+        }
+        size_t offset = 0;
+        while (offset < batch.size()) {
+            ssize_t count = write(fd, batch.data() + offset, batch.size() - offset);
+            if (count <= 0) {
+                result.failed = true;
+                close(fd);
+                return;
+            }
+            offset += count;
+        }
+
+        // read answers, each one ends with a line holding only "."
+        ssize_t count = read(fd, buffer, sizeof(buffer));
+        if (count <= 0) {
+            result.failed = true;
+            close(fd);
+            return;
+        }
+        result.bytesReceived += count;
+        Clock::time_point now = Clock::now();
+        for (int i = 0; i < count; i++) {
+            if (buffer[i] == '\n') {
+                if (dotSeen && !inFlight.empty()) {
+                    chrono::duration<double, micro> latency = now - inFlight.front();
+                    result.latencies.push_back(latency.count());
+                    inFlight.pop_front();
+                    answered++;
+                }
+                lineStart = true;
+                dotSeen = false;
+            } else {
+                dotSeen = lineStart && buffer[i] == '.';
+                lineStart = false;
+            }
+        }
+    }
+    close(fd);
+}
+
+// latency at the given fraction of the sorted list
+static double percentile(const vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    options.socketPath = "";
+    options.port = 0;
+    options.connections = 4;
+    options.depth = 16;
+    options.commands = 100000;
+    options.weights[0] = 45;
+    options.weights[1] = 45;
+    options.weights[2] = 9;
+    options.weights[3] = 1;
+    options.booksPath = "data4books.txt";
+    options.patronsPath = "data4patrons.txt";
+    options.idle = 0;
+
+    bool valid = true;
+    for (int i = 1; i < argc; i += 2) {
+        // an option without its value is as wrong as an unknown one
+        string option = (i + 1 < argc) ? argv[i] : "";
+        string value = (i + 1 < argc) ? argv[i + 1] : "";
+        if (option == "-u") {
+            options.socketPath = value;
+        } else if (option == "-p") {
+            options.port = atoi(value.c_str());
+        } else if (option == "-c") {
+            options.connections = max(1, atoi(value.c_str()));
+        } else if (option == "-d") {
+            options.depth = max(1, atoi(value.c_str()));
+        } else if (option == "-n") {
+            options.commands = atol(value.c_str());
+        } else if (option == "-m") {
+            sscanf(value.c_str(), "%d,%d,%d,%d", &options.weights[0], &options.weights[1],
+                   &options.weights[2], &options.weights[3]);
+        } else if (option == "-b") {
+            options.booksPath = value;
+        } else if (option == "-P") {
+            options.patronsPath = value;
+        } else if (option == "-i") {
+            options.idle = max(0, atoi(value.c_str()));
+        } else {
+            valid = false;
+        }
+    }
+    int totalWeight = options.weights[0] + options.weights[1] + options.weights[2] + options.weights[3];
+    if (!valid || (options.socketPath == "" && options.port <= 0) || totalWeight <= 0) {
+        cerr << "usage: " << argv[0] << " (-u socket | -p port) [-c connections] [-d depth]"
+             << " [-n commands] [-m C,R,H,D] [-b books] [-P patrons] [-i idle]" << endl;
+        return 1;
+    }
+
+    vector<string> items = itemCommands(options.booksPath);
+    vector<int> patrons = patronIDs(options.patronsPath);
+    if (items.empty() || patrons.empty()) {
+        cerr << "ERROR: no items or patrons to build commands from" << endl;
+        return 1;
+    }
+
+    // every connection is a socket, allow as many as the system lets us
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+    vector<int> idle;
+    for (int i = 0; i < options.idle; i++) {
+        int fd = connectServer(options);
+        if (fd < 0) {
+            cerr << "ERROR: opened only " << i << " idle connections" << endl;
+            break;
+        }
+        idle.push_back(fd);
+    }
+
+    vector<ClientResult> results(options.connections);
+    vector<thread> clients;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < options.connections; i++) {
+        clients.push_back(thread(runClient, cref(options), i, cref(items), cref(patrons),
+                                 ref(results[i])));
+    }
+    for (int i = 0; i < clients.size(); i++) {
+        clients[i].join();
+    }
+    chrono::duration<double> elapsed = Clock::now() - start;
+    for (int i = 0; i < idle.size(); i++) {
+        close(idle[i]);
+    }
+
+    vector<double> latencies;
+    long bytes = 0;
+    int failed = 0;
+    for (int i = 0; i < results.size(); i++) {
+        latencies.insert(latencies.end(), results[i].latencies.begin(), results[i].latencies.end());
+        bytes += results[i].bytesReceived;
+        failed += results[i].failed ? 1 : 0;
+    }
+    sort(latencies.begin(), latencies.end());
+
+    cout << "connections      " << options.connections << " (failed " << failed << ")" << endl;
+    cout << "idle connections " << idle.size() << endl;
+    cout << "pipeline depth   " << options.depth << endl;
+    cout << "commands         " << latencies.size() << endl;
+    cout << "seconds          " << elapsed.count() << endl;
+    cout << "commands/sec     " << latencies.size() / elapsed.count() << endl;
+    cout << "MB received      " << bytes / 1e6 << endl;
+    cout << "latency us p50   " << percentile(latencies, 0.50) << endl;
+    cout << "latency us p90   " << percentile(latencies, 0.90) << endl;
+    cout << "latency us p99   " << percentile(latencies, 0.99) << endl;
+    cout << "latency us p99.9 " << percentile(latencies, 0.999) << endl;
+    cout << "latency us max   " << (latencies.empty() ? 0 : latencies.back()) << endl;
+    return failed == 0 ? 0 : 1;
+}
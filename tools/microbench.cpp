@@ -0,0 +1,757 @@
+/*---------------------------------------------------------------------------
+* @file: microbench.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: microbenchmarks of the library's core data structures
+---------------------------------------------------------------------------*/
+// Microbench: Times the operations every command is built from, one at a
+// time, over a range of sizes and key distributions. Results can be saved
+// and compared against an earlier run to catch regressions.
+//---------------------------------------------------------------------------
+// Usage:
+//   g++ -O2 -pthread -I. -o microbench tools/microbench.cpp
+//       $(ls *.cpp | grep -v main.cpp)      (one command line)
+//   ./microbench [-n sizes] [-d distributions] [-b benchmarks] [-r runs]
+//                [-w warmups] [-c cpu] [-s seed] [-o results.tsv]
+//   ./microbench -compare old.tsv new.tsv [-t percent]
+//
+// Features:
+// -- Benchmarks: bst_insert, bst_retrieve, bst_retrieve_as (the statically
+//    dispatched lookup), value_retrieve_as (the same in a value section),
+//    index_retrieve (a probe of the section's key index),
+//    filter_retrieve_mixed and index_retrieve_mixed (lookups of which
+//    MISS_PERCENT are for absent keys, with and without the section's
+//    Bloom filter in front of the key index),
+//    hash_insert, hash_retrieve, item_compare (==, < and >), item_factory,
+//    transaction_factory, patron_hasitem and patron_removeitem.
+// -- Sizes (-n 1000,10000) are the number of items or patrons in the
+//    structure. Distributions (-d sorted,shuffled,zipf) are the order keys
+//    are inserted (or removed) in: sorted (the library's own order, which
+//    degenerates the trees), shuffled (a random permutation), or zipf
+//    (shuffled inserts, lookups with Zipfian popularity, exponent 0.99).
+//    Otherwise lookups pick keys uniformly at random. Benchmarks skip the
+//    distributions that don't apply to them.
+// -- Each case is run -w times to warm up and -r times measured, on the
+//    CPU given by -c (-1 leaves scheduling alone). Median and minimum time
+//    per operation are reported, keys come from a fixed seed.
+// -- Where the kernel gives access to a hardware cache miss counter
+//    (perf_event_open), the median cache misses per operation of the timed
+//    parts are reported too, otherwise "-" (-1 in the results file).
+// -- "-compare" matches the cases of two result files and flags every
+//    case whose median got slower by more than -t percent (default 5). It
+//    exits with 1 if any case regressed.
+//
+// Assumptions/implementation:
+// -- Setup (building the structure, creating the keys) is never timed.
+// -- Inserts, creations and removals are repeated on fresh structures
+//    until MIN_OPERATIONS were timed, lookups run MIN_OPERATIONS times. Both
+//    stop early once a run took RUN_BUDGET seconds (a round that started
+//    is always finished), so degenerate trees don't take minutes.
+// -- Only fiction books are used as items, their comparisons are the same
+//    as the other types'.
+//---------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "library.h"
+#include "fictionbook.h"
+#include "valuesection.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+// order keys are inserted and looked up in
+enum Distribution { SORTED, SHUFFLED, ZIPF, DISTRIBUTIONS };
+static const char* DISTRIBUTION_NAMES[DISTRIBUTIONS] = {"sorted", "shuffled", "zipf"};
+
+// operations timed per run, so small sizes still run long enough
+static const int MIN_OPERATIONS = 100000;
+// a run stops after this many seconds (lookups check every 64), so the
+// degenerate trees of sorted inserts don't take minutes
+static const double RUN_BUDGET = 0.2;
+static const double ZIPF_EXPONENT = 0.99;
+// share of the lookups of the _mixed benchmarks that find nothing
+static const int MISS_PERCENT = 30;
+
+// one benchmark: sets up, times and returns ns per operation
+typedef double (*Benchmark)(int, Distribution, mt19937&);
+
+struct Entry {
+    const char* name;
+    Benchmark run;
+    bool applies[DISTRIBUTIONS];   // distributions it is run with
+};
+
+// one measured case
+struct Result {
+    string name;
+    int size;
+    string distribution;
+    double median;     // ns per operation
+    double minimum;
+    double misses;     // median cache misses per operation, -1 if not counted
+};
+
+// keeps the compiler from dropping results that are never used
+static volatile long sink;
+
+// hardware cache misses of this process, in user space (-1: the kernel or
+// the machine has no such counter, misses are then not reported)
+static int missCounter = -1;
+// counter value when the current timed part started
+static long long missesAtStart;
+// ns and misses of the timed parts of the current run, summed
+static double timedNanoseconds;
+static long long timedMisses;
+
+// opens the cache miss counter, if there is one
+static void openMissCounter() {
+    perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    missCounter = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+
+// cache misses counted so far, 0 without a counter
+static long long readMisses() {
+    long long value = 0;
+    if (missCounter >= 0 && read(missCounter, &value, sizeof(value)) != sizeof(value)) {
+        value = 0;
+    }
+    return value;
+}
+
+// start of a timed part of a run
+static Clock::time_point startTimer() {
+    missesAtStart = readMisses();
+    return Clock::now();
+}
+
+// ns elapsed since start, per operation. The elapsed time and the misses
+// since startTimer() are added to the run's totals.
+static double perOperation(Clock::time_point start, long operations) {
+    chrono::duration<double, nano> elapsed = Clock::now() - start;
+    timedMisses += readMisses() - missesAtStart;
+    timedNanoseconds += elapsed.count();
+    return elapsed.count() / max(1L, operations);
+}
+
+// rounds an insert-style benchmark repeats on a fresh structure, so it
+// does at least MIN_OPERATIONS operations
+static int roundsFor(int n) {
+    return max(1, MIN_OPERATIONS / n);
+}
+
+// seconds in a duration of ns
+static double seconds(double nanoseconds) {
+    return nanoseconds / 1e9;
+}
+
+// true once a run of lookups has used up its time budget
+static bool overBudget(Clock::time_point start, long done) {
+    if (done == 0 || done % 64 != 0) {
+        return false;
+    }
+    chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count() > RUN_BUDGET;
+}
+
+// key k of the fiction section, ordered like k
+static string fictionKey(int k) {
+    char text[80];
+    snprintf(text, sizeof(text), " Author%07d Ann, Fiction Title %07d,", k, k);
+    return text;
+}
+
+// fiction book with key k, as a command would create it
+static Item* makeBook(int k) {
+    Item* book = new FictionBook();
+    istringstream data(fictionKey(k));
+    book->setTransactionData(data);
+    book->setFormat('H');
+    return book;
+}
+
+// indices 0..n-1 in sorted or shuffled order
+static vector<int> insertOrder(int n, Distribution distribution, mt19937& random) {
+    vector<int> order(n);
+    for (int i = 0; i < n; i++) {
+        order[i] = i;
+    }
+    if (distribution != SORTED) {
+        shuffle(order.begin(), order.end(), random);
+    }
+    return order;
+}
+
+/*-------------------------------------------------------------------------
+* lookupOrder(int, int, Distribution, mt19937&)
+*
+* Indices to look up: Zipfian with the popular indices spread over the
+* whole range, or uniformly random for the other distributions. (Lookups
+* in ascending order would measure only the shallow end of a sorted tree
+* when a run stops at its time budget.)
+* @pre: n > 0
+* @post: None
+* @param: int - number of distinct indices
+* @param: int - number of lookups
+* @param: Distribution - how lookups are spread
+* @param: mt19937& - random source
+* @return: vector<int> - the indices, in lookup order
+*/
+static vector<int> lookupOrder(int n, int count, Distribution distribution, mt19937& random) {
+    vector<int> order(count);
+    if (distribution != ZIPF) {
+        for (int i = 0; i < count; i++) {
+            order[i] = random() % n;
+        }
+    } else {
+        vector<double> table(n);
+        double sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += 1.0 / pow(i + 1.0, ZIPF_EXPONENT);
+            table[i] = sum;
+        }
+        vector<int> popular = insertOrder(n, SHUFFLED, random);
+        uniform_real_distribution<double> uniform(0.0, sum);
+        for (int i = 0; i < count; i++) {
+            int rank = lower_bound(table.begin(), table.end(), uniform(random)) - table.begin();
+            order[i] = popular[min(rank, n - 1)];
+        }
+    }
+    return order;
+}
+
+// ******************************************* //
+// ************ Benchmarks ******************* //
+// ******************************************* //
+
+// BinarySearchTree::insert of n books, into a fresh tree every round
+static double bstInsert(int n, Distribution distribution, mt19937& random) {
+    vector<int> order = insertOrder(n, distribution, random);
+    double spent = 0;
+    long done = 0;
+    for (int round = 0; round < roundsFor(n) && seconds(spent) < RUN_BUDGET; round++) {
+        vector<Item*> books(n);
+        for (int i = 0; i < n; i++) {
+            books[i] = makeBook(order[i]);
+        }
+        BinarySearchTree tree("BENCH", "");
+        Clock::time_point start = startTimer();
+        for (int i = 0; i < n; i++) {
+            tree.insert(books[i]);
+        }
+        spent += perOperation(start, 1);
+        done += n;
+    }
+    return spent / done;
+}
+
+// how a lookup benchmark searches its section
+enum LookupPath {
+    VIRTUAL_TREE,      // BinarySearchTree::retrieve
+    COMPILED_TREE,     // BinarySearchTree::retrieveAs, as the Library does
+    COMPILED_VALUES,   // ValueSection::retrieveAs, as with value sections
+    KEY_INDEX          // Section::retrieveByKey, as the Library does now
+};
+
+// lookups in a section of n books, along the given path
+static double sectionLookups(int n, Distribution distribution, mt19937& random, LookupPath path) {
+    vector<int> order = insertOrder(n, distribution == SORTED ? SORTED : SHUFFLED, random);
+    BinarySearchTree tree("BENCH", "");
+    ValueSection<FictionBook> values("BENCH", "");
+    Section& section = (path == COMPILED_VALUES) ? static_cast<Section&>(values) : tree;
+    for (int i = 0; i < n; i++) {
+        section.insert(makeBook(order[i]));
+    }
+    int count = max(n, MIN_OPERATIONS);
+    vector<int> lookups = lookupOrder(n, count, distribution, random);
+    vector<Item*> probes(n);
+    for (int i = 0; i < n; i++) {
+        probes[i] = makeBook(i);
+    }
+    long found = 0;
+    long done = 0;
+    Clock::time_point start = startTimer();
+    for (; done < count && !overBudget(start, done); done++) {
+        Item* item = nullptr;
+        const FictionBook& probe = static_cast<const FictionBook&>(*probes[lookups[done]]);
+        int depth = 0;
+        if (path == KEY_INDEX) {
+            found += tree.retrieveByKey(probe, item, depth);
+        } else if (path == COMPILED_VALUES) {
+            found += values.retrieveAs(probe, item, depth);
+        } else if (path == COMPILED_TREE) {
+            found += tree.retrieveAs(probe, item, depth);
+        } else {
+            found += tree.retrieve(probe, item);
+        }
+    }
+    double result = perOperation(start, done);
+    sink = found;
+    for (int i = 0; i < n; i++) {
+        delete probes[i];
+    }
+    return result;
+}
+
+static double bstRetrieve(int n, Distribution distribution, mt19937& random) {
+    return sectionLookups(n, distribution, random, VIRTUAL_TREE);
+}
+
+static double bstRetrieveAs(int n, Distribution distribution, mt19937& random) {
+    return sectionLookups(n, distribution, random, COMPILED_TREE);
+}
+
+static double valueRetrieveAs(int n, Distribution distribution, mt19937& random) {
+    return sectionLookups(n, distribution, random, COMPILED_VALUES);
+}
+
+static double indexRetrieve(int n, Distribution distribution, mt19937& random) {
+    return sectionLookups(n, distribution, random, KEY_INDEX);
+}
+
+// lookups in a section of n books, MISS_PERCENT of them for absent keys:
+// through retrieveByKey (Bloom filter, then key index), or a key index alone
+static double mixedLookups(int n, Distribution distribution, mt19937& random, bool filtered) {
+    vector<int> order = insertOrder(n, distribution == SORTED ? SORTED : SHUFFLED, random);
+    BinarySearchTree tree("BENCH", "");
+    KeyIndex index;
+    for (int i = 0; i < n; i++) {
+        Item* book = makeBook(order[i]);
+        tree.insert(book);
+        index.insert(book->keyHash(), book);
+    }
+    int count = max(n, MIN_OPERATIONS);
+    vector<int> lookups = lookupOrder(n, count, distribution, random);
+    for (int i = 0; i < count; i++) {
+        if (static_cast<int>(random() % 100) < MISS_PERCENT) {
+            lookups[i] += n; // keys n..2n-1 were never inserted
+        }
+    }
+    vector<Item*> probes(2 * n);
+    for (int i = 0; i < 2 * n; i++) {
+        probes[i] = makeBook(i);
+    }
+    long found = 0;
+    long done = 0;
+    Clock::time_point start = startTimer();
+    for (; done < count && !overBudget(start, done); done++) {
+        Item* item = nullptr;
+        const FictionBook& probe = static_cast<const FictionBook&>(*probes[lookups[done]]);
+        int probed = 0;
+        if (filtered) {
+            found += tree.retrieveByKey(probe, item, probed);
+        } else {
+            found += index.findAs(probe, probe.FictionBook::keyHash(), item, probed);
+        }
+    }
+    double result = perOperation(start, done);
+    sink = found;
+    for (int i = 0; i < 2 * n; i++) {
+        delete probes[i];
+    }
+    return result;
+}
+
+static double filterRetrieveMixed(int n, Distribution distribution, mt19937& random) {
+    return mixedLookups(n, distribution, random, true);
+}
+
+static double indexRetrieveMixed(int n, Distribution distribution, mt19937& random) {
+    return mixedLookups(n, distribution, random, false);
+}
+
+// HashTable::insert of n patrons, into a fresh table every round
+static double hashInsert(int n, Distribution distribution, mt19937& random) {
+    vector<int> order = insertOrder(n, distribution, random);
+    double spent = 0;
+    long done = 0;
+    for (int round = 0; round < roundsFor(n) && seconds(spent) < RUN_BUDGET; round++) {
+        vector<Patron*> patrons(n);
+        for (int i = 0; i < n; i++) {
+            patrons[i] = new Patron();
+        }
+        HashTable table;
+        Clock::time_point start = startTimer();
+        for (int i = 0; i < n; i++) {
+            table.insert(10000 + order[i], patrons[i]);
+        }
+        spent += perOperation(start, 1);
+        done += n;
+    }
+    return spent / done;
+}
+
+// HashTable::retrieve in a table of n patrons
+static double hashRetrieve(int n, Distribution distribution, mt19937& random) {
+    vector<int> order = insertOrder(n, distribution == SORTED ? SORTED : SHUFFLED, random);
+    HashTable table;
+    for (int i = 0; i < n; i++) {
+        table.insert(10000 + order[i], new Patron());
+    }
+    int count = max(n, MIN_OPERATIONS);
+    vector<int> lookups = lookupOrder(n, count, distribution, random);
+    long found = 0;
+    long done = 0;
+    Clock::time_point start = startTimer();
+    for (; done < count && !overBudget(start, done); done++) {
+        Patron* patron = nullptr;
+        table.retrieve(10000 + lookups[done], patron);
+        found += (patron != nullptr);
+    }
+    double result = perOperation(start, done);
+    sink = found;
+    return result;
+}
+
+// Item ==, < and > on pairs of n books (sorted: neighbors, else random)
+static double itemCompare(int n, Distribution distribution, mt19937& random) {
+    vector<Item*> books(n + 1);
+    for (int i = 0; i <= n; i++) {
+        books[i] = makeBook(i);
+    }
+    int count = max(n, MIN_OPERATIONS);
+    vector<int> left = lookupOrder(n, count, distribution, random);
+    vector<int> right(count);
+    for (int i = 0; i < count; i++) {
+        right[i] = (distribution == SORTED) ? left[i] + 1 : random() % n;
+    }
+    long hits = 0;
+    long done = 0;
+    Clock::time_point start = startTimer();
+    for (; done < count && !overBudget(start, done); done++) {
+        const Item& a = *books[left[done]];
+        const Item& b = *books[right[done]];
+        hits += (a == b) + (a < b) + (a > b);
+    }
+    double result = perOperation(start, 3 * done);
+    sink = hits;
+    for (int i = 0; i <= n; i++) {
+        delete books[i];
+    }
+    return result;
+}
+
+// ItemFactory::createItem, cycling through the item types
+static double itemFactory(int n, Distribution, mt19937&) {
+    static const char TYPES[] = {'F', 'C', 'P'};
+    ItemFactory factory;
+    vector<Item*> items(n);
+    double spent = 0;
+    long done = 0;
+    for (int round = 0; round < roundsFor(n) && seconds(spent) < RUN_BUDGET; round++) {
+        Clock::time_point start = startTimer();
+        for (int i = 0; i < n; i++) {
+            items[i] = factory.createItem(TYPES[i % 3]);
+        }
+        spent += perOperation(start, 1);
+        done += n;
+        for (int i = 0; i < n; i++) {
+            delete items[i];
+        }
+    }
+    return spent / done;
+}
+
+// TransactionFactory::createTransaction, cycling through the command types
+static double transactionFactory(int n, Distribution, mt19937&) {
+    static const char TYPES[] = {'C', 'R', 'H', 'D'};
+    TransactionFactory factory;
+    vector<Transaction*> transactions(n);
+    double spent = 0;
+    long done = 0;
+    for (int round = 0; round < roundsFor(n) && seconds(spent) < RUN_BUDGET; round++) {
+        Clock::time_point start = startTimer();
+        for (int i = 0; i < n; i++) {
+            transactions[i] = factory.createTransaction(TYPES[i % 4]);
+        }
+        spent += perOperation(start, 1);
+        done += n;
+        for (int i = 0; i < n; i++) {
+            delete transactions[i];
+        }
+    }
+    return spent / done;
+}
+
+// Patron::hasItem on a patron holding n items
+static double patronHasItem(int n, Distribution distribution, mt19937& random) {
+    vector<Item*> books(n);
+    Patron patron;
+    for (int i = 0; i < n; i++) {
+        books[i] = makeBook(i);
+        patron.addItem(books[i]);
+    }
+    vector<int> lookups = lookupOrder(n, n, distribution, random);
+    long found = 0;
+    long done = 0;
+    Clock::time_point start = startTimer();
+    for (; done < n && !overBudget(start, done); done++) {
+        found += patron.hasItem(books[lookups[done]]);
+    }
+    double result = perOperation(start, done);
+    sink = found;
+    for (int i = 0; i < n; i++) {
+        delete books[i];
+    }
+    return result;
+}
+
+// Patron::removeItem of all n items a patron holds, refilled every round
+static double patronRemoveItem(int n, Distribution distribution, mt19937& random) {
+    vector<Item*> books(n);
+    for (int i = 0; i < n; i++) {
+        books[i] = makeBook(i);
+    }
+    vector<int> order = insertOrder(n, distribution, random);
+    double spent = 0;
+    long done = 0;
+    for (int round = 0; round < roundsFor(n) && seconds(spent) < RUN_BUDGET; round++) {
+        Patron patron;
+        for (int i = 0; i < n; i++) {
+            patron.addItem(books[i]);
+        }
+        Clock::time_point start = startTimer();
+        for (int i = 0; i < n; i++) {
+            patron.removeItem(books[order[i]]);
+        }
+        spent += perOperation(start, 1);
+        done += n;
+    }
+    for (int i = 0; i < n; i++) {
+        delete books[i];
+    }
+    return spent / done;
+}
+
+static const Entry BENCHMARKS[] = {
+    {"bst_insert",          bstInsert,          {true, true, false}},
+    {"bst_retrieve",        bstRetrieve,        {true, true, true}},
+    {"bst_retrieve_as",     bstRetrieveAs,      {true, true, true}},
+    {"value_retrieve_as",   valueRetrieveAs,    {true, true, true}},
+    {"index_retrieve",      indexRetrieve,      {true, true, true}},
+    {"filter_retrieve_mixed", filterRetrieveMixed, {true, true, true}},
+    {"index_retrieve_mixed",  indexRetrieveMixed,  {true, true, true}},
+    {"hash_insert",         hashInsert,         {true, true, false}},
+    {"hash_retrieve",       hashRetrieve,       {true, true, true}},
+    {"item_compare",        itemCompare,        {true, true, false}},
+    {"item_factory",        itemFactory,        {true, false, false}},
+    {"transaction_factory", transactionFactory, {true, false, false}},
+    {"patron_hasitem",      patronHasItem,      {true, true, true}},
+    {"patron_removeitem",   patronRemoveItem,   {true, true, false}},
+};
+static const int BENCHMARK_COUNT = sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]);
+
+// ******************************************* //
+// ********* Running and comparing *********** //
+// ******************************************* //
+
+// comma separated list split into its parts
+static vector<string> split(const string& list) {
+    vector<string> parts;
+    stringstream data(list);
+    string part;
+    while (getline(data, part, ',')) {
+        if (!part.empty()) {
+            parts.push_back(part);
+        }
+    }
+    return parts;
+}
+
+// result line as written to and read from a results file
+static void writeResult(ostream& out, const Result& result) {
+    out << result.name << '\t' << result.size << '\t' << result.distribution
+        << '\t' << result.median << '\t' << result.minimum << '\t' << result.misses << endl;
+}
+
+// results of a file, keyed by "name size distribution"
+static map<string, Result> readResults(const string& path) {
+    map<string, Result> results;
+    ifstream infile(path.c_str());
+    string line;
+    while (getline(infile, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        Result result;
+        result.misses = -1;
+        istringstream data(line);
+        if (data >> result.name >> result.size >> result.distribution >> result.median >> result.minimum) {
+            results[result.name + " " + to_string(result.size) + " " + result.distribution] = result;
+        }
+    }
+    return results;
+}
+
+/*-------------------------------------------------------------------------
+* compare(const string&, const string&, double)
+*
+* Prints the change of every case found in both result files and flags
+* the ones slower than the threshold
+* @pre: None
+* @post: None
+* @param: const string& - the old (baseline) results
+* @param: const string& - the new results
+* @param: double - slowdown in percent that counts as a regression
+* @return: int - exit code, 1 if any case regressed
+*/
+static int compare(const string& oldPath, const string& newPath, double threshold) {
+    map<string, Result> before = readResults(oldPath);
+    map<string, Result> after = readResults(newPath);
+    int regressions = 0;
+    printf("%-42s %12s %12s %9s\n", "case", "old ns/op", "new ns/op", "change");
+    for (map<string, Result>::const_iterator it = after.begin(); it != after.end(); ++it) {
+        map<string, Result>::const_iterator old = before.find(it->first);
+        if (old == before.end()) {
+            printf("%-42s %12s %12.1f %9s\n", it->first.c_str(), "-", it->second.median, "new");
+            continue;
+        }
+        double change = (old->second.median > 0)
+            ? (it->second.median - old->second.median) / old->second.median * 100 : 0;
+        const char* flag = "";
+        if (change > threshold) {
+            flag = "  REGRESSION";
+            regressions++;
+        } else if (change < -threshold) {
+            flag = "  faster";
+        }
+        printf("%-42s %12.1f %12.1f %+8.1f%%%s\n", it->first.c_str(), old->second.median,
+               it->second.median, change, flag);
+    }
+    printf("%d regression(s) beyond %.1f%%\n", regressions, threshold);
+    return regressions > 0 ? 1 : 0;
+}
+
+// keeps this process on one CPU, so runs don't migrate between cores
+static void pin(int cpu) {
+    if (cpu < 0) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        cerr << "warning: cannot pin to cpu " << cpu << ", running unpinned" << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 4 && string(argv[1]) == "-compare") {
+        double threshold = 5;
+        if (argc >= 6 && string(argv[4]) == "-t") {
+            threshold = atof(argv[5]);
+        }
+        return compare(argv[2], argv[3], threshold);
+    }
+
+    vector<string> sizes = split("1000,10000");
+    vector<string> distributions = split("sorted,shuffled,zipf");
+    vector<string> selected;
+    int runs = 5;
+    int warmups = 1;
+    int cpu = 0;
+    unsigned int seed = 1;
+    string outputPath = "";
+    for (int i = 1; i < argc; i += 2) {
+        // an option without its value is as wrong as an unknown one
+        string option = (i + 1 < argc) ? argv[i] : "";
+        string value = (i + 1 < argc) ? argv[i + 1] : "";
+        if (option == "-n") {
+            sizes = split(value);
+        } else if (option == "-d") {
+            distributions = split(value);
+        } else if (option == "-b") {
+            selected = split(value);
+        } else if (option == "-r") {
+            runs = max(1, atoi(value.c_str()));
+        } else if (option == "-w") {
+            warmups = max(0, atoi(value.c_str()));
+        } else if (option == "-c") {
+            cpu = atoi(value.c_str());
+        } else if (option == "-s") {
+            seed = strtoul(value.c_str(), nullptr, 10);
+        } else if (option == "-o") {
+            outputPath = value;
+        } else {
+            cerr << "usage: " << argv[0] << " [-n sizes] [-d distributions] [-b benchmarks]"
+                 << " [-r runs] [-w warmups] [-c cpu] [-s seed] [-o results.tsv]" << endl
+                 << "       " << argv[0] << " -compare old.tsv new.tsv [-t percent]" << endl;
+            return 1;
+        }
+    }
+    pin(cpu);
+    openMissCounter();
+
+    ofstream output;
+    if (outputPath != "") {
+        output.open(outputPath.c_str());
+        output << "# benchmark\tsize\tdistribution\tmedian_ns\tmin_ns\tmisses_per_op" << endl;
+    }
+    printf("%-20s %9s %-9s %12s %12s %12s\n", "benchmark", "size", "order", "median ns", "min ns",
+           "misses/op");
+    for (int b = 0; b < BENCHMARK_COUNT; b++) {
+        const Entry& entry = BENCHMARKS[b];
+        if (!selected.empty() && find(selected.begin(), selected.end(), entry.name) == selected.end()) {
+            continue;
+        }
+        for (int s = 0; s < sizes.size(); s++) {
+            int size = max(1, atoi(sizes[s].c_str()));
+            for (int d = 0; d < DISTRIBUTIONS; d++) {
+                if (!entry.applies[d] || find(distributions.begin(), distributions.end(),
+                                              DISTRIBUTION_NAMES[d]) == distributions.end()) {
+                    continue;
+                }
+                // same keys for every run of a case, and for every build
+                mt19937 random(seed);
+                vector<double> times;
+                vector<double> misses;
+                for (int r = 0; r < warmups + runs; r++) {
+                    random.seed(seed);
+                    timedNanoseconds = 0;
+                    timedMisses = 0;
+                    double time = entry.run(size, static_cast<Distribution>(d), random);
+                    if (r >= warmups) {
+                        times.push_back(time);
+                        // operations timed = timed ns / ns per operation
+                        misses.push_back(timedNanoseconds > 0 ? timedMisses * time / timedNanoseconds : 0);
+                    }
+                }
+                sort(times.begin(), times.end());
+                sort(misses.begin(), misses.end());
+                Result result = {entry.name, size, DISTRIBUTION_NAMES[d], times[times.size() / 2],
+                                 times[0], missCounter >= 0 ? misses[misses.size() / 2] : -1};
+                char missText[32] = "-";
+                if (result.misses >= 0) {
+                    snprintf(missText, sizeof(missText), "%.2f", result.misses);
+                }
+                printf("%-20s %9d %-9s %12.1f %12.1f %12s\n", result.name.c_str(), result.size,
+                       result.distribution.c_str(), result.median, result.minimum, missText);
+                fflush(stdout);
+                if (output.is_open()) {
+                    writeResult(output, result);
+                }
+            }
+        }
+    }
+    return 0;
+}
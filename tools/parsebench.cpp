@@ -0,0 +1,167 @@
+/*---------------------------------------------------------------------------
+* @file: parsebench.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: throughput of the command file parsers
+---------------------------------------------------------------------------*/
+// Parsebench: Times how fast a command file is turned into Commands, with
+// nothing executed, so the parser alone is measured.
+//---------------------------------------------------------------------------
+// Usage:
+//   g++ -O2 -pthread -I. -o parsebench tools/parsebench.cpp
+//       $(ls *.cpp | grep -v main.cpp)      (one command line)
+//   ./parsebench commands.txt [-j 1,2,4,8,16] [-r runs]
+//
+// Features:
+// -- "stream" reads the file through a LineReader, the way "-c" does.
+// -- "block" parses the mapped file as one block on this thread.
+// -- "parallel/N" parses the mapped file with a ParallelParser on N
+//    threads, once per count given to -j, and takes its blocks in order.
+// -- Prints MB/s and commands parsed, the best of -r runs (default 3).
+//
+// Assumptions/implementation:
+// -- The file is mapped and read once before timing, so it is in the page
+//    cache and no run pays for the disk.
+//---------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "command.h"
+#include "linereader.h"
+
+using namespace std;
+
+// seconds since an arbitrary start
+static double now() {
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// commands parsed by a LineReader over the file
+static long parseStream(const string& path) {
+    LineReader reader(LineReader::open(path));
+    Command command;
+    const char* begin;
+    const char* end;
+    long commands = 0;
+    while (reader.next(begin, end)) {
+        if (CommandParser::parse(begin, end, command)) {
+            commands++;
+        }
+    }
+    return commands;
+}
+
+// commands parsed from the whole mapping as one block
+static long parseWhole(const char* data, size_t size) {
+    vector<Command> commands;
+    CommandParser::parseBlock(data, data + size, commands);
+    return commands.size();
+}
+
+// commands parsed by a ParallelParser, taken in file order
+static long parseParallel(const char* data, size_t size, int threads) {
+    ParallelParser parser(data, size, threads);
+    vector<Command> chunk;
+    long commands = 0;
+    while (parser.next(chunk)) {
+        commands += chunk.size();
+    }
+    return commands;
+}
+
+// prints one result line
+static void report(const string& name, size_t size, double seconds, long commands) {
+    cout << left << setw(14) << name << right << fixed << setprecision(1)
+         << setw(10) << size / seconds / (1024 * 1024) << " MB/s"
+         << setw(12) << commands << " commands" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> threadCounts;
+    int runs = 3;
+    bool valid = argc >= 2;
+    for (int i = 2; i < argc; i += 2) {
+        // an option without its value is as wrong as an unknown one
+        string option = (i + 1 < argc) ? argv[i] : "";
+        if (option == "-j") {
+            stringstream list(argv[i + 1]);
+            string count;
+            while (getline(list, count, ',')) {
+                threadCounts.push_back(atoi(count.c_str()));
+            }
+        } else if (option == "-r") {
+            runs = atoi(argv[i + 1]);
+        } else {
+            valid = false;
+        }
+    }
+    if (!valid) {
+        cerr << "usage: " << argv[0] << " commands.txt [-j threads,...] [-r runs]" << endl;
+        return 1;
+    }
+    string path = argv[1];
+    if (threadCounts.empty()) {
+        threadCounts.push_back(1);
+        threadCounts.push_back(2);
+        threadCounts.push_back(4);
+    }
+
+    int source = open(path.c_str(), O_RDONLY);
+    struct stat status;
+    if (source < 0 || fstat(source, &status) != 0 || status.st_size == 0) {
+        cerr << "cannot read " << path << endl;
+        return 1;
+    }
+    size_t size = status.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, source, 0);
+    close(source);
+    if (mapping == MAP_FAILED) {
+        cerr << "cannot map " << path << endl;
+        return 1;
+    }
+    const char* data = static_cast<const char*>(mapping);
+
+    // touch every page so the first run is not the only one reading the disk
+    long pageSum = 0;
+    for (size_t i = 0; i < size; i += 4096) {
+        pageSum += data[i];
+    }
+    cout << path << ": " << size / (1024 * 1024) << " MB" << (pageSum == 0 ? " " : "") << endl;
+
+    // best time of the runs for each parser
+    for (int parser = -2; parser < static_cast<int>(threadCounts.size()); parser++) {
+        double best = 0;
+        long commands = 0;
+        for (int run = 0; run < runs; run++) {
+            double started = now();
+            if (parser == -2) {
+                commands = parseStream(path);
+            } else if (parser == -1) {
+                commands = parseWhole(data, size);
+            } else {
+                commands = parseParallel(data, size, threadCounts[parser]);
+            }
+            double seconds = now() - started;
+            if (run == 0 || seconds < best) {
+                best = seconds;
+            }
+        }
+        string name = (parser == -2) ? "stream" : (parser == -1) ? "block" : "";
+        if (parser >= 0) {
+            stringstream label;
+            label << "parallel/" << threadCounts[parser];
+            name = label.str();
+        }
+        report(name, size, best, commands);
+    }
+    munmap(mapping, size);
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*---------------------------------------------------------------------------
+* @file: searchbench.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: speed and memory of keyword search over titles
+---------------------------------------------------------------------------*/
+// Searchbench: Indexes a catalog of made up titles in a WordIndex, then
+// times 1, 2 and 3 word queries against what answering one took before:
+// reading every title and keeping the ones with all the words.
+//---------------------------------------------------------------------------
+// Usage:
+//   g++ -O2 -pthread -I. -o searchbench tools/searchbench.cpp
+//       $(ls *.cpp | grep -v main.cpp)      (one command line)
+//   ./searchbench [-n sizes] [-q queries] [-s seed]
+//
+// Features:
+// -- Sizes (-n 1000000,20000000) are numbers of books of each catalog,
+//    with titles of 2 to 6 words from a 20000 word vocabulary, common
+//    words far more often, as in real titles.
+// -- Queries take their words from a random title of the catalog, so
+//    every query finds at least one book.
+// -- Prints for every catalog: seconds to index it, megabytes of the index
+//    and of the books, then for 1, 2 and 3 word queries the books found
+//    on average and microseconds per query (-q queries of each, default
+//    10000), and milliseconds of one scan of every title.
+//
+// Assumptions/implementation:
+// -- The books are fiction books held in one array, as the Items of a
+//    section would be; 20M of them take about 2 GB.
+//---------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include "book.h"
+#include "fictionbook.h"
+#include "wordindex.h"
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+// keeps query results alive, so the loops aren't optimized away
+static volatile long sink;
+
+// seconds since the given time
+static double since(Clock::time_point start) {
+    chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+// comma separated list of sizes
+static vector<int> parseSizes(const string& list) {
+    vector<int> sizes;
+    stringstream items(list);
+    string size;
+    while (getline(items, size, ',')) {
+        sizes.push_back(atoi(size.c_str()));
+    }
+    return sizes;
+}
+
+// made up word number index, 3 to 9 letters
+static string word(int index) {
+    static const char* const LETTERS = "etaoinshrdlucmfwypvbgkqjxz";
+    string text;
+    int length = 3 + index % 7;
+    unsigned value = index * 2654435761u;
+    for (int i = 0; i < length; i++) {
+        text += LETTERS[value % 26];
+        value = value / 26 + index * 7 + i;
+    }
+    return text;
+}
+
+// a title of 2 to 6 words, low (common) word numbers more often
+static string makeTitle(mt19937& random) {
+    exponential_distribution<double> common(1.0 / 2000);
+    int words = 2 + random() % 5;
+    string title;
+    for (int i = 0; i < words; i++) {
+        if (i > 0) {
+            title += ' ';
+        }
+        title += word(min(19999, static_cast<int>(common(random))));
+    }
+    return title;
+}
+
+// sets book number key to a title
+static void setBook(FictionBook& book, int key, const string& title, istringstream& data) {
+    stringstream text;
+    text << " Author" << key << " Ann, " << title << ",";
+    data.clear();
+    data.str(text.str());
+    book.setTransactionData(data);
+    book.setFormat('H');
+}
+
+// true if every query word is a word of the title, the search a scan does
+static bool holdsAll(const vector<string>& title, const vector<string>& query) {
+    for (size_t i = 0; i < query.size(); i++) {
+        if (find(title.begin(), title.end(), query[i]) == title.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// one catalog of n books: index, then queries of 1 to 3 words timed
+static void run(int n, int queries, mt19937& random) {
+    istringstream data;
+    vector<FictionBook> books(n);
+    for (int i = 0; i < n; i++) {
+        setBook(books[i], i, makeTitle(random), data);
+    }
+    WordIndex index;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < n; i++) {
+        index.insert(&books[i]);
+    }
+    double building = since(start);
+    cout << setw(10) << n << setw(10) << building << setw(10) << index.getBytes() / 1e6
+         << setw(10) << n * sizeof(FictionBook) / 1e6 << endl;
+
+    vector<Item*> found;
+    vector<string> words;
+    cout << setw(10) << "WORDS" << setw(14) << "FOUND" << setw(12) << "SEARCH US"
+         << setw(12) << "SCAN MS" << endl;
+    for (int length = 1; length <= 3; length++) {
+        vector<string> asked(queries);
+        for (int i = 0; i < queries; i++) {
+            WordIndex::tokenize(books[random() % n].getTitle(), words);
+            shuffle(words.begin(), words.end(), random);
+            for (int j = 0; j < length && j < static_cast<int>(words.size()); j++) {
+                asked[i] += (j > 0 ? " " : "") + words[j];
+            }
+        }
+        long matches = 0;
+        start = Clock::now();
+        for (int i = 0; i < queries; i++) {
+            matches += index.search(asked[i], found);
+        }
+        double searching = since(start) / queries * 1e6;
+
+        vector<string> query;
+        vector<string> title;
+        WordIndex::tokenize(asked[0], query);
+        start = Clock::now();
+        for (int i = 0; i < n; i++) {
+            WordIndex::tokenize(books[i].getTitle(), title);
+            sink += holdsAll(title, query);
+        }
+        double scanning = since(start) * 1e3;
+
+        cout << setw(10) << length << setw(14) << static_cast<double>(matches) / queries
+             << setw(12) << searching << setw(12) << scanning << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> sizes = parseSizes("1000000,20000000");
+    int queries = 10000;
+    unsigned seed = 1;
+    for (int i = 1; i < argc; i += 2) {
+        // an option without its value is as wrong as an unknown one
+        string option = (i + 1 < argc) ? argv[i] : "";
+        if (option == "-n") {
+            sizes = parseSizes(argv[i + 1]);
+        } else if (option == "-q") {
+            queries = atoi(argv[i + 1]);
+        } else if (option == "-s") {
+            seed = static_cast<unsigned>(atoi(argv[i + 1]));
+        } else {
+            cerr << "usage: " << argv[0] << " [-n sizes] [-q queries] [-s seed]" << endl;
+            return 1;
+        }
+    }
+    mt19937 random(seed);
+    cout << fixed << setprecision(2);
+    for (size_t i = 0; i < sizes.size(); i++) {
+        cout << setw(10) << "BOOKS" << setw(10) << "INDEX S" << setw(10) << "INDEX MB"
+             << setw(10) << "BOOKS MB" << endl;
+        run(sizes[i], queries, random);
+    }
+    return 0;
+}
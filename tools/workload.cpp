@@ -0,0 +1,341 @@
+/*---------------------------------------------------------------------------
+* @file: workload.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: synthetic book, patron and command file generator
+---------------------------------------------------------------------------*/
+// Workload: Writes book, patron and command files in the same layout as
+// data4books.txt, data4patrons.txt and data4commands.txt, at any size, so
+// the library can be measured at production scale (see benchmark.cpp).
+//---------------------------------------------------------------------------
+// Usage:
+//   g++ -O2 -o workload tools/workload.cpp
+//   ./workload [-b books] [-p patrons] [-c commands] [-z zipf exponent]
+//              [-o sorted|shuffled] [-m C,R,H,D] [-e P,T,S,N] [-s seed]
+//              [-f file prefix]
+//
+// Features:
+// -- Books are 50% fiction, 30% children's and 20% periodicals. Patrons
+//    get IDs from 10000 up.
+// -- "-o sorted" writes books and patrons in the order the library sorts
+//    them (the worst case for its unbalanced trees), "-o shuffled" in
+//    random order.
+// -- Items are picked for checkouts with Zipfian popularity (exponent -z,
+//    0 is uniform). The most popular items are spread over all sections.
+// -- The mix gives relative weights of checkouts, returns, histories and
+//    displays. Returns give back an item some patron actually holds.
+// -- Error rates, in percent of the checkouts and returns: invalid patron
+//    (P), unknown item type (T), out of stock (S, a checkout of an item
+//    whose copies are all out) and not checked out (N, a return by a
+//    patron who doesn't hold the item). Out of stock also happens on its
+//    own once popular items run out.
+//
+// Assumptions/implementation:
+// -- Writes <prefix>_books.txt, <prefix>_patrons.txt and
+//    <prefix>_commands.txt, then prints what was generated.
+// -- The stock of each item is tracked while generating (5 copies of a
+//    book, 1 of a periodical) so error rates are what was asked for.
+//---------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+
+// what to generate
+struct Options {
+    int books;
+    int patrons;
+    long commands;
+    double zipf;
+    bool sorted;
+    int weights[4];    // C, R, H, D
+    int errors[4];     // invalid patron, unknown type, out of stock, not checked out
+    unsigned int seed;
+    string prefix;
+};
+
+// one generated item
+struct Book {
+    char type;
+    string record;     // line of the book file
+    string command;    // item part of a command, e.g. "F H author, title,"
+    int stock;         // copies left while generating
+};
+
+// one checkout that hasn't been returned yet
+struct Loan {
+    int patron;
+    int book;
+};
+
+/*-------------------------------------------------------------------------
+* makeBooks(const Options&)
+*
+* Creates every book with its file record and command text, in the order
+* the library sorts them within each section
+* @pre: options.books > 0
+* @post: None
+* @param: const Options& - how many books
+* @return: vector<Book> - fiction, then children's, then periodicals
+*/
+static vector<Book> makeBooks(const Options& options) {
+    int fiction = options.books / 2;
+    int children = options.books * 3 / 10;
+    int periodicals = options.books - fiction - children;
+    int journals = max(1, periodicals / 600);
+    vector<Book> books;
+    char text[160];
+    for (int k = 0; k < fiction; k++) {
+        Book book;
+        book.type = 'F';
+        snprintf(text, sizeof(text), "Author%07d Ann, Fiction Title %07d", k, k);
+        book.record = string("F ") + text + ", " + to_string(1900 + k % 120);
+        book.command = string("F H ") + text + ",";
+        book.stock = 5;
+        books.push_back(book);
+    }
+    for (int k = 0; k < children; k++) {
+        Book book;
+        book.type = 'C';
+        // the file has author first, commands have title first
+        snprintf(text, sizeof(text), "Writer%07d Bo, Children Title %07d", k, k);
+        book.record = string("C ") + text + ", " + to_string(1950 + k % 70);
+        snprintf(text, sizeof(text), "Children Title %07d, Writer%07d Bo", k, k);
+        book.command = string("C H ") + text + ",";
+        book.stock = 5;
+        books.push_back(book);
+    }
+    for (int k = 0; k < periodicals; k++) {
+        // sorted by year, then month, then title
+        int year = 1950 + k / (12 * journals);
+        int month = (k / journals) % 12 + 1;
+        Book book;
+        book.type = 'P';
+        snprintf(text, sizeof(text), "Journal %05d", k % journals);
+        book.record = string("P ") + text + ", " + to_string(month) + " " + to_string(year);
+        book.command = string("P H ") + to_string(year) + " " + to_string(month) + " " + text + ",";
+        book.stock = 1;
+        books.push_back(book);
+    }
+    return books;
+}
+
+/*-------------------------------------------------------------------------
+* zipfTable(int, double)
+*
+* Cumulative probabilities of ranks 1..n under a Zipf distribution
+* @pre: n > 0
+* @post: None
+* @param: int - number of ranks
+* @param: double - exponent, 0 for uniform
+* @return: vector<double> - cumulative probability of each rank
+*/
+static vector<double> zipfTable(int n, double exponent) {
+    vector<double> table(n);
+    double sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += 1.0 / pow(i + 1.0, exponent);
+        table[i] = sum;
+    }
+    for (int i = 0; i < n; i++) {
+        table[i] /= sum;
+    }
+    return table;
+}
+
+// rank drawn from a zipfTable()
+static int zipfRank(const vector<double>& table, mt19937& random) {
+    double u = uniform_real_distribution<double>(0.0, 1.0)(random);
+    return lower_bound(table.begin(), table.end(), u) - table.begin();
+}
+
+// true with the given chance in percent
+static bool chance(int percent, mt19937& random) {
+    return percent > 0 && (int)(random() % 100) < percent;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    options.books = 10000;
+    options.patrons = 1000;
+    options.commands = 100000;
+    options.zipf = 0.99;
+    options.sorted = false;
+    options.weights[0] = 50;
+    options.weights[1] = 40;
+    options.weights[2] = 9;
+    options.weights[3] = 1;
+    options.errors[0] = 1;
+    options.errors[1] = 1;
+    options.errors[2] = 1;
+    options.errors[3] = 1;
+    options.seed = 12345;
+    options.prefix = "workload";
+
+    bool valid = true;
+    for (int i = 1; i < argc; i += 2) {
+        // an option without its value is as wrong as an unknown one
+        string option = (i + 1 < argc) ? argv[i] : "";
+        string value = (i + 1 < argc) ? argv[i + 1] : "";
+        if (option == "-b") {
+            options.books = max(1, atoi(value.c_str()));
+        } else if (option == "-p") {
+            options.patrons = max(1, atoi(value.c_str()));
+        } else if (option == "-c") {
+            options.commands = max(0L, atol(value.c_str()));
+        } else if (option == "-z") {
+            options.zipf = max(0.0, atof(value.c_str()));
+        } else if (option == "-o") {
+            options.sorted = (value == "sorted");
+        } else if (option == "-m") {
+            sscanf(value.c_str(), "%d,%d,%d,%d", &options.weights[0], &options.weights[1],
+                   &options.weights[2], &options.weights[3]);
+        } else if (option == "-e") {
+            sscanf(value.c_str(), "%d,%d,%d,%d", &options.errors[0], &options.errors[1],
+                   &options.errors[2], &options.errors[3]);
+        } else if (option == "-s") {
+            options.seed = strtoul(value.c_str(), nullptr, 10);
+        } else if (option == "-f") {
+            options.prefix = value;
+        } else {
+            valid = false;
+        }
+    }
+    int totalWeight = options.weights[0] + options.weights[1] + options.weights[2] + options.weights[3];
+    if (!valid || totalWeight <= 0) {
+        cerr << "usage: " << argv[0] << " [-b books] [-p patrons] [-c commands] [-z zipf]"
+             << " [-o sorted|shuffled] [-m C,R,H,D] [-e P,T,S,N] [-s seed] [-f prefix]" << endl;
+        return 1;
+    }
+    mt19937 random(options.seed);
+
+    // books and patrons files
+    vector<Book> books = makeBooks(options);
+    vector<int> order(books.size());
+    for (int i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    if (!options.sorted) {
+        shuffle(order.begin(), order.end(), random);
+    }
+    ofstream bookFile((options.prefix + "_books.txt").c_str());
+    for (int i = 0; i < order.size(); i++) {
+        bookFile << books[order[i]].record << '\n';
+    }
+
+    vector<int> patronIDs(options.patrons);
+    for (int i = 0; i < options.patrons; i++) {
+        patronIDs[i] = 10000 + i;
+    }
+    vector<int> patronOrder(patronIDs);
+    if (!options.sorted) {
+        shuffle(patronOrder.begin(), patronOrder.end(), random);
+    }
+    ofstream patronFile((options.prefix + "_patrons.txt").c_str());
+    char name[64];
+    for (int i = 0; i < patronOrder.size(); i++) {
+        snprintf(name, sizeof(name), "Last%06d First", patronOrder[i] - 10000);
+        patronFile << patronOrder[i] << ' ' << name << '\n';
+    }
+
+    // popularity: rank r is books[popular[r]], spread over the sections
+    vector<int> popular(books.size());
+    for (int i = 0; i < popular.size(); i++) {
+        popular[i] = i;
+    }
+    shuffle(popular.begin(), popular.end(), random);
+    vector<double> table = zipfTable(books.size(), options.zipf);
+    vector<int> soldOut;            // books with no copies left
+    vector<int> soldOutIndex(books.size(), -1); // position of a book in soldOut
+    vector<Loan> loans;             // checkouts not returned yet
+
+    // commands file
+    ofstream commandFile((options.prefix + "_commands.txt").c_str());
+    long counts[4] = {0, 0, 0, 0};
+    long errorCounts[4] = {0, 0, 0, 0}; // P, T, S, N
+    for (long i = 0; i < options.commands; i++) {
+        int pick = random() % totalWeight;
+        int patron = patronIDs[random() % patronIDs.size()];
+        bool checkout = pick < options.weights[0] ||
+                        (pick < options.weights[0] + options.weights[1] && loans.empty());
+        if (checkout) {
+            counts[0]++;
+            int book = popular[zipfRank(table, random)];
+            if (chance(options.errors[2], random) && !soldOut.empty()) {
+                book = soldOut[random() % soldOut.size()];
+            }
+            if (chance(options.errors[0], random)) {
+                errorCounts[0]++;
+                commandFile << "C " << 9 << ' ' << books[book].command << '\n';
+            } else if (chance(options.errors[1], random)) {
+                errorCounts[1]++;
+                commandFile << "C " << patron << " X" << books[book].command.substr(1) << '\n';
+            } else {
+                commandFile << "C " << patron << ' ' << books[book].command << '\n';
+                if (books[book].stock == 0) {
+                    errorCounts[2]++;
+                } else {
+                    books[book].stock--;
+                    if (books[book].stock == 0) {
+                        soldOutIndex[book] = soldOut.size();
+                        soldOut.push_back(book);
+                    }
+                    Loan loan;
+                    loan.patron = patron;
+                    loan.book = book;
+                    loans.push_back(loan);
+                }
+            }
+        } else if (pick < options.weights[0] + options.weights[1]) {
+            counts[1]++;
+            int index = random() % loans.size();
+            Loan loan = loans[index];
+            if (chance(options.errors[3], random)) {
+                // someone who (most likely) doesn't hold it
+                errorCounts[3]++;
+                int other = patronIDs[random() % patronIDs.size()];
+                commandFile << "R " << other << ' ' << books[loan.book].command << '\n';
+                continue;
+            }
+            if (chance(options.errors[0], random)) {
+                errorCounts[0]++;
+                commandFile << "R " << 9 << ' ' << books[loan.book].command << '\n';
+                continue;
+            }
+            commandFile << "R " << loan.patron << ' ' << books[loan.book].command << '\n';
+            loans[index] = loans.back();
+            loans.pop_back();
+            if (books[loan.book].stock == 0) {
+                int last = soldOut.back();
+                soldOut[soldOutIndex[loan.book]] = last;
+                soldOutIndex[last] = soldOutIndex[loan.book];
+                soldOut.pop_back();
+            }
+            books[loan.book].stock++;
+        } else if (pick < options.weights[0] + options.weights[1] + options.weights[2]) {
+            counts[2]++;
+            commandFile << "H " << patron << '\n';
+        } else {
+            counts[3]++;
+            commandFile << "D\n";
+        }
+    }
+
+    cout << "books            " << books.size() << (options.sorted ? " (sorted)" : " (shuffled)") << endl;
+    cout << "patrons          " << patronIDs.size() << endl;
+    cout << "commands         " << options.commands << " (C " << counts[0] << ", R " << counts[1]
+         << ", H " << counts[2] << ", D " << counts[3] << ")" << endl;
+    cout << "invalid patron   " << errorCounts[0] << endl;
+    cout << "unknown type     " << errorCounts[1] << endl;
+    cout << "out of stock     " << errorCounts[2] << endl;
+    cout << "not checked out  " << errorCounts[3] << endl;
+    return 0;
+}
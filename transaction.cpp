@@ -29,4 +29,27 @@ Transaction::Transaction(){
 */
 Transaction::~Transaction(){
 
+}
+
+/*-------------------------------------------------------------------------
+* execute(Library&, const Command&)
+*
+* This method is designed to change a Library object based on a parsed 
+* command. It runs the four stages below back to back for this single
+* command. How each stage changes the Library (or if it does at all) is 
+* up to the derived classes.
+* @pre: Library exists, command.type names this kind of transaction
+* @post: The command is executed, but this will cause no change in the 
+* library if any part of the command is invalid.
+* @param: Library& - the library the command should change
+* @param: const Command& - the parsed command
+* @return: returns a bool marking whether or not to save this transaction
+* to the library (and patron) history. Returns true if it should be saved 
+* and returns false if it should not (determined by derived classes)
+*/
+bool Transaction::execute(Library& currLibrary, const Command& command) {
+    load(command);
+    findPatron(currLibrary);
+    findItem(currLibrary);
+    return apply(currLibrary);
 }
\ No newline at end of file
@@ -7,8 +7,10 @@
 // Transactions stored inside a Patron.
 //---------------------------------------------------------------------------
 // Features: 
-//  -- N/A (all methods virtual, Transaction itself doesn't have any 
-//     implementation beyond constructor and destructor)
+//  -- execute() runs the stages implemented by derived classes in order
+//     (load, findPatron, findItem, apply). Everything else is virtual.
+//  -- Transactions never read streams, they are loaded from a Command that
+//     was parsed beforehand (see command.h).
 //
 // Assumptions/implementation:
 // -- Any derived class will implement pure virtual functions
@@ -17,7 +19,9 @@
 #define TRANSACTION_H
 
 class Library;
+class Patron;
 #include "item.h"
+#include "command.h"
 #include <fstream>
 
 class Transaction {
@@ -57,22 +61,87 @@ class Transaction {
         virtual Transaction* create() const = 0;
 
         /*-------------------------------------------------------------------------
-        * execute(Library&, ifstream&)
+        * execute(Library&, const Command&)
         *
-        * Pure virtual function to be implemented by derived classes. This method
-        * is designed to change a Library object based on command data in a file.
-        * How it changes the Library (or if it does at all) is up to the derived
-        * classes.
-        * @pre: Library and a command file exist.
-        * @post: The next command specified in the file is executed, but this will
-        * cause no change in the library if any part of the command is invalid.
+        * This method is designed to change a Library object based on a parsed 
+        * command. It runs the four stages below back to back for this single
+        * command. How each stage changes the Library (or if it does at all) is 
+        * up to the derived classes.
+        * @pre: Library exists, command.type names this kind of transaction
+        * @post: The command is executed, but this will cause no change in the 
+        * library if any part of the command is invalid.
         * @param: Library& - the library the command should change
-        * @param: ifstream& - the ifstream providing data for commands (1 per line)
+        * @param: const Command& - the parsed command
         * @return: returns a bool marking whether or not to save this transaction
         * to the library (and patron) history. Returns true if it should be saved 
         * and returns false if it should not (determined by derived classes)
         */
-        virtual bool execute(Library&, ifstream&) = 0; 
+        virtual bool execute(Library&, const Command&); 
+
+        // ************************************** //
+        // ******** Execution stages ************ //
+        // ************************************** //
+        // execute() is split into stages so a batch of commands can run one 
+        // stage for the whole batch before moving to the next (see 
+        // Library::acceptBatch). Lookups never change the library, so only the
+        // apply() stage has to run in command order.
+
+        /*-------------------------------------------------------------------------
+        * load(const Command&)
+        *
+        * Pure virtual, stage 1. Stores the fields of a parsed command this
+        * transaction needs, without looking anything up.
+        * @pre: command.type names this kind of transaction
+        * @post: the command's fields are stored in this Transaction
+        * @param: const Command& - the parsed command
+        */
+        virtual void load(const Command&) = 0;
+
+        /*-------------------------------------------------------------------------
+        * getPatronID()
+        *
+        * Pure virtual. The patron ID loaded by load(), used to prefetch the patron
+        * before findPatron() runs. Transactions without a patron return 0.
+        * @pre: load() has been called
+        * @post: Transaction is unchanged
+        * @return: int - the patron ID of this command
+        */
+        virtual int getPatronID() const = 0;
+
+        /*-------------------------------------------------------------------------
+        * findPatron(Library&)
+        *
+        * Pure virtual, stage 2. Looks up the patron named by the command.
+        * @pre: load() has been called
+        * @post: the patron (or its absence) is stored in this Transaction
+        * @param: Library& - the library the patron is looked up in
+        */
+        virtual void findPatron(Library&) = 0;
+
+        /*-------------------------------------------------------------------------
+        * findItem(Library&)
+        *
+        * Pure virtual, stage 3. Looks up the item named by the command, if the
+        * command names one and its patron was found. Prints an error for an 
+        * invalid item type.
+        * @pre: findPatron() has been called
+        * @post: the item (or its absence) is stored in this Transaction
+        * @param: Library& - the library the item is looked up in
+        */
+        virtual void findItem(Library&) = 0;
+
+        /*-------------------------------------------------------------------------
+        * apply(Library&)
+        *
+        * Pure virtual, stage 4. Validates what the lookups found, changes the 
+        * library and patron, and prints the command's output or error.
+        * @pre: findItem() has been called, earlier commands have been applied
+        * @post: the command is executed
+        * @param: Library& - the library the command should change
+        * @return: returns a bool marking whether or not to save this transaction
+        * to the patron history, like execute()
+        */
+        virtual bool apply(Library&) = 0;
 
         /*-------------------------------------------------------------------------
         * display() 
@@ -84,6 +153,37 @@ class Transaction {
         * @param: None 
         */
         virtual void display() const = 0;
+
+        /*-------------------------------------------------------------------------
+        * replay(Patron*, char, Item*, int&)
+        *
+        * Pure virtual function to be implemented by derived classes. Redoes a 
+        * transaction that was already validated and executed once, as read back
+        * from a transaction log or snapshot. Nothing is printed and nothing is 
+        * re-validated. Stock is not changed directly, the change is handed back
+        * so the caller can apply it once every patron has been redone.
+        * @pre: the patron and item exist
+        * @post: the patron (and this Transaction) reflect the redone transaction
+        * @param: Patron* - the patron the transaction belongs to
+        * @param: char - the item type (section) of the item
+        * @param: Item* - the item in the library the transaction names
+        * @param: int& - set to the change in stock the transaction caused
+        * @return: returns a bool marking whether or not this transaction was 
+        * saved to the patron history, just like execute()
+        */
+        virtual bool replay(Patron*, char, Item*, int&) = 0;
+
+        /*-------------------------------------------------------------------------
+        * save(ostream&)
+        *
+        * Pure virtual function to be implemented by derived classes. Writes the
+        * transaction as a single command-format record (no newline) that can be
+        * read back to drive replay(). Only called for saved transactions.
+        * @pre: execute() or replay() has already been called by this object
+        * @post: Transaction is unchanged
+        * @param: ostream& - the stream the record is written to
+        */
+        virtual void save(ostream&) const = 0;
     
   private:
     // no member variables
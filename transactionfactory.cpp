@@ -4,10 +4,18 @@
 * @brief: implementation of the TransactionFactory class
 --------------------------------------------------------------------------*/
 #include "transactionfactory.h"
+#include "autocomplete.h"
 #include "checkout.h"
 #include "display.h"
 #include "history.h"
 #include "return.h"
+#include "search.h"
+#include "statistics.h"
+#include "storage.h"
+#include "typelist.h"
+
+// every command the library executes, each gets a prototype in the factory
+typedef TypeList<Autocomplete, Checkout, Display, History, Return, Search, Statistics, Storage> TransactionTypes;
 
 
 /*-------------------------------------------------------------------------
@@ -25,24 +33,10 @@ TransactionFactory::TransactionFactory(){
         transactionFactory[i] = nullptr;
     }
 
-    // Checkout
-    // C's ASCII Value = 67
-    transactionFactory[C_HASH_VALUE] = new Checkout;
-
-    // Display 
-    // D's ASCII Value = 68
-    transactionFactory[D_HASH_VALUE] = new Display;
-
-    // History
-    // H's ASCII Value = 72
-    transactionFactory[H_HASH_VALUE] = new History;
-
-    // Return
-    // R's ASCII Value = 82
-    /*
-    REMOVE HARD CODED NUMBERS, USE BUILT-IN ASCII SUBTRACTION TO CALCULATE 
-    */ 
-    transactionFactory[R_HASH_VALUE] = new Return;
+    // one prototype per type in TransactionTypes, at the position its
+    // letter hashes to (Checkout's C at 2, Display's D at 3, ...)
+    PrototypeRegistrar<Transaction> prototypes = {transactionFactory};
+    forEachType(prototypes, TransactionTypes());
 
 }
 
@@ -78,14 +72,16 @@ TransactionFactory::~TransactionFactory(){
 * @return: returns the new Transaction object
 */
 Transaction* TransactionFactory::createTransaction(char type){
-    int subscript = hashTransaction(type);
-    if (transactionFactory[subscript] == nullptr) {
-        cout << endl; 
-        cout << "ERROR: " << type << 
-        " is not a valid transaction type." << endl;
+    // parsed commands can hold any character as their type, all of them
+    // hash inside the array
+    Transaction* prototype = transactionFactory[hashTransaction(type)];
+    if (prototype == nullptr) {
+        // one buffered write, no flushes: cheap even when most lines are bad
+        cout << "\nERROR: " << type << 
+        " is not a valid transaction type.\n";
         return nullptr;
     }else{
-        return transactionFactory[subscript]->create();
+        return prototype->create();
     }
 }
 
@@ -93,7 +89,8 @@ Transaction* TransactionFactory::createTransaction(char type){
 /*-------------------------------------------------------------------------
 * hashTransaction
 *
-* Hashes a given character by subtracting 'A'
+* Hashes a given character with typeIndex(): 'A'-'Z' subtract 'A', any
+* other character gives the UNKNOWN_TYPE slot, which is never filled
 * @pre: TransactionFactory object exists 
 * @post: An integer is returned
 * @param: char - the key to be hashed against to find right kind of object
@@ -101,5 +98,5 @@ Transaction* TransactionFactory::createTransaction(char type){
 * transactionFactory[]
 */
 int TransactionFactory::hashTransaction(char type){
-    return type - 'A';
+    return typeIndex(type);
 } 
\ No newline at end of file
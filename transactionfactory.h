@@ -13,8 +13,9 @@
 // Assumptions/implementation:
 // -- All Transaction creation is dependent upon hashing and array indicies.
 // -- Switch-Cases and if/else statements are never used. 
-// -- Transactions can't be created unless explicitly instantiated in 
-//    constructor and stored in the factory's array
+// -- Transactions can't be created unless their class is listed in
+//    TransactionTypes (transactionfactory.cpp), the constructor stores a
+//    prototype of every listed type in the array
 // -- Transactions stored in the factory array must have a create() method 
 //    that returns a new object of that same type.
 //---------------------------------------------------------------------------
@@ -22,6 +23,7 @@
 #define TRANSACTIONFACTORY_H
 #include "transaction.h" 
 #include "constants.h"
+#include "typecodes.h"
 
 
 // Current Transactions Implemented: 
@@ -70,7 +72,8 @@ class TransactionFactory {
     /*-------------------------------------------------------------------------
     * hashTransaction
     *
-    * Hashes a given character by subtracting 'A'
+    * Hashes a given character with typeIndex(): 'A'-'Z' subtract 'A', any
+    * other character gives the UNKNOWN_TYPE slot, which is never filled
     * @pre: TransactionFactory object exists 
     * @post: An integer is returned
     * @param: char - the key to be hashed against to find right kind of object
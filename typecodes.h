@@ -0,0 +1,64 @@
+/*---------------------------------------------------------------------------
+* @file: typecodes.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: the table that turns a type letter into an array index
+---------------------------------------------------------------------------*/
+// Type codes: Media and transaction types are letters (F, C, P / C, R, D,
+// H, ...) and are hashed to an index of the factory and section arrays.
+// typeIndex() is the one hash all of them use: a load from a 256 entry
+// table built at compile time.
+//---------------------------------------------------------------------------
+// Features:
+// -- 'A' to 'Z' map to 0 to 25, like "type - 'A'" always did.
+// -- Every other byte (lowercase letters, digits, punctuation, ' ' for a
+//    missing field, bytes above 127) maps to UNKNOWN_TYPE, so no character
+//    can index outside an array.
+//
+// Assumptions/implementation:
+// -- Arrays indexed by typeIndex() have at least TYPE_SLOTS entries and
+//    never fill the UNKNOWN_TYPE one. Looking up a bad code then finds the
+//    same nullptr as a letter that has no type: the only check needed.
+//---------------------------------------------------------------------------
+#ifndef TYPECODES_H
+#define TYPECODES_H
+
+#include "constants.h"
+
+// every letter A-Z is a type code, with its own index (0-25)
+const static int TYPE_CODES = 26;
+// index of every other character: one past the letters, a slot that is
+// never filled, so it reads as "not a valid type"
+const static int UNKNOWN_TYPE = TYPE_CODES;
+// entries of an array indexed by typeIndex()
+const static int TYPE_SLOTS = TYPE_CODES + 1;
+
+static_assert(MEDIA_TYPES >= TYPE_SLOTS, "libraryStorage[] must have an UNKNOWN_TYPE slot");
+static_assert(TRANSACTION_TYPES >= TYPE_SLOTS, "transactionFactory[] must have an UNKNOWN_TYPE slot");
+
+// index of every byte value, filled in at compile time
+struct TypeIndexTable {
+    unsigned char index[256];
+
+    constexpr TypeIndexTable() : index() {
+        for (int code = 0; code < 256; code++) {
+            index[code] = (code >= 'A' && code <= 'Z') ? code - 'A' : UNKNOWN_TYPE;
+        }
+    }
+};
+
+constexpr TypeIndexTable TYPE_INDEX_TABLE;
+
+/*-------------------------------------------------------------------------
+* typeIndex(char)
+*
+* Hashes a type letter to its array index
+* @pre: None, any character can be passed
+* @post: None
+* @param: char - the type letter
+* @return: int - 0-25 for 'A'-'Z', UNKNOWN_TYPE for anything else
+*/
+inline int typeIndex(char type) {
+    return TYPE_INDEX_TABLE.index[static_cast<unsigned char>(type)];
+}
+
+#endif //TYPECODES_H
@@ -0,0 +1,58 @@
+/*---------------------------------------------------------------------------
+* @file: typelist.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: compile time lists of types and the registrars that walk them
+---------------------------------------------------------------------------*/
+// TypeList: A list of classes known at compile time. The factories and the
+// Library walk the list of media types or transaction types to fill their
+// hashed arrays, so a new type is added by writing its class and adding it
+// to its list, nothing else.
+//---------------------------------------------------------------------------
+// Features:
+// -- forEachType() calls visitor.visit<Type>() once for every type of a
+//    list, in list order.
+// -- PrototypeRegistrar stores a new object of every type at the index
+//    its letter hashes to, the way the factories used to by hand.
+//
+// Assumptions/implementation:
+// -- Every type in a list has a static const char TYPE, the letter that
+//    stands for it in data and command files.
+// -- Everything is expanded by the compiler: there is no loop and no
+//    virtual call left in what a registrar does.
+//---------------------------------------------------------------------------
+#ifndef TYPELIST_H
+#define TYPELIST_H
+
+#include "typecodes.h"
+
+template <class... Types>
+struct TypeList {};
+
+/*-------------------------------------------------------------------------
+* forEachType(Visitor&, TypeList<Types...>)
+*
+* Calls the visitor's visit<Type>() for every type of the list
+* @pre: Visitor has a template member visit<Type>()
+* @post: visit() has been called once per type, in list order
+* @param: Visitor& - what is done with every type
+* @param: TypeList<Types...> - the list, only its type is used
+*/
+template <class Visitor, class... Types>
+void forEachType(Visitor& visitor, TypeList<Types...>) {
+    // the braced list is evaluated in order, one element per type
+    int expand[] = {0, (visitor.template visit<Types>(), 0)...};
+    (void)expand;
+}
+
+// stores a prototype of every visited type in a factory's array
+template <class Base>
+struct PrototypeRegistrar {
+    Base** prototypes;
+
+    template <class Type>
+    void visit() {
+        prototypes[typeIndex(Type::TYPE)] = new Type;
+    }
+};
+
+#endif //TYPELIST_H
@@ -0,0 +1,357 @@
+/*---------------------------------------------------------------------------
+* @file: valuesection.h
+* @authors: Braxton Goss & Elijah Shaw
+* @brief: header file (and template implementation) of the ValueSection class
+*/
+//---------------------------------------------------------------------------
+// ValueSection Class: Section that stores its Items by value. Each tree
+// node embeds the Item itself instead of pointing to a heap allocated one,
+// and nodes are allocated VALUE_BLOCK_NODES at a time in contiguous blocks.
+// --------------------------------------------------------------------------
+// Features:
+//  -- A lookup touches one cache line per level (the node and the keys at
+//     the start of its Item) instead of two, and no vtable is loaded.
+//  -- retrieveAs() compares with Type::compare(), inlined into the descent.
+//  -- Same insert/retrieve/display contract as BinarySearchTree.
+//
+// Assumptions/implementation:
+// -- Holds Items of Type only. insert() copies the Item into its node and
+//    deletes the one passed in, duplicate or not.
+// -- Blocks are never moved or freed before makeEmpty(), so the Item
+//    pointers handed out (to patrons, to the transaction log) stay valid.
+//    A removed Item stays in its node, which is only unlinked.
+// -- The tree is not balanced, like BinarySearchTree. Traversals use a
+//    stack of their own instead of recursion.
+// -- A template, so everything is defined in this header.
+//---------------------------------------------------------------------------
+#ifndef VALUESECTION_H
+#define VALUESECTION_H
+
+#include <vector>
+#include <new>
+#include <utility>
+#include <typeinfo>
+#include "section.h"
+#include "constants.h"
+
+template <class Type>
+class ValueSection : public Section {
+
+public:
+    /*-------------------------------------------------------------------------
+    * ValueSection Constructor (with name and header)
+    *
+    * @pre: nothing
+    * @post: empty section exists, no block is allocated yet
+    * @param: string name - name of the section
+    * @param: string header - combination of headers used for display
+    */
+    ValueSection(string name, string header) : Section(name, header) {
+        root = nullptr;
+        used = VALUE_BLOCK_NODES;
+        count = 0;
+    }
+
+    /*-------------------------------------------------------------------------
+    * ValueSection Destructor
+    *
+    * @pre: section exists
+    * @post: calls makeEmpty() to release every Item and block
+    * @param: None
+    */
+    ~ValueSection() {
+        makeEmpty();
+    }
+
+    /*-------------------------------------------------------------------------
+    * retrieve()
+    *
+    * Section lookup for any Item: targets of another type are never found
+    * @pre: None
+    * @post: if a match is found, found points to the Item in the section
+    * @return: bool - true if found, false if not
+    */
+    bool retrieve(const Item &target, Item *&found) const {
+        int depth = 0;
+        return retrieve(target, found, depth);
+    }
+
+    bool retrieve(const Item &target, Item *&found, int &depth) const {
+        depth = 0;
+        if (typeid(target) != typeid(Type)) {
+            return false;
+        }
+        return retrieveAs(static_cast<const Type &>(target), found, depth);
+    }
+
+    /*-------------------------------------------------------------------------
+    * retrieveAs()
+    *
+    * same as retrieve() with depth, with a target already of Type. Matches
+    * what BinarySearchTree::retrieveAs<Type> finds.
+    * @pre: None
+    * @post: as retrieve(), depth is the number of nodes compared to target
+    * @param: const Type& target - the Item to find
+    * @param: Item*& found - set to the Item found, unchanged if not found
+    * @param: int& depth - set to the number of nodes visited
+    * @return: bool - true if found, false if not
+    */
+    bool retrieveAs(const Type &target, Item *&found, int &depth) const {
+        ValueNode *temp = root;
+        depth = 0;
+        while (temp != nullptr) {
+            depth++;
+            int order = temp->item.compare(target);
+            if (order == 0 && temp->item.sameFormat(target)) {
+                found = &temp->item;
+                return true;
+            }
+            temp = (order > 0) ? temp->left : temp->right;
+        }
+        return false;
+    }
+
+    /*-------------------------------------------------------------------------
+    * insert()
+    *
+    * @pre: data is a Type allocated with new
+    * @post: a copy of data is in the section (if not a duplicate), data is
+    * deleted either way
+    * @param: Item* data - the Item object to be inserted
+    * @return: true if inserted correctly, false if a duplicate
+    */
+    bool insert(Item *data) {
+        thaw();
+        const Type &item = static_cast<const Type &>(*data);
+        ValueNode **link = &root;
+        while (*link != nullptr) {
+            int order = item.compare((*link)->item);
+            if (order == 0) {
+                delete data;
+                return false; // no dupes allowed
+            }
+            link = (order < 0) ? &(*link)->left : &(*link)->right;
+        }
+        *link = allocate(item);
+        size_t hash = item.Type::keyHash();
+        index.insert(hash, &(*link)->item);
+        filterKey(hash);
+        count++;
+        delete data;
+        return true;
+    }
+
+    /*-------------------------------------------------------------------------
+    * remove()
+    *
+    * Unlinks the node of the Item retrieve() would find for target. A node
+    * with two children is replaced by its in-order successor node, so no
+    * Item moves.
+    * @pre: None (targets of another type are never found)
+    * @post: if a match is found, its node is unlinked but stays in its
+    * block, with its Item, until makeEmpty()
+    * @param: const Item& target - the Item to remove
+    * @param: Item*& removed - set to the Item removed, unchanged if not found
+    * @return: bool - true if removed, false if not found
+    */
+    bool remove(const Item &target, Item *&removed) {
+        if (typeid(target) != typeid(Type)) {
+            return false;
+        }
+        thaw();
+        const Type &key = static_cast<const Type &>(target);
+        ValueNode **link = &root;
+        while (*link != nullptr) {
+            int order = (*link)->item.compare(key);
+            if (order == 0 && (*link)->item.sameFormat(key)) {
+                break;
+            }
+            link = (order > 0) ? &(*link)->left : &(*link)->right;
+        }
+        if (*link == nullptr) {
+            return false;
+        }
+        ValueNode *node = *link;
+        if (node->left == nullptr) {
+            *link = node->right;
+        } else if (node->right == nullptr) {
+            *link = node->left;
+        } else {
+            // the leftmost node of the right subtree takes the node's place
+            ValueNode **next = &node->right;
+            while ((*next)->left != nullptr) {
+                next = &(*next)->left;
+            }
+            ValueNode *successor = *next;
+            *next = successor->right;
+            successor->left = node->left;
+            successor->right = node->right;
+            *link = successor;
+        }
+        node->left = node->right = nullptr;
+        index.remove(node->item.Type::keyHash(), &node->item);
+        removed = &node->item;
+        count--;
+        return true;
+    }
+
+    /*-------------------------------------------------------------------------
+    * isEmpty()
+    *
+    * @pre: section exists
+    * @post: section is unchanged
+    * @return boolean - true if the section holds no Items
+    */
+    bool isEmpty() const {
+        return (root == nullptr);
+    }
+
+    /*-------------------------------------------------------------------------
+    * makeEmpty()
+    *
+    * @pre: section exists (empty or not)
+    * @post: every Item is destroyed and every block freed
+    * @param: None
+    */
+    void makeEmpty() {
+        for (int b = 0; b < blocks.size(); b++) {
+            int nodes = (b + 1 < blocks.size()) ? VALUE_BLOCK_NODES : used;
+            for (int i = 0; i < nodes; i++) {
+                blocks[b][i].~ValueNode();
+            }
+            ::operator delete(blocks[b]);
+        }
+        blocks.clear();
+        clearIndexes();
+        used = VALUE_BLOCK_NODES;
+        count = 0;
+        root = nullptr;
+    }
+
+    /*-------------------------------------------------------------------------
+    * display()
+    *
+    * @pre: section exists (empty or not)
+    * @post: the header, then every Item in sorted order is printed
+    * @param: None
+    */
+    void display() const {
+        displayHeader();
+        vector<ValueNode*> pending;
+        ValueNode *node = root;
+        while (node != nullptr || !pending.empty()) {
+            while (node != nullptr) {
+                pending.push_back(node);
+                node = node->left;
+            }
+            node = pending.back();
+            pending.pop_back();
+            node->item.displayItem();
+            node = node->right;
+        }
+    }
+
+    /*-------------------------------------------------------------------------
+    * collect()
+    *
+    * @pre: section exists (empty or not)
+    * @post: every Item is appended to the vector in sorted order
+    * @param: vector<Item*>& items - the list the Items are appended to
+    */
+    void collect(vector<Item*> &items) const {
+        vector<ValueNode*> pending;
+        ValueNode *node = root;
+        while (node != nullptr || !pending.empty()) {
+            while (node != nullptr) {
+                pending.push_back(node);
+                node = node->left;
+            }
+            node = pending.back();
+            pending.pop_back();
+            items.push_back(&node->item);
+            node = node->right;
+        }
+    }
+
+    /*-------------------------------------------------------------------------
+    * measure()
+    *
+    * @pre: section exists (empty or not)
+    * @post: section is unchanged
+    * @param: Shape& shape - set to the height, depths and memory. Node
+    * bytes are the links of every node plus the unused nodes of the last
+    * block, Item bytes the Items embedded in the nodes.
+    */
+    void measure(Shape &shape) const {
+        resetShape(shape);
+        long depthSum = 0;
+        vector<pair<ValueNode*, int> > pending;
+        if (root != nullptr) {
+            pending.push_back(make_pair(root, 1));
+        }
+        while (!pending.empty()) {
+            ValueNode *node = pending.back().first;
+            int depth = pending.back().second;
+            pending.pop_back();
+
+            shape.nodes++;
+            depthSum += depth;
+            if (depth > shape.height) {
+                shape.height = depth;
+                shape.depths.resize(depth + 1, 0);
+            }
+            shape.depths[depth]++;
+            shape.stringBytes += node->item.getStringSize();
+
+            if (node->left != nullptr) {
+                pending.push_back(make_pair(node->left, depth + 1));
+            }
+            if (node->right != nullptr) {
+                pending.push_back(make_pair(node->right, depth + 1));
+            }
+        }
+        shape.itemBytes = static_cast<long>(sizeof(Type)) * count;
+        shape.nodeBytes = static_cast<long>(sizeof(ValueNode)) * blocks.size() * VALUE_BLOCK_NODES
+                          - shape.itemBytes;
+        shape.indexBytes = ((frozen != nullptr) ? frozen->getBytes() : index.getBytes())
+                           + filter.getBytes();
+        if (shape.nodes > 0) {
+            shape.averageDepth = static_cast<double>(depthSum) / shape.nodes;
+        }
+    }
+
+private:
+    // tree node with its Item inside
+    struct ValueNode {
+        Type item;
+        ValueNode *left;
+        ValueNode *right;
+
+        ValueNode(const Type &item) : item(item) {
+            left = right = nullptr;
+        }
+    };
+
+    ValueNode *root;              // root of the tree
+    vector<ValueNode*> blocks;    // storage, VALUE_BLOCK_NODES nodes each
+    int used;                     // nodes constructed in the last block
+    int count;                    // Items linked in the tree
+
+    // node holding a copy of item, in the next free place of the last block
+    ValueNode *allocate(const Type &item) {
+        if (used == VALUE_BLOCK_NODES) {
+            void *block = ::operator new(sizeof(ValueNode) * VALUE_BLOCK_NODES);
+            blocks.push_back(static_cast<ValueNode*>(block));
+            used = 0;
+        }
+        ValueNode *node = new (blocks.back() + used) ValueNode(item);
+        used++;
+        return node;
+    }
+
+    // copying would leave two sections owning the same blocks
+    ValueSection(const ValueSection &);
+    ValueSection &operator=(const ValueSection &);
+};
+
+#endif //VALUESECTION_H
@@ -0,0 +1,398 @@
+/*---------------------------------------------------------------------------
+* @file: wordindex.cpp
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: implementation of the WordIndex class
+---------------------------------------------------------------------------*/
+#include "wordindex.h"
+#include <algorithm>
+#include <queue>
+#include <cctype>
+#include <climits>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+// adds an ID, larger than every ID in it, to the end of a posting list
+static void append(vector<unsigned char>& gaps, int& last, int id) {
+    unsigned gap = static_cast<unsigned>(id - last);
+    while (gap >= 0x80) {
+        gaps.push_back(static_cast<unsigned char>(gap | 0x80));
+        gap >>= 7;
+    }
+    gaps.push_back(static_cast<unsigned char>(gap));
+    last = id;
+}
+
+/*-------------------------------------------------------------------------
+* Constructor
+*
+* @pre: None
+* @post: empty index exists
+* @param: None
+*/
+WordIndex::WordIndex() {
+    live = 0;
+    postings = 0;
+}
+
+/*-------------------------------------------------------------------------
+* insert(Item*)
+*
+* @pre: the Item is in a section and won't move while it is indexed
+* @post: the Item has the next ID and is in the lists of its title's
+* words. Titles with no words are not indexed.
+* @param: Item* - the Item
+*/
+void WordIndex::insert(Item* item) {
+    vector<string> tokens;
+    tokenize(item->getTitle(), tokens);
+    if (tokens.empty()) {
+        return;
+    }
+    int id = static_cast<int>(items.size());
+    items.push_back(item);
+    lengths.push_back(static_cast<unsigned char>(min(tokens.size(), static_cast<size_t>(255))));
+    live++;
+
+    // a word said twice in a title is listed once
+    sort(tokens.begin(), tokens.end());
+    tokens.erase(unique(tokens.begin(), tokens.end()), tokens.end());
+    for (size_t i = 0; i < tokens.size(); i++) {
+        Postings& list = words[tokens[i]];
+        if (list.count % WORD_BLOCK_IDS == 0) {
+            Skip skip = {id, static_cast<unsigned>(list.gaps.size())};
+            list.skips.push_back(skip);
+            list.last = id;
+        } else {
+            append(list.gaps, list.last, id);
+        }
+        list.count++;
+        postings++;
+    }
+}
+
+/*-------------------------------------------------------------------------
+* remove(const Item*)
+*
+* @pre: None
+* @post: searches no longer find the Item (nothing happens if it was
+* not indexed)
+* @param: const Item* - the Item, as it was inserted
+*/
+void WordIndex::remove(const Item* item) {
+    vector<string> tokens;
+    tokenize(item->getTitle(), tokens);
+    // the Item's ID is in the list of each of its words: the shortest is
+    // read to find it
+    const Postings* shortest = nullptr;
+    for (size_t i = 0; i < tokens.size(); i++) {
+        unordered_map<string, Postings>::const_iterator found = words.find(tokens[i]);
+        if (found == words.end()) {
+            return;
+        }
+        if (shortest == nullptr || found->second.count < shortest->count) {
+            shortest = &found->second;
+        }
+    }
+    if (shortest == nullptr) {
+        return;
+    }
+    int ids[WORD_BLOCK_IDS];
+    for (size_t block = 0; block < shortest->skips.size(); block++) {
+        int size = decode(*shortest, block, ids);
+        for (int i = 0; i < size; i++) {
+            if (items[ids[i]] == item) {
+                items[ids[i]] = nullptr;
+                live--;
+                return;
+            }
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------
+* search(const string&, vector<Item*>&)
+*
+* @pre: None
+* @post: index is unchanged
+* @param: const string& - the words looked for, in any order and case
+* @param: vector<Item*>& - set to the best WORD_SEARCH_RESULTS Items
+* whose titles hold every word, best first
+* @return: long - number of Items whose titles hold every word
+*/
+long WordIndex::search(const string& query, vector<Item*>& found) const {
+    found.clear();
+    vector<string> tokens;
+    tokenize(query, tokens);
+    sort(tokens.begin(), tokens.end());
+    tokens.erase(unique(tokens.begin(), tokens.end()), tokens.end());
+    vector<const Postings*> lists;
+    for (size_t i = 0; i < tokens.size(); i++) {
+        unordered_map<string, Postings>::const_iterator list = words.find(tokens[i]);
+        if (list == words.end()) {
+            return 0;
+        }
+        lists.push_back(&list->second);
+    }
+    if (lists.empty()) {
+        return 0;
+    }
+    // the shortest list gives the candidates, the others are only
+    // searched for them
+    sort(lists.begin(), lists.end(),
+         [](const Postings* a, const Postings* b) { return a->count < b->count; });
+    vector<Cursor> cursors(lists.size() - 1);
+    int end = lists[0]->last;
+    for (size_t i = 0; i < cursors.size(); i++) {
+        cursors[i].list = lists[i + 1];
+        cursors[i].block = 0;
+        cursors[i].size = decode(*lists[i + 1], 0, cursors[i].ids);
+        cursors[i].next = 0;
+        end = min(end, lists[i + 1]->last);
+    }
+
+    // best results so far, the worst on top: fewest words in the title
+    // first, then lowest ID
+    priority_queue<pair<int, int> > best;
+    long matches = 0;
+    int ids[WORD_BLOCK_IDS];
+    // a list that misses an ID tells the next one it holds: candidates
+    // below it are skipped, whole blocks of them without decoding
+    int floor = 0;
+    const vector<Skip>& skips = lists[0]->skips;
+    bool done = false;
+    for (size_t block = 0; block < skips.size() && !done; block++) {
+        if (block + 1 < skips.size() && skips[block + 1].first <= floor) {
+            continue;
+        }
+        int size = decode(*lists[0], block, ids);
+        for (int i = 0; i < size; i++) {
+            int id = ids[i];
+            if (id > end) {
+                // past the end of a list, nothing further can be in all
+                done = true;
+                break;
+            }
+            if (id < floor) {
+                continue;
+            }
+            bool everywhere = true;
+            for (size_t j = 0; j < cursors.size() && everywhere; j++) {
+                everywhere = advance(cursors[j], id);
+                if (!everywhere) {
+                    floor = following(cursors[j]);
+                }
+            }
+            // removed Items are only looked for among the matches, so the
+            // other candidates never touch the Items by ID
+            if (!everywhere || items[id] == nullptr) {
+                continue;
+            }
+            matches++;
+            pair<int, int> rank(lengths[id], id);
+            if (best.size() < static_cast<size_t>(WORD_SEARCH_RESULTS)) {
+                best.push(rank);
+            } else if (rank < best.top()) {
+                best.pop();
+                best.push(rank);
+            }
+        }
+    }
+    found.resize(best.size());
+    for (size_t i = found.size(); i-- > 0;) {
+        found[i] = items[best.top().second];
+        best.pop();
+    }
+    return matches;
+}
+
+/*-------------------------------------------------------------------------
+* makeEmpty()
+*
+* @pre: None
+* @post: nothing is indexed, IDs start from 0 again
+* @param: None
+*/
+void WordIndex::makeEmpty() {
+    words.clear();
+    items.clear();
+    lengths.clear();
+    live = 0;
+    postings = 0;
+}
+
+/*-------------------------------------------------------------------------
+* getItemCount(), getWordCount(), getPostingCount()
+*
+* @pre: None
+* @post: index is unchanged
+* @return: long - Items indexed (not removed), different words, IDs in
+* all the posting lists
+*/
+long WordIndex::getItemCount() const {
+    return live;
+}
+
+long WordIndex::getWordCount() const {
+    return static_cast<long>(words.size());
+}
+
+long WordIndex::getPostingCount() const {
+    return postings;
+}
+
+/*-------------------------------------------------------------------------
+* getBytes()
+*
+* @pre: None
+* @post: index is unchanged
+* @return: long - memory of the words, their posting lists and the
+* Items by ID
+*/
+long WordIndex::getBytes() const {
+    static const size_t INSIDE = string().capacity();
+    long bytes = static_cast<long>(items.capacity() * sizeof(Item*) + lengths.capacity()
+                                   + words.bucket_count() * sizeof(void*));
+    for (unordered_map<string, Postings>::const_iterator it = words.begin(); it != words.end(); ++it) {
+        // a node holds the word and its list, its next pointer and hash
+        bytes += sizeof(pair<const string, Postings>) + 2 * sizeof(void*);
+        bytes += (it->first.capacity() > INSIDE) ? it->first.capacity() + 1 : 0;
+        bytes += it->second.gaps.capacity() + it->second.skips.capacity() * sizeof(Skip);
+    }
+    return bytes;
+}
+
+/*-------------------------------------------------------------------------
+* tokenize(const string&, vector<string>&)
+*
+* @pre: None
+* @post: None
+* @param: const string& - a title (or a query)
+* @param: vector<string>& - set to its words, in order, lowercased
+*/
+void WordIndex::tokenize(const string& title, vector<string>& tokens) {
+    tokens.clear();
+    string word;
+    for (size_t i = 0; i <= title.size(); i++) {
+        unsigned char character = (i < title.size()) ? static_cast<unsigned char>(title[i]) : ' ';
+        // bytes above 127 (accented letters in UTF-8) are kept in words
+        if (isalnum(character) || character > 127) {
+            word += static_cast<char>(tolower(character));
+        } else if (!word.empty()) {
+            tokens.push_back(word);
+            word.clear();
+        }
+    }
+}
+
+/*-------------------------------------------------------------------------
+* decode(const Postings&, size_t, int*)
+*
+* @pre: block is a block of the list
+* @post: list is unchanged
+* @param: const Postings& - the list
+* @param: size_t - the block
+* @param: int* - set to the IDs of the block, in order
+* @return: int - number of IDs in the block
+*/
+int WordIndex::decode(const Postings& list, size_t block, int* ids) {
+    int size = min(WORD_BLOCK_IDS, list.count - static_cast<int>(block) * WORD_BLOCK_IDS);
+    const unsigned char* gap = list.gaps.data() + list.skips[block].offset;
+    ids[0] = list.skips[block].first;
+    for (int i = 1; i < size; i++) {
+        unsigned value = 0;
+        int shift = 0;
+        unsigned char byte;
+        do {
+            byte = *gap++;
+            value |= static_cast<unsigned>(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        ids[i] = ids[i - 1] + static_cast<int>(value);
+    }
+    return size;
+}
+
+/*-------------------------------------------------------------------------
+* following(const Cursor&)
+*
+* @pre: None
+* @post: cursor is unchanged
+* @param: const Cursor& - the cursor
+* @return: int - the first ID of its list not passed yet, INT_MAX if the
+* list has none left
+*/
+int WordIndex::following(const Cursor& cursor) {
+    if (cursor.next < cursor.size) {
+        return cursor.ids[cursor.next];
+    }
+    if (cursor.block + 1 < cursor.list->skips.size()) {
+        return cursor.list->skips[cursor.block + 1].first;
+    }
+    return INT_MAX;
+}
+
+/*-------------------------------------------------------------------------
+* advance(Cursor&, int)
+*
+* @pre: id is not below any ID the cursor was advanced to before
+* @post: the cursor is at the first ID of its list not below id (or past
+* the end of its block if the list has none)
+* @param: Cursor& - the cursor
+* @param: int - the ID looked for
+* @return: bool - true if the list holds id
+*/
+bool WordIndex::advance(Cursor& cursor, int id) {
+    if (cursor.ids[cursor.size - 1] < id) {
+        // gallop over the block heads: 1, 2, 4, ... blocks on, then halve
+        // between the last head not above id and the first past it
+        const vector<Skip>& skips = cursor.list->skips;
+        size_t low = cursor.block;
+        size_t step = 1;
+        while (low + step < skips.size() && skips[low + step].first <= id) {
+            low += step;
+            step *= 2;
+        }
+        size_t high = min(low + step, skips.size());
+        while (high - low > 1) {
+            size_t middle = low + (high - low) / 2;
+            if (skips[middle].first <= id) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+        if (low == cursor.block) {
+            // id falls between this block and the next
+            cursor.next = cursor.size;
+            return false;
+        }
+        cursor.block = low;
+        cursor.size = decode(*cursor.list, low, cursor.ids);
+        cursor.next = 0;
+    }
+
+    int next = cursor.next;
+#ifdef __SSE2__
+    // 4 IDs a compare: the ones below id are the low lanes (the IDs are
+    // sorted), so their count is where id is or would be
+    __m128i wanted = _mm_set1_epi32(id);
+    while (next + 4 <= cursor.size) {
+        __m128i four = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor.ids + next));
+        int below = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(four, wanted)));
+        if (below != 0xf) {
+            next += __builtin_popcount(below);
+            cursor.next = next;
+            return cursor.ids[next] == id;
+        }
+        next += 4;
+    }
+#endif
+    while (next < cursor.size && cursor.ids[next] < id) {
+        next++;
+    }
+    cursor.next = next;
+    return next < cursor.size && cursor.ids[next] == id;
+}
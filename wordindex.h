@@ -0,0 +1,173 @@
+/*---------------------------------------------------------------------------
+* @file: wordindex.h
+* @authors: Elijah Shaw, Braxton Goss
+* @brief: header file for the WordIndex class
+---------------------------------------------------------------------------*/
+// WordIndex Class: Inverted index from the words of the titles to the
+// Items holding them, for keyword search: "homework machine" finds
+// "Danny Dunn & the Homework Machine" without reading every title.
+//---------------------------------------------------------------------------
+// Features:
+// -- Words are the runs of letters and digits of a title, lowercased.
+//    Every Item gets an ID (in the order it was inserted), and every word
+//    a posting list: the IDs of the Items whose titles hold it.
+// -- Posting lists are compressed: blocks of WORD_BLOCK_IDS IDs, the first
+//    stored whole (in a skip list beside the bytes), the others as the
+//    varint gap from the ID before. A common word costs a byte or two an
+//    Item.
+// -- search() intersects the lists of the query's words, shortest first.
+//    Each longer list gallops over its block heads to the block that may
+//    hold the next ID, decodes only that block, and compares 4 IDs at a
+//    time (one SSE2 compare where the compiler has it). A list that
+//    misses tells the next ID it holds, and the shortest list skips to it.
+// -- Results are ranked by the share of the title the query's words make
+//    up, so "the hobbit" puts "The Hobbit" before "The Hobbit Companion";
+//    ties keep the order the Items were inserted in.
+//
+// Assumptions/implementation:
+// -- IDs only grow, so an insert appends to the end of its lists. Removing
+//    an Item clears its slot, its ID stays in the lists and is skipped by
+//    searches, until the index is rebuilt (makeEmpty() and inserts).
+// -- Holds pointers to Items, which must not move while they are indexed:
+//    the Library fills it after the sections are laid out.
+//---------------------------------------------------------------------------
+#ifndef WORDINDEX_H
+#define WORDINDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "item.h"
+#include "constants.h"
+
+using namespace std;
+
+class WordIndex {
+  public:
+    /*-------------------------------------------------------------------------
+    * Constructor
+    *
+    * @pre: None
+    * @post: empty index exists
+    * @param: None
+    */
+    WordIndex();
+
+    /*-------------------------------------------------------------------------
+    * insert(Item*)
+    *
+    * @pre: the Item is in a section and won't move while it is indexed
+    * @post: the Item has the next ID and is in the lists of its title's
+    * words. Titles with no words are not indexed.
+    * @param: Item* - the Item
+    */
+    void insert(Item*);
+
+    /*-------------------------------------------------------------------------
+    * remove(const Item*)
+    *
+    * @pre: None
+    * @post: searches no longer find the Item (nothing happens if it was
+    * not indexed)
+    * @param: const Item* - the Item, as it was inserted
+    */
+    void remove(const Item*);
+
+    /*-------------------------------------------------------------------------
+    * search(const string&, vector<Item*>&)
+    *
+    * @pre: None
+    * @post: index is unchanged
+    * @param: const string& - the words looked for, in any order and case
+    * @param: vector<Item*>& - set to the best WORD_SEARCH_RESULTS Items
+    * whose titles hold every word, best first
+    * @return: long - number of Items whose titles hold every word
+    */
+    long search(const string&, vector<Item*>&) const;
+
+    /*-------------------------------------------------------------------------
+    * makeEmpty()
+    *
+    * @pre: None
+    * @post: nothing is indexed, IDs start from 0 again
+    * @param: None
+    */
+    void makeEmpty();
+
+    /*-------------------------------------------------------------------------
+    * getItemCount(), getWordCount(), getPostingCount()
+    *
+    * @pre: None
+    * @post: index is unchanged
+    * @return: long - Items indexed (not removed), different words, IDs in
+    * all the posting lists
+    */
+    long getItemCount() const;
+    long getWordCount() const;
+    long getPostingCount() const;
+
+    /*-------------------------------------------------------------------------
+    * getBytes()
+    *
+    * @pre: None
+    * @post: index is unchanged
+    * @return: long - memory of the words, their posting lists and the
+    * Items by ID
+    */
+    long getBytes() const;
+
+    /*-------------------------------------------------------------------------
+    * tokenize(const string&, vector<string>&)
+    *
+    * @pre: None
+    * @post: None
+    * @param: const string& - a title (or a query)
+    * @param: vector<string>& - set to its words, in order, lowercased
+    */
+    static void tokenize(const string&, vector<string>&);
+
+  private:
+    // first ID of a block of a posting list, and where its gaps start
+    struct Skip {
+        int first;
+        unsigned offset;
+    };
+
+    // IDs of the Items whose titles hold one word
+    struct Postings {
+        vector<unsigned char> gaps;  // varint gaps, after each block's first
+        vector<Skip> skips;          // one per block
+        int count;                   // IDs in the list
+        int last;                    // last ID added
+    };
+
+    // a place in a posting list while it is intersected
+    struct Cursor {
+        const Postings* list;
+        size_t block;                // block decoded into ids
+        int ids[WORD_BLOCK_IDS];
+        int size;                    // IDs of that block
+        int next;                    // first of them not passed yet
+    };
+
+    unordered_map<string, Postings> words;  // posting list of every word
+    vector<Item*> items;                    // Item of every ID, nullptr if removed
+    vector<unsigned char> lengths;          // words of every ID's title (at most 255)
+    long live;                              // Items not removed
+    long postings;                          // IDs in all lists
+
+    // decodes a block of a list into ids, returns how many it holds
+    static int decode(const Postings& list, size_t block, int* ids);
+
+    // moves a cursor to the first ID not below id, true if it is id
+    static bool advance(Cursor& cursor, int id);
+
+    // first ID of a cursor's list not passed yet, INT_MAX if none is left
+    static int following(const Cursor& cursor);
+
+    // copying would leave two indexes with the same Items by ID
+    WordIndex(const WordIndex&);
+    WordIndex& operator=(const WordIndex&);
+};
+
+#endif //WORDINDEX_H